@@ -216,10 +216,10 @@ namespace scarab
             
             // order of precedence: default --> auth file --> env --> overrides
             f_data.clear();
-            f_data.merge( t_default_data );
-            if( t_file_data_ptr ) f_data.merge( t_file_data_ptr->as_node() );
-            f_data.merge( t_env_data );
-            f_data.merge( t_override_data );
+            f_data.merge( std::move(t_default_data) );
+            if( t_file_data_ptr ) f_data.merge( std::move(t_file_data_ptr->as_node()) );
+            f_data.merge( std::move(t_env_data) );
+            f_data.merge( std::move(t_override_data) );
             LDEBUG( mtlog, "Authentication data processed" );
             //LWARN( mtlog, "Final data:\n" << f_data );
         }
@@ -251,7 +251,7 @@ namespace scarab
 
         param_ptr_t t_file_data_ptr = std::make_unique< param_node >();
 
-        t_file_data_ptr->as_node().merge( t_read_file->as_node() );
+        t_file_data_ptr->as_node().merge( std::move(t_read_file->as_node()) );
         //LWARN( mtlog, "File loaded:\n" << t_file_data_ptr->as_node() );
         return t_file_data_ptr;
     }
@@ -61,8 +61,10 @@ namespace scarab
             config_decorator( this, this ),
             app(),
             f_primary_config(),
+            f_live_config(),
             f_default_config(),
             f_config_filename(),
+            f_config_filenames(),
             f_config_encoding(),
             f_nonoption_kw_args(),
             f_nonoption_ord_args(),
@@ -80,7 +82,10 @@ namespace scarab
 
         if( f_use_config )
         {
-            add_option( "-c,--config", f_config_filename, "Config file filename" )->check(CLI::ExistingFile);
+            // -c replaces config_filename (and any default set for it) with the first file given
+            add_option_function< std::vector< std::string > >( "-c,--config",
+                    [this]( const std::vector< std::string >& a_filenames ){ f_config_filenames = a_filenames; f_config_filename = a_filenames.front(); },
+                    "Config file filename; can be repeated, and later files take precedence" )->check(CLI::ExistingFile)->allow_extra_args(false);
             add_option( "--config-encoding", f_config_encoding, "Config file encoding" );
         }
 
@@ -162,6 +167,8 @@ namespace scarab
 
             LPROG( applog, "Final configuration:\n" << f_primary_config );
             LPROG( applog, "Ordered args:\n" << f_nonoption_ord_args );
+
+            f_live_config.publish( f_primary_config );
         }
 
         f_splash();
@@ -189,31 +196,42 @@ namespace scarab
         if( ! f_use_config ) return;
 
         LDEBUG( applog, "second configuration stage" );
-        if( ! f_config_filename.empty() )
+        // config_filenames is set from -c, in which case config_filename is its first element
+        std::vector< std::string > t_config_filepaths;
+        if( f_config_filenames.empty() && ! f_config_filename.empty() )
         {
-            path t_config_filepath = scarab::expand_path( f_config_filename );
-            LDEBUG( applog, "Loading config file <" << t_config_filepath << "> from filename <" << f_config_filename << ">" );
-            param_translator t_translator;
-            std::unique_ptr< param > t_config_from_file;
-            if( f_config_encoding.empty() )
+            t_config_filepaths.push_back( scarab::expand_path( f_config_filename ).string() );
+        }
+        for( const std::string& t_filename : f_config_filenames )
+        {
+            t_config_filepaths.push_back( scarab::expand_path( t_filename ).string() );
+        }
+        if( ! t_config_filepaths.empty() )
+        {
+            for( const std::string& t_filepath : t_config_filepaths )
             {
-                t_config_from_file = t_translator.read_file( t_config_filepath.string() );
+                LDEBUG( applog, "Loading config file <" << t_filepath << ">" );
             }
-            else
+            param_node t_file_opts;
+            if( ! f_config_encoding.empty() )
             {
-                param_node t_file_opts;
                 t_file_opts.add( "encoding", f_config_encoding );
-                t_config_from_file = t_translator.read_file( t_config_filepath.string(), t_file_opts );
-            }
-            if( t_config_from_file == NULL )
-            {
-                throw error() << "[application] error parsing config file";
             }
-            if( ! t_config_from_file->is_node() )
+            param_translator t_translator;
+            std::vector< param_ptr_t > t_configs_from_files = t_translator.read_each_file( t_config_filepaths, t_file_opts );
+            // merged in the order given, so later files take precedence
+            for( param_ptr_t& t_config_from_file : t_configs_from_files )
             {
-                throw error() << "[application] configuration file must consist of an object/node";
+                if( t_config_from_file == NULL )
+                {
+                    throw error() << "[application] error parsing config file";
+                }
+                if( ! t_config_from_file->is_node() )
+                {
+                    throw error() << "[application] configuration file must consist of an object/node";
+                }
+                f_primary_config.merge( std::move(t_config_from_file->as_node()) );
             }
-            f_primary_config.merge( t_config_from_file->as_node() );
         }
         //LWARN( applog, "Primary config, after stage 2:\n" << f_primary_config )
         return;
@@ -15,6 +15,7 @@
 #include "member_variables.hh"
 #include "param.hh"
 #include "param_helpers.hh"
+#include "param_versioned_config.hh"
 #include "version_semantic.hh"
 
 #include <type_traits>
@@ -122,7 +123,7 @@ namespace scarab
                     param_ptr_t t_new_config_ptr = simple_parser::parse_address(
                             f_primary_config_addr,
                             param_ptr_t( new param_value(f_value) ) ); // throws scarab::error if top-level param object is not a node
-                    a_app_options.merge( t_new_config_ptr->as_node() );
+                    a_app_options.merge( std::move(t_new_config_ptr->as_node()) );
                     return;
                 }
                 T f_value;
@@ -140,7 +141,7 @@ namespace scarab
                     param_ptr_t t_new_config_ptr = simple_parser::parse_address(
                             f_primary_config_addr,
                             param_ptr_t( new param_array(std::move(t_array)) ) ); // throws scarab::error if top-level param object is not a node
-                    a_app_options.merge( t_new_config_ptr->as_node() );
+                    a_app_options.merge( std::move(t_new_config_ptr->as_node()) );
                     return;
                 }
                 std::vector< T > f_values;
@@ -155,7 +156,7 @@ namespace scarab
                     param_ptr_t t_new_config_ptr = simple_parser::parse_address(
                             f_primary_config_addr,
                             param_ptr_t( new param_value( bool(f_value > 0) ) ) ); // throws scarab::error if top-level param object is not a node
-                    a_app_options.merge( t_new_config_ptr->as_node() );
+                    a_app_options.merge( std::move(t_new_config_ptr->as_node()) );
                     return;
                 }
                 int f_value;
@@ -226,7 +227,7 @@ namespace scarab
 
        Stages for setting the configuration
        1. Default options
-       2. Config file
+       2. Config file(s)
        3. Non-option arguments
        4. Application-specified options
 
@@ -244,12 +245,19 @@ namespace scarab
        The functionality for each stage is implemented in its own virtual function,
        so a subclass can customize the procedure as needed.
 
+       Once the configuration is final, it's published to `live_config` (as version 1).
+       Threads that need to follow changes to the configuration while the application is running
+       should read it through `live_config` (preferably with a `versioned_config::reader` on each thread)
+       instead of `primary_config`, and the new configuration can be pushed with `live_config().merge()` or `live_config().publish()`.
+
        Example:
          > my_app -c config.yaml --an_opt 20 nested.value="hello"
 
          What happens:
          1. my_app will have default values hard-coded
          2. File `config.yaml` will be parsed and merged with the defaults
+            (-c can be repeated, e.g. `-c site.yaml -c detector.yaml`; the files are parsed concurrently
+            and merged in the order given, so later files take precedence)
          3. Configuration `nested { value: "hello" }` will be merged with the primary config
          4. Option `an_opt` will set something specified in the config to 20
 
@@ -314,14 +322,18 @@ namespace scarab
 
             /// Master configuration tree for the application
             mv_referrable( param_node, primary_config );
+            /// The configuration while the application is running; starts as the final primary_config
+            mv_referrable( versioned_config, live_config );
 
             // configuration stage 1
             /// Default configuration values
             mv_referrable( param_node, default_config );
 
             // configuration stage 2
-            /// Configuration file name
+            /// Configuration file name; replaced by the first -c/--config, and read only if config_filenames is empty
             mv_referrable( std::string, config_filename );
+            /// Configuration file names, from each use of -c/--config; they're read concurrently and merged in order
+            mv_referrable( std::vector< std::string >, config_filenames );
             /// In case the encoding is not made clear by the file extension
             mv_referrable( std::string, config_encoding );
 
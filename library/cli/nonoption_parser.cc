@@ -53,7 +53,7 @@ namespace scarab
             param_ptr_t t_new_param = simple_parser::parse_address(
                     an_arg.substr(0, t_val_pos),
                     simple_parser::parse_value( an_arg.substr(t_val_pos+1) ) ); // can throw scarab::error
-            f_kw_args.merge( t_new_param->as_node() );
+            f_kw_args.merge( std::move(t_new_param->as_node()) );
         }
         else
         {
@@ -7,19 +7,31 @@
 
 #define SCARAB_API_EXPORTS
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <sstream>
+#include <streambuf>
+#include <vector>
 using std::string;
 using std::stringstream;
 
 #include "param_json.hh"
 
 #include "logger.hh"
+#include "mapped_file.hh"
 
 #include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
 #include "rapidjson/filereadstream.h"
 #include "rapidjson/filewritestream.h"
+#include "rapidjson/reader.h"
 #include "rapidjson/stringbuffer.h"
 
+#if defined( SCARAB_JSON_SIMD ) && defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#endif
+
 
 
 namespace scarab
@@ -35,75 +47,404 @@ namespace scarab
     {
     }
 
-    param_ptr_t param_input_json::read_file( const std::string& a_filename, const param_node& )
+    json_parse_error::json_parse_error() :
+            f_message(),
+            f_offset( 0 ),
+            f_line( 0 ),
+            f_column( 0 )
+    {}
+
+    std::string json_parse_error::to_string() const
+    {
+        if( f_line == 0 ) return f_message;
+        stringstream t_str;
+        t_str << f_message << " (line " << f_line << ", column " << f_column << ", byte " << f_offset << ")";
+        return t_str.str();
+    }
+
+    std::ostream& operator<<( std::ostream& out, const json_parse_error& an_error )
+    {
+        return out << an_error.to_string();
+    }
+
+    namespace json_simd
+    {
+        bool available()
+        {
+#if defined( SCARAB_JSON_SIMD ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+            static const bool s_available = __builtin_cpu_supports( "sse4.2" );
+            return s_available;
+#elif defined( SCARAB_JSON_SIMD ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+            // SSE4.2 support is bit 20 of ECX for CPUID function 1
+            static const bool s_available = []()
+            {
+                int t_info[ 4 ];
+                __cpuid( t_info, 1 );
+                return ( t_info[ 2 ] & ( 1 << 20 ) ) != 0;
+            }();
+            return s_available;
+#elif defined( SCARAB_JSON_SIMD )
+            // NEON is part of 64-bit ARM
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        const char* instruction_set()
+        {
+            if( ! available() ) return "";
+#if defined( __aarch64__ ) || defined( _M_ARM64 )
+            return "NEON";
+#else
+            return "SSE4.2";
+#endif
+        }
+    }
+
+    namespace
+    {
+        // Wraps a rapidjson input stream and counts lines as characters are taken from it,
+        // so that the location of a parse error is known without reading the input again
+        template< class XStream >
+        class line_counting_stream
+        {
+            public:
+                typedef typename XStream::Ch Ch;
+
+                line_counting_stream( XStream& a_stream ) :
+                        f_stream( a_stream ),
+                        f_line( 1 ),
+                        f_line_start( 0 )
+                {}
+
+                Ch Peek() const { return f_stream.Peek(); }
+                Ch Take()
+                {
+                    Ch t_char = f_stream.Take();
+                    if( t_char == '\n' )
+                    {
+                        ++f_line;
+                        f_line_start = f_stream.Tell();
+                    }
+                    return t_char;
+                }
+                size_t Tell() const { return f_stream.Tell(); }
+
+                // only used for in-situ parsing and writing, which these streams don't do
+                Ch* PutBegin() { return f_stream.PutBegin(); }
+                void Put( Ch a_char ) { f_stream.Put( a_char ); }
+                void Flush() { f_stream.Flush(); }
+                size_t PutEnd( Ch* a_begin ) { return f_stream.PutEnd( a_begin ); }
+
+                size_t line() const { return f_line; }
+                size_t line_start() const { return f_line_start; }
+
+            private:
+                XStream& f_stream;
+                size_t f_line;
+                size_t f_line_start;
+        };
+
+        // rapidjson input stream that reads a std::streambuf through a buffer, as rapidjson::FileReadStream does a FILE
+        class streambuf_read_stream
+        {
+            public:
+                typedef char Ch;
+
+                streambuf_read_stream( std::streambuf* a_streambuf ) :
+                        f_streambuf( a_streambuf ),
+                        f_buffer( RAPIDJSON_FILE_BUFFER_SIZE ),
+                        f_current( nullptr ),
+                        f_last( nullptr ),
+                        f_read_count( 0 ),
+                        f_count( 0 ),
+                        f_eof( false )
+                {
+                    read();
+                }
+
+                Ch Peek() const { return *f_current; }
+                Ch Take()
+                {
+                    Ch t_char = *f_current;
+                    read();
+                    return t_char;
+                }
+                size_t Tell() const { return f_count + ( f_current - f_buffer.data() ); }
+
+                // only used for in-situ parsing and writing, which this stream doesn't do
+                Ch* PutBegin() { return nullptr; }
+                void Put( Ch ) {}
+                void Flush() {}
+                size_t PutEnd( Ch* ) { return 0; }
+
+            private:
+                // moves to the next character, refilling the buffer when it's used up; the end of the input reads as a zero
+                void read()
+                {
+                    if( f_current < f_last )
+                    {
+                        ++f_current;
+                        return;
+                    }
+                    if( f_eof ) return;
+
+                    f_count += f_read_count;
+                    f_read_count = size_t( f_streambuf->sgetn( f_buffer.data(), std::streamsize( f_buffer.size() - 1 ) ) );
+                    f_current = f_buffer.data();
+                    f_last = f_buffer.data() + f_read_count - 1;
+                    if( f_read_count < f_buffer.size() - 1 )
+                    {
+                        f_buffer[ f_read_count ] = '\0';
+                        ++f_last;
+                        f_eof = true;
+                    }
+                    return;
+                }
+
+                std::streambuf* f_streambuf;
+                std::vector< Ch > f_buffer;
+                Ch* f_current;
+                Ch* f_last;
+                size_t f_read_count;
+                size_t f_count;
+                bool f_eof;
+        };
+
+        void record_error( json_parse_error& an_error, rapidjson::ParseErrorCode a_code, size_t an_offset, size_t a_line, size_t a_line_start )
+        {
+            an_error.f_message = rapidjson::GetParseError_En( a_code );
+            an_error.f_offset = an_offset;
+            an_error.f_line = a_line;
+            an_error.f_column = an_offset >= a_line_start ? an_offset - a_line_start + 1 : 1;
+            return;
+        }
+
+        // records an error in text that's in memory, counting the lines that precede it
+        void record_error( json_parse_error& an_error, rapidjson::ParseErrorCode a_code, size_t an_offset, const char* a_text, size_t a_size )
+        {
+            size_t t_line = 1;
+            size_t t_line_start = 0;
+            const char* t_end = a_text + std::min( an_offset, a_size );
+            for( const char* t_newline = a_text; ( t_newline = static_cast< const char* >( std::memchr( t_newline, '\n', t_end - t_newline ) ) ) != nullptr; ++t_newline )
+            {
+                ++t_line;
+                t_line_start = t_newline - a_text + 1;
+            }
+            record_error( an_error, a_code, an_offset, t_line, t_line_start );
+            return;
+        }
+    }
+
+    param_ptr_t param_input_json::read_file( const std::string& a_filename, const param_node& a_options )
+    {
+        json_parse_error t_error;
+        param_ptr_t t_param = read_file( a_filename, a_options, t_error );
+        if( ! t_param )
+        {
+            LERROR( dlog, "error reading JSON file <" << a_filename << ">:\n\t" << t_error );
+        }
+        return t_param;
+    }
+
+    param_ptr_t param_input_json::read_file( const std::string& a_filename, const param_node& a_options, json_parse_error& an_error )
     {
+        an_error = json_parse_error();
+
+        if( a_options.get_value( "mmap", false ) )
+        {
+            return read_mapped_file( a_filename, a_options.get_value( "typed-arrays", false ), a_options.get_value( "dom", false ),
+                                     a_options.get_value( "lazy", false ), a_options.get_value( "simd", true ), an_error );
+        }
+
         FILE* t_config_file = fopen( a_filename.c_str(), "r" );
         if( t_config_file == NULL )
         {
-            LERROR( dlog, "file <" << a_filename << "> did not open" );
+            an_error.f_message = "file did not open";
             return NULL;
         }
 
         char t_buffer[ RAPIDJSON_FILE_BUFFER_SIZE ];
         rapidjson::FileReadStream t_file_stream( t_config_file, t_buffer, sizeof(t_buffer) );
+        param_ptr_t t_param = read_input_stream( t_file_stream, a_options, an_error );
+        fclose( t_config_file );
+        return t_param;
+    }
 
-        rapidjson::Document t_config_doc;
-        if( t_config_doc.ParseStream<0>( t_file_stream ).HasParseError() )
+    param_ptr_t param_input_json::read_stream( std::istream& a_stream, const param_node& a_options )
+    {
+        json_parse_error t_error;
+        param_ptr_t t_param = read_stream( a_stream, a_options, t_error );
+        if( ! t_param )
         {
-            unsigned errorPos = t_config_doc.GetErrorOffset();
-            rewind( t_config_file );
-            unsigned iChar, newlineCount = 1, lastNewlinePos = 0;
-            int thisChar;
-            for( iChar = 0; iChar != errorPos; ++iChar )
+            LERROR( dlog, "error reading JSON stream:\n\t" << t_error );
+        }
+        return t_param;
+    }
+
+    param_ptr_t param_input_json::read_stream( std::istream& a_stream, const param_node& a_options, json_parse_error& an_error )
+    {
+        an_error = json_parse_error();
+        streambuf_read_stream t_stream( a_stream.rdbuf() );
+        return read_input_stream( t_stream, a_options, an_error );
+    }
+
+    template< class XStream >
+    param_ptr_t param_input_json::read_input_stream( XStream& a_input, const param_node& a_options, json_parse_error& an_error )
+    {
+        line_counting_stream< XStream > t_stream( a_input );
+
+        bool t_typed_arrays = a_options.get_value( "typed-arrays", false );
+        bool t_lazy = a_options.get_value( "lazy", false );
+
+        if( t_lazy || a_options.get_value( "dom", false ) )
+        {
+            std::shared_ptr< rapidjson::Document > t_config_doc = std::make_shared< rapidjson::Document >();
+            t_config_doc->ParseStream<0>( t_stream );
+            if( t_config_doc->HasParseError() )
             {
-                thisChar = fgetc( t_config_file );
-                if( thisChar == EOF )
-                {
-                    break;
-                }
-                if( thisChar == '\n' || thisChar == '\r' )
-                {
-                    newlineCount++;
-                    lastNewlinePos = iChar + 1;
-                }
+                record_error( an_error, t_config_doc->GetParseError(), t_config_doc->GetErrorOffset(), t_stream.line(), t_stream.line_start() );
+                return NULL;
             }
-            if( iChar == errorPos )
+            if( t_lazy ) return param_input_json::read_deferred( t_config_doc, *t_config_doc, t_typed_arrays );
+            return param_input_json::read_document( *t_config_doc, t_typed_arrays );
+        }
+
+        param_json_handler t_handler( t_typed_arrays );
+        rapidjson::Reader t_reader;
+        t_reader.Parse<0>( t_stream, t_handler );
+        if( t_reader.HasParseError() )
+        {
+            record_error( an_error, t_reader.GetParseErrorCode(), t_reader.GetErrorOffset(), t_stream.line(), t_stream.line_start() );
+            return NULL;
+        }
+        return t_handler.release();
+    }
+
+    namespace
+    {
+        // a document parsed in situ, along with the mapping that its strings point into
+        struct mapped_document
+        {
+            std::unique_ptr< mapped_file > f_file;
+            rapidjson::Document f_doc;
+        };
+    }
+
+    param_ptr_t param_input_json::read_mapped_file( const std::string& a_filename, bool a_typed_arrays, bool a_dom, bool a_lazy, bool a_simd, json_parse_error& an_error )
+    {
+        std::unique_ptr< mapped_file > t_file;
+        try
+        {
+            t_file.reset( new mapped_file( a_filename ) );
+        }
+        catch( const error& e )
+        {
+            an_error.f_message = e.what();
+            return NULL;
+        }
+
+        // the mapping is private and ends in a zero byte, so it can be parsed in situ
+        rapidjson::ParseErrorCode t_code = rapidjson::kParseErrorNone;
+        size_t t_offset = 0;
+        param_ptr_t t_param;
+        if( a_lazy )
+        {
+            std::shared_ptr< mapped_document > t_mapped_doc = std::make_shared< mapped_document >();
+            t_mapped_doc->f_file = std::move( t_file );
+            t_mapped_doc->f_doc.ParseInsitu<0>( t_mapped_doc->f_file->data() );
+            t_code = t_mapped_doc->f_doc.GetParseError();
+            t_offset = t_mapped_doc->f_doc.GetErrorOffset();
+            if( ! t_mapped_doc->f_doc.HasParseError() )
             {
-                LERROR( dlog, "error parsing config file :\n" <<
-                        '\t' << t_config_doc.GetParseError() << '\n' <<
-                        "\tThe error was reported at line " << newlineCount << ", character " << errorPos - lastNewlinePos );
+                // the deferred nodes and arrays keep the mapping as well as the document
+                std::shared_ptr< const rapidjson::Document > t_config_doc( t_mapped_doc, &t_mapped_doc->f_doc );
+                t_param = param_input_json::read_deferred( t_config_doc, *t_config_doc, a_typed_arrays );
             }
-            else
+        }
+        else if( a_dom )
+        {
+            rapidjson::Document t_config_doc;
+            t_config_doc.ParseInsitu<0>( t_file->data() );
+            t_code = t_config_doc.GetParseError();
+            t_offset = t_config_doc.GetErrorOffset();
+            if( ! t_config_doc.HasParseError() ) t_param = param_input_json::read_document( t_config_doc, a_typed_arrays );
+        }
+        else
+        {
+            param_json_handler t_handler( a_typed_arrays );
+            rapidjson::ParseResult t_result = t_handler.parse_insitu( t_file->data(), a_simd );
+            t_code = t_result.Code();
+            t_offset = t_result.Offset();
+            if( ! t_result.IsError() ) t_param = t_handler.release();
+        }
+
+        if( t_code != rapidjson::kParseErrorNone )
+        {
+            // in-situ parsing has modified the mapping, so the lines are counted in a fresh one;
+            // only the failure case pays for this
+            try
             {
-                LERROR( dlog, "error parsing config file :\n" <<
-                        '\t' << t_config_doc.GetParseError() <<
-                        "\tend of file reached before error location was found" );
+                mapped_file t_original( a_filename );
+                record_error( an_error, t_code, t_offset, t_original.data(), t_original.size() );
+            }
+            catch( const error& )
+            {
+                an_error.f_message = rapidjson::GetParseError_En( t_code );
+                an_error.f_offset = t_offset;
             }
-            fclose( t_config_file );
-            return NULL;
         }
-        fclose( t_config_file );
+        return t_param;
+    }
 
-        return param_input_json::read_document( t_config_doc );
+    param_ptr_t param_input_json::read_string( const std::string& a_json_string, const param_node& a_options )
+    {
+        json_parse_error t_error;
+        param_ptr_t t_param = read_string( a_json_string, a_options, t_error );
+        if( ! t_param )
+        {
+            LERROR( dlog, "error parsing JSON string:\n\t" << t_error );
+        }
+        return t_param;
     }
 
-    param_ptr_t param_input_json::read_string( const std::string& a_json_string, const param_node& )
+    param_ptr_t param_input_json::read_string( const std::string& a_json_string, const param_node& a_options, json_parse_error& an_error )
     {
-        rapidjson::Document t_config_doc;
-        if( t_config_doc.Parse<0>( a_json_string.c_str() ).HasParseError() )
+        an_error = json_parse_error();
+
+        bool t_typed_arrays = a_options.get_value( "typed-arrays", false );
+        bool t_lazy = a_options.get_value( "lazy", false );
+
+        if( t_lazy || a_options.get_value( "dom", false ) )
         {
-            LERROR( dlog, "error parsing string:\n" << t_config_doc.GetParseError() );
+            // the document copies the strings, so it doesn't depend on a_json_string
+            std::shared_ptr< rapidjson::Document > t_config_doc = std::make_shared< rapidjson::Document >();
+            if( t_config_doc->Parse<0>( a_json_string.c_str() ).HasParseError() )
+            {
+                record_error( an_error, t_config_doc->GetParseError(), t_config_doc->GetErrorOffset(), a_json_string.data(), a_json_string.size() );
+                return NULL;
+            }
+            if( t_lazy ) return param_input_json::read_deferred( t_config_doc, *t_config_doc, t_typed_arrays );
+            return param_input_json::read_document( *t_config_doc, t_typed_arrays );
+        }
+
+        param_json_handler t_handler( t_typed_arrays );
+        rapidjson::ParseResult t_result = t_handler.parse( a_json_string.c_str(), a_options.get_value( "simd", true ) );
+        if( t_result.IsError() )
+        {
+            record_error( an_error, t_result.Code(), t_result.Offset(), a_json_string.data(), a_json_string.size() );
             return NULL;
         }
-        return param_input_json::read_document( t_config_doc );
+        return t_handler.release();
     }
 
-    param_ptr_t param_input_json::read_document( const rapidjson::Document& a_doc )
+    param_ptr_t param_input_json::read_document( const rapidjson::Document& a_doc, bool a_typed_arrays )
     {
-        return read_value( a_doc );
+        return read_value( a_doc, a_typed_arrays );
     }
 
-    param_ptr_t param_input_json::read_value( const rapidjson::Value& a_value )
+    param_ptr_t param_input_json::read_value( const rapidjson::Value& a_value, bool a_typed_arrays )
     {
         if( a_value.IsNull() )
         {
@@ -116,18 +457,23 @@ namespace scarab
                     jsonIt != a_value.MemberEnd();
                     ++jsonIt)
             {
-                t_obj_as_param->replace( jsonIt->name.GetString(), param_input_json::read_value( jsonIt->value ) );
+                t_obj_as_param->insert_or_assign( jsonIt->name.GetString(), param_input_json::read_value( jsonIt->value, a_typed_arrays ) );
             }
             return t_obj_as_param;
         }
         if( a_value.IsArray() )
         {
+            if( a_typed_arrays )
+            {
+                param_ptr_t t_typed_array = read_typed_array( a_value );
+                if( t_typed_array ) return t_typed_array;
+            }
             std::unique_ptr< param_array > t_array_as_param( new param_array() );
             for( rapidjson::Value::ConstValueIterator jsonIt = a_value.Begin();
                     jsonIt != a_value.End();
                     ++jsonIt)
             {
-                t_array_as_param->push_back( std::move(*param_input_json::read_value( *jsonIt )) );
+                t_array_as_param->push_back( std::move(*param_input_json::read_value( *jsonIt, a_typed_arrays )) );
             }
             return t_array_as_param;
         }
@@ -170,33 +516,347 @@ namespace scarab
         return std::unique_ptr< param >( new param() );
     }
 
+    param_ptr_t param_input_json::read_deferred( const std::shared_ptr< const rapidjson::Document >& a_document, const rapidjson::Value& a_value, bool a_typed_arrays )
+    {
+        // the builders only read the document, which rapidjson allows from several threads at once
+        const rapidjson::Value* t_value = &a_value;
+        if( a_value.IsObject() )
+        {
+            return param_ptr_t( new param_node( param_node::deferred( [a_document, t_value, a_typed_arrays]()
+            {
+                param_input_json t_codec;
+                param_node::contents t_contents;
+                for( rapidjson::Value::ConstMemberIterator jsonIt = t_value->MemberBegin(); jsonIt != t_value->MemberEnd(); ++jsonIt )
+                {
+                    t_contents[ std::string_view( jsonIt->name.GetString(), jsonIt->name.GetStringLength() ) ] = t_codec.read_deferred( a_document, jsonIt->value, a_typed_arrays );
+                }
+                return t_contents;
+            } ) ) );
+        }
+        if( a_value.IsArray() )
+        {
+            if( a_typed_arrays )
+            {
+                param_ptr_t t_typed_array = read_typed_array( a_value );
+                if( t_typed_array ) return t_typed_array;
+            }
+            return param_ptr_t( new param_array( param_array::deferred( [a_document, t_value, a_typed_arrays]()
+            {
+                param_input_json t_codec;
+                param_array::contents t_contents;
+                for( rapidjson::Value::ConstValueIterator jsonIt = t_value->Begin(); jsonIt != t_value->End(); ++jsonIt )
+                {
+                    t_contents.push_back( t_codec.read_deferred( a_document, *jsonIt, a_typed_arrays ) );
+                }
+                return t_contents;
+            } ) ) );
+        }
+        return read_value( a_value, a_typed_arrays );
+    }
+
+    param_ptr_t param_input_json::read_typed_array( const rapidjson::Value& a_value )
+    {
+        // numbers are classified as read_value() would make them: non-negative integers are unsigned
+        typed_array_classifier t_classifier;
+        for( rapidjson::Value::ConstValueIterator jsonIt = a_value.Begin(); jsonIt != a_value.End(); ++jsonIt )
+        {
+            if( ! jsonIt->IsNumber() ) return param_ptr_t();
+            if( jsonIt->IsDouble() ) t_classifier.add_double();
+            else if( jsonIt->IsUint64() ) t_classifier.add_uint( jsonIt->GetUint64() );
+            else t_classifier.add_int();
+        }
 
-    REGISTER_PARAM_OUTPUT_CODEC( param_output_json, "json" );
+        param_typed_array_base::element_type t_type;
+        if( ! t_classifier.classify( t_type ) ) return param_ptr_t();
+        switch( t_type )
+        {
+            case param_typed_array_base::k_int64:
+            {
+                std::unique_ptr< param_int64_array > t_array( new param_int64_array( a_value.Size() ) );
+                std::int64_t* t_data = t_array->data();
+                for( rapidjson::Value::ConstValueIterator jsonIt = a_value.Begin(); jsonIt != a_value.End(); ++jsonIt ) *t_data++ = jsonIt->GetInt64();
+                return t_array;
+            }
+            case param_typed_array_base::k_uint64:
+            {
+                std::unique_ptr< param_uint64_array > t_array( new param_uint64_array( a_value.Size() ) );
+                std::uint64_t* t_data = t_array->data();
+                for( rapidjson::Value::ConstValueIterator jsonIt = a_value.Begin(); jsonIt != a_value.End(); ++jsonIt ) *t_data++ = jsonIt->GetUint64();
+                return t_array;
+            }
+            case param_typed_array_base::k_double:
+            {
+                std::unique_ptr< param_double_array > t_array( new param_double_array( a_value.Size() ) );
+                double* t_data = t_array->data();
+                for( rapidjson::Value::ConstValueIterator jsonIt = a_value.Begin(); jsonIt != a_value.End(); ++jsonIt ) *t_data++ = jsonIt->GetDouble();
+                return t_array;
+            }
+        }
+        return param_ptr_t();
+    }
 
-    param_output_json::param_output_json()
+
+    param_json_handler::param_json_handler( bool a_typed_arrays ) :
+            f_open(),
+            f_key(),
+            f_result(),
+            f_typed_arrays( a_typed_arrays )
     {}
 
-    param_output_json::~param_output_json()
+    param_json_handler::~param_json_handler()
     {}
 
-    bool param_output_json::write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options )
+#ifdef SCARAB_JSON_SIMD
+    namespace
     {
-        if( a_filename.empty() )
+        // passes the events of the SIMD parser on to a param_json_handler
+        class simd_forwarder : public json_simd::event_handler
         {
-            LERROR( dlog, "Filename cannot be an empty string" );
-            return false;
+            public:
+                simd_forwarder( param_json_handler& a_handler ) : f_handler( a_handler ) {}
+                virtual ~simd_forwarder() {}
+
+                virtual bool Null() { return f_handler.Null(); }
+                virtual bool Bool( bool a_value ) { return f_handler.Bool( a_value ); }
+                virtual bool Int( int a_value ) { return f_handler.Int( a_value ); }
+                virtual bool Uint( unsigned a_value ) { return f_handler.Uint( a_value ); }
+                virtual bool Int64( std::int64_t a_value ) { return f_handler.Int64( a_value ); }
+                virtual bool Uint64( std::uint64_t a_value ) { return f_handler.Uint64( a_value ); }
+                virtual bool Double( double a_value ) { return f_handler.Double( a_value ); }
+                virtual bool RawNumber( const char* a_str, unsigned a_length, bool a_copy ) { return f_handler.RawNumber( a_str, a_length, a_copy ); }
+                virtual bool String( const char* a_str, unsigned a_length, bool a_copy ) { return f_handler.String( a_str, a_length, a_copy ); }
+                virtual bool StartObject() { return f_handler.StartObject(); }
+                virtual bool Key( const char* a_str, unsigned a_length, bool a_copy ) { return f_handler.Key( a_str, a_length, a_copy ); }
+                virtual bool EndObject( unsigned a_member_count ) { return f_handler.EndObject( a_member_count ); }
+                virtual bool StartArray() { return f_handler.StartArray(); }
+                virtual bool EndArray( unsigned an_element_count ) { return f_handler.EndArray( an_element_count ); }
+
+            private:
+                param_json_handler& f_handler;
+        };
+    }
+#endif
+
+    rapidjson::ParseResult param_json_handler::parse( const char* a_text, bool a_simd )
+    {
+#ifdef SCARAB_JSON_SIMD
+        if( a_simd && json_simd::available() )
+        {
+            simd_forwarder t_forwarder( *this );
+            json_simd::parse_outcome t_outcome = json_simd::parse( a_text, t_forwarder );
+            return rapidjson::ParseResult( rapidjson::ParseErrorCode( t_outcome.f_code ), t_outcome.f_offset );
         }
+#else
+        (void)a_simd;
+#endif
+        rapidjson::Reader t_reader;
+        rapidjson::StringStream t_stream( a_text );
+        return t_reader.Parse< 0 >( t_stream, *this );
+    }
 
-        FILE* file = fopen( a_filename.c_str(), "w" );
-        if( file == NULL )
+    rapidjson::ParseResult param_json_handler::parse_insitu( char* a_text, bool a_simd )
+    {
+#ifdef SCARAB_JSON_SIMD
+        if( a_simd && json_simd::available() )
         {
-            LERROR( dlog, "Unable to open file: " << a_filename );
-            return false;
+            simd_forwarder t_forwarder( *this );
+            json_simd::parse_outcome t_outcome = json_simd::parse_insitu( a_text, t_forwarder );
+            return rapidjson::ParseResult( rapidjson::ParseErrorCode( t_outcome.f_code ), t_outcome.f_offset );
         }
+#else
+        (void)a_simd;
+#endif
+        rapidjson::Reader t_reader;
+        rapidjson::InsituStringStream t_stream( a_text );
+        return t_reader.Parse< rapidjson::kParseInsituFlag >( t_stream, *this );
+    }
 
-        char t_buffer[ RAPIDJSON_FILE_BUFFER_SIZE ];
-        rapidjson::FileWriteStream t_filestream( file, t_buffer, sizeof(t_buffer) );
+    bool param_json_handler::Null()
+    {
+        return add( param_ptr_t( new param() ) );
+    }
+
+    bool param_json_handler::Bool( bool a_value )
+    {
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::Int( int a_value )
+    {
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::Uint( unsigned a_value )
+    {
+        // a rapidjson::Value holding a non-negative number that fits in an int reports IsInt(), so read_value() stores it as an int
+        if( a_value <= unsigned( std::numeric_limits< int >::max() ) ) return add( param_ptr_t( new param_value( int( a_value ) ) ) );
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::Int64( int64_t a_value )
+    {
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::Uint64( uint64_t a_value )
+    {
+        // likewise, read_value() stores a number that fits in an int64 as an int64
+        if( a_value <= uint64_t( std::numeric_limits< int64_t >::max() ) ) return add( param_ptr_t( new param_value( int64_t( a_value ) ) ) );
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::Double( double a_value )
+    {
+        return add( param_ptr_t( new param_value( a_value ) ) );
+    }
+
+    bool param_json_handler::RawNumber( const char* /*a_str*/, rapidjson::SizeType /*a_length*/, bool /*a_copy*/ )
+    {
+        LERROR( dlog, "Numbers parsed as strings are not supported" );
+        return false;
+    }
+
+    bool param_json_handler::String( const char* a_str, rapidjson::SizeType a_length, bool /*a_copy*/ )
+    {
+        return add( param_ptr_t( new param_value( std::string( a_str, a_length ) ) ) );
+    }
+
+    bool param_json_handler::StartObject()
+    {
+        f_open.push_back( open_container{ param_ptr_t( new param_node() ), std::move(f_key), typed_array_classifier(), false } );
+        f_key.clear();
+        return true;
+    }
+
+    bool param_json_handler::Key( const char* a_str, rapidjson::SizeType a_length, bool /*a_copy*/ )
+    {
+        f_key.assign( a_str, a_length );
+        return true;
+    }
+
+    bool param_json_handler::EndObject( rapidjson::SizeType /*a_member_count*/ )
+    {
+        open_container t_closed( std::move(f_open.back()) );
+        f_open.pop_back();
+        f_key = std::move(t_closed.f_name);
+        return add( std::move(t_closed.f_container) );
+    }
+
+    bool param_json_handler::StartArray()
+    {
+        f_open.push_back( open_container{ param_ptr_t( new param_array() ), std::move(f_key), typed_array_classifier(), true } );
+        f_key.clear();
+        return true;
+    }
+
+    bool param_json_handler::EndArray( rapidjson::SizeType /*an_element_count*/ )
+    {
+        open_container t_closed( std::move(f_open.back()) );
+        f_open.pop_back();
+        f_key = std::move(t_closed.f_name);
+        param_typed_array_base::element_type t_type;
+        if( f_typed_arrays && t_closed.f_numbers_only && t_closed.f_classifier.classify( t_type ) )
+        {
+            return add( to_typed_array( t_closed.f_container->as_array(), t_type ) );
+        }
+        return add( std::move(t_closed.f_container) );
+    }
+
+    param_ptr_t param_json_handler::release()
+    {
+        f_open.clear();
+        f_key.clear();
+        return std::move(f_result);
+    }
+
+    bool param_json_handler::add( param_ptr_t a_param )
+    {
+        if( f_open.empty() )
+        {
+            f_result = std::move(a_param);
+            return true;
+        }
+        param& t_parent = *f_open.back().f_container;
+        if( t_parent.is_node() )
+        {
+            t_parent.as_node().insert_or_assign( f_key, std::move(a_param) );
+        }
+        else
+        {
+            // Uint() and Uint64() store small numbers as signed, but for typed arrays non-negative integers count as unsigned, as in read_typed_array()
+            open_container& t_open = f_open.back();
+            if( f_typed_arrays && t_open.f_numbers_only )
+            {
+                if( ! a_param->is_value() ) t_open.f_numbers_only = false;
+                else
+                {
+                    const param_value& t_value = a_param->as_value();
+                    if( t_value.is_double() ) t_open.f_classifier.add_double();
+                    else if( t_value.is_int() && t_value.as_int() >= 0 ) t_open.f_classifier.add_uint( t_value.as_int() );
+                    else if( ! t_open.f_classifier.add( t_value ) ) t_open.f_numbers_only = false;
+                }
+            }
+            t_parent.as_array().push_back( std::move(a_param) );
+        }
+        return true;
+    }
+
+
+    REGISTER_PARAM_OUTPUT_CODEC( param_output_json, "json" );
+
+    namespace
+    {
+        // rapidjson output stream that writes to a std::streambuf through a buffer, as rapidjson::FileWriteStream does to a FILE
+        class streambuf_write_stream
+        {
+            public:
+                typedef char Ch;
+
+                streambuf_write_stream( std::streambuf* a_streambuf ) :
+                        f_streambuf( a_streambuf ),
+                        f_buffer( RAPIDJSON_FILE_BUFFER_SIZE ),
+                        f_size( 0 ),
+                        f_good( true )
+                {}
+
+                void Put( Ch a_char )
+                {
+                    if( f_size == f_buffer.size() ) Flush();
+                    f_buffer[ f_size++ ] = a_char;
+                }
+                void Flush()
+                {
+                    if( f_size == 0 ) return;
+                    if( f_streambuf->sputn( f_buffer.data(), std::streamsize( f_size ) ) != std::streamsize( f_size ) ) f_good = false;
+                    f_size = 0;
+                }
+
+                // only used for reading, which this stream doesn't do
+                Ch Peek() const { return '\0'; }
+                Ch Take() { return '\0'; }
+                size_t Tell() const { return 0; }
+                Ch* PutBegin() { return nullptr; }
+                size_t PutEnd( Ch* ) { return 0; }
+
+                /// False if any of the output could not be written
+                bool good() const { return f_good; }
+
+            private:
+                std::streambuf* f_streambuf;
+                std::vector< Ch > f_buffer;
+                size_t f_size;
+                bool f_good;
+        };
+    }
+
+    param_output_json::param_output_json()
+    {}
 
+    param_output_json::~param_output_json()
+    {}
+
+    param_output_json::json_writing_style param_output_json::writing_style( const param_node& a_options )
+    {
         json_writing_style t_style = k_compact;
         if( a_options.has( "style" ) )
         {
@@ -210,6 +870,28 @@ namespace scarab
                 if( t_style_string == string( "pretty" ) ) t_style = k_pretty;
             }
         }
+        return t_style;
+    }
+
+    bool param_output_json::write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options )
+    {
+        if( a_filename.empty() )
+        {
+            LERROR( dlog, "Filename cannot be an empty string" );
+            return false;
+        }
+
+        FILE* file = fopen( a_filename.c_str(), "w" );
+        if( file == NULL )
+        {
+            LERROR( dlog, "Unable to open file: " << a_filename );
+            return false;
+        }
+
+        char t_buffer[ RAPIDJSON_FILE_BUFFER_SIZE ];
+        rapidjson::FileWriteStream t_filestream( file, t_buffer, sizeof(t_buffer) );
+
+        json_writing_style t_style = writing_style( a_options );
 
         bool t_result = false;
         if( t_style == k_compact )
@@ -222,6 +904,7 @@ namespace scarab
             rj_pretty_file_writer t_writer( t_filestream );
             t_result = param_output_json::write_param( a_to_write, &t_writer );
         }
+        fclose( file );
 
         if (! t_result )
         {
@@ -236,19 +919,7 @@ namespace scarab
     {
         rapidjson::StringBuffer t_str_buff;
 
-        json_writing_style t_style = k_compact;
-        if( a_options.has( "style" ) )
-        {
-            if( a_options["style"]().is_uint() )
-            {
-                t_style = (json_writing_style)a_options.get_value< unsigned >( "style", k_compact );
-            }
-            else
-            {
-                string t_style_string( a_options.get_value( "style", "compact" ) );
-                if( t_style_string == string( "pretty" ) ) t_style = k_pretty;
-            }
-        }
+        json_writing_style t_style = writing_style( a_options );
 
         bool t_result = false;
         if( t_style == k_compact )
@@ -273,4 +944,33 @@ namespace scarab
         return true;
     }
 
+    bool param_output_json::write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& a_options )
+    {
+        streambuf_write_stream t_out( a_stream.rdbuf() );
+
+        json_writing_style t_style = writing_style( a_options );
+
+        bool t_result = false;
+        if( t_style == k_compact )
+        {
+            rapidjson::Writer< streambuf_write_stream > t_writer( t_out );
+            t_result = param_output_json::write_param( a_to_write, &t_writer );
+        }
+        else
+        {
+            rapidjson::PrettyWriter< streambuf_write_stream > t_writer( t_out );
+            t_result = param_output_json::write_param( a_to_write, &t_writer );
+        }
+        t_out.Flush();
+
+        if( ! t_result || ! t_out.good() )
+        {
+            LERROR( dlog, "Error while writing stream" );
+            a_stream.setstate( std::ios::badbit );
+            return false;
+        }
+
+        return true;
+    }
+
 } /* namespace scarab */
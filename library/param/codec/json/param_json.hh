@@ -9,18 +9,23 @@
 #define SCARAB_PARAM_JSON_HH_
 
 #include "param_codec.hh"
+#include "param_json_simd.hh"
 
 #include "logger.hh"
 #include "param.hh"
 
+#include "rapidjson/error/error.h"
 #include "rapidjson/fwd.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/writer.h"
 
+#include <cstddef>
 #include <deque>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 
 namespace scarab
@@ -31,6 +36,34 @@ namespace scarab
     //************** INPUT ******************
     //***************************************
 
+    /*!
+     @class json_parse_error
+     @author agent
+
+     @brief Describes why and where JSON could not be read
+
+     @details
+     The line and column are counted from 1, and are found while parsing, so reporting an error doesn't require reading the input again.
+     They're 0 if the error has no location in the text (e.g. if the file could not be opened).
+    */
+    struct SCARAB_API json_parse_error
+    {
+        json_parse_error();
+
+        /// True if an error was recorded
+        bool occurred() const { return ! f_message.empty(); }
+
+        std::string to_string() const;
+
+        std::string f_message;
+        /// Offset of the error from the beginning of the text, in bytes
+        std::size_t f_offset;
+        std::size_t f_line;
+        std::size_t f_column;
+    };
+
+    SCARAB_API std::ostream& operator<<( std::ostream& out, const json_parse_error& an_error );
+
     /*!
      @class param_input_json
      @author N.S. Oblath
@@ -38,7 +71,32 @@ namespace scarab
      @brief Convert JSON to Param
 
      @details
-     Options: None
+     By default, read_file() and read_string() build the param structure directly from the parser's events (see param_json_handler),
+     so no rapidjson::Document is held alongside it.  That saves the Document's memory, but the param structure is usually the larger part:
+     for records of short strings and numbers it takes roughly fifteen times the size of the text (see benchmark_param_json.cc).
+
+     If the JSON can't be read, read_file() and read_string() log the reason and location and return nullptr;
+     the overloads that take a json_parse_error fill it in instead of logging.
+
+     Options:
+       - Typed arrays
+           { "typed-arrays": true } reads arrays in which every element is a number into param_typed_arrays,
+           with the element type chosen by typed_array_classifier (the same for every parsing mode, and the same as for YAML)
+       - DOM parsing
+           { "dom": true } parses into a rapidjson::Document first, and then converts it with read_document()
+       - Memory-mapped files (read_file() only)
+           { "mmap": true } maps the file into memory (privately, so the file is not modified) and parses it in situ,
+           instead of reading it through stdio buffers.  In-situ strings and keys point into the mapping, so they're copied into
+           the param structure as it's made, and the mapping is released before read_file() returns (except with "lazy").
+       - Lazy reading
+           { "lazy": true } parses into a rapidjson::Document, which is kept, and returns a param structure whose nodes and arrays
+           are made from it the first time they're accessed (see param_node::deferred()).  Values (and typed arrays) are made
+           along with the node or array that contains them.  When only part of a large document is used, the rest is never converted.
+           The document is released once every node and array has been made.  Can be combined with "mmap", in which case the mapping is kept too.
+       - SIMD parsing
+           Text that's in memory (read_string(), and read_file() with "mmap") is parsed with the SIMD parser if it's available
+           (see json_simd::available()); { "simd": false } uses the scalar parser instead.  The results are the same.
+           Files read through stdio buffers, and the "dom" and "lazy" options, always use the scalar parser.
     */
     class SCARAB_API param_input_json : public param_input_codec
     {
@@ -48,8 +106,97 @@ namespace scarab
 
             virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() );
             virtual param_ptr_t read_string( const std::string& a_json_str, const param_node& a_options = param_node() );
-            param_ptr_t read_document( const rapidjson::Document& a_document );
-            param_ptr_t read_value( const rapidjson::Value& a_value );
+            /// Reads a_stream through its buffer as the text is parsed; "mmap" and "simd" don't apply
+            virtual param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options = param_node() );
+            param_ptr_t read_file( const std::string& a_filename, const param_node& a_options, json_parse_error& an_error );
+            param_ptr_t read_string( const std::string& a_json_str, const param_node& a_options, json_parse_error& an_error );
+            param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options, json_parse_error& an_error );
+            param_ptr_t read_document( const rapidjson::Document& a_document, bool a_typed_arrays = false );
+            param_ptr_t read_value( const rapidjson::Value& a_value, bool a_typed_arrays = false );
+
+        private:
+            /// Parses a rapidjson input stream, as read_file() does a file
+            template< class XStream >
+            param_ptr_t read_input_stream( XStream& a_input, const param_node& a_options, json_parse_error& an_error );
+
+            param_ptr_t read_mapped_file( const std::string& a_filename, bool a_typed_arrays, bool a_dom, bool a_lazy, bool a_simd, json_parse_error& an_error );
+
+            /// Converts a_value, which is part of a_document; objects and arrays become deferred nodes and arrays that keep a_document
+            param_ptr_t read_deferred( const std::shared_ptr< const rapidjson::Document >& a_document, const rapidjson::Value& a_value, bool a_typed_arrays );
+
+            /// Returns a param_typed_array if every element of a_value (an array) is a number and typed_array_classifier gives an element type; otherwise returns nullptr
+            param_ptr_t read_typed_array( const rapidjson::Value& a_value );
+    };
+
+    /*!
+     @class param_json_handler
+     @author agent
+
+     @brief Builds a param structure from the events of a rapidjson::Reader
+
+     @details
+     Implements the rapidjson Handler concept.  Nodes and arrays are created as the parser opens them and are filled as the values arrive,
+     so the only copy of the data is the param structure itself.
+     Numbers are stored with the same types that param_input_json::read_value() gives them.
+
+     If typed arrays are requested, an array in which every element is a number is converted with to_typed_array() when it closes.
+
+     Usage:
+         param_json_handler t_handler;
+         rapidjson::Reader t_reader;
+         if( t_reader.Parse( a_stream, t_handler ) ) t_param = t_handler.release();
+
+     Null-terminated text in memory can be parsed with parse() or parse_insitu(), which use the SIMD parser when it's available:
+         param_json_handler t_handler;
+         if( ! t_handler.parse( a_text ).IsError() ) t_param = t_handler.release();
+    */
+    class SCARAB_API param_json_handler
+    {
+        public:
+            param_json_handler( bool a_typed_arrays = false );
+            ~param_json_handler();
+
+            bool Null();
+            bool Bool( bool a_value );
+            bool Int( int a_value );
+            bool Uint( unsigned a_value );
+            bool Int64( int64_t a_value );
+            bool Uint64( uint64_t a_value );
+            bool Double( double a_value );
+            /// Only used with kParseNumbersAsStringsFlag, which is not supported; returns false
+            bool RawNumber( const char* a_str, rapidjson::SizeType a_length, bool a_copy );
+            bool String( const char* a_str, rapidjson::SizeType a_length, bool a_copy );
+            bool StartObject();
+            bool Key( const char* a_str, rapidjson::SizeType a_length, bool a_copy );
+            bool EndObject( rapidjson::SizeType a_member_count );
+            bool StartArray();
+            bool EndArray( rapidjson::SizeType an_element_count );
+
+            /// Parses null-terminated text into this handler, with the SIMD parser if a_simd is true and it's available
+            rapidjson::ParseResult parse( const char* a_text, bool a_simd = true );
+            /// As parse(), but in situ: a_text is modified, and strings are taken from it
+            rapidjson::ParseResult parse_insitu( char* a_text, bool a_simd = true );
+
+            /// Returns the completed param structure (nullptr if nothing has been completed) and resets the handler
+            param_ptr_t release();
+
+        private:
+            /// Adds a_param to the innermost open node or array, or makes it the result if nothing is open
+            bool add( param_ptr_t a_param );
+
+            struct open_container
+            {
+                param_ptr_t f_container;
+                // name under which the container will be placed in its parent node
+                std::string f_name;
+                // for arrays: the items so far, classified as read_typed_array() classifies them
+                typed_array_classifier f_classifier;
+                bool f_numbers_only;
+            };
+            std::vector< open_container > f_open;
+            std::string f_key;
+            param_ptr_t f_result;
+            bool f_typed_arrays;
     };
 
     //***************************************
@@ -63,6 +210,8 @@ namespace scarab
      @brief Convert Param to JSON
 
      @details
+     Typed arrays are written as arrays of numbers.
+
      Options:
        - JSON Style
            Pretty print: { "style": param_output_json::k_pretty } or { "style": "pretty" }
@@ -88,6 +237,8 @@ namespace scarab
 
             virtual bool write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options = param_node() );
             virtual bool write_string( const param& a_to_write, std::string& a_string, const param_node& a_options = param_node() );
+            /// Writes to a_stream through its buffer as the JSON is made
+            virtual bool write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& a_options = param_node() );
 
             template< class XWriter >
             bool write_param( const param& a_to_write, XWriter* a_writer );
@@ -99,7 +250,24 @@ namespace scarab
             bool write_param_array( const param_array& a_to_write, XWriter* a_writer );
             template< class XWriter >
             bool write_param_node( const param_node& a_to_write, XWriter* a_writer );
+            template< class XWriter >
+            bool write_param_typed_array( const param_typed_array_base& a_to_write, XWriter* a_writer );
 
+        private:
+            static json_writing_style writing_style( const param_node& a_options );
+
+            /// Writes a param_value with a single dispatch on its stored type
+            template< class XWriter >
+            struct value_writer
+            {
+                XWriter* f_writer;
+
+                void operator()( bool a_value ) const { f_writer->Bool( a_value ); }
+                void operator()( uint64_t a_value ) const { f_writer->Uint64( a_value ); }
+                void operator()( int64_t a_value ) const { f_writer->Int64( a_value ); }
+                void operator()( double a_value ) const { f_writer->Double( a_value ); }
+                void operator()( const std::string& a_value ) const { f_writer->String( a_value.data(), rapidjson::SizeType( a_value.size() ) ); }
+            };
     };
 
     template< class XWriter >
@@ -121,6 +289,10 @@ namespace scarab
         {
             return param_output_json::write_param_node( a_to_write.as_node(), a_writer );
         }
+        if( a_to_write.is_typed_array() )
+        {
+            return param_output_json::write_param_typed_array( a_to_write.as_typed_array(), a_writer );
+        }
         LWARN( dlog_param_json, "parameter not written: <" << a_to_write << ">" );
         return false;
     }
@@ -135,31 +307,8 @@ namespace scarab
     bool param_output_json::write_param_value( const param_value& a_to_write, XWriter* a_writer )
     {
         //LWARN( dlog_param_json, "writing value" );
-        if( a_to_write.is_string() )
-        {
-            a_writer->String( a_to_write.as_string().c_str() );
-            //LWARN( dlog_param_json, "writing string to json: " << a_to_write.as_string() );
-        }
-        else if( a_to_write.is_bool() )
-        {
-            a_writer->Bool( a_to_write.as_bool() );
-            //LWARN( dlog_param_json, "writing bool to json: " << a_to_write.as_bool() );
-        }
-        else if( a_to_write.is_int() )
-        {
-            a_writer->Int64( a_to_write.as_int() );
-            //LWARN( dlog_param_json, "writing int to json: " << a_to_write.as_int() );
-        }
-        else if( a_to_write.is_uint() )
-        {
-            a_writer->Uint64( a_to_write.as_uint() );
-            //LWARN( dlog_param_json, "writing uint to json: " << a_to_write.as_uint() );
-        }
-        else if( a_to_write.is_double() )
-        {
-            a_writer->Double( a_to_write.as_double() );
-            //LWARN( dlog_param_json, "writing double to json: " << a_to_write.as_double() );
-        }
+        // strings are written from their data and size, without a copy
+        a_to_write.accept_value_visitor< void >( value_writer< XWriter >{ a_writer } );
         return true;
     }
     template< class XWriter >
@@ -185,7 +334,7 @@ namespace scarab
         a_writer->StartObject();
         for( param_node::const_iterator it = a_to_write.begin(); it != a_to_write.end(); ++it )
         {
-            a_writer->String( it.name().c_str() );
+            a_writer->Key( it.name().data(), rapidjson::SizeType( it.name().size() ) );
             if( ! param_output_json::write_param( *it, a_writer ) )
             {
                 LERROR( dlog_param_json, "Error while writing parameter node" );
@@ -195,7 +344,25 @@ namespace scarab
         a_writer->EndObject();
         return true;
     }
-
+    template< class XWriter >
+    bool param_output_json::write_param_typed_array( const param_typed_array_base& a_to_write, XWriter* a_writer )
+    {
+        a_writer->StartArray();
+        switch( a_to_write.get_element_type() )
+        {
+            case param_typed_array_base::k_double:
+                for( double t_element : a_to_write.as< double >() ) a_writer->Double( t_element );
+                break;
+            case param_typed_array_base::k_int64:
+                for( std::int64_t t_element : a_to_write.as< std::int64_t >() ) a_writer->Int64( t_element );
+                break;
+            case param_typed_array_base::k_uint64:
+                for( std::uint64_t t_element : a_to_write.as< std::uint64_t >() ) a_writer->Uint64( t_element );
+                break;
+        }
+        a_writer->EndArray();
+        return true;
+    }
 
 } /* namespace scarab */
 
@@ -0,0 +1,52 @@
+/*
+ * param_json_simd.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  This file is compiled with the SIMD instruction set enabled (SSE4.2 on x86), so it must only be entered through
+ *  json_simd::parse() and parse_insitu(), after json_simd::available() has been checked.
+ *
+ *  Inline functions and templates are compiled into each file that uses them, and identical copies are merged when the library
+ *  is linked.  So that none of the code compiled here can stand in for the baseline code in other files, RapidJSON is placed
+ *  in its own namespace in this file, and no other scarab headers are included; events are passed on through json_simd::event_handler.
+ */
+
+#define SCARAB_API_EXPORTS
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define RAPIDJSON_SSE42
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+#define RAPIDJSON_NEON
+#endif
+
+#define RAPIDJSON_NAMESPACE rapidjson_simd
+#define RAPIDJSON_NAMESPACE_BEGIN namespace rapidjson_simd {
+#define RAPIDJSON_NAMESPACE_END }
+
+#include "param_json_simd.hh"
+
+#include "rapidjson/reader.h"
+
+namespace scarab
+{
+    namespace json_simd
+    {
+        parse_outcome parse( const char* a_text, event_handler& a_handler )
+        {
+            rapidjson_simd::Reader t_reader;
+            rapidjson_simd::StringStream t_stream( a_text );
+            t_reader.Parse< 0 >( t_stream, a_handler );
+            return parse_outcome{ t_reader.GetParseErrorCode(), t_reader.GetErrorOffset() };
+        }
+
+        parse_outcome parse_insitu( char* a_text, event_handler& a_handler )
+        {
+            rapidjson_simd::Reader t_reader;
+            rapidjson_simd::InsituStringStream t_stream( a_text );
+            t_reader.Parse< rapidjson_simd::kParseInsituFlag >( t_stream, a_handler );
+            return parse_outcome{ t_reader.GetParseErrorCode(), t_reader.GetErrorOffset() };
+        }
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,76 @@
+/*
+ * param_json_simd.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_JSON_SIMD_HH_
+#define SCARAB_PARAM_JSON_SIMD_HH_
+
+#include "scarab_api.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scarab
+{
+    /*!
+     @brief The SIMD build of the JSON parser
+
+     @details
+     RapidJSON can skip whitespace and scan strings 16 bytes at a time with SSE4.2 (x86) or NEON (64-bit ARM).
+     When scarab is built with Scarab_JSON_SIMD (off by default), a second copy of the parser is compiled with those fast paths
+     (see param_json_simd.cc); on x86 it's only used if the CPU supports SSE4.2, which is checked once, at run time.
+     The rest of the library, and anything built against it, is compiled for the baseline instruction set.
+
+     param_json_handler::parse() and parse_insitu() choose between the two parsers, so nothing else needs to call this directly.
+     This header doesn't use rapidjson or param types, so that the code compiled for SIMD stays separate from everything else;
+     the parser's events reach the caller through an event_handler.
+    */
+    namespace json_simd
+    {
+        /// True if the SIMD parser was built and can run on this CPU
+        SCARAB_API bool available();
+
+        /// Name of the instruction set used by the SIMD parser ("SSE4.2" or "NEON"), or an empty string if it isn't available
+        SCARAB_API const char* instruction_set();
+
+        /// Result of a parse: the code is a rapidjson::ParseErrorCode (0 if the text was parsed), and the offset is where parsing stopped
+        struct parse_outcome
+        {
+            int f_code;
+            std::size_t f_offset;
+        };
+
+        /// Receives the parser's events; the functions are those of the rapidjson Handler concept
+        class SCARAB_API event_handler
+        {
+            public:
+                virtual ~event_handler() {}
+
+                virtual bool Null() = 0;
+                virtual bool Bool( bool a_value ) = 0;
+                virtual bool Int( int a_value ) = 0;
+                virtual bool Uint( unsigned a_value ) = 0;
+                virtual bool Int64( std::int64_t a_value ) = 0;
+                virtual bool Uint64( std::uint64_t a_value ) = 0;
+                virtual bool Double( double a_value ) = 0;
+                virtual bool RawNumber( const char* a_str, unsigned a_length, bool a_copy ) = 0;
+                virtual bool String( const char* a_str, unsigned a_length, bool a_copy ) = 0;
+                virtual bool StartObject() = 0;
+                virtual bool Key( const char* a_str, unsigned a_length, bool a_copy ) = 0;
+                virtual bool EndObject( unsigned a_member_count ) = 0;
+                virtual bool StartArray() = 0;
+                virtual bool EndArray( unsigned an_element_count ) = 0;
+        };
+
+        /// Parses null-terminated text; only call if available() is true
+        parse_outcome parse( const char* a_text, event_handler& a_handler );
+        /// Parses null-terminated text in situ (a_text is modified, and strings are taken from it); only call if available() is true
+        parse_outcome parse_insitu( char* a_text, event_handler& a_handler );
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_JSON_SIMD_HH_ */
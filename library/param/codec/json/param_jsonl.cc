@@ -0,0 +1,309 @@
+/*
+ * param_jsonl.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_jsonl.hh"
+
+#include "error.hh"
+#include "logger.hh"
+
+#include "rapidjson/error/en.h"
+
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace scarab
+{
+    LOGGER( slog, "param_jsonl" );
+
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    param_jsonl_reader::iterator::iterator() :
+            f_reader( nullptr ),
+            f_record()
+    {}
+
+    param_jsonl_reader::iterator::iterator( param_jsonl_reader* a_reader ) :
+            f_reader( a_reader ),
+            f_record()
+    {
+        ++(*this);
+    }
+
+    param_jsonl_reader::iterator& param_jsonl_reader::iterator::operator++()
+    {
+        f_record = f_reader->next();
+        if( ! f_record ) f_reader = nullptr;
+        return *this;
+    }
+
+    param_jsonl_reader::iterator param_jsonl_reader::iterator::operator++( int )
+    {
+        iterator t_current( *this );
+        ++(*this);
+        return t_current;
+    }
+
+    param_jsonl_reader::param_jsonl_reader( const std::string& a_filename, bool a_typed_arrays ) :
+            f_file( new std::ifstream( a_filename, std::ios::in | std::ios::binary ) ),
+            f_stream( f_file.get() ),
+            f_typed_arrays( a_typed_arrays ),
+            f_line(),
+            f_line_number( 0 ),
+            f_offset( 0 ),
+            f_n_records( 0 ),
+            f_error()
+    {
+        if( ! static_cast< std::ifstream* >( f_file.get() )->is_open() )
+        {
+            throw scarab::error() << "Unable to open JSON-lines file <" << a_filename << ">";
+        }
+    }
+
+    param_jsonl_reader::param_jsonl_reader( std::istream& a_stream, bool a_typed_arrays ) :
+            f_file(),
+            f_stream( &a_stream ),
+            f_typed_arrays( a_typed_arrays ),
+            f_line(),
+            f_line_number( 0 ),
+            f_offset( 0 ),
+            f_n_records( 0 ),
+            f_error()
+    {}
+
+    param_jsonl_reader::~param_jsonl_reader()
+    {}
+
+    param_ptr_t param_jsonl_reader::next()
+    {
+        if( f_error.occurred() ) return nullptr;
+
+        // f_line keeps its capacity, so reading a line only allocates when it's longer than any before it
+        while( std::getline( *f_stream, f_line ) )
+        {
+            const std::size_t t_line_offset = f_offset;
+            ++f_line_number;
+            f_offset += f_line.size() + 1;
+
+            if( f_line.find_first_not_of( " \t\r" ) == std::string::npos ) continue;
+
+            param_json_handler t_handler( f_typed_arrays );
+            rapidjson::ParseResult t_result = t_handler.parse( f_line.c_str() );
+            if( t_result.IsError() )
+            {
+                f_error.f_message = rapidjson::GetParseError_En( t_result.Code() );
+                f_error.f_offset = t_line_offset + t_result.Offset();
+                f_error.f_line = f_line_number;
+                f_error.f_column = t_result.Offset() + 1;
+                return nullptr;
+            }
+            ++f_n_records;
+            return t_handler.release();
+        }
+
+        if( f_stream->bad() )
+        {
+            f_error.f_message = "error reading the input";
+        }
+        return nullptr;
+    }
+
+    param_jsonl_reader::iterator param_jsonl_reader::begin()
+    {
+        return iterator( this );
+    }
+
+    param_jsonl_reader::iterator param_jsonl_reader::end()
+    {
+        return iterator();
+    }
+
+
+    REGISTER_PARAM_INPUT_CODEC( param_input_jsonl, "jsonl" );
+
+    param_input_jsonl::param_input_jsonl()
+    {}
+
+    param_input_jsonl::~param_input_jsonl()
+    {}
+
+    param_ptr_t param_input_jsonl::read_file( const std::string& a_filename, const param_node& a_options )
+    {
+        try
+        {
+            param_jsonl_reader t_reader( a_filename, a_options.get_value( "typed-arrays", false ) );
+            return read_records( t_reader );
+        }
+        catch( error& e )
+        {
+            LERROR( slog, e.what() );
+            return nullptr;
+        }
+    }
+
+    param_ptr_t param_input_jsonl::read_string( const std::string& a_jsonl_str, const param_node& a_options )
+    {
+        std::istringstream t_stream( a_jsonl_str );
+        param_jsonl_reader t_reader( t_stream, a_options.get_value( "typed-arrays", false ) );
+        return read_records( t_reader );
+    }
+
+    param_ptr_t param_input_jsonl::read_stream( std::istream& a_stream, const param_node& a_options )
+    {
+        param_jsonl_reader t_reader( a_stream, a_options.get_value( "typed-arrays", false ) );
+        return read_records( t_reader );
+    }
+
+    param_ptr_t param_input_jsonl::read_records( param_jsonl_reader& a_reader )
+    {
+        std::unique_ptr< param_array > t_records( new param_array() );
+        while( param_ptr_t t_record = a_reader.next() )
+        {
+            t_records->push_back( std::move( t_record ) );
+        }
+        if( a_reader.error().occurred() )
+        {
+            LERROR( slog, "error reading JSON-lines record " << a_reader.n_records() << ":\n\t" << a_reader.error() );
+            return nullptr;
+        }
+        return t_records;
+    }
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    param_jsonl_writer::param_jsonl_writer( const std::string& a_filename, bool an_append, unsigned a_batch_size ) :
+            f_file( new std::ofstream( a_filename, std::ios::out | std::ios::binary | ( an_append ? std::ios::app : std::ios::trunc ) ) ),
+            f_stream( f_file.get() ),
+            f_batch_size( std::max( a_batch_size, 1U ) ),
+            f_json(),
+            f_buffer(),
+            f_n_buffered( 0 ),
+            f_n_records( 0 )
+    {
+        if( ! static_cast< std::ofstream* >( f_file.get() )->is_open() )
+        {
+            throw error() << "Unable to open JSON-lines file <" << a_filename << ">";
+        }
+    }
+
+    param_jsonl_writer::param_jsonl_writer( std::ostream& a_stream, unsigned a_batch_size ) :
+            f_file(),
+            f_stream( &a_stream ),
+            f_batch_size( std::max( a_batch_size, 1U ) ),
+            f_json(),
+            f_buffer(),
+            f_n_buffered( 0 ),
+            f_n_records( 0 )
+    {}
+
+    param_jsonl_writer::~param_jsonl_writer()
+    {
+        flush();
+    }
+
+    bool param_jsonl_writer::write( const param& a_record )
+    {
+        const std::size_t t_start = f_buffer.GetSize();
+        param_output_json::rj_string_writer t_writer( f_buffer );
+        if( ! f_json.write_param( a_record, &t_writer ) || ! t_writer.IsComplete() )
+        {
+            // drop the partial record
+            f_buffer.Pop( f_buffer.GetSize() - t_start );
+            LERROR( slog, "Unable to write JSON-lines record " << f_n_records );
+            return false;
+        }
+        f_buffer.Put( '\n' );
+        ++f_n_records;
+
+        if( ++f_n_buffered >= f_batch_size ) return flush();
+        return true;
+    }
+
+    bool param_jsonl_writer::flush()
+    {
+        if( f_buffer.GetSize() != 0 )
+        {
+            f_stream->write( f_buffer.GetString(), f_buffer.GetSize() );
+            f_buffer.Clear();
+        }
+        f_n_buffered = 0;
+        f_stream->flush();
+        return f_stream->good();
+    }
+
+
+    REGISTER_PARAM_OUTPUT_CODEC( param_output_jsonl, "jsonl" );
+
+    param_output_jsonl::param_output_jsonl()
+    {}
+
+    param_output_jsonl::~param_output_jsonl()
+    {}
+
+    bool param_output_jsonl::write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options )
+    {
+        if( a_filename.empty() )
+        {
+            LERROR( slog, "Filename cannot be an empty string" );
+            return false;
+        }
+
+        try
+        {
+            param_jsonl_writer t_writer( a_filename, a_options.get_value( "append", false ) );
+            return write_records( a_to_write, t_writer );
+        }
+        catch( error& e )
+        {
+            LERROR( slog, e.what() );
+            return false;
+        }
+    }
+
+    bool param_output_jsonl::write_string( const param& a_to_write, std::string& a_string, const param_node& /*a_options*/ )
+    {
+        std::ostringstream t_stream;
+        {
+            param_jsonl_writer t_writer( t_stream );
+            if( ! write_records( a_to_write, t_writer ) ) return false;
+        }
+        a_string = t_stream.str();
+        return true;
+    }
+
+    bool param_output_jsonl::write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& /*a_options*/ )
+    {
+        param_jsonl_writer t_writer( a_stream );
+        return write_records( a_to_write, t_writer );
+    }
+
+    bool param_output_jsonl::write_records( const param& a_to_write, param_jsonl_writer& a_writer )
+    {
+        if( a_to_write.is_array() )
+        {
+            const param_array& t_records = a_to_write.as_array();
+            for( param_array::const_iterator t_it = t_records.begin(); t_it != t_records.end(); ++t_it )
+            {
+                if( ! a_writer.write( *t_it ) ) return false;
+            }
+        }
+        else if( ! a_writer.write( a_to_write ) )
+        {
+            return false;
+        }
+        return a_writer.flush();
+    }
+
+} /* namespace scarab */
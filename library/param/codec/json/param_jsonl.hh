@@ -0,0 +1,234 @@
+/*
+ * param_jsonl.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_JSONL_HH_
+#define SCARAB_PARAM_JSONL_HH_
+
+#include "param_json.hh"
+
+#include "rapidjson/stringbuffer.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace scarab
+{
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    /*!
+     @class param_jsonl_reader
+     @author agent
+
+     @brief Reads a JSON-lines record stream one record at a time
+
+     @details
+     Each non-blank line of the input is one JSON value (a record).  next() parses the next line into a param structure,
+     so only one line and one record are held at a time, and memory use doesn't depend on the length of the input.
+
+     Iteration goes through the same records:
+
+         param_jsonl_reader t_reader( "records.jsonl" );
+         for( param& t_record : t_reader ) { ... }
+
+     Reading stops at the end of the input or at a line that can't be parsed; error() says which happened.
+     The error's line is the line in the input, and its offset is counted from the beginning of the input.
+
+     The constructor that takes a filename throws a scarab::error if the file can't be opened.
+    */
+    class SCARAB_API param_jsonl_reader
+    {
+        public:
+            /// Input iterator over the records; dereferencing gives the current record, which can be modified or moved from.
+            /// Copies share the reader and the current record; as with any input iterator, only one of them should be incremented.
+            class SCARAB_API iterator
+            {
+                public:
+                    typedef std::input_iterator_tag iterator_category;
+                    typedef param value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef param* pointer;
+                    typedef param& reference;
+
+                    /// The end iterator
+                    iterator();
+                    iterator( param_jsonl_reader* a_reader );
+
+                    param& operator*() const { return *f_record; }
+                    param* operator->() const { return f_record.get(); }
+
+                    iterator& operator++();
+                    /// The returned copy keeps the record that was current
+                    iterator operator++( int );
+
+                    bool operator==( const iterator& a_rhs ) const { return f_reader == a_rhs.f_reader; }
+                    bool operator!=( const iterator& a_rhs ) const { return f_reader != a_rhs.f_reader; }
+
+                private:
+                    param_jsonl_reader* f_reader;
+                    std::shared_ptr< param > f_record;
+            };
+
+        public:
+            param_jsonl_reader( const std::string& a_filename, bool a_typed_arrays = false );
+            /// Reads from a_stream, which must outlive the reader
+            param_jsonl_reader( std::istream& a_stream, bool a_typed_arrays = false );
+            param_jsonl_reader( const param_jsonl_reader& ) = delete;
+            ~param_jsonl_reader();
+
+            param_jsonl_reader& operator=( const param_jsonl_reader& ) = delete;
+
+            /// Reads the next record; returns nullptr at the end of the input, or if a record can't be parsed (see error())
+            param_ptr_t next();
+
+            /// Iteration continues from the current position in the input
+            iterator begin();
+            iterator end();
+
+            /// The reason that reading stopped, if it was not the end of the input
+            const json_parse_error& error() const;
+            /// Number of records read so far
+            std::size_t n_records() const;
+
+        private:
+            std::unique_ptr< std::istream > f_file;
+            std::istream* f_stream;
+            bool f_typed_arrays;
+
+            std::string f_line;
+            std::size_t f_line_number;
+            std::size_t f_offset;
+            std::size_t f_n_records;
+            json_parse_error f_error;
+    };
+
+    /*!
+     @class param_input_jsonl
+     @author agent
+
+     @brief Reads a whole JSON-lines record stream into a param_array
+
+     @details
+     Each record becomes one element of the array.  To process long streams without holding every record, use param_jsonl_reader.
+
+     Options:
+       - Typed arrays
+           { "typed-arrays": true } is as for param_input_json
+    */
+    class SCARAB_API param_input_jsonl : public param_input_codec
+    {
+        public:
+            param_input_jsonl();
+            virtual ~param_input_jsonl();
+
+            virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual param_ptr_t read_string( const std::string& a_jsonl_str, const param_node& a_options = param_node() );
+            virtual param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options = param_node() );
+
+        private:
+            param_ptr_t read_records( param_jsonl_reader& a_reader );
+    };
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    /*!
+     @class param_jsonl_writer
+     @author agent
+
+     @brief Writes a JSON-lines record stream, one record per call
+
+     @details
+     write() adds a record as one line of compact JSON.  Lines are collected in a buffer, which is passed to the output
+     (and the output is flushed) once every a_batch_size records, when flush() is called, and when the writer is destroyed.
+     A batch size of 1 flushes after every record.
+
+     A record that can't be written leaves nothing in the output.
+
+     The constructor that takes a filename truncates the file, or appends to it if an_append is true,
+     and throws a scarab::error if the file can't be opened.
+    */
+    class SCARAB_API param_jsonl_writer
+    {
+        public:
+            param_jsonl_writer( const std::string& a_filename, bool an_append = false, unsigned a_batch_size = 128 );
+            /// Writes to a_stream, which must outlive the writer
+            param_jsonl_writer( std::ostream& a_stream, unsigned a_batch_size = 128 );
+            param_jsonl_writer( const param_jsonl_writer& ) = delete;
+            ~param_jsonl_writer();
+
+            param_jsonl_writer& operator=( const param_jsonl_writer& ) = delete;
+
+            /// Adds a_record to the stream; returns false if it could not be written
+            bool write( const param& a_record );
+            /// Passes the buffered records to the output and flushes it; returns false if the output is in a failed state
+            bool flush();
+
+            /// Number of records written so far, including those still in the buffer
+            std::size_t n_records() const;
+
+        private:
+            std::unique_ptr< std::ostream > f_file;
+            std::ostream* f_stream;
+            unsigned f_batch_size;
+
+            param_output_json f_json;
+            rapidjson::StringBuffer f_buffer;
+            unsigned f_n_buffered;
+            std::size_t f_n_records;
+    };
+
+    /*!
+     @class param_output_jsonl
+     @author agent
+
+     @brief Writes a param_array as a JSON-lines record stream
+
+     @details
+     Each element of an array is written as one record; any other param is written as a single record.
+
+     Options (write_file() only):
+       - Append
+           { "append": true } adds the records to the end of an existing file instead of replacing it
+    */
+    class SCARAB_API param_output_jsonl : public param_output_codec
+    {
+        public:
+            param_output_jsonl();
+            virtual ~param_output_jsonl();
+
+            virtual bool write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual bool write_string( const param& a_to_write, std::string& a_string, const param_node& a_options = param_node() );
+            virtual bool write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& a_options = param_node() );
+
+        private:
+            bool write_records( const param& a_to_write, param_jsonl_writer& a_writer );
+    };
+
+    inline const json_parse_error& param_jsonl_reader::error() const
+    {
+        return f_error;
+    }
+
+    inline std::size_t param_jsonl_reader::n_records() const
+    {
+        return f_n_records;
+    }
+
+    inline std::size_t param_jsonl_writer::n_records() const
+    {
+        return f_n_records;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_JSONL_HH_ */
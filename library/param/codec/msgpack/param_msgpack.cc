@@ -0,0 +1,628 @@
+/*
+ * param_msgpack.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_msgpack.hh"
+
+#include "error.hh"
+#include "logger.hh"
+#include "param.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+namespace scarab
+{
+    LOGGER( slog, "param_msgpack" );
+
+    namespace
+    {
+        //***************************************
+        //*********** BYTE SOURCES **************
+        //***************************************
+
+        // Reads from a buffer in memory
+        class buffer_source
+        {
+            public:
+                buffer_source( const char* a_data, std::size_t a_size ) :
+                        f_next( a_data ),
+                        f_end( a_data + a_size )
+                {}
+
+                void read( char* a_dest, std::size_t a_size )
+                {
+                    require( a_size );
+                    std::memcpy( a_dest, f_next, a_size );
+                    f_next += a_size;
+                    return;
+                }
+
+                std::uint8_t read_byte()
+                {
+                    require( 1 );
+                    return std::uint8_t( *f_next++ );
+                }
+
+                std::string read_string( std::size_t a_size )
+                {
+                    require( a_size );
+                    std::string t_string( f_next, a_size );
+                    f_next += a_size;
+                    return t_string;
+                }
+
+                // The number of bytes of a_size that can be allocated before reading them: all of them, once they're known to be there
+                std::size_t allocatable( std::size_t a_size ) const
+                {
+                    require( a_size );
+                    return a_size;
+                }
+
+            private:
+                void require( std::size_t a_size ) const
+                {
+                    if( std::size_t( f_end - f_next ) < a_size ) throw error() << "Unexpected end of MessagePack data";
+                }
+
+                const char* f_next;
+                const char* f_end;
+        };
+
+        // Reads from a stream's buffer, so that the data is read incrementally
+        class stream_source
+        {
+            public:
+                stream_source( std::streambuf* a_buffer ) :
+                        f_buffer( a_buffer )
+                {}
+
+                void read( char* a_dest, std::size_t a_size )
+                {
+                    if( f_buffer->sgetn( a_dest, a_size ) != std::streamsize( a_size ) ) throw error() << "Unexpected end of MessagePack data";
+                    return;
+                }
+
+                std::uint8_t read_byte()
+                {
+                    std::streambuf::int_type t_char = f_buffer->sbumpc();
+                    if( std::streambuf::traits_type::eq_int_type( t_char, std::streambuf::traits_type::eof() ) ) throw error() << "Unexpected end of MessagePack data";
+                    return std::uint8_t( std::streambuf::traits_type::to_char_type( t_char ) );
+                }
+
+                // read in chunks, so that memory is only used for data that arrive
+                std::string read_string( std::size_t a_size )
+                {
+                    std::string t_string;
+                    while( t_string.size() < a_size )
+                    {
+                        std::size_t t_start = t_string.size();
+                        std::size_t t_chunk = allocatable( a_size - t_start );
+                        t_string.resize( t_start + t_chunk );
+                        read( &t_string[t_start], t_chunk );
+                    }
+                    return t_string;
+                }
+
+                // The number of bytes of a_size that can be allocated before reading them: a stated size can't be checked, so up to a chunk
+                std::size_t allocatable( std::size_t a_size ) const
+                {
+                    return std::min( a_size, s_chunk_size );
+                }
+
+            private:
+                static constexpr std::size_t s_chunk_size = 65536;
+
+                std::streambuf* f_buffer;
+        };
+
+        //***************************************
+        //************** DECODER ****************
+        //***************************************
+
+        template< class XSource >
+        class msgpack_decoder
+        {
+            public:
+                msgpack_decoder( XSource& a_source ) :
+                        f_source( a_source ),
+                        f_depth( 0 )
+                {}
+
+                param_ptr_t read()
+                {
+                    std::uint8_t t_byte = f_source.read_byte();
+
+                    if( t_byte <= 0x7f ) return value( std::uint64_t( t_byte ) ); // positive fixint
+                    if( t_byte >= 0xe0 ) return value( std::int64_t( std::int8_t( t_byte ) ) ); // negative fixint
+                    if( ( t_byte & 0xf0 ) == 0x80 ) return read_map( t_byte & 0x0f ); // fixmap
+                    if( ( t_byte & 0xf0 ) == 0x90 ) return read_array( t_byte & 0x0f ); // fixarray
+                    if( ( t_byte & 0xe0 ) == 0xa0 ) return read_str( t_byte & 0x1f ); // fixstr
+
+                    switch( t_byte )
+                    {
+                        case 0xc0: return param_ptr_t( new param() );
+                        case 0xc2: return value( false );
+                        case 0xc3: return value( true );
+                        case 0xc4: return read_str( read_be< std::uint8_t >() ); // bin 8
+                        case 0xc5: return read_str( read_be< std::uint16_t >() ); // bin 16
+                        case 0xc6: return read_str( read_be< std::uint32_t >() ); // bin 32
+                        case 0xc7: return read_ext( read_be< std::uint8_t >() ); // ext 8
+                        case 0xc8: return read_ext( read_be< std::uint16_t >() ); // ext 16
+                        case 0xc9: return read_ext( read_be< std::uint32_t >() ); // ext 32
+                        case 0xca: // float 32
+                        {
+                            std::uint32_t t_bits = read_be< std::uint32_t >();
+                            float t_float;
+                            std::memcpy( &t_float, &t_bits, sizeof( t_float ) );
+                            return value( double( t_float ) );
+                        }
+                        case 0xcb: // float 64
+                        {
+                            std::uint64_t t_bits = read_be< std::uint64_t >();
+                            double t_double;
+                            std::memcpy( &t_double, &t_bits, sizeof( t_double ) );
+                            return value( t_double );
+                        }
+                        case 0xcc: return value( std::uint64_t( read_be< std::uint8_t >() ) );
+                        case 0xcd: return value( std::uint64_t( read_be< std::uint16_t >() ) );
+                        case 0xce: return value( std::uint64_t( read_be< std::uint32_t >() ) );
+                        case 0xcf: return value( read_be< std::uint64_t >() );
+                        case 0xd0: return value( std::int64_t( std::int8_t( read_be< std::uint8_t >() ) ) );
+                        case 0xd1: return value( std::int64_t( std::int16_t( read_be< std::uint16_t >() ) ) );
+                        case 0xd2: return value( std::int64_t( std::int32_t( read_be< std::uint32_t >() ) ) );
+                        case 0xd3: return value( std::int64_t( read_be< std::uint64_t >() ) );
+                        case 0xd4: return read_ext( 1 ); // fixext 1
+                        case 0xd5: return read_ext( 2 ); // fixext 2
+                        case 0xd6: return read_ext( 4 ); // fixext 4
+                        case 0xd7: return read_ext( 8 ); // fixext 8
+                        case 0xd8: return read_ext( 16 ); // fixext 16
+                        case 0xd9: return read_str( read_be< std::uint8_t >() );
+                        case 0xda: return read_str( read_be< std::uint16_t >() );
+                        case 0xdb: return read_str( read_be< std::uint32_t >() );
+                        case 0xdc: return read_array( read_be< std::uint16_t >() );
+                        case 0xdd: return read_array( read_be< std::uint32_t >() );
+                        case 0xde: return read_map( read_be< std::uint16_t >() );
+                        case 0xdf: return read_map( read_be< std::uint32_t >() );
+                        default:
+                            throw error() << "Invalid MessagePack type byte: " << unsigned( t_byte );
+                    }
+                }
+
+            private:
+                template< typename XValue >
+                static param_ptr_t value( XValue a_value )
+                {
+                    return param_ptr_t( new param_value( a_value ) );
+                }
+
+                template< typename XUInt >
+                XUInt read_be()
+                {
+                    unsigned char t_bytes[ sizeof( XUInt ) ];
+                    f_source.read( reinterpret_cast< char* >( t_bytes ), sizeof( XUInt ) );
+                    XUInt t_value = 0;
+                    for( unsigned i_byte = 0; i_byte < sizeof( XUInt ); ++i_byte ) t_value = ( t_value << 8 ) | t_bytes[i_byte];
+                    return t_value;
+                }
+
+                param_ptr_t read_str( std::size_t a_size )
+                {
+                    return value( f_source.read_string( a_size ) );
+                }
+
+                // containers are read recursively, so the depth is limited
+                void enter()
+                {
+                    if( ++f_depth > param_msgpack_format::s_max_depth ) throw error() << "MessagePack data are nested more than " << param_msgpack_format::s_max_depth << " levels deep";
+                    return;
+                }
+
+                param_ptr_t read_array( std::size_t a_size )
+                {
+                    enter();
+                    std::unique_ptr< param_array > t_array( new param_array() );
+                    for( std::size_t i_element = 0; i_element < a_size; ++i_element )
+                    {
+                        t_array->push_back( read() );
+                    }
+                    --f_depth;
+                    return t_array;
+                }
+
+                param_ptr_t read_map( std::size_t a_size )
+                {
+                    enter();
+                    std::unique_ptr< param_node > t_node( new param_node() );
+                    for( std::size_t i_item = 0; i_item < a_size; ++i_item )
+                    {
+                        std::uint8_t t_byte = f_source.read_byte();
+                        std::size_t t_key_size = 0;
+                        if( ( t_byte & 0xe0 ) == 0xa0 ) t_key_size = t_byte & 0x1f;
+                        else if( t_byte == 0xd9 ) t_key_size = read_be< std::uint8_t >();
+                        else if( t_byte == 0xda ) t_key_size = read_be< std::uint16_t >();
+                        else if( t_byte == 0xdb ) t_key_size = read_be< std::uint32_t >();
+                        else throw error() << "MessagePack map keys must be strings";
+                        std::string t_key = f_source.read_string( t_key_size );
+                        t_node->insert_or_assign( t_key, read() );
+                    }
+                    --f_depth;
+                    return t_node;
+                }
+
+                param_ptr_t read_ext( std::size_t a_size )
+                {
+                    signed char t_type = static_cast< signed char >( f_source.read_byte() );
+                    if( a_size % 8 != 0 ) throw error() << "MessagePack ext of type " << int( t_type ) << " is not a param typed array";
+                    switch( t_type )
+                    {
+                        case param_msgpack_format::k_double_array: return read_typed_array< double >( a_size / 8 );
+                        case param_msgpack_format::k_int64_array: return read_typed_array< std::int64_t >( a_size / 8 );
+                        case param_msgpack_format::k_uint64_array: return read_typed_array< std::uint64_t >( a_size / 8 );
+                        default:
+                            throw error() << "Unsupported MessagePack ext type: " << int( t_type );
+                    }
+                }
+
+                template< typename XElement >
+                param_ptr_t read_typed_array( std::size_t a_size )
+                {
+                    // the array grows in chunks as the data arrive, rather than trusting the stated size
+                    std::unique_ptr< param_typed_array< XElement > > t_array( new param_typed_array< XElement >() );
+                    unsigned char t_bytes[8];
+                    std::size_t t_done = 0;
+                    while( t_done < a_size )
+                    {
+                        std::size_t t_chunk = f_source.allocatable( ( a_size - t_done ) * 8 ) / 8;
+                        t_array->resize( t_done + t_chunk );
+                        XElement* t_data = t_array->data() + t_done;
+                        for( std::size_t i_element = 0; i_element < t_chunk; ++i_element )
+                        {
+                            f_source.read( reinterpret_cast< char* >( t_bytes ), 8 );
+                            std::uint64_t t_bits = 0;
+                            for( unsigned i_byte = 8; i_byte > 0; --i_byte ) t_bits = ( t_bits << 8 ) | t_bytes[i_byte - 1];
+                            std::memcpy( t_data + i_element, &t_bits, 8 );
+                        }
+                        t_done += t_chunk;
+                    }
+                    return t_array;
+                }
+
+                XSource& f_source;
+                unsigned f_depth;
+        };
+
+        //***************************************
+        //************** ENCODER ****************
+        //***************************************
+
+        // Writes to a string
+        class string_sink
+        {
+            public:
+                string_sink( std::string& a_string ) :
+                        f_string( a_string )
+                {}
+
+                void write( const char* a_data, std::size_t a_size )
+                {
+                    f_string.append( a_data, a_size );
+                    return;
+                }
+
+            private:
+                std::string& f_string;
+        };
+
+        // Writes to a stream's buffer
+        class stream_sink
+        {
+            public:
+                stream_sink( std::streambuf* a_buffer ) :
+                        f_buffer( a_buffer )
+                {}
+
+                void write( const char* a_data, std::size_t a_size )
+                {
+                    if( f_buffer->sputn( a_data, a_size ) != std::streamsize( a_size ) ) throw error() << "Unable to write MessagePack data";
+                    return;
+                }
+
+            private:
+                std::streambuf* f_buffer;
+        };
+
+        template< class XSink >
+        class msgpack_encoder
+        {
+            public:
+                msgpack_encoder( XSink& a_sink ) :
+                        f_sink( a_sink )
+                {}
+
+                void write( const param& a_param )
+                {
+                    if( a_param.is_value() ) write_value( a_param.as_value() );
+                    else if( a_param.is_node() ) write_node( a_param.as_node() );
+                    else if( a_param.is_array() ) write_array( a_param.as_array() );
+                    else if( a_param.is_typed_array() ) write_typed_array( a_param.as_typed_array() );
+                    else if( a_param.is_null() ) write_byte( 0xc0 );
+                    else throw error() << "Unknown param type: " << a_param.type();
+                    return;
+                }
+
+            private:
+                void write_byte( std::uint8_t a_byte )
+                {
+                    char t_char = char( a_byte );
+                    f_sink.write( &t_char, 1 );
+                    return;
+                }
+
+                // writes a type byte followed by a big-endian value
+                template< typename XUInt >
+                void write_be( std::uint8_t a_type, XUInt a_value )
+                {
+                    char t_bytes[ sizeof( XUInt ) + 1 ];
+                    t_bytes[0] = char( a_type );
+                    for( unsigned i_byte = sizeof( XUInt ); i_byte > 0; --i_byte )
+                    {
+                        t_bytes[i_byte] = char( a_value & 0xff );
+                        a_value >>= 8;
+                    }
+                    f_sink.write( t_bytes, sizeof( XUInt ) + 1 );
+                    return;
+                }
+
+                void write_uint( std::uint64_t a_value )
+                {
+                    if( a_value <= 0x7f ) write_byte( std::uint8_t( a_value ) );
+                    else if( a_value <= std::numeric_limits< std::uint8_t >::max() ) write_be( 0xcc, std::uint8_t( a_value ) );
+                    else if( a_value <= std::numeric_limits< std::uint16_t >::max() ) write_be( 0xcd, std::uint16_t( a_value ) );
+                    else if( a_value <= std::numeric_limits< std::uint32_t >::max() ) write_be( 0xce, std::uint32_t( a_value ) );
+                    else write_be( 0xcf, a_value );
+                    return;
+                }
+
+                // signed formats only, so that the value is read back as signed
+                void write_int( std::int64_t a_value )
+                {
+                    if( a_value < 0 && a_value >= -32 ) write_byte( std::uint8_t( a_value ) );
+                    else if( a_value >= std::numeric_limits< std::int8_t >::min() && a_value <= std::numeric_limits< std::int8_t >::max() ) write_be( 0xd0, std::uint8_t( a_value ) );
+                    else if( a_value >= std::numeric_limits< std::int16_t >::min() && a_value <= std::numeric_limits< std::int16_t >::max() ) write_be( 0xd1, std::uint16_t( a_value ) );
+                    else if( a_value >= std::numeric_limits< std::int32_t >::min() && a_value <= std::numeric_limits< std::int32_t >::max() ) write_be( 0xd2, std::uint32_t( a_value ) );
+                    else write_be( 0xd3, std::uint64_t( a_value ) );
+                    return;
+                }
+
+                void write_str( std::string_view a_string )
+                {
+                    std::size_t t_size = a_string.size();
+                    if( t_size <= 31 ) write_byte( std::uint8_t( 0xa0 | t_size ) );
+                    else if( t_size <= std::numeric_limits< std::uint8_t >::max() ) write_be( 0xd9, std::uint8_t( t_size ) );
+                    else if( t_size <= std::numeric_limits< std::uint16_t >::max() ) write_be( 0xda, std::uint16_t( t_size ) );
+                    else if( t_size <= std::numeric_limits< std::uint32_t >::max() ) write_be( 0xdb, std::uint32_t( t_size ) );
+                    else throw error() << "String is too long for MessagePack";
+                    f_sink.write( a_string.data(), t_size );
+                    return;
+                }
+
+                void write_container_header( std::size_t a_size, std::uint8_t a_fix, std::uint8_t a_16, std::uint8_t a_32 )
+                {
+                    if( a_size <= 15 ) write_byte( std::uint8_t( a_fix | a_size ) );
+                    else if( a_size <= std::numeric_limits< std::uint16_t >::max() ) write_be( a_16, std::uint16_t( a_size ) );
+                    else if( a_size <= std::numeric_limits< std::uint32_t >::max() ) write_be( a_32, std::uint32_t( a_size ) );
+                    else throw error() << "Container is too large for MessagePack";
+                    return;
+                }
+
+                void write_value( const param_value& a_value )
+                {
+                    if( a_value.is_bool() ) write_byte( a_value.as_bool() ? 0xc3 : 0xc2 );
+                    else if( a_value.is_uint() ) write_uint( a_value.as_uint() );
+                    else if( a_value.is_int() ) write_int( a_value.as_int() );
+                    else if( a_value.is_double() )
+                    {
+                        double t_double = a_value.as_double();
+                        std::uint64_t t_bits;
+                        std::memcpy( &t_bits, &t_double, sizeof( t_bits ) );
+                        write_be( 0xcb, t_bits );
+                    }
+                    else write_str( a_value.as_string() );
+                    return;
+                }
+
+                void write_array( const param_array& an_array )
+                {
+                    write_container_header( an_array.size(), 0x90, 0xdc, 0xdd );
+                    for( const param& t_element : an_array ) write( t_element );
+                    return;
+                }
+
+                void write_node( const param_node& a_node )
+                {
+                    write_container_header( a_node.size(), 0x80, 0xde, 0xdf );
+                    for( param_node::const_iterator t_it = a_node.begin(); t_it != a_node.end(); ++t_it )
+                    {
+                        write_str( t_it.name() );
+                        write( *t_it );
+                    }
+                    return;
+                }
+
+                void write_typed_array( const param_typed_array_base& an_array )
+                {
+                    switch( an_array.get_element_type() )
+                    {
+                        case param_typed_array_base::k_double:
+                            write_typed_array_data( param_msgpack_format::k_double_array, an_array.as< double >() );
+                            break;
+                        case param_typed_array_base::k_int64:
+                            write_typed_array_data( param_msgpack_format::k_int64_array, an_array.as< std::int64_t >() );
+                            break;
+                        case param_typed_array_base::k_uint64:
+                            write_typed_array_data( param_msgpack_format::k_uint64_array, an_array.as< std::uint64_t >() );
+                            break;
+                    }
+                    return;
+                }
+
+                template< typename XElement >
+                void write_typed_array_data( param_msgpack_format::ext_type a_type, const param_typed_array< XElement >& an_array )
+                {
+                    std::size_t t_size = an_array.size() * 8;
+                    if( t_size <= std::numeric_limits< std::uint8_t >::max() ) write_be( 0xc7, std::uint8_t( t_size ) );
+                    else if( t_size <= std::numeric_limits< std::uint16_t >::max() ) write_be( 0xc8, std::uint16_t( t_size ) );
+                    else if( t_size <= std::numeric_limits< std::uint32_t >::max() ) write_be( 0xc9, std::uint32_t( t_size ) );
+                    else throw error() << "Typed array is too large for MessagePack";
+                    write_byte( std::uint8_t( a_type ) );
+
+                    char t_bytes[8];
+                    for( XElement t_element : an_array )
+                    {
+                        std::uint64_t t_bits;
+                        std::memcpy( &t_bits, &t_element, 8 );
+                        for( unsigned i_byte = 0; i_byte < 8; ++i_byte )
+                        {
+                            t_bytes[i_byte] = char( t_bits & 0xff );
+                            t_bits >>= 8;
+                        }
+                        f_sink.write( t_bytes, 8 );
+                    }
+                    return;
+                }
+
+                XSink& f_sink;
+        };
+    }
+
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    REGISTER_PARAM_INPUT_CODEC( param_input_msgpack, "msgpack" );
+
+    param_input_msgpack::param_input_msgpack()
+    {}
+
+    param_input_msgpack::~param_input_msgpack()
+    {}
+
+    param_ptr_t param_input_msgpack::read_file( const std::string& a_filename, const param_node& )
+    {
+        std::ifstream t_file( a_filename, std::ios::binary );
+        if( ! t_file.is_open() )
+        {
+            LERROR( slog, "Unable to open file <" << a_filename << ">" );
+            return param_ptr_t();
+        }
+        return read_stream( t_file );
+    }
+
+    param_ptr_t param_input_msgpack::read_string( const std::string& a_msgpack_str, const param_node& )
+    {
+        return read_buffer( a_msgpack_str.data(), a_msgpack_str.size() );
+    }
+
+    param_ptr_t param_input_msgpack::read_buffer( const char* a_data, std::size_t a_size )
+    {
+        try
+        {
+            buffer_source t_source( a_data, a_size );
+            return msgpack_decoder< buffer_source >( t_source ).read();
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "MessagePack error: " << e.what() );
+            return param_ptr_t();
+        }
+    }
+
+    param_ptr_t param_input_msgpack::read_stream( std::istream& a_stream, const param_node& )
+    {
+        try
+        {
+            stream_source t_source( a_stream.rdbuf() );
+            return msgpack_decoder< stream_source >( t_source ).read();
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "MessagePack error: " << e.what() );
+            a_stream.setstate( std::ios::failbit );
+            return param_ptr_t();
+        }
+    }
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    REGISTER_PARAM_OUTPUT_CODEC( param_output_msgpack, "msgpack" );
+
+    param_output_msgpack::param_output_msgpack()
+    {}
+
+    param_output_msgpack::~param_output_msgpack()
+    {}
+
+    bool param_output_msgpack::write_file( const param& a_to_write, const std::string& a_filename, const param_node& )
+    {
+        if( a_filename.empty() )
+        {
+            LERROR( slog, "Filename cannot be an empty string" );
+            return false;
+        }
+
+        std::ofstream t_file( a_filename, std::ios::binary );
+        if( ! t_file.is_open() )
+        {
+            LERROR( slog, "Unable to open file: " << a_filename );
+            return false;
+        }
+        return write_stream( a_to_write, t_file ) && t_file.flush().good();
+    }
+
+    bool param_output_msgpack::write_string( const param& a_to_write, std::string& a_msgpack_str, const param_node& )
+    {
+        a_msgpack_str.clear();
+        try
+        {
+            string_sink t_sink( a_msgpack_str );
+            msgpack_encoder< string_sink >( t_sink ).write( a_to_write );
+            return true;
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "MessagePack error: " << e.what() );
+            return false;
+        }
+    }
+
+    bool param_output_msgpack::write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& )
+    {
+        try
+        {
+            stream_sink t_sink( a_stream.rdbuf() );
+            msgpack_encoder< stream_sink >( t_sink ).write( a_to_write );
+            return true;
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "MessagePack error: " << e.what() );
+            a_stream.setstate( std::ios::badbit );
+            return false;
+        }
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,116 @@
+/*
+ * param_msgpack.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_MSGPACK_HH_
+#define SCARAB_PARAM_MSGPACK_HH_
+
+#include "param_codec.hh"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace scarab
+{
+    /*!
+     @class param_msgpack_format
+     @author agent
+
+     @brief How param structures are represented in MessagePack
+
+     @details
+     The encoding is standard MessagePack (https://msgpack.org), so any MessagePack reader can read it.
+     Some choices are made so that every param structure is read back exactly as it was written:
+       - null params are nil
+       - param_values: booleans are bool; strings are str; doubles are float 64.
+         Unsigned integers use the unsigned formats (positive fixint, uint 8-64), and signed integers use the signed formats
+         (negative fixint, int 8-64, even for non-negative values), so that the uint/int distinction is kept.
+       - param_arrays are arrays, and param_nodes are maps with str keys
+       - param_typed_arrays are ext values whose type is one of the ext_type values below, and whose data are the elements,
+         8 bytes each, in little-endian order
+
+     When reading MessagePack from elsewhere, float 32 is read as a double, bin as a string, and timestamps and other ext types are not supported.
+
+     Data that are corrupt or hostile are rejected without exhausting the stack or memory: arrays and maps may be nested
+     at most s_max_depth levels deep, and sizes stated in the data are checked against the data in memory,
+     or, for streams, memory is allocated in chunks as the data are read.
+    */
+    struct SCARAB_API param_msgpack_format
+    {
+        /// Maximum nesting depth of arrays and maps when reading
+        static constexpr unsigned s_max_depth = 1000;
+
+        enum ext_type : signed char
+        {
+            k_double_array = 1,
+            k_int64_array = 2,
+            k_uint64_array = 3
+        };
+    };
+
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    /*!
+     @class param_input_msgpack
+     @author agent
+
+     @brief Convert MessagePack to Param
+
+     @details
+     See param_msgpack_format for the encoding.  Files and streams are read incrementally, through the stream's buffer.
+     Strings passed to read_string() hold the binary MessagePack data.
+
+     Options: None
+    */
+    class SCARAB_API param_input_msgpack : public param_input_codec
+    {
+        public:
+            param_input_msgpack();
+            virtual ~param_input_msgpack();
+
+            virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual param_ptr_t read_string( const std::string& a_msgpack_str, const param_node& a_options = param_node() );
+
+            /// Reads one MessagePack object from a buffer
+            param_ptr_t read_buffer( const char* a_data, std::size_t a_size );
+            /// Reads one MessagePack object from a stream; the stream is left positioned just after it
+            virtual param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options = param_node() );
+    };
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    /*!
+     @class param_output_msgpack
+     @author agent
+
+     @brief Convert Param to MessagePack
+
+     @details
+     See param_msgpack_format for the encoding.
+
+     Options: None
+    */
+    class SCARAB_API param_output_msgpack : public param_output_codec
+    {
+        public:
+            param_output_msgpack();
+            virtual ~param_output_msgpack();
+
+            virtual bool write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual bool write_string( const param& a_to_write, std::string& a_msgpack_str, const param_node& a_options = param_node() );
+
+            /// Appends the MessagePack encoding of a_to_write to a_stream
+            virtual bool write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& a_options = param_node() );
+    };
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_MSGPACK_HH_ */
@@ -0,0 +1,131 @@
+/*
+ * param_spb.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_spb.hh"
+
+#include "error.hh"
+#include "logger.hh"
+#include "param.hh"
+
+#include <cstdio>
+#include <fstream>
+
+namespace scarab
+{
+    LOGGER( slog, "param_spb" );
+
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    REGISTER_PARAM_INPUT_CODEC( param_input_spb, "spb" );
+
+    param_input_spb::param_input_spb()
+    {}
+
+    param_input_spb::~param_input_spb()
+    {}
+
+    param_ptr_t param_input_spb::read_file( const std::string& a_filename, const param_node& )
+    {
+        try
+        {
+            param_snapshot t_snapshot = param_snapshot::map_file( a_filename );
+            t_snapshot.validate();
+            return t_snapshot.thaw();
+        }
+        catch( const error& e )
+        {
+            LERROR( slog, e.what() );
+            return param_ptr_t();
+        }
+    }
+
+    param_ptr_t param_input_spb::read_string( const std::string& a_spb_str, const param_node& )
+    {
+        try
+        {
+            // the copied image is validated
+            return param_snapshot( a_spb_str.data(), a_spb_str.size() ).thaw();
+        }
+        catch( const error& e )
+        {
+            LERROR( slog, "Unable to read spb image: " << e.what() );
+            return param_ptr_t();
+        }
+    }
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    REGISTER_PARAM_OUTPUT_CODEC( param_output_spb, "spb" );
+
+    param_output_spb::param_output_spb()
+    {}
+
+    param_output_spb::~param_output_spb()
+    {}
+
+    bool param_output_spb::write_file( const param& a_to_write, const std::string& a_filename, const param_node& )
+    {
+        if( a_filename.empty() )
+        {
+            LERROR( slog, "Filename cannot be an empty string" );
+            return false;
+        }
+
+        std::string t_image;
+        if( ! write_string( a_to_write, t_image ) ) return false;
+
+        // written under a temporary name and renamed, so that existing mappings of the file are unaffected
+        std::string t_temp_filename( a_filename + ".tmp" );
+        {
+            std::ofstream t_file( t_temp_filename, std::ios::binary | std::ios::trunc );
+            if( ! t_file.is_open() )
+            {
+                LERROR( slog, "Unable to open file: " << t_temp_filename );
+                return false;
+            }
+            if( ! t_file.write( t_image.data(), t_image.size() ).flush().good() )
+            {
+                LERROR( slog, "Unable to write file: " << t_temp_filename );
+                t_file.close();
+                std::remove( t_temp_filename.c_str() );
+                return false;
+            }
+        }
+#ifdef _WIN32
+        // rename() doesn't replace an existing file on Windows (where files are read rather than mapped)
+        std::remove( a_filename.c_str() );
+#endif
+        if( std::rename( t_temp_filename.c_str(), a_filename.c_str() ) != 0 )
+        {
+            LERROR( slog, "Unable to rename <" << t_temp_filename << "> to <" << a_filename << ">" );
+            std::remove( t_temp_filename.c_str() );
+            return false;
+        }
+        return true;
+    }
+
+    bool param_output_spb::write_string( const param& a_to_write, std::string& a_spb_str, const param_node& )
+    {
+        try
+        {
+            a_spb_str = param_snapshot( a_to_write ).image();
+            return true;
+        }
+        catch( const error& e )
+        {
+            LERROR( slog, "Unable to freeze param structure: " << e.what() );
+            return false;
+        }
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,76 @@
+/*
+ * param_spb.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_SPB_HH_
+#define SCARAB_PARAM_SPB_HH_
+
+#include "param_codec.hh"
+
+#include <string>
+
+namespace scarab
+{
+    //***************************************
+    //************** INPUT ******************
+    //***************************************
+
+    /*!
+     @class param_input_spb
+     @author agent
+
+     @brief Convert an spb (scarab param binary) snapshot image to Param
+
+     @details
+     An spb file is the image of a param_snapshot (see param_snapshot_data for the layout).
+     The codec interface returns a modifiable param, so read_file() and read_string() thaw the snapshot.
+     The whole image is validated first (see param_snapshot_data::validate()), so a corrupt file or string fails to read.
+     To read an spb file without any conversion, open it with param_snapshot::map_file() instead.
+
+     Strings passed to read_string() hold the binary image.
+
+     Options: None
+    */
+    class SCARAB_API param_input_spb : public param_input_codec
+    {
+        public:
+            param_input_spb();
+            virtual ~param_input_spb();
+
+            virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual param_ptr_t read_string( const std::string& a_spb_str, const param_node& a_options = param_node() );
+    };
+
+    //***************************************
+    //************** OUTPUT *****************
+    //***************************************
+
+    /*!
+     @class param_output_spb
+     @author agent
+
+     @brief Convert Param to an spb (scarab param binary) snapshot image
+
+     @details
+     The param is frozen into a param_snapshot, and its image is written.
+     Files are written under a temporary name and then renamed, so processes that have the previous version of the file
+     mapped keep seeing the previous version, and a process never maps a partly-written file.
+
+     Options: None
+    */
+    class SCARAB_API param_output_spb : public param_output_codec
+    {
+        public:
+            param_output_spb();
+            virtual ~param_output_spb();
+
+            virtual bool write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options = param_node() );
+            virtual bool write_string( const param& a_to_write, std::string& a_spb_str, const param_node& a_options = param_node() );
+    };
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_SPB_HH_ */
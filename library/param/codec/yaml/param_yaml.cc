@@ -12,8 +12,13 @@
 #include "logger.hh"
 #include "param.hh"
 
+#include <charconv>
+#include <limits>
+#include <locale>
 #include <sstream>
 #include <fstream>
+#include <string_view>
+#include <type_traits>
 
 using std::string;
 using std::stringstream;
@@ -30,35 +35,99 @@ namespace scarab
     param_input_yaml::~param_input_yaml()
     {}
 
-    param_ptr_t param_input_yaml::read_file( const std::string& a_filename, const param_node& )
+    param_ptr_t param_input_yaml::read_file( const std::string& a_filename, const param_node& a_options )
     {
-        try
+        if( a_options.get_value( "node", false ) )
         {
-            YAML::Node root_node = YAML::LoadFile( a_filename );
-            return param_input_yaml::read_node_type( root_node );
+            try
+            {
+                YAML::Node root_node = YAML::LoadFile( a_filename );
+                return param_input_yaml::read_node_type( root_node, a_options.get_value( "typed-arrays", false ) );
+            }
+            catch( YAML::Exception& e )
+            {
+                LERROR( slog, "YAML error: " << e.what() );
+                return std::unique_ptr< param >();
+            }
         }
-        catch( YAML::Exception& e )
+
+        std::ifstream t_file( a_filename );
+        if( ! t_file.is_open() )
         {
-            LERROR( slog, "YAML error: " << e.what() );
+            LERROR( slog, "Unable to open file <" << a_filename << ">" );
             return std::unique_ptr< param >();
         }
+        return read_stream( t_file, a_options );
+    }
+
+    std::unique_ptr< param > param_input_yaml::read_string( const std::string& a_string, const param_node& a_options )
+    {
+        if( a_options.get_value( "node", false ) )
+        {
+            try
+            {
+                YAML::Node root_node = YAML::Load( a_string );
+                return param_input_yaml::read_node_type( root_node, a_options.get_value( "typed-arrays", false ) );
+            }
+            catch( YAML::Exception& e )
+            {
+                LERROR( slog, "YAML error: " << e.what() );
+                return std::unique_ptr< param >();
+            }
+        }
+
+        std::istringstream t_stream( a_string );
+        return read_stream( t_stream, a_options );
     }
 
-    std::unique_ptr< param > param_input_yaml::read_string( const std::string& a_string, const param_node& )
+    param_ptr_t param_input_yaml::read_stream( std::istream& a_stream, const param_node& a_options )
+    {
+        param_ptr_t t_first;
+        bool t_valid = read_documents( a_stream,
+                [&t_first]( param_ptr_t a_document ){ t_first = std::move(a_document); return false; },
+                a_options );
+        if( ! t_valid ) return param_ptr_t();
+        // like YAML::Load(), an empty stream is null
+        if( ! t_first ) t_first.reset( new param() );
+        return t_first;
+    }
+
+    bool param_input_yaml::read_documents( std::istream& a_stream, const document_callback& a_callback, const param_node& a_options )
     {
         try
         {
-            YAML::Node root_node = YAML::Load( a_string );
-            return param_input_yaml::read_node_type( root_node );
+            YAML::Parser t_parser( a_stream );
+            param_yaml_handler t_handler( a_options.get_value( "typed-arrays", false ) );
+            while( t_parser.HandleNextDocument( t_handler ) )
+            {
+                if( ! a_callback( t_handler.release() ) ) break;
+            }
+            return true;
         }
         catch( YAML::Exception& e )
         {
             LERROR( slog, "YAML error: " << e.what() );
-            return std::unique_ptr< param >();
+            return false;
+        }
+        catch( error& e )
+        {
+            LERROR( slog, "YAML error: " << e.what() );
+            return false;
         }
     }
 
-    param_ptr_t param_input_yaml::read_node_type( const YAML::Node& a_node )
+    bool param_input_yaml::read_file_documents( const std::string& a_filename, const document_callback& a_callback, const param_node& a_options )
+    {
+        std::ifstream t_file( a_filename );
+        if( ! t_file.is_open() )
+        {
+            LERROR( slog, "Unable to open file <" << a_filename << ">" );
+            return false;
+        }
+        return read_documents( t_file, a_callback, a_options );
+    }
+
+    param_ptr_t param_input_yaml::read_node_type( const YAML::Node& a_node, bool a_typed_arrays )
     {
         try
         {
@@ -72,11 +141,17 @@ namespace scarab
             }
             if( a_node.IsSequence() )
             {
-                return param_input_yaml::sequence_handler(a_node);
+                std::unique_ptr< param_array > t_array = param_input_yaml::sequence_handler( a_node, a_typed_arrays );
+                if( a_typed_arrays && t_array )
+                {
+                    param_ptr_t t_typed_array = to_typed_array( *t_array );
+                    if( t_typed_array ) return t_typed_array;
+                }
+                return t_array;
             }
             if( a_node.IsMap() )
             {
-                return param_input_yaml::map_handler(a_node);
+                return param_input_yaml::map_handler( a_node, a_typed_arrays );
             }
         }
         catch( YAML::Exception& e )
@@ -89,7 +164,7 @@ namespace scarab
         return std::unique_ptr< param >();
     }
 
-    std::unique_ptr< param_array > param_input_yaml::sequence_handler( const YAML::Node& a_node )
+    std::unique_ptr< param_array > param_input_yaml::sequence_handler( const YAML::Node& a_node, bool a_typed_arrays )
     {
         try
         {
@@ -97,7 +172,7 @@ namespace scarab
 
             for( YAML::const_iterator counter = a_node.begin(); counter != a_node.end(); ++counter )
             {
-                t_array_as_param->push_back( param_input_yaml::read_node_type( *counter ) );
+                t_array_as_param->push_back( param_input_yaml::read_node_type( *counter, a_typed_arrays ) );
             }
 
             return t_array_as_param;
@@ -109,7 +184,7 @@ namespace scarab
         }
     }
 
-    std::unique_ptr< param_node > param_input_yaml::map_handler( const YAML::Node& a_node )
+    std::unique_ptr< param_node > param_input_yaml::map_handler( const YAML::Node& a_node, bool a_typed_arrays )
     {
         try
         {
@@ -117,7 +192,7 @@ namespace scarab
 
             for( YAML::const_iterator counter = a_node.begin(); counter != a_node.end(); ++counter )
             {
-                t_map_as_param->replace( counter->first.as< std::string >(), param_input_yaml::read_node_type( counter->second ) );
+                t_map_as_param->replace( counter->first.as< std::string >(), param_input_yaml::read_node_type( counter->second, a_typed_arrays ) );
             }
 
             return t_map_as_param;
@@ -133,50 +208,380 @@ namespace scarab
     {
         try
         {
-            // the order of these try statements matters!
-            try
+            if( a_node.IsScalar() )
             {
-                return std::unique_ptr< param_value >( new param_value( a_node.as< unsigned >() ) );
+                return std::unique_ptr< param_value >( new param_value( scalar_value( a_node.Scalar() ) ) );
             }
-            catch( YAML::TypedBadConversion<unsigned>& )
+            // other nodes can only be converted to strings: null nodes are "null", and other nodes have an empty scalar
+            return std::unique_ptr< param_value >( new param_value( a_node.IsNull() ? std::string( "null" ) : a_node.Scalar() ) );
+        }
+        catch ( YAML::Exception& e )
+        {
+            LERROR( slog, "YAML error in scalar_handler: " << e.what() );
+            return std::unique_ptr< param_value >();
+        }
+        return std::unique_ptr< param_value >();
+    }
+
+    namespace
+    {
+        // The conversions in YAML::convert read numbers from a std::stringstream with the base field unset,
+        // require that nothing but whitespace follows the number, and then accept YAML's special floating-point values.
+        // These functions parse the same forms as the stream (with the classic locale) without constructing one.
+
+        bool is_stream_space( char a_char )
+        {
+            return a_char == ' ' || ( a_char >= '\t' && a_char <= '\r' );
+        }
+
+        bool only_space_from( const std::string& a_scalar, std::size_t a_pos )
+        {
+            for( ; a_pos < a_scalar.size(); ++a_pos )
             {
-                try
+                if( ! is_stream_space( a_scalar[a_pos] ) ) return false;
+            }
+            return true;
+        }
+
+        int digit_value( char a_char )
+        {
+            if( a_char >= '0' && a_char <= '9' ) return a_char - '0';
+            if( a_char >= 'a' && a_char <= 'f' ) return a_char - 'a' + 10;
+            if( a_char >= 'A' && a_char <= 'F' ) return a_char - 'A' + 10;
+            return -1;
+        }
+
+        // An optional sign, and then hexadecimal (0x or 0X), octal (leading 0), or decimal digits.
+        // Unsigned types reject a leading '-', as YAML::convert does.
+        template< typename XInt >
+        bool parse_integer( const std::string& a_scalar, XInt& a_value )
+        {
+            typedef typename std::make_unsigned< XInt >::type unsigned_type;
+
+            std::size_t t_pos = 0;
+            bool t_negative = false;
+            if( t_pos < a_scalar.size() && ( a_scalar[t_pos] == '+' || a_scalar[t_pos] == '-' ) )
+            {
+                t_negative = a_scalar[t_pos] == '-';
+                ++t_pos;
+            }
+            if( t_negative && std::is_unsigned< XInt >::value ) return false;
+
+            unsigned t_base = 10;
+            bool t_found_zero = false;
+            if( t_pos < a_scalar.size() && a_scalar[t_pos] == '0' )
+            {
+                t_found_zero = true;
+                t_base = 8;
+                ++t_pos;
+                if( t_pos < a_scalar.size() && ( a_scalar[t_pos] == 'x' || a_scalar[t_pos] == 'X' ) )
                 {
-                    return std::unique_ptr< param_value >( new param_value( a_node.as< int >() ) );
+                    // "0x" on its own is not a number
+                    t_found_zero = false;
+                    t_base = 16;
+                    ++t_pos;
                 }
-                catch( const YAML::TypedBadConversion<int>& )
+            }
+
+            const unsigned_type t_max = t_negative ? unsigned_type( std::numeric_limits< XInt >::max() ) + 1 : unsigned_type( std::numeric_limits< XInt >::max() );
+            unsigned_type t_magnitude = 0;
+            bool t_found_digit = false;
+            for( ; t_pos < a_scalar.size(); ++t_pos )
+            {
+                int t_digit = digit_value( a_scalar[t_pos] );
+                if( t_digit < 0 || unsigned( t_digit ) >= t_base ) break;
+                if( t_magnitude > ( t_max - unsigned_type( t_digit ) ) / t_base ) return false;
+                t_magnitude = t_magnitude * t_base + unsigned_type( t_digit );
+                t_found_digit = true;
+            }
+            if( ( ! t_found_digit && ! t_found_zero ) || ! only_space_from( a_scalar, t_pos ) ) return false;
+
+            a_value = t_negative ? XInt( unsigned_type( 0 ) - t_magnitude ) : XInt( t_magnitude );
+            return true;
+        }
+
+        // An optional sign, digits with at most one decimal point, and an exponent after at least one digit;
+        // this is the text the stream collects before converting it with strtod
+        bool parse_double( const std::string& a_scalar, double& a_value )
+        {
+            std::size_t t_pos = 0;
+            std::size_t t_start = 0;
+            if( t_pos < a_scalar.size() && ( a_scalar[t_pos] == '+' || a_scalar[t_pos] == '-' ) )
+            {
+                // from_chars doesn't accept '+'
+                if( a_scalar[t_pos] == '+' ) ++t_start;
+                ++t_pos;
+            }
+
+            bool t_found_mantissa = false;
+            bool t_found_dec = false;
+            bool t_found_sci = false;
+            for( ; t_pos < a_scalar.size(); ++t_pos )
+            {
+                char t_char = a_scalar[t_pos];
+                if( t_char == '.' && ! t_found_dec && ! t_found_sci )
+                {
+                    t_found_dec = true;
+                }
+                else if( t_char >= '0' && t_char <= '9' )
+                {
+                    t_found_mantissa = true;
+                }
+                else if( ( t_char == 'e' || t_char == 'E' ) && t_found_mantissa && ! t_found_sci )
                 {
-                    try
-                    {
-                        return std::unique_ptr< param_value >( new param_value( a_node.as< double >() ) );
-                    }
-                    catch( const YAML::TypedBadConversion<double>& )
-                    {
-                        try
-                        {
-                            return std::unique_ptr< param_value >( new param_value( a_node.as< bool >() ) );
-                        }
-                        catch( const YAML::TypedBadConversion<bool>& )
-                        {
-                            try
-                            {
-                                return std::unique_ptr< param_value >( new param_value( a_node.as< std::string >() ) );
-                            }
-                            catch( const YAML::TypedBadConversion<std::string>& )
-                            {
-                                return std::unique_ptr< param_value >( new param_value( a_node.Scalar() ) );
-                            }
-                        }
-                    }
+                    t_found_sci = true;
+                    if( t_pos + 1 < a_scalar.size() && ( a_scalar[t_pos + 1] == '+' || a_scalar[t_pos + 1] == '-' ) ) ++t_pos;
                 }
+                else break;
+            }
+            if( ! t_found_mantissa || ! only_space_from( a_scalar, t_pos ) ) return false;
+
+            // the whole collected text must be a number (e.g. "1e" is not)
+            const char* t_end = a_scalar.data() + t_pos;
+            std::from_chars_result t_result = std::from_chars( a_scalar.data() + t_start, t_end, a_value );
+            if( t_result.ec == std::errc::result_out_of_range && t_result.ptr == t_end )
+            {
+                // the stream rejects overflow but accepts underflow; let it decide
+                std::istringstream t_stream( a_scalar.substr( t_start, t_pos - t_start ) );
+                t_stream.imbue( std::locale::classic() );
+                t_stream >> a_value;
+                return ! t_stream.fail();
             }
+            return t_result.ec == std::errc() && t_result.ptr == t_end;
         }
-        catch ( YAML::Exception& e )
+
+        // YAML's .inf, -.inf, and .nan, as YAML::convert accepts them
+        bool parse_special_double( const std::string& a_scalar, double& a_value )
         {
-            LERROR( slog, "YAML error in scalar_handler: " << e.what() );
-            return std::unique_ptr< param_value >();
+            if( a_scalar == ".inf" || a_scalar == ".Inf" || a_scalar == ".INF" || a_scalar == "+.inf" || a_scalar == "+.Inf" || a_scalar == "+.INF" )
+            {
+                a_value = std::numeric_limits< double >::infinity();
+                return true;
+            }
+            if( a_scalar == "-.inf" || a_scalar == "-.Inf" || a_scalar == "-.INF" )
+            {
+                a_value = -std::numeric_limits< double >::infinity();
+                return true;
+            }
+            if( a_scalar == ".nan" || a_scalar == ".NaN" || a_scalar == ".NAN" )
+            {
+                a_value = std::numeric_limits< double >::quiet_NaN();
+                return true;
+            }
+            return false;
         }
-        return std::unique_ptr< param_value >();
+
+        // y/n, yes/no, true/false, and on/off, in lower case, upper case, or capitalized
+        bool parse_bool( const std::string& a_scalar, bool& a_value )
+        {
+            if( a_scalar.empty() || a_scalar.size() > 5 ) return false;
+            auto t_is_lower = []( char a_char ){ return a_char >= 'a' && a_char <= 'z'; };
+            auto t_is_upper = []( char a_char ){ return a_char >= 'A' && a_char <= 'Z'; };
+            bool t_all_lower = true;
+            bool t_rest_lower = true;
+            bool t_rest_upper = true;
+            char t_lower[5];
+            for( std::size_t i_char = 0; i_char < a_scalar.size(); ++i_char )
+            {
+                char t_char = a_scalar[i_char];
+                t_all_lower = t_all_lower && t_is_lower( t_char );
+                if( i_char > 0 )
+                {
+                    t_rest_lower = t_rest_lower && t_is_lower( t_char );
+                    t_rest_upper = t_rest_upper && t_is_upper( t_char );
+                }
+                t_lower[i_char] = t_is_upper( t_char ) ? char( t_char - 'A' + 'a' ) : t_char;
+            }
+            if( ! t_all_lower && ! ( t_is_upper( a_scalar[0] ) && ( t_rest_lower || t_rest_upper ) ) ) return false;
+
+            std::string_view t_name( t_lower, a_scalar.size() );
+            if( t_name == "y" || t_name == "yes" || t_name == "true" || t_name == "on" )
+            {
+                a_value = true;
+                return true;
+            }
+            if( t_name == "n" || t_name == "no" || t_name == "false" || t_name == "off" )
+            {
+                a_value = false;
+                return true;
+            }
+            return false;
+        }
+    }
+
+    param_value param_input_yaml::scalar_value( const std::string& a_scalar )
+    {
+        // the order of these conversions matters!
+        unsigned t_unsigned = 0;
+        if( parse_integer( a_scalar, t_unsigned ) ) return param_value( t_unsigned );
+
+        int t_int = 0;
+        if( parse_integer( a_scalar, t_int ) ) return param_value( t_int );
+
+        double t_double = 0.;
+        if( parse_double( a_scalar, t_double ) || parse_special_double( a_scalar, t_double ) ) return param_value( t_double );
+
+        bool t_bool = false;
+        if( parse_bool( a_scalar, t_bool ) ) return param_value( t_bool );
+
+        return param_value( a_scalar );
+    }
+
+
+    param_yaml_handler::param_yaml_handler( bool a_typed_arrays ) :
+            YAML::EventHandler(),
+            f_open(),
+            f_anchors(),
+            f_anchored_scalars(),
+            f_result(),
+            f_typed_arrays( a_typed_arrays )
+    {}
+
+    param_yaml_handler::~param_yaml_handler()
+    {}
+
+    void param_yaml_handler::OnDocumentStart( const YAML::Mark& )
+    {
+        // anchors only apply within a document
+        f_open.clear();
+        f_anchors.clear();
+        f_anchored_scalars.clear();
+        f_result.reset();
+        return;
+    }
+
+    void param_yaml_handler::OnDocumentEnd()
+    {
+        // an empty document is null
+        if( ! f_result ) f_result.reset( new param() );
+        return;
+    }
+
+    void param_yaml_handler::OnNull( const YAML::Mark&, YAML::anchor_t an_anchor )
+    {
+        // a null key is converted to a string as YAML::Node::as< std::string >() does
+        if( expecting_key() ) return set_key( "null" );
+        add( param_ptr_t( new param() ), an_anchor );
+        return;
+    }
+
+    void param_yaml_handler::OnAlias( const YAML::Mark& a_mark, YAML::anchor_t an_anchor )
+    {
+        std::map< YAML::anchor_t, param_ptr_t >::const_iterator t_anchored = f_anchors.find( an_anchor );
+        if( t_anchored == f_anchors.end() )
+        {
+            throw error() << "Alias to an unknown or unfinished anchor at line " << a_mark.line + 1 << ", column " << a_mark.column + 1;
+        }
+        if( expecting_key() )
+        {
+            std::map< YAML::anchor_t, std::string >::const_iterator t_scalar = f_anchored_scalars.find( an_anchor );
+            if( t_scalar != f_anchored_scalars.end() ) return set_key( t_scalar->second );
+            if( t_anchored->second->is_null() ) return set_key( "null" );
+            throw error() << "Maps and sequences cannot be used as keys (line " << a_mark.line + 1 << ", column " << a_mark.column + 1 << ")";
+        }
+        add( t_anchored->second->clone(), YAML::NullAnchor );
+        return;
+    }
+
+    void param_yaml_handler::OnScalar( const YAML::Mark&, const std::string&, YAML::anchor_t an_anchor, const std::string& a_value )
+    {
+        if( an_anchor != YAML::NullAnchor )
+        {
+            f_anchored_scalars[ an_anchor ] = a_value;
+        }
+        if( expecting_key() )
+        {
+            if( an_anchor != YAML::NullAnchor )
+            {
+                f_anchors[ an_anchor ].reset( new param_value( param_input_yaml::scalar_value( a_value ) ) );
+            }
+            return set_key( a_value );
+        }
+        add( param_ptr_t( new param_value( param_input_yaml::scalar_value( a_value ) ) ), an_anchor );
+        return;
+    }
+
+    void param_yaml_handler::OnSequenceStart( const YAML::Mark& a_mark, const std::string&, YAML::anchor_t an_anchor, YAML::EmitterStyle::value )
+    {
+        if( expecting_key() )
+        {
+            throw error() << "Sequences cannot be used as keys (line " << a_mark.line + 1 << ", column " << a_mark.column + 1 << ")";
+        }
+        f_open.push_back( open_container{ param_ptr_t( new param_array() ), an_anchor, std::string(), false } );
+        return;
+    }
+
+    void param_yaml_handler::OnSequenceEnd()
+    {
+        open_container t_closed( std::move(f_open.back()) );
+        f_open.pop_back();
+        if( f_typed_arrays )
+        {
+            param_ptr_t t_typed_array = to_typed_array( t_closed.f_container->as_array() );
+            if( t_typed_array ) return add( std::move(t_typed_array), t_closed.f_anchor );
+        }
+        add( std::move(t_closed.f_container), t_closed.f_anchor );
+        return;
+    }
+
+    void param_yaml_handler::OnMapStart( const YAML::Mark& a_mark, const std::string&, YAML::anchor_t an_anchor, YAML::EmitterStyle::value )
+    {
+        if( expecting_key() )
+        {
+            throw error() << "Maps cannot be used as keys (line " << a_mark.line + 1 << ", column " << a_mark.column + 1 << ")";
+        }
+        f_open.push_back( open_container{ param_ptr_t( new param_node() ), an_anchor, std::string(), false } );
+        return;
+    }
+
+    void param_yaml_handler::OnMapEnd()
+    {
+        open_container t_closed( std::move(f_open.back()) );
+        f_open.pop_back();
+        add( std::move(t_closed.f_container), t_closed.f_anchor );
+        return;
+    }
+
+    param_ptr_t param_yaml_handler::release()
+    {
+        f_open.clear();
+        return std::move(f_result);
+    }
+
+    bool param_yaml_handler::expecting_key() const
+    {
+        return ! f_open.empty() && f_open.back().f_container->is_node() && ! f_open.back().f_has_key;
+    }
+
+    void param_yaml_handler::set_key( std::string a_key )
+    {
+        f_open.back().f_key = std::move(a_key);
+        f_open.back().f_has_key = true;
+        return;
+    }
+
+    void param_yaml_handler::add( param_ptr_t a_param, YAML::anchor_t an_anchor )
+    {
+        if( an_anchor != YAML::NullAnchor )
+        {
+            f_anchors[ an_anchor ] = a_param->clone();
+        }
+        if( f_open.empty() )
+        {
+            f_result = std::move(a_param);
+            return;
+        }
+        open_container& t_parent = f_open.back();
+        if( t_parent.f_container->is_node() )
+        {
+            t_parent.f_container->as_node().insert_or_assign( t_parent.f_key, std::move(a_param) );
+            t_parent.f_has_key = false;
+        }
+        else
+        {
+            t_parent.f_container->as_array().push_back( std::move(a_param) );
+        }
+        return;
     }
 
 
@@ -196,8 +601,6 @@ namespace scarab
             return false;
         }
 
-        YAML::Node a_node = param_output_yaml::check_param_type(a_to_write);
-
         std::ofstream fout( a_filename.c_str() );
         if (! fout.is_open() )
         {
@@ -205,24 +608,150 @@ namespace scarab
             return false;
         }
 
-        fout << a_node;
-
-        fout.close();
-
-        return true;
+        return write_stream( a_to_write, fout );
     }
 
     bool param_output_yaml::write_string( const param& a_to_write, std::string& a_string, const param_node& )
     {
-        YAML::Node a_node = param_output_yaml::check_param_type( a_to_write );
-
         std::stringstream t_out;
-        t_out << a_node;
+        if( ! write_stream( a_to_write, t_out ) ) return false;
         a_string = t_out.str();
 
         return true;
     }
 
+    bool param_output_yaml::write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& )
+    {
+        YAML::Emitter t_emitter( a_stream );
+        // the precision YAML::convert uses for doubles, so the output matches emitting a YAML::Node
+        t_emitter.SetDoublePrecision( std::numeric_limits< double >::max_digits10 );
+        // as with a YAML::Node, a document that's null (including an empty node or array) is written as nothing at all
+        bool t_is_null = a_to_write.is_null() || ( a_to_write.is_node() && a_to_write.as_node().empty() ) ||
+                ( a_to_write.is_array() && a_to_write.as_array().empty() );
+        if( ! t_is_null ) emit( a_to_write, t_emitter );
+        if( ! t_emitter.good() )
+        {
+            LERROR( slog, "YAML error: " << t_emitter.GetLastError() );
+            return false;
+        }
+        if( ! a_stream.flush().good() )
+        {
+            LERROR( slog, "Unable to write the YAML output" );
+            return false;
+        }
+        return true;
+    }
+
+    namespace
+    {
+        // an open array or node, and its next element
+        struct emit_frame
+        {
+            const param* f_container;
+            param_node::const_iterator f_node_next;
+            param_array::const_iterator f_array_next;
+        };
+
+        void emit_value( const param_value& a_value, YAML::Emitter& an_emitter )
+        {
+            if( a_value.is_bool() ) an_emitter << a_value.as_bool();
+            else if( a_value.is_uint() ) an_emitter << a_value.as_uint();
+            else if( a_value.is_double() ) an_emitter << a_value.as_double();
+            else if( a_value.is_int() ) an_emitter << a_value.as_int();
+            else an_emitter << a_value.as_string();
+            return;
+        }
+
+        void emit_typed_array( const param_typed_array_base& a_typed, YAML::Emitter& an_emitter )
+        {
+            an_emitter << YAML::Flow << YAML::BeginSeq;
+            switch( a_typed.get_element_type() )
+            {
+                case param_typed_array_base::k_double:
+                    for( double t_element : a_typed.as< double >() ) an_emitter << t_element;
+                    break;
+                case param_typed_array_base::k_int64:
+                    for( std::int64_t t_element : a_typed.as< std::int64_t >() ) an_emitter << t_element;
+                    break;
+                case param_typed_array_base::k_uint64:
+                    for( std::uint64_t t_element : a_typed.as< std::uint64_t >() ) an_emitter << t_element;
+                    break;
+            }
+            an_emitter << YAML::EndSeq;
+            return;
+        }
+
+        // emits a_param, except for the contents of non-empty arrays and nodes, which are opened and pushed onto a_stack
+        void emit_one( const param& a_param, YAML::Emitter& an_emitter, std::vector< emit_frame >& a_stack )
+        {
+            if( a_param.is_value() )
+            {
+                emit_value( a_param.as_value(), an_emitter );
+            }
+            else if( a_param.is_typed_array() )
+            {
+                emit_typed_array( a_param.as_typed_array(), an_emitter );
+            }
+            else if( a_param.is_node() && ! a_param.as_node().empty() )
+            {
+                const param_node& t_node = a_param.as_node();
+                an_emitter << YAML::BeginMap;
+                a_stack.push_back( emit_frame{ &a_param, t_node.begin(), param_array::const_iterator() } );
+            }
+            else if( a_param.is_array() && ! a_param.as_array().empty() )
+            {
+                const param_array& t_array = a_param.as_array();
+                an_emitter << YAML::BeginSeq;
+                a_stack.push_back( emit_frame{ &a_param, param_node::const_iterator(), t_array.begin() } );
+            }
+            else
+            {
+                // null params, and empty nodes and arrays (which become null YAML::Nodes)
+                an_emitter << YAML::Null;
+            }
+            return;
+        }
+    }
+
+    void param_output_yaml::emit( const param& a_to_write, YAML::Emitter& an_emitter )
+    {
+        std::vector< emit_frame > t_stack;
+        emit_one( a_to_write, an_emitter, t_stack );
+        while( ! t_stack.empty() )
+        {
+            // t_top is not used after emit_one(), which may push onto the stack and invalidate it
+            emit_frame& t_top = t_stack.back();
+            const param* t_next = nullptr;
+            if( t_top.f_container->is_node() )
+            {
+                const param_node& t_node = t_top.f_container->as_node();
+                if( t_top.f_node_next == t_node.end() )
+                {
+                    an_emitter << YAML::EndMap;
+                    t_stack.pop_back();
+                    continue;
+                }
+                an_emitter << YAML::Key << std::string( t_top.f_node_next.name() ) << YAML::Value;
+                t_next = &*t_top.f_node_next;
+                ++t_top.f_node_next;
+            }
+            else
+            {
+                const param_array& t_array = t_top.f_container->as_array();
+                if( t_top.f_array_next == t_array.end() )
+                {
+                    an_emitter << YAML::EndSeq;
+                    t_stack.pop_back();
+                    continue;
+                }
+                t_next = &*t_top.f_array_next;
+                ++t_top.f_array_next;
+            }
+            emit_one( *t_next, an_emitter, t_stack );
+        }
+        return;
+    }
+
     YAML::Node param_output_yaml::check_param_type( const param& a_to_write )
     {
         if( a_to_write.is_null() )
@@ -241,6 +770,10 @@ namespace scarab
         {
             return param_output_yaml::param_value_handler( a_to_write );
         }
+        else if( a_to_write.is_typed_array() )
+        {
+            return param_output_yaml::param_typed_array_handler( a_to_write );
+        }
         LWARN( slog, "Unknown param type encountered" );
         return YAML::Node();
     }
@@ -304,6 +837,28 @@ namespace scarab
         LWARN( slog, "Unkown value type encountered" );
         return YAML::Node();
     }
+
+    YAML::Node param_output_yaml::param_typed_array_handler( const param& a_to_write )
+    {
+        YAML::Node t_node( YAML::NodeType::Sequence );
+        t_node.SetStyle( YAML::EmitterStyle::Flow );
+
+        const param_typed_array_base& t_typed = a_to_write.as_typed_array();
+        switch( t_typed.get_element_type() )
+        {
+            case param_typed_array_base::k_double:
+                for( double t_element : t_typed.as< double >() ) t_node.push_back( t_element );
+                break;
+            case param_typed_array_base::k_int64:
+                for( std::int64_t t_element : t_typed.as< std::int64_t >() ) t_node.push_back( t_element );
+                break;
+            case param_typed_array_base::k_uint64:
+                for( std::uint64_t t_element : t_typed.as< std::uint64_t >() ) t_node.push_back( t_element );
+                break;
+        }
+
+        return t_node;
+    }
 }
 /* namespace scarab */
 
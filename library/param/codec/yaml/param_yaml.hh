@@ -8,10 +8,18 @@
 #ifndef PARAM_YAML_HH_
 #define PARAM_YAML_HH_
 
+#include "yaml-cpp/eventhandler.h"
 #include "yaml-cpp/yaml.h"
 
 #include "param_codec.hh"
 
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 
 namespace scarab
 {
@@ -29,7 +37,18 @@ namespace scarab
      @brief Convert YAML to Param
 
      @details
-     Options: None
+     Scalars are typed with the rules of YAML::Node::as<>(), tried in the order unsigned, int, double, bool, and string
+     (see scalar_value()).
+
+     By default, the parser's events are streamed into the param structure with param_yaml_handler, so no YAML::Node graph is built.
+     read_file(), read_string(), and read_stream() read the first document in the input;
+     read_documents() and read_file_documents() read every document in a multi-document stream, one at a time.
+
+     Options:
+       - Typed arrays
+           { "typed-arrays": true } reads sequences in which every element is a number into param_typed_arrays (see to_typed_array())
+       - YAML::Node
+           { "node": true } loads the input into a YAML::Node first, and converts that (read_file() and read_string() only)
     */
     class SCARAB_API param_input_yaml : public param_input_codec
     {
@@ -40,10 +59,94 @@ namespace scarab
             virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() );
             virtual param_ptr_t read_string( const std::string& a_string, const param_node& a_options = param_node() );
 
-            param_ptr_t read_node_type( const YAML::Node& a_node );
-            std::unique_ptr< param_array > sequence_handler( const YAML::Node& a_node );
-            std::unique_ptr< param_node > map_handler( const YAML::Node& a_node );
+            /// Reads the first document in a_stream; an empty stream gives a null param
+            virtual param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options = param_node() );
+
+            /// Receives each document; returns false to stop reading
+            typedef std::function< bool ( param_ptr_t ) > document_callback;
+
+            /// Reads the documents in a_stream one at a time, passing each to a_callback as soon as it has been parsed.
+            /// Returns false if the YAML is invalid; documents before the error will have been passed to a_callback.
+            bool read_documents( std::istream& a_stream, const document_callback& a_callback, const param_node& a_options = param_node() );
+            bool read_file_documents( const std::string& a_filename, const document_callback& a_callback, const param_node& a_options = param_node() );
+
+            param_ptr_t read_node_type( const YAML::Node& a_node, bool a_typed_arrays = false );
+            std::unique_ptr< param_array > sequence_handler( const YAML::Node& a_node, bool a_typed_arrays = false );
+            std::unique_ptr< param_node > map_handler( const YAML::Node& a_node, bool a_typed_arrays = false );
             std::unique_ptr< param_value > scalar_handler( const YAML::Node& a_node );
+
+            /// Converts a scalar to the first of unsigned, int, double, bool, and string that YAML::Node::as<>() would convert it to.
+            /// The conversions are parsed directly, so no exceptions are thrown for scalars that aren't numbers.
+            static param_value scalar_value( const std::string& a_scalar );
+    };
+
+    /*!
+     @class param_yaml_handler
+     @author agent
+
+     @brief Builds a param structure from the events of a YAML::Parser
+
+     @details
+     Implements YAML::EventHandler.  Nodes and arrays are created as the parser opens them and are filled as the values arrive,
+     so the only copy of the data is the param structure itself.
+     The result is the same as converting the document's YAML::Node with param_input_yaml::read_node_type():
+     scalars are typed with param_input_yaml::scalar_value(), map keys are used as strings, later duplicate keys replace earlier ones,
+     and each alias is a copy of its anchored param.  Maps and sequences as keys are not supported.
+
+     If typed arrays are requested, a sequence in which every element is a number is converted with to_typed_array() when it closes.
+
+     The handler throws a scarab::error for YAML that it can't convert; the parser passes that on.
+
+     Usage:
+         YAML::Parser t_parser( a_stream );
+         param_yaml_handler t_handler;
+         while( t_parser.HandleNextDocument( t_handler ) ) process( t_handler.release() );
+    */
+    class SCARAB_API param_yaml_handler : public YAML::EventHandler
+    {
+        public:
+            param_yaml_handler( bool a_typed_arrays = false );
+            virtual ~param_yaml_handler();
+
+            virtual void OnDocumentStart( const YAML::Mark& a_mark );
+            virtual void OnDocumentEnd();
+
+            virtual void OnNull( const YAML::Mark& a_mark, YAML::anchor_t an_anchor );
+            virtual void OnAlias( const YAML::Mark& a_mark, YAML::anchor_t an_anchor );
+            virtual void OnScalar( const YAML::Mark& a_mark, const std::string& a_tag, YAML::anchor_t an_anchor, const std::string& a_value );
+
+            virtual void OnSequenceStart( const YAML::Mark& a_mark, const std::string& a_tag, YAML::anchor_t an_anchor, YAML::EmitterStyle::value a_style );
+            virtual void OnSequenceEnd();
+
+            virtual void OnMapStart( const YAML::Mark& a_mark, const std::string& a_tag, YAML::anchor_t an_anchor, YAML::EmitterStyle::value a_style );
+            virtual void OnMapEnd();
+
+            /// Returns the most recently completed document (nullptr if none has been completed)
+            param_ptr_t release();
+
+        private:
+            /// Returns true if the next event is a key in the innermost open map
+            bool expecting_key() const;
+            /// Records a_key as the key for the next value in the innermost open map
+            void set_key( std::string a_key );
+            /// Adds a_param to the innermost open map or sequence, or makes it the result if nothing is open
+            void add( param_ptr_t a_param, YAML::anchor_t an_anchor );
+
+            struct open_container
+            {
+                param_ptr_t f_container;
+                YAML::anchor_t f_anchor;
+                // for maps, the key for the next value, if it has been read
+                std::string f_key;
+                bool f_has_key;
+            };
+            std::vector< open_container > f_open;
+            // copies of the anchored params in the current document
+            std::map< YAML::anchor_t, param_ptr_t > f_anchors;
+            // the text of the anchored scalars, for aliases used as keys
+            std::map< YAML::anchor_t, std::string > f_anchored_scalars;
+            param_ptr_t f_result;
+            bool f_typed_arrays;
     };
 
     //***************************************
@@ -57,6 +160,14 @@ namespace scarab
      @brief Convert Param to YAML
 
      @details
+     The param structure is written straight to a YAML::Emitter (see emit()), which writes to the file or string as it goes,
+     so no YAML::Node copy of the structure is made.
+     The output is the same as emitting the YAML::Node from check_param_type(): null params, and empty nodes and arrays, are written as null (~),
+     or as an empty document if they're the whole document,
+     and doubles are written with enough digits to be read back exactly.
+
+     Typed arrays are written as flow-style sequences of numbers.
+
      Options: None
     */
     class SCARAB_API param_output_yaml : public param_output_codec
@@ -68,10 +179,17 @@ namespace scarab
             virtual bool write_file( const param& a_to_write, const std::string& a_filename, const param_node& a_options = param_node() );
             virtual bool write_string( const param& a_to_write, std::string& a_string, const param_node& a_options = param_node() );
 
+            /// Writes a_to_write to a_stream as a YAML document
+            virtual bool write_stream( const param& a_to_write, std::ostream& a_stream, const param_node& a_options = param_node() );
+            /// Writes a_to_write to an_emitter; containers are walked with an explicit stack rather than by recursion
+            void emit( const param& a_to_write, YAML::Emitter& an_emitter );
+
+            /// Converts a_to_write to a YAML::Node
             YAML::Node check_param_type( const param& a_to_write );
             YAML::Node param_node_handler( const param& a_to_write );
             YAML::Node param_array_handler( const param& a_to_write );
             YAML::Node param_value_handler( const param& a_to_write );
+            YAML::Node param_typed_array_handler( const param& a_to_write );
     };
 
 } /* namespace scarab */
@@ -8,9 +8,14 @@
 #ifndef SCARAB_PARAM_HH_
 #define SCARAB_PARAM_HH_
 
+#include "param_arena.hh"
 #include "param_array.hh"
 #include "param_base.hh"
+#include "param_diff.hh"
 #include "param_node.hh"
+#include "param_path.hh"
+#include "param_snapshot.hh"
+#include "param_typed_array.hh"
 #include "param_value.hh"
 
 #include "param_base_impl.hh"
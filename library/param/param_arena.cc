@@ -0,0 +1,109 @@
+/*
+ * param_arena.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_arena.hh"
+
+#include "logger.hh"
+
+#include <new>
+
+LOGGER( plog, "param_arena" );
+
+namespace scarab
+{
+    // the arena that's active on each thread; nullptr means that params are allocated on the heap
+    static thread_local param_arena* s_current_arena = nullptr;
+
+    static constexpr std::size_t s_arena_alignment = alignof( std::max_align_t );
+
+    param_arena::param_arena( std::size_t a_block_size ) :
+            f_blocks(),
+            f_next( nullptr ),
+            f_end( nullptr ),
+            f_block_size( a_block_size ),
+            f_capacity( 0 ),
+            f_n_allocations( 0 ),
+            f_n_live( 0 )
+    {}
+
+    param_arena::~param_arena()
+    {
+        if( f_n_live.load() != 0 )
+        {
+            LWARN( plog, "Destroying a param arena that still has " << f_n_live.load() << " live objects" );
+        }
+        for( block& t_block : f_blocks )
+        {
+            ::operator delete( t_block.f_begin );
+        }
+    }
+
+    void* param_arena::allocate( std::size_t a_size )
+    {
+        // round up so that every allocation keeps the next one aligned
+        a_size = (a_size + s_arena_alignment - 1) & ~(s_arena_alignment - 1);
+        if( f_next == nullptr || static_cast< std::size_t >( f_end - f_next ) < a_size )
+        {
+            add_block( a_size );
+        }
+        void* t_mem = f_next;
+        f_next += a_size;
+        ++f_n_allocations;
+        f_n_live.fetch_add( 1, std::memory_order_relaxed );
+        return t_mem;
+    }
+
+    void param_arena::deallocate( void*, std::size_t ) noexcept
+    {
+        // memory is returned to the system only when the arena is destroyed
+        f_n_live.fetch_sub( 1, std::memory_order_relaxed );
+        return;
+    }
+
+    void param_arena::add_block( std::size_t a_min_size )
+    {
+        std::size_t t_size = a_min_size > f_block_size ? a_min_size : f_block_size;
+        std::byte* t_begin = static_cast< std::byte* >( ::operator new( t_size ) );
+        f_blocks.push_back( block{ t_begin, t_size } );
+        f_next = t_begin;
+        f_end = t_begin + t_size;
+        f_capacity += t_size;
+        return;
+    }
+
+    param_arena* param_arena::current()
+    {
+        return s_current_arena;
+    }
+
+    void param_arena::set_current( param_arena* a_arena )
+    {
+        s_current_arena = a_arena;
+        return;
+    }
+
+
+    param_arena_scope::param_arena_scope( param_arena& a_arena ) :
+            f_previous( param_arena::current() )
+    {
+        param_arena::set_current( &a_arena );
+    }
+
+    param_arena_scope::param_arena_scope( param_arena* a_arena ) :
+            f_previous( param_arena::current() )
+    {
+        param_arena::set_current( a_arena );
+    }
+
+    param_arena_scope::~param_arena_scope()
+    {
+        param_arena::set_current( f_previous );
+    }
+
+} /* namespace scarab */
@@ -22,6 +22,17 @@ using std::stringstream;
 namespace scarab
 {
 
+    param_array_contents clone_contents( const param_array_contents& a_contents )
+    {
+        param_array_contents t_clone;
+        for( param_array_contents::const_iterator it = a_contents.begin(); it != a_contents.end(); ++it )
+        {
+            t_clone.push_back( *it ? (*it)->clone() : param_ptr_t() );
+        }
+        return t_clone;
+    }
+
+
     param_array::param_array() :
             param(),
             f_contents()
@@ -35,23 +46,14 @@ namespace scarab
 
     param_array::param_array( const param_array& orig ) :
             param( orig ),
-            f_contents( orig.f_contents.size() )
+            f_contents( orig.f_contents )
     {
-        for( unsigned ind = 0; ind < f_contents.size(); ++ind )
-        {
-            f_contents[ind] = orig.f_contents[ ind ]->clone();
-        }
     }
 
     param_array::param_array( param_array&& orig ) :
             param( std::move(orig) ),
-            f_contents( orig.f_contents.size() )
+            f_contents( std::move(orig.f_contents) )
     {
-        for( unsigned ind = 0; ind < f_contents.size(); ++ind )
-        {
-            f_contents[ind] = orig.f_contents[ ind ]->move_clone();
-        }
-        orig.clear();
     }
 
     param_array::~param_array()
@@ -62,12 +64,7 @@ namespace scarab
     {
         //std::cerr << "Copying an array with operator=()" << std::endl;
         this->param::operator=( rhs );
-        clear();
-        resize( rhs.size()) ;
-        for( unsigned ind = 0; ind < rhs.f_contents.size(); ++ind )
-        {
-            f_contents[ind] = rhs.f_contents[ ind ]->clone();
-        }
+        f_contents = rhs.f_contents;
         return *this;
     }
 
@@ -75,17 +72,18 @@ namespace scarab
     {
         //std::cerr << "Moving an array with operator=()" << std::endl;
         this->param::operator=( std::move(rhs) );
-        clear();
-        resize( rhs.size()) ;
-        for( unsigned ind = 0; ind < rhs.f_contents.size(); ++ind )
-        {
-            f_contents[ind] = rhs.f_contents[ ind ]->move_clone();
-        }
-        rhs.clear();
+        f_contents = std::move(rhs.f_contents);
         //std::cerr << "after move:" << rhs << std::endl;
         return *this;
     }
 
+    param_array param_array::deferred( shared_contents< contents >::builder a_build )
+    {
+        param_array t_array;
+        t_array.f_contents = shared_contents< contents >::deferred( std::move(a_build) );
+        return t_array;
+    }
+
     param_ptr_t param_array::clone() const
     {
         //std::cerr << "Copy-cloning an array" << std::endl;
@@ -114,8 +112,10 @@ namespace scarab
 
     void param_array::resize( unsigned a_size )
     {
-        f_contents.resize( a_size );
-        for( auto it = f_contents.begin(); it != f_contents.end(); ++it )
+        if( a_size == size() ) return;
+        contents& t_contents = f_contents.mutate();
+        t_contents.resize( a_size );
+        for( auto it = t_contents.begin(); it != t_contents.end(); ++it )
         {
             if( ! *it ) it->reset( new param() );
         }
@@ -126,10 +126,10 @@ namespace scarab
     {
         if( ! a_subset.is_array() ) return false;
         const param_array& t_subset_array = a_subset.as_array();
-        if( t_subset_array.size() > f_contents.size() ) return false;
-        contents::const_iterator t_this_it = f_contents.begin();
-        contents::const_iterator t_that_it = t_subset_array.f_contents.begin();
-        while( t_that_it != t_subset_array.f_contents.end() ) // loop condition is on a_subset because it's smaller or equal to this
+        if( t_subset_array.size() > size() ) return false;
+        contents::const_iterator t_this_it = f_contents.get().begin();
+        contents::const_iterator t_that_it = t_subset_array.f_contents.get().begin();
+        while( t_that_it != t_subset_array.f_contents.get().end() ) // loop condition is on a_subset because it's smaller or equal to this
         {
             if( ! (*t_this_it)->has_subset( **t_that_it ) ) return false;
             ++t_this_it;
@@ -141,47 +141,132 @@ namespace scarab
     void param_array::merge( const param_array& a_object )
     {
         //LDEBUG( dlog, "merging array with " << a_object.size() << " items:\n" << a_object );
+        if( a_object.empty() ) return;
         if( size() < a_object.size() ) resize( a_object.size() );
 
-        for( unsigned index = 0; index < size() && index < a_object.size(); ++index )
+        // items that are shared with a_object are cloned cheaply, and items that aren't touched stay shared with other copies of this array
+        contents& t_contents = f_contents.mutate();
+        const contents& t_incoming = a_object.f_contents.get();
+        for( unsigned index = 0; index < t_contents.size() && index < t_incoming.size(); ++index )
         {
+            const param& t_incoming_param = *t_incoming[index];
+
             // directly assign if destination location is empty
-            if( f_contents.at( index )->is_null() )
+            if( t_contents[index]->is_null() )
             {
-                //LDEBUG( dlog, "have a null object at <" << index << ">; adding <" << a_object[index] << ">" );
-                assign( index, a_object[index].clone() );
+                //LDEBUG( dlog, "have a null object at <" << index << ">; adding <" << t_incoming_param << ">" );
+                t_contents[index] = t_incoming_param.clone();
                 continue;
             }
 
             // overwrite/recurse if destination location matches incoming type
-            param& t_param = (*this)[index];
-            if( t_param.is_value() && a_object[index].is_value() )
+            param& t_param = *t_contents[index];
+            if( t_param.is_value() && t_incoming_param.is_value() )
             {
-                //LDEBUG( dlog, "replacing the value at <" << index << "> with <" << a_object[index] << ">" );
-                t_param.as_value() = a_object[index].as_value();
+                //LDEBUG( dlog, "replacing the value at <" << index << "> with <" << t_incoming_param << ">" );
+                t_param.as_value() = t_incoming_param.as_value();
                 continue;
             }
-            if( t_param.is_node() && a_object[index].is_node() )
+            if( t_param.is_node() && t_incoming_param.is_node() )
             {
                 //LDEBUG( dlog, "merging nodes at <" << index << ">" )
-                t_param.as_node().merge( a_object[index].as_node() );
+                t_param.as_node().merge( t_incoming_param.as_node() );
                 continue;
             }
-            if( t_param.is_array() && a_object[index].is_array() )
+            if( t_param.is_array() && t_incoming_param.is_array() )
             {
                 //LDEBUG( dlog, "merging array at <" << index << ">" );
-                t_param.as_array().merge( a_object[index].as_array() );
+                t_param.as_array().merge( t_incoming_param.as_array() );
                 continue;
             }
 
             // overwrite via direct assignment if destination location does not match incoming type
             //LDEBUG( dlog, "generic replace" );
-            assign( index, a_object[index].clone() );
+            t_contents[index] = t_incoming_param.clone();
         }
         return;
      }
 
 
+    void param_array::merge( param_array&& a_object )
+    {
+        if( &a_object == this || a_object.empty() ) return;
+
+        if( a_object.f_contents.is_shared() || a_object.f_contents.arena() != f_contents.arena() )
+        {
+            // taking the items would modify a_object's other sharers, or would mix arenas
+            merge( static_cast< const param_array& >( a_object ) );
+            a_object.clear();
+            return;
+        }
+
+        if( empty() )
+        {
+            f_contents = std::move(a_object.f_contents);
+            return;
+        }
+
+        if( size() < a_object.size() ) resize( a_object.size() );
+
+        // references into a_object's items may have been handed out, and those items are about to become ours
+        contents& t_contents = a_object.f_contents.is_leaked() ? f_contents.leak() : f_contents.mutate();
+        contents& t_incoming = a_object.f_contents.mutate();
+        for( unsigned index = 0; index < t_contents.size() && index < t_incoming.size(); ++index )
+        {
+            param& t_incoming_param = *t_incoming[index];
+
+            if( t_contents[index]->is_null() )
+            {
+                t_contents[index] = std::move(t_incoming[index]);
+                continue;
+            }
+
+            param& t_param = *t_contents[index];
+            if( t_param.is_value() && t_incoming_param.is_value() )
+            {
+                t_param.as_value() = std::move(t_incoming_param.as_value());
+                continue;
+            }
+            if( t_param.is_node() && t_incoming_param.is_node() )
+            {
+                t_param.as_node().merge( std::move(t_incoming_param.as_node()) );
+                continue;
+            }
+            if( t_param.is_array() && t_incoming_param.is_array() )
+            {
+                t_param.as_array().merge( std::move(t_incoming_param.as_array()) );
+                continue;
+            }
+
+            t_contents[index] = std::move(t_incoming[index]);
+        }
+        a_object.clear();
+        return;
+    }
+
+
+    void param_array::insert( unsigned a_index, param_ptr_t a_param )
+    {
+        if( a_index > size() )
+        {
+            throw error() << "Cannot insert at index " << a_index << " in an array of size " << size();
+        }
+        contents& t_contents = f_contents.mutate();
+        t_contents.insert( t_contents.begin() + a_index, std::move(a_param) );
+        return;
+    }
+
+    void param_array::remove_element( unsigned a_index )
+    {
+        if( a_index >= size() )
+        {
+            throw error() << "Cannot remove index " << a_index << " from an array of size " << size();
+        }
+        contents& t_contents = f_contents.mutate();
+        t_contents.erase( t_contents.begin() + a_index );
+        return;
+    }
+
     std::string param_array::to_string() const
     {
         stringstream out;
@@ -190,7 +275,7 @@ namespace scarab
             indentation += "    ";
         out << '\n' << indentation << "[\n";
         param::s_indent_level++;
-        for( contents::const_iterator it = f_contents.begin(); it != f_contents.end(); ++it )
+        for( contents::const_iterator it = f_contents.get().begin(); it != f_contents.get().end(); ++it )
         {
             out << indentation << "    " << **it << '\n';
         }
@@ -9,6 +9,7 @@
 #define SCARAB_PARAM_ARRAY_HH_
 
 #include "param_modifier.hh"
+#include "param_shared_contents.hh"
 #include "param_value.hh"
 #include "param_visitor.hh"
 
@@ -28,6 +29,9 @@ namespace scarab
 
     typedef std::deque< std::unique_ptr< param > > param_array_contents;
 
+    /// Clones the items in a_contents (used by shared_contents)
+    SCARAB_API param_array_contents clone_contents( const param_array_contents& a_contents );
+
     typedef boost::indirect_iterator< param_array_contents::iterator, param > param_array_iterator;
     typedef boost::indirect_iterator< param_array_contents::const_iterator, const param > param_array_const_iterator;
 
@@ -38,6 +42,9 @@ namespace scarab
      @brief Array/list-like param structure
 
      @details
+     The contents of an array are shared with its copies until one of them is modified (see shared_contents),
+     so copying an array, or a tree of nodes and arrays, is O(1).
+     Modifying an array may invalidate references and iterators previously obtained from it, as with other containers.
     */
     class SCARAB_API param_array : public param
     {
@@ -59,6 +66,10 @@ namespace scarab
             param_array& operator=( const param_array& rhs );
             param_array& operator=( param_array&& rhs );
 
+            /// Creates an array whose elements are made by a_build the first time the array is accessed (see shared_contents::deferred());
+            /// codecs use this to read a document lazily, one array at a time
+            static param_array deferred( shared_contents< contents >::builder a_build );
+
             virtual param_ptr_t clone() const;
             virtual param_ptr_t move_clone();
 
@@ -73,6 +84,15 @@ namespace scarab
             unsigned size() const;
             bool empty() const;
 
+            /// Returns true if the contents of this array are currently shared with a copy
+            bool is_shared() const;
+            /// Returns true if this array and a_other share their contents, in which case their elements are identical
+            bool shares_contents_with( const param_array& a_other ) const;
+            /// Returns a number that changes whenever items may have been added to, removed from, or replaced in this array
+            std::uint64_t revision() const;
+            /// Returns true if this array's elements are deferred and haven't been made yet
+            bool is_deferred() const;
+
             /// sets the size of the array
             /// if smaller than the current size, extra elements are deleted
             void resize( unsigned a_size );
@@ -126,9 +146,18 @@ namespace scarab
             void append( const param_array& an_array );
 
             void merge( const param_array& an_array );
+            /// Merges an_array into this array, moving its items instead of cloning them; an_array is left empty.
+            /// If an_array's contents are shared, or were created in a different param_arena, the items are cloned as in the const version.
+            void merge( param_array&& an_array );
 
             void erase( unsigned a_index );
             param_ptr_t remove( unsigned a_index );
+            /// Places a_param before the element at a_index (or at the end, if a_index is size()); a_param itself is stored rather than a clone of it.
+            /// Throws a scarab::error if a_index is greater than size().
+            void insert( unsigned a_index, param_ptr_t a_param );
+            /// Removes the element at a_index, moving the later elements down (unlike erase() and remove(), which leave an empty slot).
+            /// Throws a scarab::error if a_index is out of range.
+            void remove_element( unsigned a_index );
             void clear();
 
             iterator begin();
@@ -149,7 +178,7 @@ namespace scarab
             void push_back(); // end the parameter pack recursion
             void push_front(); // end the parameter pack recursion
 
-            contents f_contents;
+            shared_contents< contents > f_contents;
     };
 
     template< typename XValType >
@@ -160,11 +189,31 @@ namespace scarab
 
     inline unsigned param_array::size() const
     {
-        return f_contents.size();
+        return f_contents.get().size();
     }
     inline bool param_array::empty() const
     {
-        return f_contents.empty();
+        return f_contents.get().empty();
+    }
+
+    inline bool param_array::is_shared() const
+    {
+        return f_contents.is_shared();
+    }
+
+    inline bool param_array::is_deferred() const
+    {
+        return f_contents.is_deferred();
+    }
+
+    inline bool param_array::shares_contents_with( const param_array& a_other ) const
+    {
+        return f_contents.shares_with( a_other.f_contents );
+    }
+
+    inline std::uint64_t param_array::revision() const
+    {
+        return f_contents.revision();
     }
 
     inline void param_array::accept( const param_modifier& a_modifier )
@@ -191,38 +240,38 @@ namespace scarab
 
     inline const param& param_array::at( unsigned a_index ) const
     {
-        return *f_contents.at( a_index );
+        return *f_contents.get().at( a_index );
     }
     inline param& param_array::at( unsigned a_index )
     {
-        return *f_contents.at( a_index );
+        return *f_contents.leak().at( a_index );
     }
 
     inline const param& param_array::operator[]( unsigned a_index ) const
     {
-        return *f_contents.at( a_index );
+        return *f_contents.get().at( a_index );
     }
     inline param& param_array::operator[]( unsigned a_index )
     {
-        return *f_contents.at( a_index );
+        return *f_contents.leak().at( a_index );
     }
 
     inline const param& param_array::front() const
     {
-        return *f_contents.front();
+        return *f_contents.get().front();
     }
     inline param& param_array::front()
     {
-        return *f_contents.front();
+        return *f_contents.leak().front();
     }
 
     inline const param& param_array::back() const
     {
-        return *f_contents.back();
+        return *f_contents.get().back();
     }
     inline param& param_array::back()
     {
-        return *f_contents.back();
+        return *f_contents.leak().back();
     }
 
     template< typename T >
@@ -236,22 +285,22 @@ namespace scarab
         erase( a_index );
         if constexpr ( std::is_same_v< param_ptr_t, T_noref > )
         {
-            f_contents.at( a_index ) = std::move(a_value);
+            f_contents.mutate().at( a_index ) = std::move(a_value);
         }
         if constexpr ( std::is_base_of_v< param, T_noref > )
         {
             if constexpr ( std::is_lvalue_reference_v< T > ) // then do a copy
             {
-                f_contents.at( a_index ) = a_value.clone();
+                f_contents.mutate().at( a_index ) = a_value.clone();
             }
             else // then do a move
             {
-                f_contents.at( a_index ) = a_value.move_clone();
+                f_contents.mutate().at( a_index ) = a_value.move_clone();
             }
         }
         else if constexpr ( std::is_convertible_v< T_noref, param_value > )
         {
-            f_contents.at( a_index ) = param_ptr_t( new param_value( a_value ) );
+            f_contents.mutate().at( a_index ) = param_ptr_t( new param_value( a_value ) );
         }
         return;
     }
@@ -266,22 +315,22 @@ namespace scarab
 
         if constexpr ( std::is_same_v< param_ptr_t, T_noref > )
         {
-            f_contents.push_back( std::move(a_value) );
+            f_contents.mutate().push_back( std::move(a_value) );
         }
         if constexpr ( std::is_base_of_v< param, T_noref > )
         {
             if constexpr ( std::is_lvalue_reference_v< T > ) // then do a copy
             {
-                f_contents.push_back( a_value.clone() );
+                f_contents.mutate().push_back( a_value.clone() );
             }
             else // then do a move
             {
-                f_contents.push_back( a_value.move_clone() );
+                f_contents.mutate().push_back( a_value.move_clone() );
             }
         }
         else if constexpr ( std::is_convertible_v< T_noref, param_value > )
         {
-            f_contents.push_back( param_ptr_t( new param_value( a_value ) ) );
+            f_contents.mutate().push_back( param_ptr_t( new param_value( a_value ) ) );
         }
         push_back( std::forward<Ts>( a_values )... );
         return;
@@ -300,22 +349,22 @@ namespace scarab
 
         if constexpr ( std::is_same_v< param_ptr_t, T_noref > )
         {
-            f_contents.push_front( std::move(a_value) );
+            f_contents.mutate().push_front( std::move(a_value) );
         }
         if constexpr ( std::is_base_of_v< param, T_noref > )
         {
             if constexpr ( std::is_lvalue_reference_v< T > ) // then do a copy
             {
-                f_contents.push_front( a_value.clone() );
+                f_contents.mutate().push_front( a_value.clone() );
             }
             else // then do a move
             {
-                f_contents.push_front( a_value.move_clone() );
+                f_contents.mutate().push_front( a_value.move_clone() );
             }
         }
         else if constexpr ( std::is_convertible_v< T_noref, param_value > )
         {
-            f_contents.push_front( param_ptr_t( new param_value( a_value ) ) );
+            f_contents.mutate().push_front( param_ptr_t( new param_value( a_value ) ) );
         }
         push_front( std::forward<Ts>( a_values )... );
         return;
@@ -335,54 +384,54 @@ namespace scarab
 
     inline void param_array::erase( unsigned a_index )
     {
-        f_contents.at( a_index ).reset();
+        f_contents.mutate().at( a_index ).reset();
         return;
     }
     inline param_ptr_t param_array::remove( unsigned a_index )
     {
-        param_ptr_t t_current( std::move( f_contents.at( a_index ) ) );
+        param_ptr_t t_current( std::move( f_contents.mutate().at( a_index ) ) );
         return t_current;
     }
     inline void param_array::clear()
     {
-        f_contents.clear();
+        f_contents.reset();
         return;
     }
 
     inline param_array::iterator param_array::begin()
     {
-        return iterator( f_contents.begin() );
+        return iterator( f_contents.leak().begin() );
     }
     inline param_array::const_iterator param_array::begin() const
     {
-        return const_iterator( f_contents.cbegin() );
+        return const_iterator( f_contents.get().cbegin() );
     }
 
     inline param_array::iterator param_array::end()
     {
-        return iterator( f_contents.end() );
+        return iterator( f_contents.leak().end() );
     }
     inline param_array::const_iterator param_array::end() const
     {
-        return const_iterator( f_contents.cend() );
+        return const_iterator( f_contents.get().cend() );
     }
 
     inline param_array::reverse_iterator param_array::rbegin()
     {
-        return f_contents.rbegin();
+        return f_contents.leak().rbegin();
     }
     inline param_array::const_reverse_iterator param_array::rbegin() const
     {
-        return f_contents.rbegin();
+        return f_contents.get().rbegin();
     }
 
     inline param_array::reverse_iterator param_array::rend()
     {
-        return f_contents.rend();
+        return f_contents.leak().rend();
     }
     inline param_array::const_reverse_iterator param_array::rend() const
     {
-        return f_contents.crend();
+        return f_contents.get().crend();
     }
 
     SCARAB_API std::ostream& operator<<(std::ostream& out, const param_array& value);
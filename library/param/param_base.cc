@@ -15,11 +15,47 @@ using std::stringstream;
 
 #include "param_base_impl.hh"
 
+#include "param_arena.hh"
+
 namespace scarab
 {
 
     SCARAB_API unsigned param::s_indent_level = 0;
 
+    // Every param allocation is prefixed with a header recording which arena (if any) it came from,
+    // so that operator delete can tell arena memory from heap memory regardless of which thread deletes it.
+    // The header is padded to the maximum alignment so that the param itself stays suitably aligned.
+    // This costs sizeof( param_alloc_header ) (16 bytes on typical 64-bit platforms) per param, on the heap as well as in an arena.
+    struct alignas( std::max_align_t ) param_alloc_header
+    {
+        param_arena* f_arena;
+        std::size_t f_size;
+    };
+
+    void* param::operator new( std::size_t a_size )
+    {
+        param_arena* t_arena = param_arena::current();
+        std::size_t t_size = a_size + sizeof( param_alloc_header );
+        void* t_mem = t_arena == nullptr ? ::operator new( t_size ) : t_arena->allocate( t_size );
+        ::new( t_mem ) param_alloc_header{ t_arena, t_size };
+        return static_cast< param_alloc_header* >( t_mem ) + 1;
+    }
+
+    void param::operator delete( void* a_ptr ) noexcept
+    {
+        if( a_ptr == nullptr ) return;
+        param_alloc_header* t_header = static_cast< param_alloc_header* >( a_ptr ) - 1;
+        if( t_header->f_arena == nullptr )
+        {
+            ::operator delete( t_header );
+        }
+        else
+        {
+            t_header->f_arena->deallocate( t_header, t_header->f_size );
+        }
+        return;
+    }
+
     param::param()
     {}
 
@@ -44,6 +80,12 @@ namespace scarab
         return param_ptr_t( new param( std::move(*this) ) );
     }
 
+    param_ptr_t param::clone_into( param_arena& a_arena ) const
+    {
+        param_arena_scope t_scope( a_arena );
+        return clone();
+    }
+
     bool param::is_null() const
     {
         return true;
@@ -64,11 +106,17 @@ namespace scarab
         return false;
     }
 
+    bool param::is_typed_array() const
+    {
+        return false;
+    }
+
     std::string param::type() const
     {
         if( this->is_value() ) return "value";
         else if( this->is_node() ) return "node";
         else if( this->is_array() ) return "array";
+        else if( this->is_typed_array() ) return "typed_array";
         else if( this->is_null() ) return "null";
         else throw error() << "Unknown param type encountered";
     }
@@ -96,6 +144,38 @@ namespace scarab
             as_value() = a_param.as_value();
             return;
         }
+        if( is_typed_array() && a_param.is_typed_array() )
+        {
+            as_typed_array().merge( a_param.as_typed_array() );
+            return;
+        }
+        if( is_null() && a_param.is_null() ) return;
+        throw error() << "Invalid merge command with incompatible param types";
+    }
+
+    void param::merge( param&& a_param )
+    {
+        if( is_node() && a_param.is_node() )
+        {
+            as_node().merge( std::move(a_param.as_node()) );
+            return;
+        }
+        if( is_array() && a_param.is_array() )
+        {
+            as_array().merge( std::move(a_param.as_array()) );
+            return;
+        }
+        if( is_value() && a_param.is_value() )
+        {
+            as_value() = std::move(a_param.as_value());
+            return;
+        }
+        if( is_typed_array() && a_param.is_typed_array() )
+        {
+            // copying a typed array only shares its buffer
+            as_typed_array().merge( a_param.as_typed_array() );
+            return;
+        }
         if( is_null() && a_param.is_null() ) return;
         throw error() << "Invalid merge command with incompatible param types";
     }
@@ -11,9 +11,11 @@
 #include "error.hh"
 #include "param_fwd.hh"
 
+#include <cstddef>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 namespace scarab
 {
@@ -43,6 +45,13 @@ namespace scarab
             virtual param_ptr_t clone() const;
             virtual param_ptr_t move_clone();
 
+            /// Deep-copies this param, allocating the copy from a_arena (see param_arena)
+            param_ptr_t clone_into( param_arena& a_arena ) const;
+
+            /// All param objects are allocated through these functions, which use the param_arena active on the current thread if there is one
+            static void* operator new( std::size_t a_size );
+            static void operator delete( void* a_ptr ) noexcept;
+
             virtual void accept( const param_modifier& a_modifier );
             virtual void accept( const param_visitor& a_visitor ) const;
 
@@ -50,6 +59,8 @@ namespace scarab
             virtual bool is_value() const;
             virtual bool is_array() const;
             virtual bool is_node() const;
+            /// True for param_typed_array (see param_typed_array_base)
+            virtual bool is_typed_array() const;
             std::string type() const;
 
             virtual bool has_subset( const param& a_subset ) const;
@@ -62,6 +73,9 @@ namespace scarab
             const param_array& as_array() const;
             const param_node& as_node() const;
 
+            param_typed_array_base& as_typed_array();
+            const param_typed_array_base& as_typed_array() const;
+
             /// Assumes that the parameter is a value, and returns a reference to itself.
             const param_value& operator()() const;
             /// Assumes that the parameter is a value, and returns a reference to itself.
@@ -79,11 +93,11 @@ namespace scarab
             /// Assumes that the parameter is a node, and returns a reference to the param corresponding to a_name.
             /// Throws a scarab::error if a_name is not present.
             /// Note that this behavior differs from the C++ STL map-like container behavior
-            const param& operator[]( const std::string& a_name ) const;
+            const param& operator[]( std::string_view a_name ) const;
             /// Assumes that the parameter is a node, and returns a reference to the param corresponding to a_name.
             /// Throws an scarab::error if a_name is not present.
             /// Note that this behavior differs from the C++ STL map-like container behavior
-            param& operator[]( const std::string& a_name );
+            param& operator[]( std::string_view a_name );
 
             /// Assumes that the parameter is an array, and returns a reference to the param at a_index.
             /// Behavior is undefined if a_index is out-of-range.
@@ -94,21 +108,21 @@ namespace scarab
 
             /// Assumes that the parameter is a node, and returns a reference to the param corresponding to a_name.
             /// Throws a scarab::error if a_name is not present.
-            const param& at( const std::string& a_name ) const;
+            const param& at( std::string_view a_name ) const;
             /// Assumes that the parameter is a node, and returns a reference to the param corresponding to a_name.
             /// Throws a scarab::error if a_name is not present.
-            param& at( const std::string& a_name );
+            param& at( std::string_view a_name );
 
             /// If the derived param type is param_node, forwards the reqeust to param_node; otherwise throws an error.
             /// Returns the result of param_value::get if a_name is present and is of type param_value
             /// Returns a_default if a_name is not present or is not of type param_value
-            std::string get_value( const std::string& a_name, const std::string& a_default ) const;
-            std::string get_value( const std::string& a_name, const char* a_default ) const;
+            std::string get_value( std::string_view a_name, const std::string& a_default ) const;
+            std::string get_value( std::string_view a_name, const char* a_default ) const;
             /// If the derived param type is param_node, forwards the reqeust to param_node; otherwise throws an error.
             /// Returns the result of param_value::get if a_name is present and is of type param_value
             /// Returns a_default if a_name is not present or is not of type param_value
             template< typename XValType >
-            XValType get_value( const std::string& a_name, XValType a_default ) const;
+            XValType get_value( std::string_view a_name, XValType a_default ) const;
 
             /// If the derived param type is param_node, forwards the reqeust to param_node; otherwise throws an error.
             /// Returns the result of param_value::get if a_name is present and is of type param_value
@@ -122,6 +136,7 @@ namespace scarab
             XValType get_value( unsigned a_index, XValType a_default ) const;
 
             void merge( const param& a_param );
+            void merge( param&& a_param );
 
             virtual std::string to_string() const;
 
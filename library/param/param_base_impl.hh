@@ -12,6 +12,7 @@
 
 #include "param_array.hh"
 #include "param_node.hh"
+#include "param_typed_array.hh"
 #include "param_value.hh"
 
 #include "param_modifier.hh"
@@ -78,6 +79,18 @@ namespace scarab
         throw error() << "Param object is not a node";
     }
 
+    inline param_typed_array_base& param::as_typed_array()
+    {
+        if( this->is_typed_array() ) return *static_cast< param_typed_array_base* >( this );
+        throw error() << "Param object is not a typed array";
+    }
+
+    inline const param_typed_array_base& param::as_typed_array() const
+    {
+        if( this->is_typed_array() ) return *static_cast< const param_typed_array_base* >( this );
+        throw error() << "Param object is not a typed array";
+    }
+
     inline const param_value& param::operator()() const
     {
         return as_value();
@@ -98,12 +111,12 @@ namespace scarab
         return as_array()[ a_index ];
     }
 
-    inline const param& param::operator[]( const std::string& a_name ) const
+    inline const param& param::operator[]( std::string_view a_name ) const
     {
         return as_node()[ a_name ];
     }
 
-    inline param& param::operator[]( const std::string& a_name )
+    inline param& param::operator[]( std::string_view a_name )
     {
         return as_node()[ a_name ];
     }
@@ -118,28 +131,28 @@ namespace scarab
         return as_array().at( a_index );
     }
 
-    inline const param& param::at( const std::string& a_name ) const
+    inline const param& param::at( std::string_view a_name ) const
     {
         return as_node().at( a_name );
     }
 
-    inline param& param::at( const std::string& a_name )
+    inline param& param::at( std::string_view a_name )
     {
         return as_node().at( a_name );
     }
 
-    inline std::string param::get_value( const std::string& a_name, const std::string& a_default ) const
+    inline std::string param::get_value( std::string_view a_name, const std::string& a_default ) const
     {
         return as_node().get_value( a_name, a_default );
     }
 
-    inline std::string param::get_value( const std::string& a_name, const char* a_default ) const
+    inline std::string param::get_value( std::string_view a_name, const char* a_default ) const
     {
         return as_node().get_value( a_name, a_default );
     }
 
     template< typename XValType >
-    inline XValType param::get_value( const std::string& a_name, XValType a_default ) const
+    inline XValType param::get_value( std::string_view a_name, XValType a_default ) const
     {
         return as_node().get_value( a_name, a_default );
     }
@@ -9,14 +9,107 @@
 
 #include "param_codec.hh"
 
+#include "error.hh"
 #include "factory.hh"
 #include "logger.hh"
 #include "path.hh"
+#include "worker_pool.hh"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <thread>
+
+#ifdef USE_COMPRESSED_IO
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#endif
 
 LOGGER( slog, "param_codec" );
 
 namespace scarab
 {
+    namespace
+    {
+        // The calling thread's codec for a_encoding; codecs are created on first use, and owned by the thread
+        template< class XCodec >
+        XCodec* thread_codec( const std::string& a_encoding )
+        {
+            thread_local std::map< std::string, std::unique_ptr< XCodec >, std::less<> > t_codecs;
+
+            auto t_it = t_codecs.find( a_encoding );
+            if( t_it != t_codecs.end() ) return t_it->second.get();
+
+            std::unique_ptr< XCodec > t_codec( factory< XCodec >::get_instance()->create( a_encoding ) );
+            if( ! t_codec ) return nullptr;
+            return t_codecs.emplace( a_encoding, std::move(t_codec) ).first->second.get();
+        }
+
+        enum class compression
+        {
+            k_none,
+            k_gzip,
+            k_zstd
+        };
+
+        // Throws if a_name isn't a known compression
+        compression compression_from_name( const std::string& a_name )
+        {
+            if( a_name == "gz" || a_name == "gzip" ) return compression::k_gzip;
+            if( a_name == "zst" || a_name == "zstd" ) return compression::k_zstd;
+            if( a_name == "none" ) return compression::k_none;
+            throw error() << "Unknown compression <" << a_name << ">";
+        }
+
+        bool is_compression_extension( const std::string& an_extension )
+        {
+            return an_extension == ".gz" || an_extension == ".gzip" || an_extension == ".zst" || an_extension == ".zstd";
+        }
+
+        // Finds the encoding and compression of a file from its extensions (e.g. "config.json.gz"), unless they're given in a_options.
+        // A compression extension is never taken as the encoding, even if the compression is given in a_options.
+        // Throws if the encoding isn't given and there's no extension for it, or if the compression is unknown.
+        void file_encoding( const std::string& a_filename, const param_node& a_options, std::string& an_encoding, compression& a_compression )
+        {
+            an_encoding = a_options.get_value( "encoding", "" );
+            path t_path = expand_path( a_filename );
+            std::string t_extension = t_path.extension().string();
+            bool t_compression_extension = is_compression_extension( t_extension );
+            // the encoding is given by the extension before the compression's
+            if( t_compression_extension ) t_path = t_path.stem();
+            if( a_options.has( "compression" ) )
+            {
+                a_compression = compression_from_name( a_options.get_value( "compression", "" ) );
+            }
+            else
+            {
+                a_compression = t_compression_extension ? compression_from_name( t_extension.substr( 1 ) ) : compression::k_none;
+            }
+            if( an_encoding.empty() ) an_encoding = t_path.extension().string().substr( 1 ); // remove the '.' at the beginning
+            return;
+        }
+
+#ifdef USE_COMPRESSED_IO
+        template< class XChain >
+        void push_compression_filter( XChain& a_chain, compression a_compression, bool an_output )
+        {
+            if( a_compression == compression::k_gzip )
+            {
+                if( an_output ) a_chain.push( boost::iostreams::gzip_compressor() );
+                else a_chain.push( boost::iostreams::gzip_decompressor() );
+            }
+            else if( a_compression == compression::k_zstd )
+            {
+                if( an_output ) a_chain.push( boost::iostreams::zstd_compressor() );
+                else a_chain.push( boost::iostreams::zstd_decompressor() );
+            }
+            return;
+        }
+#endif
+    }
 
     param_input_codec::param_input_codec()
     {
@@ -26,6 +119,12 @@ namespace scarab
     {
     }
 
+    param_ptr_t param_input_codec::read_stream( std::istream& a_stream, const param_node& a_options )
+    {
+        std::string t_string( (std::istreambuf_iterator< char >( a_stream )), std::istreambuf_iterator< char >() );
+        return read_string( t_string, a_options );
+    }
+
 
     param_output_codec::param_output_codec()
     {
@@ -35,6 +134,13 @@ namespace scarab
     {
     }
 
+    bool param_output_codec::write_stream( const param& a_param, std::ostream& a_stream, const param_node& a_options )
+    {
+        std::string t_string;
+        if( ! write_string( a_param, t_string, a_options ) ) return false;
+        return a_stream.write( t_string.data(), t_string.size() ).good();
+    }
+
 
     param_translator::param_translator()
     {
@@ -46,29 +152,58 @@ namespace scarab
 
     param_ptr_t param_translator::read_file( const std::string& a_filename, const param_node& a_options  )
     {
-        std::string t_encoding = a_options.get_value( "encoding", "" );
-        if( t_encoding.empty() )
+        std::string t_encoding;
+        compression t_compression = compression::k_none;
+        try
         {
-            try
-            {
-                path t_path = expand_path( a_filename );
-                t_encoding = t_path.extension().string().substr( 1 ); // remove the '.' at the beginning
-            }
-            catch( const std::exception& e )
-            {
-                LERROR( slog, "Unable to parse the file extension to determine the input codec for file <" << a_filename << ">" );
-                return nullptr;
-            }
+            file_encoding( a_filename, a_options, t_encoding, t_compression );
+        }
+        catch( const error& e )
+        {
+            LERROR( slog, "Unable to read file <" << a_filename << ">: " << e.what() );
+            return nullptr;
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "Unable to parse the file extension to determine the input codec for file <" << a_filename << ">" );
+            return nullptr;
         }
 
-        param_input_codec* t_codec = factory< param_input_codec >::get_instance()->create( t_encoding );
+        param_input_codec* t_codec = input_codec( t_encoding );
         if( t_codec == nullptr )
         {
             LERROR( slog, "Unable to find input codec for encoding <" << t_encoding << ">");
             return nullptr;
         }
 
-        return t_codec->read_file( a_filename, a_options );
+        if( t_compression == compression::k_none ) return t_codec->read_file( a_filename, a_options );
+
+#ifdef USE_COMPRESSED_IO
+        std::ifstream t_file( a_filename, std::ios::in | std::ios::binary );
+        if( ! t_file.is_open() )
+        {
+            LERROR( slog, "Unable to open file <" << a_filename << ">" );
+            return nullptr;
+        }
+        try
+        {
+            // the codec reads the decompressed data as it's produced
+            boost::iostreams::filtering_istream t_stream;
+            push_compression_filter( t_stream, t_compression, false );
+            t_stream.push( t_file );
+            // errors in the compressed data are thrown from the stream rather than only setting its state
+            t_stream.exceptions( std::ios::badbit );
+            return t_codec->read_stream( t_stream, a_options );
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "Unable to decompress file <" << a_filename << ">: " << e.what() );
+            return nullptr;
+        }
+#else
+        LERROR( slog, "Unable to read compressed file <" << a_filename << ">: Scarab was built without compressed I/O" );
+        return nullptr;
+#endif
     }
 
     param_ptr_t param_translator::read_string( const std::string& a_string, const param_node& a_options  )
@@ -85,7 +220,7 @@ namespace scarab
 
     param_ptr_t param_translator::read_string( const std::string& a_string, const std::string& a_encoding, const param_node& a_options  )
     {
-        param_input_codec* t_codec = factory< param_input_codec >::get_instance()->create( a_encoding );
+        param_input_codec* t_codec = input_codec( a_encoding );
         if( t_codec == nullptr )
         {
             LERROR( slog, "Unable to find input codec for encoding <" << a_encoding << ">");
@@ -95,31 +230,106 @@ namespace scarab
         return t_codec->read_string( a_string, a_options );
     }
 
-    bool param_translator::write_file( const param& a_param, const std::string& a_filename, const param_node& a_options  )
+    param_ptr_t param_translator::read_files( const std::vector< std::string >& a_filenames, const param_node& a_options, unsigned a_n_threads )
     {
-        std::string t_encoding = a_options.get_value( "encoding", "" );
-        if( t_encoding.empty() )
+        std::vector< param_ptr_t > t_configs( read_each_file( a_filenames, a_options, a_n_threads ) );
+
+        // merged in the order given, regardless of the order in which the files were read
+        param_ptr_t t_merged( new param_node() );
+        for( std::size_t i_file = 0; i_file < a_filenames.size(); ++i_file )
         {
-            try
+            if( ! t_configs[i_file] )
             {
-                path t_path = expand_path( a_filename );
-                t_encoding = t_path.extension().string().substr( 1 ); // remove the '.' at the beginning
+                LERROR( slog, "Unable to read file <" << a_filenames[i_file] << ">" );
+                return nullptr;
             }
-            catch( const std::exception& e )
+            if( ! t_configs[i_file]->is_node() )
             {
-                LERROR( slog, "Unable to parse the file extension to determine the output codec for file <" << a_filename << ">" );
-                return false;
-            }            
+                LERROR( slog, "File <" << a_filenames[i_file] << "> must consist of an object/node" );
+                return nullptr;
+            }
+            if( i_file == 0 ) t_merged = std::move(t_configs[i_file]);
+            else t_merged->as_node().merge( std::move(t_configs[i_file]->as_node()) );
+        }
+        return t_merged;
+    }
+
+    std::vector< param_ptr_t > param_translator::read_each_file( const std::vector< std::string >& a_filenames, const param_node& a_options, unsigned a_n_threads )
+    {
+        std::vector< param_ptr_t > t_configs( a_filenames.size() );
+
+        unsigned t_n_threads = a_n_threads == 0 ? std::max( 1U, std::thread::hardware_concurrency() ) : a_n_threads;
+        t_n_threads = std::max< std::size_t >( 1, std::min< std::size_t >( t_n_threads, a_filenames.size() ) );
+        LDEBUG( slog, "Reading " << a_filenames.size() << " files on " << t_n_threads << " threads" );
+        worker_pool( t_n_threads ).run( a_filenames.size(), [this, &a_filenames, &a_options, &t_configs]( std::size_t an_index, unsigned )
+            {
+                t_configs[an_index] = read_file( a_filenames[an_index], a_options );
+                return;
+            } );
+        return t_configs;
+    }
+
+    bool param_translator::write_file( const param& a_param, const std::string& a_filename, const param_node& a_options  )
+    {
+        std::string t_encoding;
+        compression t_compression = compression::k_none;
+        try
+        {
+            file_encoding( a_filename, a_options, t_encoding, t_compression );
+        }
+        catch( const error& e )
+        {
+            LERROR( slog, "Unable to write file <" << a_filename << ">: " << e.what() );
+            return false;
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "Unable to parse the file extension to determine the output codec for file <" << a_filename << ">" );
+            return false;
         }
 
-        param_output_codec* t_codec = factory< param_output_codec >::get_instance()->create( t_encoding );
+        param_output_codec* t_codec = output_codec( t_encoding );
         if( t_codec == nullptr )
         {
             LERROR( slog, "Unable to find output codec for encoding <" << t_encoding << ">" );
             return false;
         }
 
-        return t_codec->write_file( a_param, a_filename, a_options );
+        if( t_compression == compression::k_none ) return t_codec->write_file( a_param, a_filename, a_options );
+
+#ifdef USE_COMPRESSED_IO
+        std::ofstream t_file( a_filename, std::ios::out | std::ios::binary | std::ios::trunc );
+        if( ! t_file.is_open() )
+        {
+            LERROR( slog, "Unable to open file: " << a_filename );
+            return false;
+        }
+        try
+        {
+            // the data are compressed as the codec writes them
+            boost::iostreams::filtering_ostream t_stream;
+            push_compression_filter( t_stream, t_compression, true );
+            t_stream.push( t_file );
+            t_stream.exceptions( std::ios::badbit );
+            if( ! t_codec->write_stream( a_param, t_stream, a_options ) ) return false;
+            // removing the compressor from the chain flushes it and writes the end of the compressed data
+            t_stream.reset();
+        }
+        catch( const std::exception& e )
+        {
+            LERROR( slog, "Unable to compress file <" << a_filename << ">: " << e.what() );
+            return false;
+        }
+        if( ! t_file.flush().good() )
+        {
+            LERROR( slog, "Unable to write file: " << a_filename );
+            return false;
+        }
+        return true;
+#else
+        LERROR( slog, "Unable to write compressed file <" << a_filename << ">: Scarab was built without compressed I/O" );
+        return false;
+#endif
     }
 
     bool param_translator::write_string( const param& a_param, std::string& a_string, const param_node& a_options  )
@@ -136,7 +346,7 @@ namespace scarab
 
     bool param_translator::write_string( const param& a_param, std::string& a_string, const std::string& a_encoding, const param_node& a_options  )
     {
-        param_output_codec* t_codec = factory< param_output_codec >::get_instance()->create( a_encoding );
+        param_output_codec* t_codec = output_codec( a_encoding );
         if( t_codec == nullptr )
         {
             LERROR( slog, "Unable to find output codec for encoding <" << a_encoding << ">");
@@ -146,4 +356,14 @@ namespace scarab
         return t_codec->write_string( a_param, a_string, a_options );
     }
 
+    param_input_codec* param_translator::input_codec( const std::string& a_encoding )
+    {
+        return thread_codec< param_input_codec >( a_encoding );
+    }
+
+    param_output_codec* param_translator::output_codec( const std::string& a_encoding )
+    {
+        return thread_codec< param_output_codec >( a_encoding );
+    }
+
 } /* namespace scarab */
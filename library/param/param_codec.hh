@@ -14,8 +14,10 @@
 
 #include "factory.hh"
 
+#include <iosfwd>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace scarab
 {
@@ -30,6 +32,9 @@ namespace scarab
      @brief 
 
      @details
+     read_stream() is used by param_translator to read compressed files through a decompressing stream.
+     The default implementation reads the whole stream into a string and calls read_string();
+     codecs that can parse incrementally override it.
     */
     class SCARAB_API param_input_codec
     {
@@ -39,6 +44,7 @@ namespace scarab
 
             virtual param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node() ) = 0;
             virtual param_ptr_t read_string( const std::string& a_string, const param_node& a_options = param_node() ) = 0;
+            virtual param_ptr_t read_stream( std::istream& a_stream, const param_node& a_options = param_node() );
     };
 
 
@@ -49,6 +55,9 @@ namespace scarab
      @brief 
 
      @details
+     write_stream() is used by param_translator to write compressed files through a compressing stream.
+     The default implementation calls write_string() and writes the string to the stream;
+     codecs that can write incrementally override it.
     */
     class SCARAB_API param_output_codec
     {
@@ -58,6 +67,7 @@ namespace scarab
 
             virtual bool write_file( const param& a_param, const std::string& a_filename, const param_node& a_options = param_node() ) = 0;
             virtual bool write_string( const param& a_param, std::string& a_string, const param_node& a_options = param_node() ) = 0;
+            virtual bool write_stream( const param& a_param, std::ostream& a_stream, const param_node& a_options = param_node() );
     };
 
 #define REGISTER_PARAM_OUTPUT_CODEC(codec_class, encoding) \
@@ -71,6 +81,22 @@ namespace scarab
      @brief Translates between files/strings of data and param structures
 
      @details
+     The codec for an encoding is created from the factory the first time it's used on a thread, and is reused for later calls on that thread.
+     The codecs are owned by the thread (see input_codec() and output_codec()), so translators are cheap to create,
+     and translating doesn't lock or allocate a codec each time.
+
+     read_files() parses several files concurrently and merges them, in the order given, into one param_node;
+     read_each_file() parses them the same way and returns them without merging.
+
+     Compressed files are read and written transparently.  The compression is given by the last extension of the filename,
+     and the encoding by the one before it: e.g. "run.json.gz", "config.yaml.zst", "metadata.msgpack.zst".
+       - gzip: ".gz" or ".gzip"
+       - zstd: ".zst" or ".zstd"
+     The file is (de)compressed as the codec reads or writes it (see param_input_codec::read_stream()),
+     so no uncompressed copy is made, in a file or in memory, for codecs that work incrementally.
+     The "compression" option ("gzip", "zstd", or "none") overrides the extension, and the "encoding" option can be given as usual;
+     a compression extension is never taken as the encoding, even with "compression" set to "none".  An unknown compression name is an error.
+     Compression requires scarab to be built with Scarab_COMPRESSED_IO (off by default); otherwise compressed files can't be read or written.
     */
     class SCARAB_API param_translator
     {
@@ -82,11 +108,26 @@ namespace scarab
             param_ptr_t read_file( const std::string& a_filename, const param_node& a_options = param_node()  );
             param_ptr_t read_string( const std::string& a_string, const param_node& a_options = param_node()  );
             param_ptr_t read_string( const std::string& a_string, const std::string& a_encoding, const param_node& a_options = param_node() );
+            /// Reads the files on up to a_n_threads threads (0 uses the hardware concurrency), and merges them in the order given,
+            /// so values in later files take precedence.  Each file must contain a node, and a_options are used for all of them.
+            /// Returns a param_node, or nullptr if a file can't be read or doesn't contain a node.
+            param_ptr_t read_files( const std::vector< std::string >& a_filenames, const param_node& a_options = param_node(), unsigned a_n_threads = 0 );
+            /// Reads the files on up to a_n_threads threads (0 uses the hardware concurrency), with a_options used for all of them.
+            /// Returns what was read from each file, in the order given; an element is nullptr if its file can't be read.
+            std::vector< param_ptr_t > read_each_file( const std::vector< std::string >& a_filenames, const param_node& a_options = param_node(), unsigned a_n_threads = 0 );
 
         public:
             bool write_file( const param& a_param, const std::string& a_filename, const param_node& a_options = param_node() );
             bool write_string( const param& a_param, std::string& a_string, const param_node& a_options = param_node() );
             bool write_string( const param& a_param, std::string& a_string, const std::string& a_encoding, const param_node& a_options = param_node() );
+
+        public:
+            /// Returns the calling thread's codec for a_encoding, creating it if needed, or nullptr if there's no such codec.
+            /// The codec is owned by the thread, and is destroyed when the thread exits.
+            static param_input_codec* input_codec( const std::string& a_encoding );
+            /// Returns the calling thread's codec for a_encoding, creating it if needed, or nullptr if there's no such codec.
+            /// The codec is owned by the thread, and is destroyed when the thread exits.
+            static param_output_codec* output_codec( const std::string& a_encoding );
     };
 
 
@@ -0,0 +1,381 @@
+/*
+ * param_diff.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_diff.hh"
+
+#include "param_base_impl.hh"
+#include "param_helpers_impl.hh"
+#include "param_node.hh"
+#include "param_typed_array.hh"
+#include "param_value.hh"
+
+#include "error.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+    namespace
+    {
+        // A pair of params to compare; the path to them is found by following f_parent back to the root
+        struct diff_frame
+        {
+            const param* f_from;
+            const param* f_to;
+            std::size_t f_parent;
+            std::string f_name;
+            unsigned f_index;
+            bool f_is_index;
+        };
+
+        const std::size_t s_no_parent = std::size_t(-1);
+
+        class differ
+        {
+            public:
+                differ() :
+                        f_frames(),
+                        f_patch()
+                {}
+
+                param_array run( const param& a_from, const param& a_to )
+                {
+                    f_frames.push_back( diff_frame{ &a_from, &a_to, s_no_parent, std::string(), 0, false } );
+                    // f_frames grows while it's being processed; frames are kept so that paths can be built
+                    for( std::size_t i_frame = 0; i_frame < f_frames.size(); ++i_frame )
+                    {
+                        compare( i_frame );
+                    }
+                    return std::move(f_patch);
+                }
+
+            private:
+                void compare( std::size_t a_frame )
+                {
+                    // frames for added and removed items are only used for their paths
+                    if( f_frames[a_frame].f_from == nullptr || f_frames[a_frame].f_from == f_frames[a_frame].f_to ) return;
+                    const param& t_from = *f_frames[a_frame].f_from;
+                    const param& t_to = *f_frames[a_frame].f_to;
+
+                    if( t_from.is_node() && t_to.is_node() )
+                    {
+                        compare_nodes( a_frame, t_from.as_node(), t_to.as_node() );
+                    }
+                    else if( t_from.is_array() && t_to.is_array() )
+                    {
+                        compare_arrays( a_frame, t_from.as_array(), t_to.as_array() );
+                    }
+                    else if( t_from.is_value() && t_to.is_value() )
+                    {
+                        if( ! same_values( t_from.as_value(), t_to.as_value() ) ) add_op( "replace", a_frame, &t_to );
+                    }
+                    else if( t_from.is_typed_array() && t_to.is_typed_array() )
+                    {
+                        if( ! same_typed_arrays( t_from.as_typed_array(), t_to.as_typed_array() ) ) add_op( "replace", a_frame, &t_to );
+                    }
+                    else if( ! (t_from.is_null() && t_to.is_null()) )
+                    {
+                        add_op( "replace", a_frame, &t_to );
+                    }
+                    return;
+                }
+
+                void compare_nodes( std::size_t a_frame, const param_node& a_from, const param_node& a_to )
+                {
+                    if( a_from.shares_contents_with( a_to ) ) return;
+
+                    // both nodes are sorted by name, so they're walked together
+                    param_node::const_iterator t_from_it = a_from.begin();
+                    param_node::const_iterator t_to_it = a_to.begin();
+                    while( t_from_it != a_from.end() || t_to_it != a_to.end() )
+                    {
+                        int t_order = t_from_it == a_from.end() ? 1 : ( t_to_it == a_to.end() ? -1 : t_from_it.name().compare( t_to_it.name() ) );
+                        if( t_order < 0 )
+                        {
+                            add_op( "remove", add_frame( a_frame, nullptr, nullptr, t_from_it.name() ), nullptr );
+                            ++t_from_it;
+                        }
+                        else if( t_order > 0 )
+                        {
+                            add_op( "add", add_frame( a_frame, nullptr, nullptr, t_to_it.name() ), &*t_to_it );
+                            ++t_to_it;
+                        }
+                        else
+                        {
+                            if( ! shared( *t_from_it, *t_to_it ) ) add_frame( a_frame, &*t_from_it, &*t_to_it, t_from_it.name() );
+                            ++t_from_it;
+                            ++t_to_it;
+                        }
+                    }
+                    return;
+                }
+
+                void compare_arrays( std::size_t a_frame, const param_array& a_from, const param_array& a_to )
+                {
+                    if( a_from.shares_contents_with( a_to ) ) return;
+
+                    unsigned t_common = std::min( a_from.size(), a_to.size() );
+                    for( unsigned i_element = 0; i_element < t_common; ++i_element )
+                    {
+                        if( ! shared( a_from[i_element], a_to[i_element] ) ) add_frame( a_frame, &a_from[i_element], &a_to[i_element], i_element );
+                    }
+                    // extra elements are removed from the end, so that the indices of the others don't change
+                    for( unsigned i_element = a_from.size(); i_element > t_common; --i_element )
+                    {
+                        add_op( "remove", add_frame( a_frame, nullptr, nullptr, i_element - 1 ), nullptr );
+                    }
+                    for( unsigned i_element = t_common; i_element < a_to.size(); ++i_element )
+                    {
+                        add_op( "add", add_frame( a_frame, nullptr, nullptr, i_element ), &a_to[i_element] );
+                    }
+                    return;
+                }
+
+                // true if a_from and a_to are known to be identical without comparing their items
+                static bool shared( const param& a_from, const param& a_to )
+                {
+                    if( &a_from == &a_to ) return true;
+                    if( a_from.is_node() && a_to.is_node() ) return a_from.as_node().shares_contents_with( a_to.as_node() );
+                    if( a_from.is_array() && a_to.is_array() ) return a_from.as_array().shares_contents_with( a_to.as_array() );
+                    return false;
+                }
+
+                // doubles are compared bit-for-bit, as in typed arrays, so that a NaN is the same as itself
+                static bool same_values( const param_value& a_from, const param_value& a_to )
+                {
+                    if( a_from.is_double() && a_to.is_double() )
+                    {
+                        double t_from = a_from.as_double();
+                        double t_to = a_to.as_double();
+                        return std::memcmp( &t_from, &t_to, sizeof( double ) ) == 0;
+                    }
+                    return a_from == a_to;
+                }
+
+                template< typename XElement >
+                static bool same_elements( const param_typed_array_base& a_from, const param_typed_array_base& a_to )
+                {
+                    const param_typed_array< XElement >& t_from = a_from.as< XElement >();
+                    const param_typed_array< XElement >& t_to = a_to.as< XElement >();
+                    if( t_from.shares_contents_with( t_to ) ) return true;
+                    // compared bit-for-bit, so that NaNs compare equal and signed zeros don't
+                    return t_from.size() == t_to.size() &&
+                            ( t_from.size() == 0 || std::memcmp( t_from.data(), t_to.data(), t_from.size() * sizeof( XElement ) ) == 0 );
+                }
+
+                static bool same_typed_arrays( const param_typed_array_base& a_from, const param_typed_array_base& a_to )
+                {
+                    if( a_from.get_element_type() != a_to.get_element_type() ) return false;
+                    switch( a_from.get_element_type() )
+                    {
+                        case param_typed_array_base::k_double:
+                            return same_elements< double >( a_from, a_to );
+                        case param_typed_array_base::k_int64:
+                            return same_elements< std::int64_t >( a_from, a_to );
+                        case param_typed_array_base::k_uint64:
+                            return same_elements< std::uint64_t >( a_from, a_to );
+                    }
+                    return false;
+                }
+
+                std::size_t add_frame( std::size_t a_parent, const param* a_from, const param* a_to, std::string_view a_name )
+                {
+                    f_frames.push_back( diff_frame{ a_from, a_to, a_parent, std::string( a_name ), 0, false } );
+                    return f_frames.size() - 1;
+                }
+
+                std::size_t add_frame( std::size_t a_parent, const param* a_from, const param* a_to, unsigned an_index )
+                {
+                    f_frames.push_back( diff_frame{ a_from, a_to, a_parent, std::string(), an_index, true } );
+                    return f_frames.size() - 1;
+                }
+
+                void add_op( const char* an_op, std::size_t a_frame, const param* a_value )
+                {
+                    // the steps from a_frame back to the root, in reverse
+                    std::vector< std::size_t > t_frames;
+                    for( std::size_t t_frame = a_frame; f_frames[t_frame].f_parent != s_no_parent; t_frame = f_frames[t_frame].f_parent )
+                    {
+                        t_frames.push_back( t_frame );
+                    }
+                    param_array t_path;
+                    for( auto t_it = t_frames.rbegin(); t_it != t_frames.rend(); ++t_it )
+                    {
+                        const diff_frame& t_step = f_frames[*t_it];
+                        if( t_step.f_is_index ) t_path.push_back( t_step.f_index );
+                        else t_path.push_back( param_ptr_t( new param_value( t_step.f_name ) ) );
+                    }
+
+                    param_node t_op;
+                    t_op.add( "op", an_op );
+                    t_op.add( "path", std::move(t_path) );
+                    if( a_value != nullptr ) t_op.insert_or_assign( "value", a_value->clone() );
+                    f_patch.push_back( std::move(t_op) );
+                    return;
+                }
+
+                std::vector< diff_frame > f_frames;
+                param_array f_patch;
+        };
+
+        // A step of a patch path, as a name for nodes or an index for arrays
+        std::string step_name( const param& a_step )
+        {
+            if( ! a_step.is_value() || ! ( a_step.as_value().is_string() || a_step.as_value().is_uint() ) )
+            {
+                throw error() << "Patch path steps must be strings or unsigned integers; found <" << a_step << ">";
+            }
+            return a_step.as_value().as_string();
+        }
+
+        unsigned step_index( const param& a_step )
+        {
+            if( ! a_step.is_value() || ! a_step.as_value().is_uint() )
+            {
+                throw error() << "Patch path step <" << a_step << "> reached an array, but is not an index";
+            }
+            return a_step.as_value().as_uint();
+        }
+
+        // Replaces the root of a patch target in place; a_value must be the same kind of param
+        void replace_root( param& a_target, const param& a_value )
+        {
+            if( a_target.is_node() && a_value.is_node() ) a_target.as_node() = a_value.as_node();
+            else if( a_target.is_array() && a_value.is_array() ) a_target.as_array() = a_value.as_array();
+            else if( a_target.is_value() && a_value.is_value() ) a_target.as_value() = a_value.as_value();
+            else if( a_target.is_typed_array() && a_value.is_typed_array() &&
+                     a_target.as_typed_array().get_element_type() == a_value.as_typed_array().get_element_type() )
+            {
+                a_target.as_typed_array().merge( a_value.as_typed_array() );
+            }
+            else
+            {
+                throw error() << "Patch cannot replace the root in place with a different kind of param";
+            }
+            return;
+        }
+
+        // Applies an operation to the item at a_path[a_step], which is in a_parent.
+        // The containers on the path are only changed through their mutating functions:
+        // the child on the path is taken out of its parent, patched, and put back (even if the patch fails),
+        // so no references to the items are handed out, and contents that aren't changed stay shared with any copies (see shared_contents).
+        void apply_at( param& a_parent, const param_array& a_path, unsigned a_step, const std::string& an_op, const param* a_value )
+        {
+            const param& t_step = a_path[a_step];
+            const bool t_is_last = a_step + 1 == a_path.size();
+            if( a_parent.is_node() )
+            {
+                param_node& t_node = a_parent.as_node();
+                std::string t_name = step_name( t_step );
+                if( t_is_last )
+                {
+                    if( an_op != "add" && ! t_node.has( t_name ) )
+                    {
+                        throw error() << "Patch operation <" << an_op << "> on missing item <" << t_name << ">";
+                    }
+                    if( a_value == nullptr ) t_node.erase( t_name );
+                    else t_node.insert_or_assign( t_name, a_value->clone() );
+                    return;
+                }
+                if( ! t_node.has( t_name ) ) throw error() << "Patch path step <" << t_name << "> is not in the node";
+                param_ptr_t t_child = t_node.remove( t_name );
+                try
+                {
+                    apply_at( *t_child, a_path, a_step + 1, an_op, a_value );
+                }
+                catch( ... )
+                {
+                    t_node.insert_or_assign( t_name, std::move(t_child) );
+                    throw;
+                }
+                t_node.insert_or_assign( t_name, std::move(t_child) );
+            }
+            else if( a_parent.is_array() )
+            {
+                param_array& t_array = a_parent.as_array();
+                unsigned t_index = step_index( t_step );
+                if( t_is_last )
+                {
+                    if( an_op == "add" ) t_array.insert( t_index, a_value->clone() );
+                    else if( t_index >= t_array.size() ) throw error() << "Patch operation <" << an_op << "> on missing index <" << t_index << ">";
+                    else if( a_value == nullptr ) t_array.remove_element( t_index );
+                    else t_array.assign( t_index, a_value->clone() );
+                    return;
+                }
+                if( t_index >= t_array.size() ) throw error() << "Patch path step <" << t_index << "> is past the end of the array";
+                param_ptr_t t_child = t_array.remove( t_index );
+                try
+                {
+                    apply_at( *t_child, a_path, a_step + 1, an_op, a_value );
+                }
+                catch( ... )
+                {
+                    t_array.assign( t_index, std::move(t_child) );
+                    throw;
+                }
+                t_array.assign( t_index, std::move(t_child) );
+            }
+            else
+            {
+                throw error() << "Patch path step <" << t_step << "> did not follow a node or array";
+            }
+            return;
+        }
+
+        void apply_op( param& a_target, const param& an_op )
+        {
+            if( ! an_op.is_node() || ! an_op.as_node().has( "op" ) || ! an_op.as_node().has( "path" ) || ! an_op["path"].is_array() )
+            {
+                throw error() << "Patch operations must be nodes with \"op\" and \"path\" (an array); found <" << an_op << ">";
+            }
+            const param_node& t_op_node = an_op.as_node();
+            const std::string t_op = t_op_node.get_value( "op", "" );
+            const param_array& t_path = t_op_node["path"].as_array();
+
+            const param* t_value = nullptr;
+            if( t_op == "add" || t_op == "replace" )
+            {
+                if( ! t_op_node.has( "value" ) ) throw error() << "Patch operation <" << t_op << "> needs a \"value\"";
+                t_value = &t_op_node["value"];
+            }
+            else if( t_op != "remove" )
+            {
+                throw error() << "Unknown patch operation <" << t_op << ">";
+            }
+
+            if( t_path.empty() )
+            {
+                if( t_value == nullptr ) throw error() << "Patch cannot remove the root";
+                replace_root( a_target, *t_value );
+                return;
+            }
+
+            apply_at( a_target, t_path, 0, t_op, t_value );
+            return;
+        }
+    }
+
+    param_array param_diff( const param& a_from, const param& a_to )
+    {
+        return differ().run( a_from, a_to );
+    }
+
+    void apply_patch( param& a_target, const param_array& a_patch )
+    {
+        for( const param& t_op : a_patch )
+        {
+            apply_op( a_target, t_op );
+        }
+        return;
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,64 @@
+/*
+ * param_diff.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_DIFF_HH_
+#define SCARAB_PARAM_DIFF_HH_
+
+#include "param_array.hh"
+
+namespace scarab
+{
+    /*!
+     @brief Creates a patch that turns a_from into a_to
+
+     @details
+     The patch is a param_array of operations, in the spirit of JSON Patch (RFC 6902), to be applied in order by apply_patch().
+     Each operation is a param_node:
+       - "op": "add", "remove", or "replace"
+       - "path": a param_array of steps from the root: strings are names in nodes, and unsigned integers are indices in arrays.
+         An empty path refers to the root.  An unsigned-integer step that reaches a node is used as a name,
+         so paths can be read back by codecs that type names like "3" as numbers.
+       - "value": the new param, for "add" and "replace"
+
+     Since the patch is an ordinary param structure, it can be written and read with any codec (codecs that can't represent
+     every param structure, e.g. YAML for empty nodes and arrays, have the same limitations for patches).
+
+     The patch is minimal at the level of items: names that are only in one of the nodes are added or removed,
+     items of arrays of different sizes are added or removed at the end, values that differ are replaced,
+     and a param whose type changes, or a typed array whose elements differ, is replaced as a whole.
+     Doubles are compared bit-for-bit, in values as in typed arrays, so a NaN is unchanged if it's in both, and 0. and -0. differ.
+
+     Nodes, arrays, and typed arrays whose contents are shared between a_from and a_to (see param_node::shares_contents_with())
+     are identical, so they're skipped without being compared.  When a_to is a modified copy of a_from,
+     everything that wasn't modified is still shared, so the time taken depends on the size of the change
+     (and the number of items in the nodes and arrays that contain it) rather than on the size of the tree.
+     Trees that were built separately are compared item by item.
+    */
+    SCARAB_API param_array param_diff( const param& a_from, const param& a_to );
+
+    /*!
+     @brief Applies a patch made by param_diff() to a_target, in place
+
+     @details
+     Operations are applied in order:
+       - "add" places the value at the path: under the name in a node (replacing any existing item),
+         or before the index in an array (an index equal to the array's size appends);
+       - "remove" removes the item at the path, which must be present (later array elements move down);
+       - "replace" replaces the item at the path, which must be present.
+     With an empty path, "add" and "replace" replace a_target itself, which must be of the same kind as the value (node, array, value, or typed array).
+
+     Only the nodes and arrays on the path of each operation are modified, and no references to their items are handed out,
+     so a patched copy of a tree still shares everything else with the original (see shared_contents).
+
+     Throws a scarab::error if an operation is malformed or its path can't be followed;
+     the operations before it will have been applied.
+    */
+    SCARAB_API void apply_patch( param& a_target, const param_array& a_patch );
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_DIFF_HH_ */
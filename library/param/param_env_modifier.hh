@@ -23,6 +23,9 @@ namespace scarab
      @details
      This class uses a param_value visitor to modify string values in particular.  
      The value visitor will replace all environment variable substitutions requested in a string.
+
+     Arrays and nodes are handled by param_modifier's defaults, so the traversal is iterative;
+     for large structures it can be run in parallel with param_traversal::modify().
     */
     class SCARAB_API param_env_modifier : public param_modifier
     {
@@ -16,6 +16,11 @@ namespace scarab
     class param_value;
     class param_array;
     class param_node;
+    class param_arena;
+    class param_snapshot;
+    class param_typed_array_base;
+    template< typename XElement >
+    class param_typed_array;
 
     typedef std::unique_ptr< param > param_ptr_t;
 
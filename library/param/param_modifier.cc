@@ -10,6 +10,7 @@
 #include "param_modifier.hh"
 
 #include "param.hh"
+#include "param_traversal.hh"
 
 #include "logger.hh"
 
@@ -30,19 +31,19 @@ namespace scarab
 
         void param_modifier::operator()( param_array& an_array ) const
         {
-            for( auto& it: an_array )
-            {
-                it.accept( *this );
-            }
+            // within a traversal, the traversal descends into the array; otherwise start one here
+            if( param_traversal::defer_descent( an_array ) ) return;
+            param_traversal().modify_elements( an_array, *this );
+            leave( an_array );
             return;
         }
 
         void param_modifier::operator()( param_node& a_node ) const
         {
-            for( auto& it: a_node )
-            {
-                it.accept( *this );
-            }
+            if( param_traversal::defer_descent( a_node ) ) return;
+            param_traversal().modify_elements( a_node, *this );
+            leave( a_node );
+            return;
         }
 
         void param_modifier::operator()( param_value& ) const
@@ -50,6 +51,16 @@ namespace scarab
             return;
         }
 
+        void param_modifier::leave( param_array& ) const
+        {
+            return;
+        }
+
+        void param_modifier::leave( param_node& ) const
+        {
+            return;
+        }
+
 
         param_modifier_callback::param_modifier_callback() :
                 param_modifier(),
@@ -58,17 +69,11 @@ namespace scarab
                 }),
                 f_param_array_callback( [this](param_array& an_array) {
                     LDEBUG( plog, "param_array callback: " << an_array );
-                    for( auto& it: an_array )
-                    {
-                        it.accept( *this );
-                    }
+                    param_modifier::operator()( an_array );
                 }),
                 f_param_node_callback( [this](param_node& a_node) {
                     LDEBUG( plog, "param_node callback: " << a_node );
-                    for( auto& it: a_node )
-                    {
-                        it.accept( *this );
-                    }
+                    param_modifier::operator()( a_node );
                 }),
                 f_param_value_callback( [](param_value& a_value) {
                     LDEBUG( plog, "param_value callback: " << a_value );
@@ -31,6 +31,17 @@ namespace scarab
      Modifier functions are marked as const --- the most intuitive behavior is that the modifier functions 
      don't change the state of the modifier.  If such change is required (e.g. an internal counter needs 
      to change at each visit), that should be marked as a mutable member of the modifier.
+
+     The default operator()s for arrays and nodes descend into their elements.  They do that iteratively,
+     with a param_traversal, so a modifier that relies on them can handle structures of any depth.
+     Use param_traversal directly to modify in parallel.
+
+     The default operator()s only ask for the elements to be modified: within a traversal (which includes every container below the one that accept() was called on), they return
+     before the elements have been reached, so code in a derived operator() that follows the call to the base-class operator()
+     runs before the elements, not after them.  Work that has to follow the elements (closing a bracket, decrementing a depth
+     counter, combining the results from the elements) belongs in leave(), which is called for each array and node
+     once all of its elements (and everything below them) have been modified.  leave() is only called for the containers whose
+     elements were modified through the base-class operator().
     */
     class SCARAB_API param_modifier
     {
@@ -42,6 +53,10 @@ namespace scarab
             virtual void operator()( param_array& ) const;
             virtual void operator()( param_node& ) const;
             virtual void operator()( param_value& ) const;
+            /// Called after the elements of an array have been modified by the base-class operator(); does nothing by default
+            virtual void leave( param_array& ) const;
+            /// Called after the elements of a node have been modified by the base-class operator(); does nothing by default
+            virtual void leave( param_node& ) const;
     };
 
 
@@ -16,6 +16,7 @@ using std::stringstream;
 #include "param_array.hh"
 #include "param_base_impl.hh"
 #include "param_helpers_impl.hh"
+#include "param_snapshot.hh"
 
 #include "logger.hh"
 
@@ -24,6 +25,18 @@ LOGGER( dlog, "param_node" );
 namespace scarab
 {
 
+    param_node_contents clone_contents( const param_node_contents& a_contents )
+    {
+        param_node_contents t_clone;
+        t_clone.reserve( a_contents.size() );
+        for( param_node_contents::const_iterator it = a_contents.begin(); it != a_contents.end(); ++it )
+        {
+            t_clone.insert( param_node_contents::value_type( it->first, it->second ? it->second->clone() : param_ptr_t() ) );
+        }
+        return t_clone;
+    }
+
+
     param_node::param_node() :
             param(),
             f_contents()
@@ -31,24 +44,13 @@ namespace scarab
 
     param_node::param_node( const param_node& orig ) :
             param( orig ),
-            f_contents()
-    {
-        for( contents::const_iterator it = orig.f_contents.begin(); it != orig.f_contents.end(); ++it )
-        {
-            f_contents[it->first] = it->second->clone();
-        }
-    }
+            f_contents( orig.f_contents )
+    {}
 
     param_node::param_node( param_node&& orig ) :
             param( std::move(orig) ),
-            f_contents()
-    {
-        for( contents::const_iterator it = orig.f_contents.begin(); it != orig.f_contents.end(); ++it )
-        {
-            f_contents[it->first] = it->second->move_clone();
-        }
-        orig.clear();
-    }
+            f_contents( std::move(orig.f_contents) )
+    {}
 
     param_node::~param_node()
     {}
@@ -56,26 +58,24 @@ namespace scarab
     param_node& param_node::operator=( const param_node& rhs )
     {
         this->param::operator=( rhs );
-        clear();
-        for( contents::const_iterator it = rhs.f_contents.begin(); it != rhs.f_contents.end(); ++it )
-        {
-            f_contents[it->first] = it->second->clone();
-        }
+        f_contents = rhs.f_contents;
         return *this;
     }
 
     param_node& param_node::operator=( param_node&& rhs )
     {
         this->param::operator=( std::move(rhs) );
-        clear();
-        for( contents::const_iterator it = rhs.f_contents.begin(); it != rhs.f_contents.end(); ++it )
-        {
-            f_contents[it->first] = it->second->move_clone();
-        }
-        rhs.clear();
+        f_contents = std::move(rhs.f_contents);
         return *this;
     }
 
+    param_node param_node::deferred( shared_contents< contents >::builder a_build )
+    {
+        param_node t_node;
+        t_node.f_contents = shared_contents< contents >::deferred( std::move(a_build) );
+        return t_node;
+    }
+
     param_ptr_t param_node::clone() const
     {
         //std::cout << "param_node::clone" << std::endl;
@@ -101,11 +101,13 @@ namespace scarab
     {
         if( ! a_subset.is_node() ) return false;
         const param_node& t_subset_node = a_subset.as_node();
-        if( t_subset_node.size() > f_contents.size() ) return false;
-        for( contents::const_iterator t_subset_it = t_subset_node.f_contents.begin(); t_subset_it != t_subset_node.f_contents.end(); ++t_subset_it )
+        if( t_subset_node.size() > size() ) return false;
+        const contents& t_contents = f_contents.get();
+        for( contents::const_iterator t_subset_it = t_subset_node.f_contents.get().begin(); t_subset_it != t_subset_node.f_contents.get().end(); ++t_subset_it )
         {
-            if( ! has( t_subset_it->first ) ) return false;
-            if( ! f_contents.at( t_subset_it->first )->has_subset( *t_subset_it->second ) ) return false;
+            contents::const_iterator t_it = t_contents.find( t_subset_it->first );
+            if( t_it == t_contents.end() ) return false;
+            if( ! t_it->second->has_subset( *t_subset_it->second ) ) return false;
         }
         return true;
     }
@@ -113,16 +115,21 @@ namespace scarab
     void param_node::merge( const param_node& a_object )
     {
         //LDEBUG( dlog, "merging object with " << a_object.size() << " items:\n" << a_object );
-        for( contents::const_iterator it = a_object.f_contents.begin(); it != a_object.f_contents.end(); ++it )
+        if( a_object.empty() ) return;
+
+        // items that are shared with a_object are cloned cheaply, and items that aren't touched stay shared with other copies of this node
+        contents& t_contents = f_contents.mutate();
+        for( contents::const_iterator it = a_object.f_contents.get().begin(); it != a_object.f_contents.get().end(); ++it )
         {
-            if( ! has( it->first ) )
+            contents::iterator t_it = t_contents.find( it->first );
+            if( t_it == t_contents.end() )
             {
                 //LDEBUG( dlog, "do not have object <" << it->first << "> = <" << *it->second << "> (" << it->second->type() << ")" );
-                add( it->first, it->second->clone() );
+                t_contents.insert( contents_type( it->first, it->second->clone() ) );
                 continue;
             }
 
-            param& t_param = (*this)[ it->first ];
+            param& t_param = *t_it->second;
             if( t_param.is_value() && it->second->is_value() )
             {
                 //LDEBUG( dlog, "replacing the value of \"" << it->first << "\" <" << (*this)[it->first]() << "> with <" << *it->second << ">" );
@@ -143,10 +150,69 @@ namespace scarab
             }
 
             LDEBUG( dlog, "generic replace" );
-            this->replace( it->first, it->second->clone() );
+            t_it->second = it->second->clone();
         }
     }
 
+    void param_node::merge( param_node&& a_object )
+    {
+        if( &a_object == this || a_object.empty() ) return;
+
+        if( a_object.f_contents.is_shared() || a_object.f_contents.arena() != f_contents.arena() )
+        {
+            // taking the items would modify a_object's other sharers, or would mix arenas
+            merge( static_cast< const param_node& >( a_object ) );
+            a_object.clear();
+            return;
+        }
+
+        if( empty() )
+        {
+            f_contents = std::move(a_object.f_contents);
+            return;
+        }
+
+        // references into a_object's items may have been handed out, and those items are about to become ours
+        contents& t_contents = a_object.f_contents.is_leaked() ? f_contents.leak() : f_contents.mutate();
+        contents& t_incoming = a_object.f_contents.mutate();
+        for( contents::iterator it = t_incoming.begin(); it != t_incoming.end(); ++it )
+        {
+            contents::iterator t_it = t_contents.find( it->first );
+            if( t_it == t_contents.end() )
+            {
+                t_contents.insert( contents_type( std::move(it->first), std::move(it->second) ) );
+                continue;
+            }
+
+            param& t_param = *t_it->second;
+            if( t_param.is_value() && it->second->is_value() )
+            {
+                t_param.as_value() = std::move(it->second->as_value());
+                continue;
+            }
+            if( t_param.is_node() && it->second->is_node() )
+            {
+                t_param.as_node().merge( std::move(it->second->as_node()) );
+                continue;
+            }
+            if( t_param.is_array() && it->second->is_array() )
+            {
+                t_param.as_array().merge( std::move(it->second->as_array()) );
+                continue;
+            }
+
+            LDEBUG( dlog, "generic replace" );
+            t_it->second = std::move(it->second);
+        }
+        a_object.clear();
+        return;
+    }
+
+    param_snapshot param_node::freeze() const
+    {
+        return param_snapshot( *this );
+    }
+
     std::string param_node::to_string() const
     {
         stringstream out;
@@ -155,7 +221,7 @@ namespace scarab
             indentation += "    ";
         out << '\n' << indentation << "{\n";
         param::s_indent_level++;
-        for( contents::const_iterator it = f_contents.begin(); it != f_contents.end(); ++it )
+        for( contents::const_iterator it = f_contents.get().begin(); it != f_contents.get().end(); ++it )
         {
             out << indentation << "    " << it->first << " : " << *(it->second) << '\n';
         }
@@ -10,6 +10,7 @@
 
 #include "param_helpers.hh"
 #include "param_modifier.hh"
+#include "param_shared_contents.hh"
 #include "param_value.hh"
 #include "param_visitor.hh"
 
@@ -19,8 +20,11 @@
 #include <boost/type_traits/is_convertible.hpp>
 #include <boost/utility/enable_if.hpp>
 
+#include <algorithm>
 #include <initializer_list>
-#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <iostream>
 
@@ -73,7 +77,127 @@ namespace scarab
 
     };
 
-    typedef std::map< std::string, std::unique_ptr< param > > param_node_contents;
+    /*!
+     @class param_node_contents
+     @author agent
+
+     @brief Sorted flat storage for the items in a param_node
+
+     @details
+     Items are kept in a contiguous vector sorted by name, so a lookup is a binary search over contiguous memory
+     instead of a walk through the nodes of a tree.  Iteration is in name order, as it was when the contents were a std::map.
+
+     Lookups take std::string_view, so string literals and substrings can be used as keys without creating a temporary std::string.
+
+     Inserting an item whose name sorts after all of the existing names (e.g. when copying another node) is amortized O(1);
+     inserting anywhere else is O(N).  Note that, unlike std::map, inserting or erasing items invalidates iterators.
+    */
+    class param_node_contents
+    {
+        public:
+            typedef std::pair< std::string, std::unique_ptr< param > > value_type;
+            typedef std::vector< value_type > storage;
+            typedef storage::iterator iterator;
+            typedef storage::const_iterator const_iterator;
+            typedef storage::size_type size_type;
+
+            iterator begin() { return f_storage.begin(); }
+            const_iterator begin() const { return f_storage.begin(); }
+            const_iterator cbegin() const { return f_storage.cbegin(); }
+            iterator end() { return f_storage.end(); }
+            const_iterator end() const { return f_storage.end(); }
+            const_iterator cend() const { return f_storage.cend(); }
+
+            size_type size() const { return f_storage.size(); }
+            bool empty() const { return f_storage.empty(); }
+            void clear() { f_storage.clear(); }
+            void reserve( size_type a_size ) { f_storage.reserve( a_size ); }
+
+            iterator find( std::string_view a_name );
+            const_iterator find( std::string_view a_name ) const;
+            size_type count( std::string_view a_name ) const;
+
+            /// Returns the pointer stored under a_name; if a_name isn't present, an empty pointer is inserted first
+            std::unique_ptr< param >& operator[]( std::string_view a_name );
+
+            /// Inserts a_value if its name isn't present.
+            /// Returns the position of the item with that name, and whether the insertion took place.
+            std::pair< iterator, bool > insert( value_type&& a_value );
+
+            iterator erase( const_iterator a_it );
+            size_type erase( std::string_view a_name );
+
+        private:
+            iterator lower_bound( std::string_view a_name );
+            const_iterator lower_bound( std::string_view a_name ) const;
+
+            storage f_storage;
+    };
+
+    inline param_node_contents::iterator param_node_contents::lower_bound( std::string_view a_name )
+    {
+        // fast path for names added in order
+        if( f_storage.empty() || std::string_view( f_storage.back().first ) < a_name ) return f_storage.end();
+        return std::lower_bound( f_storage.begin(), f_storage.end(), a_name,
+                [](const value_type& a_item, std::string_view a_name){ return std::string_view( a_item.first ) < a_name; } );
+    }
+
+    inline param_node_contents::const_iterator param_node_contents::lower_bound( std::string_view a_name ) const
+    {
+        if( f_storage.empty() || std::string_view( f_storage.back().first ) < a_name ) return f_storage.end();
+        return std::lower_bound( f_storage.begin(), f_storage.end(), a_name,
+                [](const value_type& a_item, std::string_view a_name){ return std::string_view( a_item.first ) < a_name; } );
+    }
+
+    inline param_node_contents::iterator param_node_contents::find( std::string_view a_name )
+    {
+        iterator t_it = lower_bound( a_name );
+        return t_it != f_storage.end() && t_it->first == a_name ? t_it : f_storage.end();
+    }
+
+    inline param_node_contents::const_iterator param_node_contents::find( std::string_view a_name ) const
+    {
+        const_iterator t_it = lower_bound( a_name );
+        return t_it != f_storage.end() && t_it->first == a_name ? t_it : f_storage.end();
+    }
+
+    inline param_node_contents::size_type param_node_contents::count( std::string_view a_name ) const
+    {
+        return find( a_name ) != f_storage.end() ? 1 : 0;
+    }
+
+    inline std::unique_ptr< param >& param_node_contents::operator[]( std::string_view a_name )
+    {
+        iterator t_it = lower_bound( a_name );
+        if( t_it == f_storage.end() || t_it->first != a_name )
+        {
+            t_it = f_storage.emplace( t_it, std::string( a_name ), std::unique_ptr< param >() );
+        }
+        return t_it->second;
+    }
+
+    inline std::pair< param_node_contents::iterator, bool > param_node_contents::insert( value_type&& a_value )
+    {
+        iterator t_it = lower_bound( a_value.first );
+        if( t_it != f_storage.end() && t_it->first == a_value.first ) return std::make_pair( t_it, false );
+        return std::make_pair( f_storage.insert( t_it, std::move(a_value) ), true );
+    }
+
+    inline param_node_contents::iterator param_node_contents::erase( const_iterator a_it )
+    {
+        return f_storage.erase( a_it );
+    }
+
+    inline param_node_contents::size_type param_node_contents::erase( std::string_view a_name )
+    {
+        iterator t_it = find( a_name );
+        if( t_it == f_storage.end() ) return 0;
+        f_storage.erase( t_it );
+        return 1;
+    }
+
+    /// Clones the items in a_contents (used by shared_contents)
+    SCARAB_API param_node_contents clone_contents( const param_node_contents& a_contents );
 
     typedef map_deref_iterator< std::string, param, param_node_contents::iterator > param_node_iterator;
     typedef map_deref_iterator< std::string, const param, param_node_contents::const_iterator > param_node_const_iterator;
@@ -85,6 +209,9 @@ namespace scarab
      @brief Dictionary/map-like param structure
 
      @details
+     The contents of a node are shared with its copies until one of them is modified (see shared_contents),
+     so copying a node, or a tree of nodes and arrays, is O(1).
+     Modifying a node may invalidate references and iterators previously obtained from it, as with other containers.
     */
     class SCARAB_API param_node : public param
     {
@@ -104,6 +231,10 @@ namespace scarab
             param_node& operator=( const param_node& rhs );
             param_node& operator=( param_node&& rhs );
 
+            /// Creates a node whose items are made by a_build the first time the node is accessed (see shared_contents::deferred());
+            /// codecs use this to read a document lazily, one node at a time
+            static param_node deferred( shared_contents< contents >::builder a_build );
+
             virtual param_ptr_t clone() const;
             virtual param_ptr_t move_clone();
 
@@ -118,33 +249,42 @@ namespace scarab
             unsigned size() const;
             bool empty() const;
 
-            bool has( const std::string& a_name ) const;
-            unsigned count( const std::string& a_name ) const;
+            /// Returns true if the contents of this node are currently shared with a copy
+            bool is_shared() const;
+            /// Returns true if this node and a_other share their contents, in which case their items are identical
+            bool shares_contents_with( const param_node& a_other ) const;
+            /// Returns a number that changes whenever items may have been added to, removed from, or replaced in this node
+            std::uint64_t revision() const;
+            /// Returns true if this node's items are deferred and haven't been made yet
+            bool is_deferred() const;
+
+            bool has( std::string_view a_name ) const;
+            unsigned count( std::string_view a_name ) const;
 
             /// Returns the result of param_value::get if a_name is present and is of type param_value
             /// Returns a_default if a_name is not present or is not of type param_value
-            std::string get_value( const std::string& a_name, const std::string& a_default ) const;
-            std::string get_value( const std::string& a_name, const char* a_default ) const;
+            std::string get_value( std::string_view a_name, const std::string& a_default ) const;
+            std::string get_value( std::string_view a_name, const char* a_default ) const;
             /// Returns the result of param_value::get if a_name is present and is of type param_value
             /// Returns a_default if a_name is not present or is not of type param_value
             template< typename XValType >
-            XValType get_value( const std::string& a_name, XValType a_default ) const;
+            XValType get_value( std::string_view a_name, XValType a_default ) const;
 
             /// Returns a reference to the param corresponding to a_name.
             /// Throws an scarab::error if a_name is not present.
-            const param& at( const std::string& a_name ) const;
+            const param& at( std::string_view a_name ) const;
             /// Returns a reference to the param corresponding to a_name.
-            /// Throws an std::out_of_range if a_name is not present.
-            param& at( const std::string& a_name );
+            /// Throws an scarab::error if a_name is not present.
+            param& at( std::string_view a_name );
 
             /// Returns a reference to the param corresponding to a_name.
             /// Throws an scarab::error if a_name is not present.
             /// Note that this behavior differs from the C++ STL map-like container behavior
-            const param& operator[]( const std::string& a_name ) const;
+            const param& operator[]( std::string_view a_name ) const;
             /// Returns a reference to the param corresponding to a_name.
             /// Throws an scarab::error if a_name is not present.
             /// Note that this behavior differs from the C++ STL map-like container behavior
-            param& operator[]( const std::string& a_name );
+            param& operator[]( std::string_view a_name );
 
             /// Adds an item or items to the node if items with the given names aren't already present.
             /// Any items whose names are not present in the node are added; if a name is present, the corresponding item is not added.
@@ -170,11 +310,23 @@ namespace scarab
             /// If names in the contents of a_object exist in this object,
             /// the values in this object corresponding to the matching names will be replaced.
             void merge( const param_node& a_object );
-
-            void erase( const std::string& a_name );
-            param_ptr_t remove( const std::string& a_name );
+            /// Merges the contents of a_object into this object, moving its items instead of cloning them; a_object is left empty.
+            /// If a_object's contents are shared, or were created in a different param_arena, the items are cloned as in the const version.
+            void merge( param_node&& a_object );
+
+            void erase( std::string_view a_name );
+            param_ptr_t remove( std::string_view a_name );
+            /// Places a_param in the node under a_name, replacing any item already present.
+            /// Unlike replace(), a_param itself is stored rather than a clone of it.
+            void insert_or_assign( std::string_view a_name, param_ptr_t a_param );
             void clear();
 
+            /// Returns an iterator to the item corresponding to a_name, or end() if a_name is not present
+            const_iterator find( std::string_view a_name ) const;
+
+            /// Creates an immutable, compact copy of this node, which can be read on any number of threads without locking
+            param_snapshot freeze() const;
+
             iterator begin();
             const_iterator begin() const;
 
@@ -187,7 +339,7 @@ namespace scarab
             bool add(); // end the parameter pack recursion
             void replace(); // end the parameter pack recursion
 
-            contents f_contents;
+            shared_contents< contents > f_contents;
 
     };
 
@@ -199,18 +351,39 @@ namespace scarab
     }
 
     template< typename XValType >
-    inline XValType param_node::get_value( const std::string& a_name, XValType a_default ) const
+    inline XValType param_node::get_value( std::string_view a_name, XValType a_default ) const
     {
-        return has( a_name ) ? operator[]( a_name ).as_value().as< XValType >() : a_default;
+        contents::const_iterator it = f_contents.get().find( a_name );
+        return it != f_contents.get().end() ? it->second->as_value().as< XValType >() : a_default;
     }
 
     inline unsigned param_node::size() const
     {
-        return f_contents.size();
+        return f_contents.get().size();
     }
     inline bool param_node::empty() const
     {
-        return f_contents.empty();
+        return f_contents.get().empty();
+    }
+
+    inline bool param_node::is_shared() const
+    {
+        return f_contents.is_shared();
+    }
+
+    inline bool param_node::is_deferred() const
+    {
+        return f_contents.is_deferred();
+    }
+
+    inline bool param_node::shares_contents_with( const param_node& a_other ) const
+    {
+        return f_contents.shares_with( a_other.f_contents );
+    }
+
+    inline std::uint64_t param_node::revision() const
+    {
+        return f_contents.revision();
     }
 
     inline void param_node::accept( const param_modifier& a_modifier )
@@ -225,56 +398,54 @@ namespace scarab
         return;
     }
 
-    inline bool param_node::has( const std::string& a_name ) const
+    inline bool param_node::has( std::string_view a_name ) const
     {
-        return f_contents.count( a_name ) > 0;
+        return f_contents.get().find( a_name ) != f_contents.get().end();
     }
 
-    inline unsigned param_node::count( const std::string& a_name ) const
+    inline unsigned param_node::count( std::string_view a_name ) const
     {
-        return f_contents.count( a_name );
+        return f_contents.get().count( a_name );
     }
 
-    inline std::string param_node::get_value( const std::string& a_name, const std::string& a_default ) const
+    inline std::string param_node::get_value( std::string_view a_name, const std::string& a_default ) const
     {
-        return has( a_name ) ? at( a_name ).to_string() : a_default;
+        contents::const_iterator it = f_contents.get().find( a_name );
+        return it != f_contents.get().end() ? it->second->to_string() : a_default;
     }
 
-    inline std::string param_node::get_value( const std::string& a_name, const char* a_default ) const
+    inline std::string param_node::get_value( std::string_view a_name, const char* a_default ) const
     {
         return get_value( a_name, std::string( a_default ) );
     }
 
-    inline const param& param_node::at( const std::string& a_name ) const
+    inline const param& param_node::at( std::string_view a_name ) const
     {
-        try
-        {
-            return *f_contents.at( a_name );
-        }
-        catch( const std::out_of_range& )
+        contents::const_iterator it = f_contents.get().find( a_name );
+        if( it == f_contents.get().end() )
         {
             throw error( __FILE__, __LINE__ ) << "Param node does not have item with key <" << a_name << ">";
         }
+        return *it->second;
     }
 
-    inline param& param_node::at( const std::string& a_name )
+    inline param& param_node::at( std::string_view a_name )
     {
-        try
-        {
-            return *f_contents.at( a_name );
-        }
-        catch( const std::out_of_range& )
+        contents& t_contents = f_contents.leak();
+        contents::iterator it = t_contents.find( a_name );
+        if( it == t_contents.end() )
         {
             throw error( __FILE__, __LINE__ ) << "Param node does not have item with key <" << a_name << ">";
         }
+        return *it->second;
     }
 
-    inline const param& param_node::operator[]( const std::string& a_name ) const
+    inline const param& param_node::operator[]( std::string_view a_name ) const
     {
         return at( a_name );
     }
 
-    inline param& param_node::operator[]( const std::string& a_name )
+    inline param& param_node::operator[]( std::string_view a_name )
     {
         return at( a_name );
     }
@@ -295,11 +466,10 @@ namespace scarab
     bool param_node::add( const kwarg& arg0, const MoreArgs&... args )
     {
         bool ret = false;
-        contents::iterator it = f_contents.find( arg0.name() );
-        if( it == f_contents.end() )
+        if( ! has( arg0.name() ) )
         {
             ret = true;
-            f_contents.insert( contents_type( arg0.name(), param_ptr_t(arg0.value()->clone()) ) );
+            f_contents.mutate().insert( contents_type( arg0.name(), param_ptr_t(arg0.value()->clone()) ) );
         }
         return ret && add( args... );
     }
@@ -326,59 +496,64 @@ namespace scarab
     template< typename... MoreArgs >
     void param_node::replace( const kwarg& arg0, const MoreArgs&... args )
     {
-        f_contents[ arg0.name() ] = param_ptr_t( arg0.value()->clone() );
+        f_contents.mutate()[ arg0.name() ] = param_ptr_t( arg0.value()->clone() );
         replace( args... );
     }
 
     inline void param_node::replace()
     {}
 
-    inline void param_node::erase( const std::string& a_name )
+    inline void param_node::erase( std::string_view a_name )
     {
-        contents::iterator it = f_contents.find( a_name );
-        if( it != f_contents.end() )
-        {
-            f_contents.erase( it );
-        }
+        if( has( a_name ) ) f_contents.mutate().erase( a_name );
         return;
     }
 
-    inline param_ptr_t param_node::remove( const std::string& a_name )
+    inline param_ptr_t param_node::remove( std::string_view a_name )
     {
-        contents::iterator it = f_contents.find( a_name );
-        if( it != f_contents.end() )
-        {
-            param_ptr_t removed( std::move( it->second ) );
-            f_contents.erase( it );
-            return removed;
-        }
-        return param_ptr_t();
+        if( ! has( a_name ) ) return param_ptr_t();
+        contents& t_contents = f_contents.mutate();
+        contents::iterator it = t_contents.find( a_name );
+        param_ptr_t removed( std::move( it->second ) );
+        t_contents.erase( it );
+        return removed;
+    }
+
+    inline void param_node::insert_or_assign( std::string_view a_name, param_ptr_t a_param )
+    {
+        f_contents.mutate()[ a_name ] = std::move( a_param );
+        return;
     }
 
     inline void param_node::clear()
     {
-        f_contents.clear();
+        f_contents.reset();
         return;
     }
 
     inline param_node::iterator param_node::begin()
     {
-        return iterator( f_contents.begin() );
+        return iterator( f_contents.leak().begin() );
+    }
+
+    inline param_node::const_iterator param_node::find( std::string_view a_name ) const
+    {
+        return const_iterator( f_contents.get().find( a_name ) );
     }
 
     inline param_node::const_iterator param_node::begin() const
     {
-        return const_iterator( f_contents.cbegin() );
+        return const_iterator( f_contents.get().cbegin() );
     }
 
     inline param_node::iterator param_node::end()
     {
-        return iterator( f_contents.end() );
+        return iterator( f_contents.leak().end() );
     }
 
     inline param_node::const_iterator param_node::end() const
     {
-        return const_iterator( f_contents.cend() );
+        return const_iterator( f_contents.get().cend() );
     }
 
     SCARAB_API std::ostream& operator<<(std::ostream& out, const param_node& value);
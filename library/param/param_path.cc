@@ -0,0 +1,178 @@
+/*
+ * param_path.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_path.hh"
+
+#include "param_base_impl.hh"
+#include "param_helpers.hh"
+
+#include "error.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace scarab
+{
+    param_path::param_path( std::string_view an_address ) :
+            f_address( an_address ),
+            f_steps()
+    {
+        if( an_address.empty() )
+        {
+            throw error() << "Cannot create a param_path from an empty address";
+        }
+
+        std::string_view::size_type t_begin = 0;
+        while( t_begin <= an_address.size() )
+        {
+            std::string_view::size_type t_end = an_address.find( simple_parser::f_node_separator, t_begin );
+            if( t_end == std::string_view::npos ) t_end = an_address.size();
+            std::string_view t_name = an_address.substr( t_begin, t_end - t_begin );
+            if( t_name.empty() )
+            {
+                throw error() << "Empty step in param_path address <" << f_address << ">";
+            }
+
+            // same rule as simple_parser: a name consisting only of digits is an array index
+            step t_step{ std::string( t_name ), 0, true };
+            t_step.f_is_index = std::all_of( t_name.begin(), t_name.end(), []( char a_char ){ return std::isdigit( static_cast< unsigned char >( a_char ) ) != 0; } );
+            if( t_step.f_is_index &&
+                std::from_chars( t_name.data(), t_name.data() + t_name.size(), t_step.f_index ).ec != std::errc() )
+            {
+                throw error() << "Array index <" << t_name << "> in param_path address <" << f_address << "> is too large";
+            }
+            f_steps.push_back( std::move(t_step) );
+
+            t_begin = t_end + 1;
+        }
+    }
+
+    const param* param_path::child( const param& a_parent, const step& a_step )
+    {
+        // the type has already been checked, so skip the check in as_node() and as_array()
+        if( a_parent.is_node() )
+        {
+            const param_node& t_node = static_cast< const param_node& >( a_parent );
+            param_node::const_iterator t_it = t_node.find( a_step.f_name );
+            return t_it == t_node.end() ? nullptr : &*t_it;
+        }
+        if( a_step.f_is_index && a_parent.is_array() )
+        {
+            const param_array& t_array = static_cast< const param_array& >( a_parent );
+            return a_step.f_index < t_array.size() ? &t_array[ a_step.f_index ] : nullptr;
+        }
+        return nullptr;
+    }
+
+    const param* param_path::find( const param& a_root ) const
+    {
+        const param* t_current = &a_root;
+        for( const step& t_step : f_steps )
+        {
+            t_current = child( *t_current, t_step );
+            if( t_current == nullptr ) return nullptr;
+        }
+        return t_current;
+    }
+
+    param* param_path::find( param& a_root ) const
+    {
+        // non-const access is used so that, if the tree is shared with a copy, it is detached along the path
+        param* t_current = &a_root;
+        for( const step& t_step : f_steps )
+        {
+            if( t_current->is_node() )
+            {
+                param_node& t_node = t_current->as_node();
+                if( ! t_node.has( t_step.f_name ) ) return nullptr;
+                t_current = &t_node[ t_step.f_name ];
+            }
+            else if( t_step.f_is_index && t_current->is_array() )
+            {
+                param_array& t_array = t_current->as_array();
+                if( t_step.f_index >= t_array.size() ) return nullptr;
+                t_current = &t_array[ t_step.f_index ];
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+        return t_current;
+    }
+
+    const param& param_path::resolve( const param& a_root ) const
+    {
+        const param* t_param = find( a_root );
+        if( t_param == nullptr )
+        {
+            throw error() << "No param found at address <" << f_address << ">";
+        }
+        return *t_param;
+    }
+
+    param& param_path::resolve( param& a_root ) const
+    {
+        param* t_param = find( a_root );
+        if( t_param == nullptr )
+        {
+            throw error() << "No param found at address <" << f_address << ">";
+        }
+        return *t_param;
+    }
+
+    param_path_handle param_path::bind( const param& a_root ) const
+    {
+        return param_path_handle( *this, a_root );
+    }
+
+
+    param_path_handle::param_path_handle( const param_path& a_path, const param& a_root ) :
+            f_path( a_path ),
+            f_root( &a_root ),
+            f_levels(),
+            f_target( nullptr )
+    {
+        f_levels.reserve( f_path.f_steps.size() );
+        update();
+    }
+
+    const param& param_path_handle::operator*()
+    {
+        const param* t_param = get();
+        if( t_param == nullptr )
+        {
+            throw error() << "No param found at address <" << f_path.address() << ">";
+        }
+        return *t_param;
+    }
+
+    void param_path_handle::update()
+    {
+        // record the revision of each node or array along the way, including the one where the lookup fails
+        f_levels.clear();
+        f_target = f_root;
+        for( const param_path::step& t_step : f_path.f_steps )
+        {
+            if( f_target->is_node() ) f_levels.push_back( level{ &f_target->as_node(), nullptr, f_target->as_node().revision() } );
+            else if( f_target->is_array() ) f_levels.push_back( level{ nullptr, &f_target->as_array(), f_target->as_array().revision() } );
+            else
+            {
+                f_target = nullptr;
+                return;
+            }
+
+            f_target = param_path::child( *f_target, t_step );
+            if( f_target == nullptr ) return;
+        }
+        return;
+    }
+
+} /* namespace scarab */
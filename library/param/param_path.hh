@@ -0,0 +1,180 @@
+/*
+ * param_path.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_PATH_HH_
+#define SCARAB_PARAM_PATH_HH_
+
+#include "param_array.hh"
+#include "param_node.hh"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scarab
+{
+    class param_path_handle;
+
+    /*!
+     @class param_path
+     @author agent
+
+     @brief An address in a param structure, compiled once for repeated lookups
+
+     @details
+     The address uses the same format as simple_parser::parse_address: names separated by '.',
+     where a name consisting only of digits is an array index (e.g. "a.b.3.c").
+     If a step that looks like an index is reached at a node, it's used as a name instead.
+
+     find() and resolve() walk the tree without parsing the address again.
+     For lookups that are repeated on the same tree, bind() returns a param_path_handle,
+     which caches the result and only walks the tree again if it has changed.
+    */
+    class SCARAB_API param_path
+    {
+        public:
+            /// Throws scarab::error if the address is empty or has an empty step (e.g. "a..b")
+            param_path( std::string_view an_address );
+            param_path( const param_path& ) = default;
+            param_path( param_path&& ) = default;
+            virtual ~param_path() = default;
+
+            param_path& operator=( const param_path& ) = default;
+            param_path& operator=( param_path&& ) = default;
+
+            const std::string& address() const;
+            /// Number of steps in the path
+            unsigned size() const;
+
+            /// Returns the param at this path in a_root, or nullptr if it is not present
+            const param* find( const param& a_root ) const;
+            /// Returns the param at this path in a_root, or nullptr if it is not present
+            param* find( param& a_root ) const;
+
+            /// Returns the param at this path in a_root; throws scarab::error if it is not present
+            const param& resolve( const param& a_root ) const;
+            /// Returns the param at this path in a_root; throws scarab::error if it is not present
+            param& resolve( param& a_root ) const;
+
+            /// Creates a handle that caches the lookup of this path in a_root; a_root must outlive the handle
+            param_path_handle bind( const param& a_root ) const;
+
+        private:
+            friend class param_path_handle;
+
+            struct step
+            {
+                std::string f_name;
+                unsigned f_index;
+                bool f_is_index;
+            };
+
+            /// Returns the child of a_parent for a_step, or nullptr if it is not present
+            static const param* child( const param& a_parent, const step& a_step );
+
+            std::string f_address;
+            std::vector< step > f_steps;
+    };
+
+    /*!
+     @class param_path_handle
+     @author agent
+
+     @brief Cached, read-only lookup of a param_path in a particular param structure
+
+     @details
+     The handle remembers the node or array at each step of the path and its revision (see param_node::revision()).
+     As long as none of them have had items added, removed, or replaced, get() returns the cached result after
+     comparing one number per step; otherwise it walks the tree again.
+     Modifying a value in place (e.g. assigning to a param_value) does not invalidate the handle.
+
+     The root passed to param_path::bind() must outlive the handle.
+    */
+    class SCARAB_API param_path_handle
+    {
+        public:
+            param_path_handle( const param_path& a_path, const param& a_root );
+            param_path_handle( const param_path_handle& ) = default;
+            param_path_handle( param_path_handle&& ) = default;
+            virtual ~param_path_handle() = default;
+
+            param_path_handle& operator=( const param_path_handle& ) = default;
+            param_path_handle& operator=( param_path_handle&& ) = default;
+
+            /// Returns the param at the path, or nullptr if it is not present
+            const param* get();
+            /// Returns the param at the path; throws scarab::error if it is not present
+            const param& operator*();
+            const param* operator->();
+
+            /// Returns true if the cached result can be used without walking the tree again
+            bool is_current() const;
+
+            const param_path& path() const;
+            const param& root() const;
+
+        private:
+            void update();
+
+            struct level
+            {
+                const param_node* f_node;
+                const param_array* f_array;
+                std::uint64_t f_revision;
+            };
+
+            param_path f_path;
+            const param* f_root;
+            std::vector< level > f_levels;
+            const param* f_target;
+    };
+
+    inline const std::string& param_path::address() const
+    {
+        return f_address;
+    }
+
+    inline unsigned param_path::size() const
+    {
+        return f_steps.size();
+    }
+
+    inline const param* param_path_handle::get()
+    {
+        if( ! is_current() ) update();
+        return f_target;
+    }
+
+    inline const param* param_path_handle::operator->()
+    {
+        return &**this;
+    }
+
+    inline bool param_path_handle::is_current() const
+    {
+        // the levels are checked from the root down, so a level is only looked at if its parent hasn't changed (and therefore still exists)
+        for( const level& t_level : f_levels )
+        {
+            if( t_level.f_revision != (t_level.f_node != nullptr ? t_level.f_node->revision() : t_level.f_array->revision()) ) return false;
+        }
+        return ! f_levels.empty();
+    }
+
+    inline const param_path& param_path_handle::path() const
+    {
+        return f_path;
+    }
+
+    inline const param& param_path_handle::root() const
+    {
+        return *f_root;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_PATH_HH_ */
@@ -0,0 +1,346 @@
+/*
+ * param_shared_contents.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_SHARED_CONTENTS_HH_
+#define SCARAB_PARAM_SHARED_CONTENTS_HH_
+
+#include "param_arena.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace scarab
+{
+    /*!
+     @class shared_contents
+     @author agent
+
+     @brief Copy-on-write handle for the contents of a param_node, param_array, or param_typed_array
+
+     @details
+     Copying a param_node or param_array shares its contents with the copy instead of cloning every item, so copying a tree is O(1).
+     The contents are cloned, one level at a time, only when one of the sharers is about to be modified,
+     so the memory used by a modified copy is proportional to what was changed.
+
+     Read access goes through get(), which never copies.
+     Modifications go through mutate(), which first makes the contents unique to this handle.
+     Functions that hand out non-const references or iterators to the items go through leak().
+     Since the handle can't know when those references are gone, leaked contents are never shared again,
+     and copies of them clone their items.  This is the same approach used by copy-on-write strings.
+
+     Contents are only shared between params created while the same param_arena (or no arena) is active,
+     so a heap-allocated copy of a tree never depends on the lifetime of an arena.
+
+     The reference counting is thread-safe, so copies of a tree can be handed to, and modified by, other threads.
+
+     Every call that can add, remove, or replace items (mutate(), reset(), assignment, and a leak() that has to clone)
+     gives the handle a new revision number, which is unique across all handles of the same type.
+     A pointer to an item obtained while the revision was unchanged is still valid; param_path uses this to revalidate cached lookups.
+
+     Contents can also be deferred (see deferred()): they're built by a function the first time they're accessed,
+     by get() as well as by mutate() and leak(), and the build happens once however many handles share them.
+     Copies of a deferred handle share the deferred contents, so lazily-read trees can be copied without building anything.
+     Deferred contents are always built on the heap, since they may be built long after the code that created them (and any arena) has finished.
+     Building the contents doesn't change the revision: the items are treated as having been there all along.
+
+     XContents must be default-constructible and have an empty() function,
+     and there must be a function `XContents clone_contents( const XContents& )` that clones the items.
+    */
+    template< typename XContents >
+    class shared_contents
+    {
+        public:
+            shared_contents();
+            shared_contents( const shared_contents& a_orig );
+            shared_contents( shared_contents&& a_orig );
+            ~shared_contents() = default;
+
+            shared_contents& operator=( const shared_contents& a_rhs );
+            shared_contents& operator=( shared_contents&& a_rhs );
+
+            typedef std::function< XContents () > builder;
+            /// Creates a handle whose contents are built by a_build (on the heap) the first time they're accessed
+            static shared_contents deferred( builder a_build );
+
+            /// Read-only access; never copies
+            const XContents& get() const;
+            /// Access for modifying the contents; clones the items first if the contents are shared
+            XContents& mutate();
+            /// Access for handing out non-const references to the items; after this the contents will not be shared
+            XContents& leak();
+
+            /// Replaces the contents with empty contents
+            void reset();
+
+            /// Returns true if the contents are currently shared with another handle
+            bool is_shared() const;
+            /// Returns true if this handle and a_other refer to the same contents (so the items are identical)
+            bool shares_with( const shared_contents& a_other ) const;
+            /// Returns true if non-const references to the items have been handed out
+            bool is_leaked() const;
+            /// Returns the arena that was active when the contents were created (nullptr for the heap)
+            param_arena* arena() const;
+            /// Returns the revision number, which changes whenever items may have been added, removed, or replaced
+            std::uint64_t revision() const;
+            /// Returns true if the contents are deferred and haven't been built yet
+            bool is_deferred() const;
+
+        private:
+            // contents that are built on first access; shared by the handles that were copied from the deferred handle
+            struct deferred_contents
+            {
+                deferred_contents( builder&& a_build );
+                const std::shared_ptr< XContents >& built();
+
+                builder f_build;
+                std::once_flag f_once;
+                std::atomic< bool > f_is_built;
+                std::shared_ptr< XContents > f_contents;
+            };
+
+            bool can_share() const;
+            /// Takes the built contents from f_deferred, so that this handle holds them directly
+            void resolve();
+            /// Clones the items if the contents are shared; returns true if they were cloned
+            bool detach();
+
+            static const std::shared_ptr< XContents >& empty_contents();
+            static std::uint64_t next_revision();
+
+            std::shared_ptr< XContents > f_contents;
+            std::shared_ptr< deferred_contents > f_deferred;
+            param_arena* f_arena;
+            bool f_leaked;
+            std::uint64_t f_revision;
+    };
+
+    template< typename XContents >
+    shared_contents< XContents >::deferred_contents::deferred_contents( builder&& a_build ) :
+            f_build( std::move(a_build) ),
+            f_once(),
+            f_is_built( false ),
+            f_contents()
+    {}
+
+    template< typename XContents >
+    const std::shared_ptr< XContents >& shared_contents< XContents >::deferred_contents::built()
+    {
+        std::call_once( f_once, [this]()
+        {
+            param_arena_scope t_heap( nullptr );
+            f_contents = std::make_shared< XContents >( f_build() );
+            // release whatever the builder holds (e.g. a parsed document) as soon as it's no longer needed
+            f_build = builder();
+            f_is_built.store( true, std::memory_order_release );
+        } );
+        return f_contents;
+    }
+
+    template< typename XContents >
+    shared_contents< XContents >::shared_contents() :
+            f_contents( empty_contents() ),
+            f_deferred(),
+            f_arena( param_arena::current() ),
+            f_leaked( false ),
+            f_revision( next_revision() )
+    {}
+
+    template< typename XContents >
+    shared_contents< XContents >::shared_contents( const shared_contents& a_orig ) :
+            f_contents(),
+            f_deferred(),
+            f_arena( param_arena::current() ),
+            f_leaked( false ),
+            f_revision( 0 )
+    {
+        *this = a_orig;
+    }
+
+    template< typename XContents >
+    shared_contents< XContents >::shared_contents( shared_contents&& a_orig ) :
+            f_contents( std::move(a_orig.f_contents) ),
+            f_deferred( std::move(a_orig.f_deferred) ),
+            f_arena( a_orig.f_arena ),
+            f_leaked( a_orig.f_leaked ),
+            f_revision( next_revision() )
+    {
+        a_orig.reset();
+    }
+
+    template< typename XContents >
+    shared_contents< XContents >& shared_contents< XContents >::operator=( const shared_contents& a_rhs )
+    {
+        if( &a_rhs == this ) return *this;
+
+        if( a_rhs.can_share() )
+        {
+            f_contents = a_rhs.f_contents;
+            f_deferred = a_rhs.f_deferred;
+            f_arena = a_rhs.f_arena;
+        }
+        else
+        {
+            f_contents = std::make_shared< XContents >( clone_contents( a_rhs.get() ) );
+            f_deferred.reset();
+            f_arena = param_arena::current();
+        }
+        f_leaked = false;
+        f_revision = next_revision();
+        return *this;
+    }
+
+    template< typename XContents >
+    shared_contents< XContents >& shared_contents< XContents >::operator=( shared_contents&& a_rhs )
+    {
+        if( &a_rhs == this ) return *this;
+
+        f_contents = std::move(a_rhs.f_contents);
+        f_deferred = std::move(a_rhs.f_deferred);
+        f_arena = a_rhs.f_arena;
+        f_leaked = a_rhs.f_leaked;
+        f_revision = next_revision();
+        a_rhs.reset();
+        return *this;
+    }
+
+    template< typename XContents >
+    shared_contents< XContents > shared_contents< XContents >::deferred( builder a_build )
+    {
+        shared_contents t_handle;
+        t_handle.f_deferred = std::make_shared< deferred_contents >( std::move(a_build) );
+        t_handle.f_arena = nullptr;
+        return t_handle;
+    }
+
+    template< typename XContents >
+    inline const XContents& shared_contents< XContents >::get() const
+    {
+        // building deferred contents doesn't touch this handle, so const access from several threads is safe
+        return f_deferred ? *f_deferred->built() : *f_contents;
+    }
+
+    template< typename XContents >
+    inline XContents& shared_contents< XContents >::mutate()
+    {
+        detach();
+        f_revision = next_revision();
+        return *f_contents;
+    }
+
+    template< typename XContents >
+    inline XContents& shared_contents< XContents >::leak()
+    {
+        // handing out references doesn't change the items unless they had to be cloned
+        if( detach() ) f_revision = next_revision();
+        f_leaked = true;
+        return *f_contents;
+    }
+
+    template< typename XContents >
+    void shared_contents< XContents >::resolve()
+    {
+        if( ! f_deferred ) return;
+        f_contents = f_deferred->built();
+        // if this was the only handle with the deferred contents, the built contents are now unique to it
+        f_deferred.reset();
+        return;
+    }
+
+    template< typename XContents >
+    bool shared_contents< XContents >::detach()
+    {
+        resolve();
+        if( f_contents.use_count() > 1 )
+        {
+            f_contents = std::make_shared< XContents >( clone_contents( *f_contents ) );
+            f_arena = param_arena::current();
+            return true;
+        }
+        // another sharer may have just released the contents on another thread;
+        // this pairs with the release in its reference-count decrement
+        std::atomic_thread_fence( std::memory_order_acquire );
+        return false;
+    }
+
+    template< typename XContents >
+    inline void shared_contents< XContents >::reset()
+    {
+        f_contents = empty_contents();
+        f_deferred.reset();
+        f_arena = param_arena::current();
+        f_leaked = false;
+        f_revision = next_revision();
+        return;
+    }
+
+    template< typename XContents >
+    inline bool shared_contents< XContents >::is_shared() const
+    {
+        if( f_deferred ) return f_deferred.use_count() > 1;
+        return f_contents.use_count() > 1 && f_contents != empty_contents();
+    }
+
+    template< typename XContents >
+    inline bool shared_contents< XContents >::shares_with( const shared_contents& a_other ) const
+    {
+        // a deferred handle and one that has taken the built contents are not recognized as sharing
+        return f_deferred == a_other.f_deferred && ( f_deferred || f_contents == a_other.f_contents );
+    }
+
+    template< typename XContents >
+    inline bool shared_contents< XContents >::is_leaked() const
+    {
+        return f_leaked;
+    }
+
+    template< typename XContents >
+    inline param_arena* shared_contents< XContents >::arena() const
+    {
+        return f_arena;
+    }
+
+    template< typename XContents >
+    inline std::uint64_t shared_contents< XContents >::revision() const
+    {
+        return f_revision;
+    }
+
+    template< typename XContents >
+    inline bool shared_contents< XContents >::is_deferred() const
+    {
+        return f_deferred && ! f_deferred->f_is_built.load( std::memory_order_acquire );
+    }
+
+    template< typename XContents >
+    inline bool shared_contents< XContents >::can_share() const
+    {
+        // empty contents have no items that could belong to an arena, and deferred contents are built on the heap
+        return ! f_leaked && (f_deferred || f_arena == param_arena::current() || f_contents->empty());
+    }
+
+    template< typename XContents >
+    const std::shared_ptr< XContents >& shared_contents< XContents >::empty_contents()
+    {
+        // all empty handles share this, so default-constructed nodes and arrays don't allocate;
+        // it is never modified, since it's always shared
+        static const std::shared_ptr< XContents > s_empty = std::make_shared< XContents >();
+        return s_empty;
+    }
+
+    template< typename XContents >
+    inline std::uint64_t shared_contents< XContents >::next_revision()
+    {
+        static std::atomic< std::uint64_t > s_last_revision( 0 );
+        return s_last_revision.fetch_add( 1, std::memory_order_relaxed ) + 1;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_SHARED_CONTENTS_HH_ */
@@ -0,0 +1,657 @@
+/*
+ * param_snapshot.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_snapshot.hh"
+
+#include "param_array.hh"
+#include "param_base_impl.hh"
+#include "param_helpers_impl.hh"
+#include "param_node.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace scarab
+{
+    // the layout of the records is part of the image format
+    static_assert( sizeof( param_snapshot_data::header ) == 48, "Unexpected size of the snapshot image header" );
+    static_assert( sizeof( param_snapshot_data::entry ) == 24, "Unexpected size of the snapshot image entries" );
+    static_assert( sizeof( param_snapshot_data::value ) == 16, "Unexpected size of the snapshot image values" );
+    static_assert( sizeof( param_snapshot_data::name_ref ) == 8, "Unexpected size of the snapshot image names" );
+
+    namespace
+    {
+        std::size_t align_8( std::size_t a_size )
+        {
+            return ( a_size + 7 ) & ~std::size_t( 7 );
+        }
+
+        // offsets of the sections of an image, and its total size
+        struct image_layout
+        {
+            std::size_t f_entries;
+            std::size_t f_values;
+            std::size_t f_names;
+            std::size_t f_displacements;
+            std::size_t f_slots;
+            std::size_t f_chars;
+            std::size_t f_size;
+
+            explicit image_layout( const param_snapshot_data::header& a_header )
+            {
+                f_entries = align_8( sizeof( param_snapshot_data::header ) );
+                f_values = align_8( f_entries + std::size_t( a_header.f_n_entries ) * sizeof( param_snapshot_data::entry ) );
+                f_names = align_8( f_values + std::size_t( a_header.f_n_values ) * sizeof( param_snapshot_data::value ) );
+                f_displacements = align_8( f_names + std::size_t( a_header.f_n_names ) * sizeof( param_snapshot_data::name_ref ) );
+                f_slots = align_8( f_displacements + std::size_t( a_header.f_n_displacements ) * sizeof( std::uint32_t ) );
+                f_chars = align_8( f_slots + std::size_t( a_header.f_n_slots ) * sizeof( std::uint32_t ) );
+                f_size = align_8( f_chars + a_header.f_n_chars );
+            }
+        };
+
+        // Builds the sections of the image in separate vectors, which are then copied into the image
+        struct snapshot_builder
+        {
+            typedef param_snapshot_data::entry entry;
+            typedef param_snapshot_data::kind kind;
+            typedef param_snapshot_data::value value;
+            typedef param_snapshot_data::value_type value_type;
+            typedef param_snapshot_data::name_ref name_ref;
+
+            std::vector< entry > f_entries;
+            std::vector< value > f_values;
+            std::string f_chars;
+            std::vector< name_ref > f_names;
+            std::vector< std::uint32_t > f_displacements;
+            std::vector< std::uint32_t > f_slots;
+
+            explicit snapshot_builder( const param& a_root );
+
+            std::uint32_t add_chars( std::string_view a_chars )
+            {
+                if( f_chars.size() + a_chars.size() > std::numeric_limits< std::uint32_t >::max() )
+                {
+                    throw error( __FILE__, __LINE__ ) << "Param structure is too large to freeze: its names and strings exceed 4 GB";
+                }
+                std::uint32_t t_offset = f_chars.size();
+                f_chars += a_chars;
+                return t_offset;
+            }
+
+            void add_value( const param_value& a_value )
+            {
+                value t_value;
+                std::memset( &t_value, 0, sizeof( t_value ) );
+                t_value.f_type = value_type::boolean;
+                if( a_value.is_bool() )
+                {
+                    t_value.f_bits = a_value.as_bool() ? 1 : 0;
+                }
+                else if( a_value.is_uint() )
+                {
+                    t_value.f_type = value_type::uint;
+                    t_value.f_bits = a_value.as_uint();
+                }
+                else if( a_value.is_int() )
+                {
+                    t_value.f_type = value_type::integer;
+                    t_value.f_bits = std::uint64_t( a_value.as_int() );
+                }
+                else if( a_value.is_double() )
+                {
+                    t_value.f_type = value_type::floating;
+                    double t_double = a_value.as_double();
+                    std::memcpy( &t_value.f_bits, &t_double, sizeof( t_double ) );
+                }
+                else
+                {
+                    std::string t_string = a_value.as_string();
+                    t_value.f_type = value_type::string;
+                    t_value.f_size = t_string.size();
+                    t_value.f_bits = add_chars( t_string );
+                }
+                f_values.push_back( t_value );
+                return;
+            }
+
+            // entries are zero-filled, including their padding, so that images are reproducible
+            static entry new_entry( kind a_kind, std::uint32_t a_name, std::uint32_t a_first )
+            {
+                entry t_entry;
+                std::memset( &t_entry, 0, sizeof( t_entry ) );
+                t_entry.f_kind = a_kind;
+                t_entry.f_name = a_name;
+                t_entry.f_first = a_first;
+                return t_entry;
+            }
+
+            std::string_view name( const entry& an_entry ) const
+            {
+                return std::string_view( f_chars.data() + f_names[ an_entry.f_name ].f_offset, f_names[ an_entry.f_name ].f_size );
+            }
+
+            void build_hash( entry& a_node );
+        };
+
+        snapshot_builder::snapshot_builder( const param& a_root )
+        {
+            const std::uint32_t s_npos = param_snapshot_data::s_npos;
+
+            // breadth-first, so that the children of each array or node are contiguous;
+            // t_sources holds the param for each entry until it's been processed
+            std::vector< const param* > t_sources( 1, &a_root );
+            f_entries.push_back( new_entry( kind::null, s_npos, 0 ) );
+            for( std::uint32_t i_entry = 0; i_entry < f_entries.size(); ++i_entry )
+            {
+                // elements of typed arrays are filled in with their array
+                if( t_sources[ i_entry ] == nullptr ) continue;
+                const param& t_source = *t_sources[ i_entry ];
+                if( t_source.is_value() )
+                {
+                    f_entries[ i_entry ].f_kind = kind::value;
+                    f_entries[ i_entry ].f_first = f_values.size();
+                    add_value( t_source.as_value() );
+                }
+                else if( t_source.is_array() )
+                {
+                    const param_array& t_array = t_source.as_array();
+                    f_entries[ i_entry ].f_kind = kind::array;
+                    f_entries[ i_entry ].f_first = f_entries.size();
+                    f_entries[ i_entry ].f_size = t_array.size();
+                    for( const param& t_child : t_array )
+                    {
+                        f_entries.push_back( new_entry( kind::null, s_npos, 0 ) );
+                        t_sources.push_back( &t_child );
+                    }
+                }
+                else if( t_source.is_typed_array() )
+                {
+                    // frozen as an array of values
+                    const param_typed_array_base& t_typed = t_source.as_typed_array();
+                    f_entries[ i_entry ].f_kind = kind::array;
+                    f_entries[ i_entry ].f_first = f_entries.size();
+                    f_entries[ i_entry ].f_size = t_typed.size();
+                    for( unsigned i_element = 0; i_element < t_typed.size(); ++i_element )
+                    {
+                        f_entries.push_back( new_entry( kind::value, s_npos, f_values.size() ) );
+                        t_sources.push_back( nullptr );
+                        add_value( t_typed.value_at( i_element ) );
+                    }
+                }
+                else if( t_source.is_node() )
+                {
+                    const param_node& t_node = t_source.as_node();
+                    f_entries[ i_entry ].f_kind = kind::node;
+                    f_entries[ i_entry ].f_first = f_entries.size();
+                    f_entries[ i_entry ].f_size = t_node.size();
+                    for( param_node::const_iterator t_it = t_node.begin(); t_it != t_node.end(); ++t_it )
+                    {
+                        f_names.push_back( name_ref{ add_chars( t_it.name() ), std::uint32_t( t_it.name().size() ) } );
+                        f_entries.push_back( new_entry( kind::null, f_names.size() - 1, 0 ) );
+                        t_sources.push_back( &*t_it );
+                    }
+                    build_hash( f_entries[ i_entry ] );
+                }
+            }
+        }
+
+        // limit on the displacements tried for one bucket; far more than distinct hashes need, and well below s_direct_slot
+        const std::uint32_t s_max_displacement = 1 << 20;
+
+        void snapshot_builder::build_hash( entry& a_node )
+        {
+            const std::uint32_t t_n_names = a_node.f_size;
+            const std::uint32_t t_n_buckets = param_snapshot_data::n_buckets( t_n_names );
+            a_node.f_displacements = f_displacements.size();
+            a_node.f_slots = f_slots.size();
+            f_displacements.resize( f_displacements.size() + t_n_buckets, 0 );
+            f_slots.resize( f_slots.size() + t_n_names, 0 );
+            if( t_n_names == 0 ) return;
+
+            // sort the names into buckets
+            std::vector< std::uint64_t > t_hashes( t_n_names );
+            std::vector< std::vector< std::uint32_t > > t_buckets( t_n_buckets );
+            for( std::uint32_t i_name = 0; i_name < t_n_names; ++i_name )
+            {
+                t_hashes[ i_name ] = param_snapshot_data::hash( name( f_entries[ a_node.f_first + i_name ] ) );
+                t_buckets[ (t_hashes[ i_name ] >> 32) % t_n_buckets ].push_back( i_name );
+            }
+
+            // place the largest buckets first, while most of the slots are free
+            std::vector< std::uint32_t > t_order( t_n_buckets );
+            std::iota( t_order.begin(), t_order.end(), 0 );
+            std::stable_sort( t_order.begin(), t_order.end(),
+                    [&t_buckets]( std::uint32_t a_lhs, std::uint32_t a_rhs ){ return t_buckets[ a_lhs ].size() > t_buckets[ a_rhs ].size(); } );
+
+            std::vector< bool > t_taken( t_n_names, false );
+            std::vector< std::uint32_t > t_bucket_slots;
+            std::uint32_t t_next_free = 0;
+            for( std::uint32_t t_bucket : t_order )
+            {
+                const std::vector< std::uint32_t >& t_names = t_buckets[ t_bucket ];
+                if( t_names.empty() ) break;
+
+                std::uint32_t t_displacement = 0;
+                if( t_names.size() == 1 )
+                {
+                    // a single name can go in any free slot, so the displacement holds the slot directly
+                    while( t_taken[ t_next_free ] ) ++t_next_free;
+                    t_displacement = param_snapshot_data::s_direct_slot | t_next_free;
+                    t_bucket_slots.assign( 1, t_next_free );
+                }
+                else
+                {
+                    // names with identical hashes land in the same slot for every displacement, so there's no point searching
+                    for( std::uint32_t i_name = 1; i_name < t_names.size(); ++i_name )
+                    {
+                        for( std::uint32_t i_other = 0; i_other < i_name; ++i_other )
+                        {
+                            if( t_hashes[ t_names[ i_name ] ] == t_hashes[ t_names[ i_other ] ] )
+                            {
+                                throw error() << "Unable to build the hash for a frozen node: names <" << name( f_entries[ a_node.f_first + t_names[ i_other ] ] )
+                                        << "> and <" << name( f_entries[ a_node.f_first + t_names[ i_name ] ] ) << "> have identical hashes";
+                            }
+                        }
+                    }
+
+                    // find a displacement that puts all of the bucket's names in distinct free slots
+                    for( ; ; ++t_displacement )
+                    {
+                        if( t_displacement == s_max_displacement )
+                        {
+                            throw error() << "Unable to build the hash for a frozen node; no displacement found for a bucket of " << t_names.size() << " names";
+                        }
+                        t_bucket_slots.clear();
+                        bool t_fits = true;
+                        for( std::uint32_t t_name : t_names )
+                        {
+                            std::uint32_t t_slot = param_snapshot_data::slot( t_hashes[ t_name ], t_displacement, t_n_names );
+                            if( t_taken[ t_slot ] || std::find( t_bucket_slots.begin(), t_bucket_slots.end(), t_slot ) != t_bucket_slots.end() )
+                            {
+                                t_fits = false;
+                                break;
+                            }
+                            t_bucket_slots.push_back( t_slot );
+                        }
+                        if( t_fits ) break;
+                    }
+                }
+
+                f_displacements[ a_node.f_displacements + t_bucket ] = t_displacement;
+                for( std::uint32_t i_name = 0; i_name < t_names.size(); ++i_name )
+                {
+                    t_taken[ t_bucket_slots[ i_name ] ] = true;
+                    f_slots[ a_node.f_slots + t_bucket_slots[ i_name ] ] = t_names[ i_name ];
+                }
+            }
+            return;
+        }
+
+        template< typename XRecord >
+        void copy_section( const std::vector< XRecord >& a_records, char* an_image, std::size_t an_offset )
+        {
+            if( ! a_records.empty() ) std::memcpy( an_image + an_offset, a_records.data(), a_records.size() * sizeof( XRecord ) );
+            return;
+        }
+    }
+
+    const char param_snapshot_data::s_magic[4] = { 'S', 'P', 'B', '\0' };
+
+    param_snapshot_data::param_snapshot_data( const param& a_root ) :
+            f_header( nullptr ),
+            f_entries( nullptr ),
+            f_values( nullptr ),
+            f_names( nullptr ),
+            f_displacements( nullptr ),
+            f_slots( nullptr ),
+            f_chars( nullptr ),
+            f_storage(),
+            f_file()
+    {
+        snapshot_builder t_builder( a_root );
+
+        header t_header;
+        std::memset( &t_header, 0, sizeof( t_header ) );
+        std::memcpy( t_header.f_magic, s_magic, sizeof( s_magic ) );
+        t_header.f_byte_order = s_byte_order;
+        t_header.f_version = s_version;
+        t_header.f_n_entries = t_builder.f_entries.size();
+        t_header.f_n_values = t_builder.f_values.size();
+        t_header.f_n_names = t_builder.f_names.size();
+        t_header.f_n_displacements = t_builder.f_displacements.size();
+        t_header.f_n_slots = t_builder.f_slots.size();
+        t_header.f_n_chars = t_builder.f_chars.size();
+        image_layout t_layout( t_header );
+        t_header.f_size = t_layout.f_size;
+
+        // the image is zero-filled, so the padding between sections is zero
+        f_storage.assign( t_layout.f_size / sizeof( std::uint64_t ), 0 );
+        char* t_image = reinterpret_cast< char* >( f_storage.data() );
+        std::memcpy( t_image, &t_header, sizeof( t_header ) );
+        copy_section( t_builder.f_entries, t_image, t_layout.f_entries );
+        copy_section( t_builder.f_values, t_image, t_layout.f_values );
+        copy_section( t_builder.f_names, t_image, t_layout.f_names );
+        copy_section( t_builder.f_displacements, t_image, t_layout.f_displacements );
+        copy_section( t_builder.f_slots, t_image, t_layout.f_slots );
+        std::memcpy( t_image + t_layout.f_chars, t_builder.f_chars.data(), t_builder.f_chars.size() );
+
+        attach( t_image, t_layout.f_size );
+    }
+
+    param_snapshot_data::param_snapshot_data( const char* an_image, std::size_t a_size ) :
+            f_header( nullptr ),
+            f_entries( nullptr ),
+            f_values( nullptr ),
+            f_names( nullptr ),
+            f_displacements( nullptr ),
+            f_slots( nullptr ),
+            f_chars( nullptr ),
+            f_storage( align_8( a_size ) / sizeof( std::uint64_t ), 0 ),
+            f_file()
+    {
+        // copied so that the records are aligned
+        if( a_size > 0 ) std::memcpy( f_storage.data(), an_image, a_size );
+        attach( reinterpret_cast< const char* >( f_storage.data() ), a_size );
+        validate();
+    }
+
+    param_snapshot_data::param_snapshot_data( mapped_file&& a_file ) :
+            f_header( nullptr ),
+            f_entries( nullptr ),
+            f_values( nullptr ),
+            f_names( nullptr ),
+            f_displacements( nullptr ),
+            f_slots( nullptr ),
+            f_chars( nullptr ),
+            f_storage(),
+            f_file( new mapped_file( std::move(a_file) ) )
+    {
+        // the mapping is page-aligned
+        attach( f_file->data(), f_file->size() );
+    }
+
+    void param_snapshot_data::attach( const char* an_image, std::size_t a_size )
+    {
+        if( a_size < sizeof( header ) )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image is too small (" << a_size << " bytes)";
+        }
+        const header* t_header = reinterpret_cast< const header* >( an_image );
+        if( std::memcmp( t_header->f_magic, s_magic, sizeof( s_magic ) ) != 0 )
+        {
+            throw error( __FILE__, __LINE__ ) << "Data is not a snapshot image";
+        }
+        if( t_header->f_byte_order != s_byte_order )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image was written with a different byte order";
+        }
+        if( t_header->f_version != s_version )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image has an unsupported version <" << t_header->f_version << ">";
+        }
+        // checked first so that the layout can't overflow
+        if( t_header->f_n_chars > a_size )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image is truncated or corrupt";
+        }
+        image_layout t_layout( *t_header );
+        if( t_header->f_n_entries == 0 || t_layout.f_size != t_header->f_size || t_header->f_size != a_size )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image is truncated or corrupt";
+        }
+
+        f_header = t_header;
+        f_entries = reinterpret_cast< const entry* >( an_image + t_layout.f_entries );
+        f_values = reinterpret_cast< const value* >( an_image + t_layout.f_values );
+        f_names = reinterpret_cast< const name_ref* >( an_image + t_layout.f_names );
+        f_displacements = reinterpret_cast< const std::uint32_t* >( an_image + t_layout.f_displacements );
+        f_slots = reinterpret_cast< const std::uint32_t* >( an_image + t_layout.f_slots );
+        f_chars = an_image + t_layout.f_chars;
+        return;
+    }
+
+    void param_snapshot_data::validate() const
+    {
+        const header& t_header = *f_header;
+        auto t_in_chars = [&t_header]( std::uint64_t an_offset, std::uint64_t a_size )
+        {
+            return an_offset <= t_header.f_n_chars && a_size <= t_header.f_n_chars - an_offset;
+        };
+
+        for( std::uint32_t i_name = 0; i_name < t_header.f_n_names; ++i_name )
+        {
+            if( ! t_in_chars( f_names[ i_name ].f_offset, f_names[ i_name ].f_size ) )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: name " << i_name << " is out of bounds";
+            }
+        }
+
+        for( std::uint32_t i_value = 0; i_value < t_header.f_n_values; ++i_value )
+        {
+            const value& t_value = f_values[ i_value ];
+            if( t_value.f_type > value_type::string || ( t_value.f_type == value_type::string && ! t_in_chars( t_value.f_bits, t_value.f_size ) ) )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: value " << i_value << " is invalid";
+            }
+        }
+
+        // the children of each array and node follow those of the previous one (breadth-first), and come after their parent,
+        // so each entry but the root belongs to exactly one container, and there are no cycles
+        std::uint64_t t_next_child = 1;
+        for( std::uint32_t i_entry = 0; i_entry < t_header.f_n_entries; ++i_entry )
+        {
+            const entry& t_entry = f_entries[ i_entry ];
+            if( i_entry >= t_next_child )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: entry " << i_entry << " is not in any array or node";
+            }
+            if( t_entry.f_name != s_npos && t_entry.f_name >= t_header.f_n_names )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: entry " << i_entry << " has an invalid name";
+            }
+            switch( t_entry.f_kind )
+            {
+                case kind::null:
+                    break;
+                case kind::value:
+                    if( t_entry.f_first >= t_header.f_n_values )
+                    {
+                        throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: entry " << i_entry << " has an invalid value";
+                    }
+                    break;
+                case kind::array:
+                case kind::node:
+                    if( t_entry.f_first != t_next_child || t_next_child + t_entry.f_size > t_header.f_n_entries )
+                    {
+                        throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: the children of entry " << i_entry << " are invalid";
+                    }
+                    t_next_child += t_entry.f_size;
+                    if( t_entry.f_kind == kind::node ) validate_node( i_entry );
+                    break;
+                default:
+                    throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: entry " << i_entry << " has an invalid kind";
+            }
+        }
+        if( t_next_child != t_header.f_n_entries )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: not every entry is in an array or node";
+        }
+        return;
+    }
+
+    void param_snapshot_data::validate_node( std::uint32_t an_index ) const
+    {
+        const entry& t_node = f_entries[ an_index ];
+        std::uint64_t t_n_buckets = n_buckets( t_node.f_size );
+        if( std::uint64_t( t_node.f_displacements ) + t_n_buckets > f_header->f_n_displacements ||
+            std::uint64_t( t_node.f_slots ) + t_node.f_size > f_header->f_n_slots )
+        {
+            throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: the hash of entry " << an_index << " is out of bounds";
+        }
+        for( std::uint32_t i_bucket = 0; i_bucket < t_n_buckets; ++i_bucket )
+        {
+            std::uint32_t t_displacement = f_displacements[ t_node.f_displacements + i_bucket ];
+            if( ( t_displacement & s_direct_slot ) && t_node.f_size != 0 && ( t_displacement & ~s_direct_slot ) >= t_node.f_size )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: the hash of entry " << an_index << " is invalid";
+            }
+        }
+        for( std::uint32_t i_slot = 0; i_slot < t_node.f_size; ++i_slot )
+        {
+            if( f_slots[ t_node.f_slots + i_slot ] >= t_node.f_size )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: the hash of entry " << an_index << " is invalid";
+            }
+        }
+        // lookups compare the names of the children
+        for( std::uint32_t i_child = 0; i_child < t_node.f_size; ++i_child )
+        {
+            if( f_entries[ t_node.f_first + i_child ].f_name >= f_header->f_n_names )
+            {
+                throw error( __FILE__, __LINE__ ) << "Snapshot image is corrupt: a child of entry " << an_index << " has no name";
+            }
+        }
+        return;
+    }
+
+    param_value param_snapshot_data::make_value( const value& a_value ) const
+    {
+        switch( a_value.f_type )
+        {
+            case value_type::boolean:
+                return param_value( a_value.f_bits != 0 );
+            case value_type::uint:
+                return param_value( std::uint64_t( a_value.f_bits ) );
+            case value_type::integer:
+                return param_value( std::int64_t( a_value.f_bits ) );
+            case value_type::floating:
+            {
+                double t_double;
+                std::memcpy( &t_double, &a_value.f_bits, sizeof( t_double ) );
+                return param_value( t_double );
+            }
+            default:
+            {
+                std::string_view t_chars = chars( a_value );
+                // param_value strips one pair of wrapping single quotes, so such a string needs another pair to survive
+                if( t_chars.size() > 1 && t_chars.front() == '\'' && t_chars.back() == '\'' )
+                {
+                    return param_value( "'" + std::string( t_chars ) + "'" );
+                }
+                return param_value( std::string( t_chars ) );
+            }
+        }
+    }
+
+
+    namespace
+    {
+        // Makes the param for a_frozen, without the contents of arrays and nodes
+        param_ptr_t thaw_shallow( const frozen_param& a_frozen )
+        {
+            if( a_frozen.is_value() ) return param_ptr_t( new param_value( a_frozen.as_value() ) );
+            if( a_frozen.is_array() ) return param_ptr_t( new param_array() );
+            if( a_frozen.is_node() ) return param_ptr_t( new param_node() );
+            return param_ptr_t( new param() );
+        }
+    }
+
+    param_ptr_t frozen_param::thaw() const
+    {
+        // iterative, so that the depth of the structure isn't limited by the size of the call stack
+        param_ptr_t t_root = thaw_shallow( *this );
+        std::vector< std::pair< frozen_param, param* > > t_pending( 1, std::make_pair( *this, t_root.get() ) );
+        while( ! t_pending.empty() )
+        {
+            frozen_param t_frozen = t_pending.back().first;
+            param* t_thawed = t_pending.back().second;
+            t_pending.pop_back();
+            if( ! t_frozen.is_array() && ! t_frozen.is_node() ) continue;
+
+            for( const_iterator t_it = t_frozen.begin(); t_it != t_frozen.end(); ++t_it )
+            {
+                param_ptr_t t_child = thaw_shallow( *t_it );
+                t_pending.push_back( std::make_pair( *t_it, t_child.get() ) );
+                if( t_frozen.is_array() ) t_thawed->as_array().push_back( std::move(t_child) );
+                else t_thawed->as_node().insert_or_assign( t_it.name(), std::move(t_child) );
+            }
+        }
+        return t_root;
+    }
+
+    std::string frozen_param::to_string() const
+    {
+        return thaw()->to_string();
+    }
+
+    SCARAB_API std::ostream& operator<<( std::ostream& out, const frozen_param& a_param )
+    {
+        return out << a_param.to_string();
+    }
+
+
+    param_snapshot::param_snapshot() :
+            frozen_param(),
+            f_owner()
+    {}
+
+    param_snapshot::param_snapshot( const param& a_root ) :
+            frozen_param(),
+            f_owner( std::make_shared< const param_snapshot_data >( a_root ) )
+    {
+        f_data = f_owner.get();
+        f_index = 0;
+    }
+
+    param_snapshot::param_snapshot( const char* an_image, std::size_t a_size ) :
+            param_snapshot( std::make_shared< const param_snapshot_data >( an_image, a_size ) )
+    {}
+
+    param_snapshot::param_snapshot( std::shared_ptr< const param_snapshot_data > an_owner ) :
+            frozen_param( an_owner.get(), 0 ),
+            f_owner( std::move(an_owner) )
+    {}
+
+    param_snapshot::param_snapshot( param_snapshot&& a_orig ) :
+            frozen_param( a_orig ),
+            f_owner( std::move(a_orig.f_owner) )
+    {
+        a_orig.f_data = nullptr;
+    }
+
+    param_snapshot& param_snapshot::operator=( param_snapshot&& a_rhs )
+    {
+        if( &a_rhs == this ) return *this;
+        frozen_param::operator=( a_rhs );
+        f_owner = std::move(a_rhs.f_owner);
+        a_rhs.f_data = nullptr;
+        return *this;
+    }
+
+    void param_snapshot::validate() const
+    {
+        if( f_owner ) f_owner->validate();
+        return;
+    }
+
+    param_snapshot param_snapshot::map_file( const std::string& a_filename )
+    {
+        try
+        {
+            return param_snapshot( std::make_shared< const param_snapshot_data >( mapped_file( a_filename ) ) );
+        }
+        catch( error& e )
+        {
+            throw error( __FILE__, __LINE__ ) << "Unable to open snapshot file <" << a_filename << ">: " << e.what();
+        }
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,597 @@
+/*
+ * param_snapshot.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_SNAPSHOT_HH_
+#define SCARAB_PARAM_SNAPSHOT_HH_
+
+#include "param_value.hh"
+
+#include "error.hh"
+#include "mapped_file.hh"
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scarab
+{
+    /*!
+     @class param_snapshot_data
+     @author agent
+
+     @brief Compact, immutable storage for a frozen param structure
+
+     @details
+     The data are a single image: a header followed by sections of fixed-size records and a character buffer.
+     Records refer to each other by index and to the character buffer by offset, never by pointer,
+     so the image can be written to a file as-is and used again from wherever the file is mapped into memory.
+     This is the spb ("scarab param binary") format.
+
+     Every param in the structure is an entry in the entry section.
+     The children of an array or node are contiguous, in array order or name order, respectively.
+     Values are stored contiguously in the value section, and names and strings are stored in the character buffer.
+
+     Each node has a minimal perfect hash of its names (hash-and-displace, as in the CHD algorithm):
+     a name's hash picks a bucket, the bucket's displacement picks the slot, and the slot gives the child.
+     Each bucket's displacement was chosen so that no two names share a slot, so a lookup is one hash,
+     two table reads, and one string comparison to reject names that aren't present.
+
+     Sections are aligned to 8 bytes, and numbers are in the byte order of the machine that wrote the image;
+     an image with the other byte order is rejected.
+     When an image is mapped, only the header is checked, so that the time to open it doesn't depend on its size;
+     validate() checks the rest of the image (every index, offset, and length, and that the entries form a tree),
+     and should be used before reading an image that may be corrupt or didn't come from a trusted writer.
+     Images that are copied are always validated.
+
+     This is an implementation detail of param_snapshot and frozen_param.
+    */
+    struct SCARAB_API param_snapshot_data
+    {
+        enum class kind : std::uint8_t
+        {
+            null,
+            value,
+            array,
+            node
+        };
+
+        enum class value_type : std::uint8_t
+        {
+            boolean,
+            uint,
+            integer,
+            floating,
+            string
+        };
+
+        struct entry
+        {
+            kind f_kind;
+            /// Index into the names; only used for children of nodes
+            std::uint32_t f_name;
+            /// For values, index into the values; for arrays and nodes, index of the first child in the entries
+            std::uint32_t f_first;
+            /// Number of children
+            std::uint32_t f_size;
+            /// For nodes, the offset of the node's displacements and slots in the displacements and slots
+            std::uint32_t f_displacements;
+            std::uint32_t f_slots;
+        };
+
+        struct value
+        {
+            value_type f_type;
+            /// For strings, the length
+            std::uint32_t f_size;
+            /// For bools and integers, the value; for doubles, the bits of the value; for strings, the offset in the characters
+            std::uint64_t f_bits;
+        };
+
+        struct name_ref
+        {
+            std::uint32_t f_offset;
+            std::uint32_t f_size;
+        };
+
+        struct header
+        {
+            char f_magic[4];
+            std::uint32_t f_byte_order;
+            std::uint32_t f_version;
+            std::uint32_t f_n_entries;
+            std::uint32_t f_n_values;
+            std::uint32_t f_n_names;
+            std::uint32_t f_n_displacements;
+            std::uint32_t f_n_slots;
+            std::uint64_t f_n_chars;
+            /// Size of the whole image in bytes
+            std::uint64_t f_size;
+        };
+
+        static const char s_magic[4];
+        static const std::uint32_t s_byte_order = 0x01020304;
+        static const std::uint32_t s_version = 1;
+
+        /// Displacements with this bit set hold the slot for a bucket with a single name
+        static const std::uint32_t s_direct_slot = 0x80000000;
+
+        /// Builds the snapshot data from a param structure
+        explicit param_snapshot_data( const param& a_root );
+        /// Copies an image and validates it; throws scarab::error if it isn't a valid image
+        param_snapshot_data( const char* an_image, std::size_t a_size );
+        /// Uses the image in a mapped file; throws scarab::error if its header isn't valid
+        explicit param_snapshot_data( mapped_file&& a_file );
+
+        /// Checks that every reference in the image is in bounds, so that it can be read safely; throws scarab::error if not
+        void validate() const;
+
+        /// Returns the index in the entries of the child of a_node named a_name, or s_npos if it isn't present
+        std::uint32_t find( const entry& a_node, std::string_view a_name ) const;
+
+        std::string_view name( const entry& an_entry ) const;
+        std::string_view chars( const value& a_value ) const;
+        param_value make_value( const value& a_value ) const;
+
+        /// The whole image, e.g. for writing to a file
+        std::string_view image() const;
+
+        static std::uint64_t hash( std::string_view a_name );
+        static std::uint32_t n_buckets( std::uint32_t a_n_names );
+        static std::uint32_t slot( std::uint64_t a_hash, std::uint32_t a_displacement, std::uint32_t a_n_names );
+
+        static const std::uint32_t s_npos = 0xFFFFFFFF;
+
+        const header* f_header;
+        const entry* f_entries;
+        const value* f_values;
+        const name_ref* f_names;
+        const std::uint32_t* f_displacements;
+        const std::uint32_t* f_slots;
+        const char* f_chars;
+
+        private:
+            /// Checks the header of the image at an_image, and sets the section pointers
+            void attach( const char* an_image, std::size_t a_size );
+            /// Checks the hash and the names of the node at an_index, for validate()
+            void validate_node( std::uint32_t an_index ) const;
+
+            // the image is in one of these
+            std::vector< std::uint64_t > f_storage;
+            std::unique_ptr< mapped_file > f_file;
+    };
+
+    class frozen_param_iterator;
+
+    /*!
+     @class frozen_param
+     @author agent
+
+     @brief Read-only view of one param in a param_snapshot
+
+     @details
+     A frozen_param has the read API of param, param_value, param_array, and param_node:
+     `operator[]` with a name or an index, `operator()` for the value, `get_value`, `has`, `size`, and iteration.
+     For a node, iteration is in name order, and the iterator's name() gives the name, as with param_node.
+
+     Values are stored compactly rather than as param_value objects, so as_value() returns a param_value by value.
+
+     A frozen_param is just a pointer and an index, and does not own the data it views;
+     it is valid as long as the param_snapshot it came from (or a copy of it) exists.
+    */
+    class SCARAB_API frozen_param
+    {
+        public:
+            typedef frozen_param_iterator const_iterator;
+
+            frozen_param();
+            frozen_param( const param_snapshot_data* a_data, std::uint32_t an_index );
+
+            bool is_null() const;
+            bool is_value() const;
+            bool is_array() const;
+            bool is_node() const;
+
+            /// For arrays and nodes, the number of items; otherwise 0
+            unsigned size() const;
+            bool empty() const;
+
+            /// For children of nodes, the name; otherwise empty
+            std::string_view name() const;
+
+            /// Returns a copy of the value; throws scarab::error if this is not a value
+            param_value as_value() const;
+            param_value operator()() const;
+
+            /// Returns true if this is a node and has an item named a_name
+            bool has( std::string_view a_name ) const;
+            unsigned count( std::string_view a_name ) const;
+
+            /// Returns the item named a_name; throws scarab::error if this is not a node or a_name is not present
+            frozen_param at( std::string_view a_name ) const;
+            frozen_param operator[]( std::string_view a_name ) const;
+            /// Returns the item at a_index; throws scarab::error if this is not an array or a_index is out of range
+            frozen_param at( unsigned a_index ) const;
+            frozen_param operator[]( unsigned a_index ) const;
+
+            /// Returns the result of param_value::as if a_name is present and is a value; returns a_default otherwise
+            template< typename XValType >
+            XValType get_value( std::string_view a_name, XValType a_default ) const;
+            std::string get_value( std::string_view a_name, const std::string& a_default ) const;
+            std::string get_value( std::string_view a_name, const char* a_default ) const;
+            /// Returns the result of param_value::as if a_index is present and is a value; returns a_default otherwise
+            template< typename XValType >
+            XValType get_value( unsigned a_index, XValType a_default ) const;
+
+            const_iterator begin() const;
+            const_iterator end() const;
+
+            /// Creates a modifiable copy of this param
+            param_ptr_t thaw() const;
+
+            std::string to_string() const;
+
+        protected:
+            const param_snapshot_data::entry& get_entry() const;
+            /// Returns the child for a_name, or a null frozen_param with no data if it isn't present
+            frozen_param find( std::string_view a_name ) const;
+
+            const param_snapshot_data* f_data;
+            std::uint32_t f_index;
+    };
+
+    SCARAB_API std::ostream& operator<<( std::ostream& out, const frozen_param& a_param );
+
+    /*!
+     @class frozen_param_iterator
+     @author agent
+
+     @brief Iterator over the items of a frozen array or node
+
+     @details
+     *iterator gives the frozen_param, and iterator.name() gives the name (for nodes).
+    */
+    class SCARAB_API frozen_param_iterator : public boost::iterator_facade< frozen_param_iterator, const frozen_param, boost::random_access_traversal_tag, frozen_param >
+    {
+        public:
+            frozen_param_iterator();
+            frozen_param_iterator( const param_snapshot_data* a_data, std::uint32_t an_index );
+
+            std::string_view name() const;
+
+        private:
+            friend class boost::iterator_core_access;
+
+            frozen_param dereference() const;
+            bool equal( const frozen_param_iterator& a_other ) const;
+            void increment();
+            void decrement();
+            void advance( std::ptrdiff_t a_n );
+            std::ptrdiff_t distance_to( const frozen_param_iterator& a_other ) const;
+
+            const param_snapshot_data* f_data;
+            std::uint32_t f_index;
+    };
+
+    /*!
+     @class param_snapshot
+     @author agent
+
+     @brief Immutable, compact copy of a param structure
+
+     @details
+     Created with param_node::freeze(), or from any param.
+     The snapshot is the root frozen_param, and it owns the data; copies share the data.
+     Since the data is never modified, copies of a snapshot can be read on any number of threads without locking.
+
+     The data are a single position-independent image (see param_snapshot_data), available with image().
+     Written to a file (e.g. with the spb codec), the image can be opened again with map_file(),
+     which maps the file into memory and reads it in place: there is no parsing step, the time to open a file doesn't
+     depend on its size, and processes that map the same file share its pages in the page cache.
+    */
+    class SCARAB_API param_snapshot : public frozen_param
+    {
+        public:
+            /// Creates an empty (null) snapshot
+            param_snapshot();
+            explicit param_snapshot( const param& a_root );
+            /// Creates a snapshot from a copy of an image; throws scarab::error if it isn't a valid image (see param_snapshot_data::validate())
+            param_snapshot( const char* an_image, std::size_t a_size );
+            param_snapshot( const param_snapshot& ) = default;
+            param_snapshot( param_snapshot&& a_orig );
+            ~param_snapshot() = default;
+
+            param_snapshot& operator=( const param_snapshot& ) = default;
+            param_snapshot& operator=( param_snapshot&& a_rhs );
+
+            /// Total number of params in the snapshot
+            unsigned n_params() const;
+
+            /// The image of the snapshot's data; empty for an empty snapshot
+            std::string_view image() const;
+
+            /// Checks the whole image (see param_snapshot_data::validate()); throws scarab::error if it's corrupt
+            void validate() const;
+
+            /// Opens a snapshot image file (as written from image()) by mapping it into memory; throws scarab::error on failure.
+            /// Only the header is checked; use validate() before reading a file that may be corrupt.
+            static param_snapshot map_file( const std::string& a_filename );
+
+        private:
+            explicit param_snapshot( std::shared_ptr< const param_snapshot_data > an_owner );
+
+            std::shared_ptr< const param_snapshot_data > f_owner;
+    };
+
+
+    inline std::string_view param_snapshot_data::name( const entry& an_entry ) const
+    {
+        const name_ref& t_name = f_names[ an_entry.f_name ];
+        return std::string_view( f_chars + t_name.f_offset, t_name.f_size );
+    }
+
+    inline std::string_view param_snapshot_data::chars( const value& a_value ) const
+    {
+        return std::string_view( f_chars + a_value.f_bits, a_value.f_size );
+    }
+
+    inline std::string_view param_snapshot_data::image() const
+    {
+        return std::string_view( reinterpret_cast< const char* >( f_header ), f_header->f_size );
+    }
+
+    inline std::uint64_t param_snapshot_data::hash( std::string_view a_name )
+    {
+        // FNV-1a
+        std::uint64_t t_hash = 0xcbf29ce484222325ULL;
+        for( char t_char : a_name )
+        {
+            t_hash ^= static_cast< unsigned char >( t_char );
+            t_hash *= 0x100000001b3ULL;
+        }
+        return t_hash;
+    }
+
+    inline std::uint32_t param_snapshot_data::n_buckets( std::uint32_t a_n_names )
+    {
+        return a_n_names / 2 + 1;
+    }
+
+    inline std::uint32_t param_snapshot_data::slot( std::uint64_t a_hash, std::uint32_t a_displacement, std::uint32_t a_n_names )
+    {
+        if( a_displacement & s_direct_slot ) return a_displacement & ~s_direct_slot;
+        // mix the displaced hash (the splitmix64 finalizer) so that each displacement gives an independent slot
+        std::uint64_t t_mixed = a_hash + 0x9e3779b97f4a7c15ULL * ( std::uint64_t(a_displacement) + 1 );
+        t_mixed = ( t_mixed ^ (t_mixed >> 30) ) * 0xbf58476d1ce4e5b9ULL;
+        t_mixed = ( t_mixed ^ (t_mixed >> 27) ) * 0x94d049bb133111ebULL;
+        t_mixed ^= t_mixed >> 31;
+        return std::uint32_t( t_mixed % a_n_names );
+    }
+
+    inline std::uint32_t param_snapshot_data::find( const entry& a_node, std::string_view a_name ) const
+    {
+        if( a_node.f_size == 0 ) return s_npos;
+        std::uint64_t t_hash = hash( a_name );
+        std::uint32_t t_bucket = std::uint32_t( (t_hash >> 32) % n_buckets( a_node.f_size ) );
+        std::uint32_t t_slot = slot( t_hash, f_displacements[ a_node.f_displacements + t_bucket ], a_node.f_size );
+        std::uint32_t t_index = a_node.f_first + f_slots[ a_node.f_slots + t_slot ];
+        return name( f_entries[ t_index ] ) == a_name ? t_index : s_npos;
+    }
+
+
+    inline frozen_param::frozen_param() :
+            f_data( nullptr ),
+            f_index( 0 )
+    {}
+
+    inline frozen_param::frozen_param( const param_snapshot_data* a_data, std::uint32_t an_index ) :
+            f_data( a_data ),
+            f_index( an_index )
+    {}
+
+    inline const param_snapshot_data::entry& frozen_param::get_entry() const
+    {
+        return f_data->f_entries[ f_index ];
+    }
+
+    inline bool frozen_param::is_null() const
+    {
+        return f_data == nullptr || get_entry().f_kind == param_snapshot_data::kind::null;
+    }
+
+    inline bool frozen_param::is_value() const
+    {
+        return f_data != nullptr && get_entry().f_kind == param_snapshot_data::kind::value;
+    }
+
+    inline bool frozen_param::is_array() const
+    {
+        return f_data != nullptr && get_entry().f_kind == param_snapshot_data::kind::array;
+    }
+
+    inline bool frozen_param::is_node() const
+    {
+        return f_data != nullptr && get_entry().f_kind == param_snapshot_data::kind::node;
+    }
+
+    inline unsigned frozen_param::size() const
+    {
+        return is_array() || is_node() ? get_entry().f_size : 0;
+    }
+
+    inline bool frozen_param::empty() const
+    {
+        return size() == 0;
+    }
+
+    inline std::string_view frozen_param::name() const
+    {
+        if( f_data == nullptr || get_entry().f_name == param_snapshot_data::s_npos ) return std::string_view();
+        return f_data->name( get_entry() );
+    }
+
+    inline param_value frozen_param::as_value() const
+    {
+        if( ! is_value() ) throw error( __FILE__, __LINE__ ) << "Frozen param is not a value";
+        return f_data->make_value( f_data->f_values[ get_entry().f_first ] );
+    }
+
+    inline param_value frozen_param::operator()() const
+    {
+        return as_value();
+    }
+
+    inline frozen_param frozen_param::find( std::string_view a_name ) const
+    {
+        if( ! is_node() ) return frozen_param();
+        std::uint32_t t_index = f_data->find( get_entry(), a_name );
+        return t_index == param_snapshot_data::s_npos ? frozen_param() : frozen_param( f_data, t_index );
+    }
+
+    inline bool frozen_param::has( std::string_view a_name ) const
+    {
+        return find( a_name ).f_data != nullptr;
+    }
+
+    inline unsigned frozen_param::count( std::string_view a_name ) const
+    {
+        return has( a_name ) ? 1 : 0;
+    }
+
+    inline frozen_param frozen_param::at( std::string_view a_name ) const
+    {
+        frozen_param t_child = find( a_name );
+        if( t_child.f_data == nullptr )
+        {
+            throw error( __FILE__, __LINE__ ) << "Frozen param does not have item with key <" << a_name << ">";
+        }
+        return t_child;
+    }
+
+    inline frozen_param frozen_param::operator[]( std::string_view a_name ) const
+    {
+        return at( a_name );
+    }
+
+    inline frozen_param frozen_param::at( unsigned a_index ) const
+    {
+        if( ! is_array() || a_index >= get_entry().f_size )
+        {
+            throw error( __FILE__, __LINE__ ) << "Frozen param does not have item at index <" << a_index << ">";
+        }
+        return frozen_param( f_data, get_entry().f_first + a_index );
+    }
+
+    inline frozen_param frozen_param::operator[]( unsigned a_index ) const
+    {
+        return at( a_index );
+    }
+
+    template< typename XValType >
+    inline XValType frozen_param::get_value( std::string_view a_name, XValType a_default ) const
+    {
+        frozen_param t_child = find( a_name );
+        return t_child.is_value() ? t_child.as_value().as< XValType >() : a_default;
+    }
+
+    inline std::string frozen_param::get_value( std::string_view a_name, const std::string& a_default ) const
+    {
+        frozen_param t_child = find( a_name );
+        if( ! t_child.is_value() ) return a_default;
+        // strings are copied straight from the image
+        const param_snapshot_data::value& t_value = f_data->f_values[ t_child.get_entry().f_first ];
+        if( t_value.f_type == param_snapshot_data::value_type::string ) return std::string( f_data->chars( t_value ) );
+        return f_data->make_value( t_value ).to_string();
+    }
+
+    inline std::string frozen_param::get_value( std::string_view a_name, const char* a_default ) const
+    {
+        return get_value( a_name, std::string( a_default ) );
+    }
+
+    template< typename XValType >
+    inline XValType frozen_param::get_value( unsigned a_index, XValType a_default ) const
+    {
+        if( ! is_array() || a_index >= get_entry().f_size ) return a_default;
+        frozen_param t_child( f_data, get_entry().f_first + a_index );
+        return t_child.is_value() ? t_child.as_value().as< XValType >() : a_default;
+    }
+
+    inline frozen_param::const_iterator frozen_param::begin() const
+    {
+        return size() == 0 ? const_iterator() : const_iterator( f_data, get_entry().f_first );
+    }
+
+    inline frozen_param::const_iterator frozen_param::end() const
+    {
+        return size() == 0 ? const_iterator() : const_iterator( f_data, get_entry().f_first + get_entry().f_size );
+    }
+
+
+    inline frozen_param_iterator::frozen_param_iterator() :
+            f_data( nullptr ),
+            f_index( 0 )
+    {}
+
+    inline frozen_param_iterator::frozen_param_iterator( const param_snapshot_data* a_data, std::uint32_t an_index ) :
+            f_data( a_data ),
+            f_index( an_index )
+    {}
+
+    inline std::string_view frozen_param_iterator::name() const
+    {
+        return dereference().name();
+    }
+
+    inline frozen_param frozen_param_iterator::dereference() const
+    {
+        return frozen_param( f_data, f_index );
+    }
+
+    inline bool frozen_param_iterator::equal( const frozen_param_iterator& a_other ) const
+    {
+        return f_data == a_other.f_data && f_index == a_other.f_index;
+    }
+
+    inline void frozen_param_iterator::increment()
+    {
+        ++f_index;
+    }
+
+    inline void frozen_param_iterator::decrement()
+    {
+        --f_index;
+    }
+
+    inline void frozen_param_iterator::advance( std::ptrdiff_t a_n )
+    {
+        f_index += a_n;
+    }
+
+    inline std::ptrdiff_t frozen_param_iterator::distance_to( const frozen_param_iterator& a_other ) const
+    {
+        return std::ptrdiff_t( a_other.f_index ) - std::ptrdiff_t( f_index );
+    }
+
+
+    inline unsigned param_snapshot::n_params() const
+    {
+        return f_owner ? f_owner->f_header->f_n_entries : 0;
+    }
+
+    inline std::string_view param_snapshot::image() const
+    {
+        return f_owner ? f_owner->image() : std::string_view();
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_SNAPSHOT_HH_ */
@@ -0,0 +1,250 @@
+/*
+ * param_traversal.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_traversal.hh"
+
+#include "param.hh"
+#include "param_modifier.hh"
+#include "param_visitor.hh"
+
+#include "logger.hh"
+#include "worker_pool.hh"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+LOGGER( ptlog, "param_traversal" );
+
+namespace scarab
+{
+    namespace
+    {
+        // The container currently being passed to a visitor by the traversal on this thread,
+        // and whether the base-class operator() asked to descend into it
+        struct dispatch_state
+        {
+            const param* f_container;
+            bool f_descend;
+        };
+        thread_local dispatch_state* s_dispatch = nullptr;
+
+        // Sets the dispatch state for this thread, and restores the previous one (from an enclosing traversal) when done
+        class dispatch_guard
+        {
+            public:
+                dispatch_guard( dispatch_state* a_state ) :
+                        f_previous( s_dispatch )
+                {
+                    s_dispatch = a_state;
+                }
+                ~dispatch_guard()
+                {
+                    s_dispatch = f_previous;
+                }
+            private:
+                dispatch_state* f_previous;
+        };
+
+        // XParam is `const param` for visitors and `param` for modifiers
+        template< typename XParam, typename XOperation >
+        class traversal
+        {
+            public:
+                traversal( const param_traversal& a_options, const XOperation& an_operation, bool an_allow_parallel ) :
+                        f_options( a_options ),
+                        f_operation( an_operation ),
+                        f_allow_parallel( an_allow_parallel && a_options.get_n_threads() > 1 ),
+                        f_stack(),
+                        f_pool(),
+                        f_serial()
+                {}
+
+                void run( XParam& a_root )
+                {
+                    f_stack.clear();
+                    f_stack.push_back( entry{ &a_root, false } );
+                    drain();
+                    return;
+                }
+
+                void run_elements( XParam& a_container )
+                {
+                    f_stack.clear();
+                    descend( a_container );
+                    drain();
+                    return;
+                }
+
+            private:
+                // A param to dispatch, or (if f_leave is set) a container whose elements have all been visited
+                struct entry
+                {
+                    XParam* f_param;
+                    bool f_leave;
+                };
+
+                void drain()
+                {
+                    while( ! f_stack.empty() )
+                    {
+                        entry t_entry = f_stack.back();
+                        f_stack.pop_back();
+                        if( t_entry.f_leave )
+                        {
+                            leave( *t_entry.f_param );
+                        }
+                        else if( dispatch( *t_entry.f_param ) )
+                        {
+                            // the container is left once everything pushed after this has come off the stack
+                            f_stack.push_back( entry{ t_entry.f_param, true } );
+                            descend( *t_entry.f_param );
+                        }
+                    }
+                    return;
+                }
+
+                // Passes a_param to the operation; returns true if its elements should be visited
+                bool dispatch( XParam& a_param )
+                {
+                    if( ! a_param.is_array() && ! a_param.is_node() )
+                    {
+                        a_param.accept( f_operation );
+                        return false;
+                    }
+                    dispatch_state t_state{ &a_param, false };
+                    dispatch_guard t_guard( &t_state );
+                    a_param.accept( f_operation );
+                    return t_state.f_descend;
+                }
+
+                void leave( XParam& a_container )
+                {
+                    if( a_container.is_array() ) f_operation.leave( a_container.as_array() );
+                    else f_operation.leave( a_container.as_node() );
+                    return;
+                }
+
+                void descend( XParam& a_container )
+                {
+                    std::size_t t_size = a_container.is_array() ? a_container.as_array().size() : a_container.as_node().size();
+                    if( f_allow_parallel && t_size >= f_options.get_parallel_threshold() )
+                    {
+                        fan_out( a_container, t_size );
+                        return;
+                    }
+
+                    // push in reverse so that the elements come off the stack in order
+                    std::size_t t_first = f_stack.size();
+                    add_elements( a_container, f_stack );
+                    std::reverse( f_stack.begin() + t_first, f_stack.end() );
+                    return;
+                }
+
+                template< typename XEntries >
+                static void add_elements( XParam& a_container, XEntries& a_elements )
+                {
+                    if( a_container.is_array() )
+                    {
+                        for( auto& t_element : a_container.as_array() ) a_elements.push_back( { &t_element, false } );
+                    }
+                    else
+                    {
+                        for( auto& t_element : a_container.as_node() ) a_elements.push_back( { &t_element, false } );
+                    }
+                    return;
+                }
+
+                // Distributes the sub-trees of a_container's elements over the pool's threads; each is traversed serially
+                void fan_out( XParam& a_container, std::size_t a_size )
+                {
+                    std::vector< entry > t_elements;
+                    t_elements.reserve( a_size );
+                    add_elements( a_container, t_elements );
+
+                    // the pool and the serial traversals are made once, and reused for every container that's distributed
+                    if( ! f_pool )
+                    {
+                        f_pool.reset( new worker_pool( f_options.get_n_threads() ) );
+                        for( unsigned i_thread = 0; i_thread < f_pool->get_n_threads(); ++i_thread )
+                        {
+                            f_serial.emplace_back( new traversal( f_options, f_operation, false ) );
+                        }
+                    }
+
+                    LTRACE( ptlog, "Traversing " << t_elements.size() << " elements on up to " << f_pool->get_n_threads() << " threads" );
+                    f_pool->run( t_elements.size(), [this, &t_elements]( std::size_t an_index, unsigned a_thread )
+                    {
+                        f_serial[a_thread]->run( *t_elements[an_index].f_param );
+                        return;
+                    } );
+                    return;
+                }
+
+                const param_traversal& f_options;
+                const XOperation& f_operation;
+                bool f_allow_parallel;
+                std::vector< entry > f_stack;
+
+                std::unique_ptr< worker_pool > f_pool;
+                std::vector< std::unique_ptr< traversal > > f_serial;
+        };
+
+        typedef traversal< const param, param_visitor > visitor_traversal;
+        typedef traversal< param, param_modifier > modifier_traversal;
+    }
+
+
+    param_traversal::param_traversal() :
+            param_traversal( 1 )
+    {}
+
+    param_traversal::param_traversal( unsigned a_n_threads, std::size_t a_parallel_threshold ) :
+            f_n_threads( a_n_threads == 0 ? std::max( 1U, std::thread::hardware_concurrency() ) : a_n_threads ),
+            f_parallel_threshold( std::max< std::size_t >( 1, a_parallel_threshold ) )
+    {}
+
+    param_traversal::~param_traversal()
+    {}
+
+    void param_traversal::visit( const param& a_root, const param_visitor& a_visitor ) const
+    {
+        visitor_traversal( *this, a_visitor, true ).run( a_root );
+        return;
+    }
+
+    void param_traversal::modify( param& a_root, const param_modifier& a_modifier ) const
+    {
+        modifier_traversal( *this, a_modifier, true ).run( a_root );
+        return;
+    }
+
+    void param_traversal::visit_elements( const param& a_container, const param_visitor& a_visitor ) const
+    {
+        if( ! a_container.is_array() && ! a_container.is_node() ) return;
+        visitor_traversal( *this, a_visitor, true ).run_elements( a_container );
+        return;
+    }
+
+    void param_traversal::modify_elements( param& a_container, const param_modifier& a_modifier ) const
+    {
+        if( ! a_container.is_array() && ! a_container.is_node() ) return;
+        modifier_traversal( *this, a_modifier, true ).run_elements( a_container );
+        return;
+    }
+
+    bool param_traversal::defer_descent( const param& a_container )
+    {
+        if( s_dispatch == nullptr || s_dispatch->f_container != &a_container ) return false;
+        s_dispatch->f_descend = true;
+        return true;
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,85 @@
+/*
+ * param_traversal.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_TRAVERSAL_HH_
+#define SCARAB_PARAM_TRAVERSAL_HH_
+
+#include "param_fwd.hh"
+
+#include "member_variables.hh"
+#include "scarab_api.hh"
+
+#include <cstddef>
+
+namespace scarab
+{
+    /*!
+     @class param_traversal
+     @author agent
+
+     @brief Walks a param structure with a visitor or modifier, using an explicit stack instead of recursion
+
+     @details
+     The traversal has the same meaning as the recursive form, `a_root.accept( a_visitor )`:
+     each element is passed to the visitor's operator(), and a container's elements are visited
+     if (and only if) the visitor's operator() for that container calls through to the base-class operator(),
+     which is what param_visitor's and param_modifier's defaults do.
+     Instead of recursing, the base-class operator() tells the traversal to push the container's elements onto its stack,
+     so the depth of the structure is not limited by the size of the call stack.
+     A visitor that descends into a container itself (by calling accept() on the elements) still works as before.
+
+     Because the base-class operator() returns before the elements are visited, it's the pre-order part of the recursive form only:
+     code that a derived operator() runs after calling the base-class operator() is not run after the elements.
+     Post-order work goes in the visitor's leave() functions instead; the traversal calls leave() for a container
+     once everything below it has been visited (for containers it descended into at the base-class operator()'s request).
+
+     The base-class operator()s use a serial param_traversal when called outside of one,
+     so visitors and modifiers that rely on the defaults (e.g. param_env_modifier) are always iterative.
+
+     Serial traversal visits elements in the same (depth-first, in-order) sequence as the recursive form.
+
+     In parallel mode (n_threads > 1), the elements of the first container on each branch that has at least
+     parallel_threshold elements are distributed over n_threads threads (including the calling thread),
+     each of which traverses its share of the sub-trees serially.  In that case:
+      - the order in which elements are visited is not defined;
+      - the visitor's operator()s are called concurrently, so they (and any mutable state) must be thread-safe;
+      - a modifier may only change the element it's given (and its contents);
+      - leave() for the distributed container is called on the calling thread, after all of its sub-trees are done;
+      - if an operator() throws, the remaining sub-trees are abandoned and the first exception is rethrown on the calling thread.
+
+     The threads are started the first time a container is distributed, and are reused for the rest of that visit() or modify().
+    */
+    class SCARAB_API param_traversal
+    {
+        public:
+            /// Serial traversal
+            param_traversal();
+            /// Parallel traversal on a_n_threads threads (0 uses the hardware concurrency), for containers of at least a_parallel_threshold elements
+            param_traversal( unsigned a_n_threads, std::size_t a_parallel_threshold = 1024 );
+            virtual ~param_traversal();
+
+            mv_accessible( unsigned, n_threads );
+            mv_accessible( std::size_t, parallel_threshold );
+
+        public:
+            /// Visits a_root and everything below it
+            void visit( const param& a_root, const param_visitor& a_visitor ) const;
+            /// Modifies a_root and everything below it
+            void modify( param& a_root, const param_modifier& a_modifier ) const;
+
+            /// Visits the elements of a_container (an array or a node) and everything below them
+            void visit_elements( const param& a_container, const param_visitor& a_visitor ) const;
+            /// Modifies the elements of a_container (an array or a node) and everything below them
+            void modify_elements( param& a_container, const param_modifier& a_modifier ) const;
+
+            /// For use by the base-class operator()s: returns true if a traversal on this thread is dispatching a_container, and will descend into it (and then call leave())
+            static bool defer_descent( const param& a_container );
+    };
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_TRAVERSAL_HH_ */
@@ -0,0 +1,159 @@
+/*
+ * param_typed_array.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_typed_array.hh"
+
+#include "param_base_impl.hh"
+#include "param_helpers_impl.hh"
+
+#include <limits>
+#include <sstream>
+
+namespace scarab
+{
+    param_typed_array_base::param_typed_array_base() :
+            param()
+    {}
+
+    param_typed_array_base::param_typed_array_base( const param_typed_array_base& orig ) :
+            param( orig )
+    {}
+
+    param_typed_array_base::param_typed_array_base( param_typed_array_base&& orig ) :
+            param( std::move(orig) )
+    {}
+
+    param_typed_array_base::~param_typed_array_base()
+    {}
+
+    bool param_typed_array_base::is_null() const
+    {
+        return false;
+    }
+
+    bool param_typed_array_base::is_typed_array() const
+    {
+        return true;
+    }
+
+    bool param_typed_array_base::has_subset( const param& a_subset ) const
+    {
+        if( a_subset.is_typed_array() ) return a_subset.as_typed_array().size() <= size();
+        if( ! a_subset.is_array() ) return false;
+        const param_array& t_subset_array = a_subset.as_array();
+        if( t_subset_array.size() > size() ) return false;
+        for( const param& t_item : t_subset_array )
+        {
+            if( ! t_item.is_value() ) return false;
+        }
+        return true;
+    }
+
+    std::string param_typed_array_base::element_type_name() const
+    {
+        switch( get_element_type() )
+        {
+            case k_double: return "double";
+            case k_int64: return "int64";
+            case k_uint64: return "uint64";
+        }
+        throw error() << "Unknown typed-array element type";
+    }
+
+    void param_typed_array_base::merge( const param_typed_array_base& a_typed_array )
+    {
+        if( get_element_type() != a_typed_array.get_element_type() )
+        {
+            throw error() << "Cannot merge a typed array of " << a_typed_array.element_type_name() << " elements into one of " << element_type_name() << " elements";
+        }
+        switch( get_element_type() )
+        {
+            case k_double:
+                as< double >() = a_typed_array.as< double >();
+                break;
+            case k_int64:
+                as< std::int64_t >() = a_typed_array.as< std::int64_t >();
+                break;
+            case k_uint64:
+                as< std::uint64_t >() = a_typed_array.as< std::uint64_t >();
+                break;
+        }
+        return;
+    }
+
+    param_array param_typed_array_base::to_param_array() const
+    {
+        param_array t_array;
+        for( unsigned i_element = 0; i_element < size(); ++i_element )
+        {
+            t_array.push_back( value_at( i_element ) );
+        }
+        return t_array;
+    }
+
+    std::string param_typed_array_base::to_string() const
+    {
+        std::stringstream out;
+        std::string indentation;
+        for ( unsigned i=0; i<param::s_indent_level; ++i )
+            indentation += "    ";
+        out << '\n' << indentation << "[\n";
+        for( unsigned i_element = 0; i_element < size(); ++i_element )
+        {
+            out << indentation << "    " << value_at( i_element ).to_string() << '\n';
+        }
+        out << indentation << "]\n";
+        return out.str();
+    }
+
+    namespace
+    {
+        template< typename XElement >
+        param_ptr_t make_typed_array( const param_array& an_array )
+        {
+            std::unique_ptr< param_typed_array< XElement > > t_typed( new param_typed_array< XElement >( an_array.size() ) );
+            XElement* t_data = t_typed->data();
+            for( const param& t_item : an_array )
+            {
+                *t_data++ = t_item.as_value().as< XElement >();
+            }
+            return t_typed;
+        }
+    }
+
+    param_ptr_t to_typed_array( const param_array& an_array )
+    {
+        typed_array_classifier t_classifier;
+        for( const param& t_item : an_array )
+        {
+            if( ! t_item.is_value() || ! t_classifier.add( t_item.as_value() ) ) return param_ptr_t();
+        }
+
+        param_typed_array_base::element_type t_type;
+        if( ! t_classifier.classify( t_type ) ) return param_ptr_t();
+        return to_typed_array( an_array, t_type );
+    }
+
+    param_ptr_t to_typed_array( const param_array& an_array, param_typed_array_base::element_type an_element_type )
+    {
+        switch( an_element_type )
+        {
+            case param_typed_array_base::k_double: return make_typed_array< double >( an_array );
+            case param_typed_array_base::k_int64: return make_typed_array< std::int64_t >( an_array );
+            case param_typed_array_base::k_uint64: return make_typed_array< std::uint64_t >( an_array );
+        }
+        return param_ptr_t();
+    }
+
+    SCARAB_API std::ostream& operator<<(std::ostream& out, const param_typed_array_base& a_value)
+    {
+        return out << a_value.to_string();
+    }
+
+} /* namespace scarab */
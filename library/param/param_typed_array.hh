@@ -0,0 +1,544 @@
+/*
+ * param_typed_array.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_TYPED_ARRAY_HH_
+#define SCARAB_PARAM_TYPED_ARRAY_HH_
+
+#include "param_base.hh"
+#include "param_shared_contents.hh"
+#include "param_value.hh"
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace scarab
+{
+    class param_array;
+
+    /*!
+     @class param_typed_array_base
+     @author agent
+
+     @brief Base class for param_typed_array, giving access to a typed array without knowing its element type
+
+     @details
+     A typed array is neither a value, an array, nor a node: is_typed_array() is true, and the other type checks are false.
+     Visitors and modifiers see it through their operator() for param.
+    */
+    class SCARAB_API param_typed_array_base : public param
+    {
+        public:
+            enum element_type
+            {
+                k_double = 0,
+                k_int64 = 1,
+                k_uint64 = 2
+            };
+
+        public:
+            param_typed_array_base();
+            param_typed_array_base( const param_typed_array_base& orig );
+            param_typed_array_base( param_typed_array_base&& orig );
+            virtual ~param_typed_array_base();
+
+            virtual bool is_null() const;
+            virtual bool is_typed_array() const;
+
+            /// True if a_subset is a typed array or an array of values, and is no larger than this array
+            virtual bool has_subset( const param& a_subset ) const;
+
+            virtual element_type get_element_type() const = 0;
+            /// Returns "double", "int64", or "uint64"
+            std::string element_type_name() const;
+
+            virtual unsigned size() const = 0;
+            bool empty() const;
+
+            /// Returns a copy of the element at a_index as a param_value; throws a scarab::error if a_index is out-of-range
+            virtual param_value value_at( unsigned a_index ) const = 0;
+
+            /// Returns true if the elements are of type XElement
+            template< typename XElement >
+            bool holds() const;
+            /// Returns this as a param_typed_array< XElement >; throws a scarab::error if the elements aren't of type XElement
+            template< typename XElement >
+            const param_typed_array< XElement >& as() const;
+            template< typename XElement >
+            param_typed_array< XElement >& as();
+
+            /// Replaces the contents with those of a_typed_array, which must have the same element type
+            void merge( const param_typed_array_base& a_typed_array );
+
+            /// Converts to a param_array of param_values
+            param_array to_param_array() const;
+
+            virtual std::string to_string() const;
+    };
+
+    /// Element type of a param_typed_array
+    template< typename XElement >
+    struct typed_array_element;
+
+    template<>
+    struct typed_array_element< double >
+    {
+        static constexpr param_typed_array_base::element_type s_type = param_typed_array_base::k_double;
+    };
+
+    template<>
+    struct typed_array_element< std::int64_t >
+    {
+        static constexpr param_typed_array_base::element_type s_type = param_typed_array_base::k_int64;
+    };
+
+    template<>
+    struct typed_array_element< std::uint64_t >
+    {
+        static constexpr param_typed_array_base::element_type s_type = param_typed_array_base::k_uint64;
+    };
+
+    /// The elements of a param_typed_array (used by shared_contents)
+    template< typename XElement >
+    class typed_array_contents : public std::vector< XElement >
+    {
+        public:
+            using std::vector< XElement >::vector;
+    };
+
+    /// Copies the elements in a_contents (used by shared_contents)
+    template< typename XElement >
+    typed_array_contents< XElement > clone_contents( const typed_array_contents< XElement >& a_contents )
+    {
+        return a_contents;
+    }
+
+    /*!
+     @class param_typed_array
+     @author agent
+
+     @brief Array of numbers of one type, stored contiguously
+
+     @details
+     A param_array holds each number in its own param_value, with a pointer to it; a typed array stores the numbers
+     themselves in one buffer, so an array of a million doubles uses 8 MB, and can be passed to numerical code
+     (or, from Python, viewed with numpy) without copying.
+     XElement may be double, std::int64_t, or std::uint64_t.
+
+     data() and size() give access to the buffer; data() is valid until the array is resized or reassigned.
+
+     As with param_node and param_array, the buffer is shared with copies until one of them is modified (see shared_contents).
+     The non-const accessors (data(), operator[], at(), begin(), and end()) make the buffer unique first,
+     so for element-by-element writes it's fastest to get data() once.
+
+     The JSON and YAML input codecs create typed arrays from arrays of numbers when the "typed-arrays" option is true,
+     and the output codecs write them as arrays of numbers.
+    */
+    template< typename XElement >
+    class param_typed_array : public param_typed_array_base
+    {
+        static_assert( std::is_same< XElement, double >::value || std::is_same< XElement, std::int64_t >::value || std::is_same< XElement, std::uint64_t >::value,
+                       "param_typed_array elements must be double, std::int64_t, or std::uint64_t" );
+
+        public:
+            typedef XElement value_type;
+            typedef typed_array_contents< XElement > contents;
+            typedef XElement* iterator;
+            typedef const XElement* const_iterator;
+
+        public:
+            param_typed_array();
+            explicit param_typed_array( unsigned a_size, XElement a_value = XElement() );
+            param_typed_array( std::initializer_list< XElement > a_values );
+            param_typed_array( const XElement* a_values, unsigned a_size );
+            param_typed_array( const param_typed_array& orig );
+            param_typed_array( param_typed_array&& orig );
+            virtual ~param_typed_array();
+
+            param_typed_array& operator=( const param_typed_array& rhs );
+            param_typed_array& operator=( param_typed_array&& rhs );
+
+            virtual param_ptr_t clone() const;
+            virtual param_ptr_t move_clone();
+
+            virtual element_type get_element_type() const;
+
+            virtual unsigned size() const;
+
+            /// Returns true if the buffer is currently shared with a copy
+            bool is_shared() const;
+            /// Returns true if this array and a_other share their buffer, in which case their elements are identical
+            bool shares_contents_with( const param_typed_array& a_other ) const;
+
+            const XElement* data() const;
+            XElement* data();
+
+            /// Behavior is undefined if a_index is out-of-range
+            XElement operator[]( unsigned a_index ) const;
+            /// Behavior is undefined if a_index is out-of-range
+            XElement& operator[]( unsigned a_index );
+
+            /// Throws a scarab::error if a_index is out-of-range
+            XElement at( unsigned a_index ) const;
+            /// Throws a scarab::error if a_index is out-of-range
+            XElement& at( unsigned a_index );
+
+            virtual param_value value_at( unsigned a_index ) const;
+
+            const_iterator begin() const;
+            const_iterator end() const;
+            iterator begin();
+            iterator end();
+
+            void push_back( XElement a_value );
+            /// Sets the size of the array; new elements are set to a_value
+            void resize( unsigned a_size, XElement a_value = XElement() );
+            void reserve( unsigned a_capacity );
+            /// Replaces the contents with a_size elements copied from a_values
+            void assign( const XElement* a_values, unsigned a_size );
+            void clear();
+
+        protected:
+            shared_contents< contents > f_contents;
+    };
+
+    typedef param_typed_array< double > param_double_array;
+    typedef param_typed_array< std::int64_t > param_int64_array;
+    typedef param_typed_array< std::uint64_t > param_uint64_array;
+
+    /*!
+     @class typed_array_classifier
+     @author agent
+
+     @brief Chooses the element type of a typed array from the numbers that will be in it
+
+     @details
+     This is the one rule for typed arrays: to_typed_array() and the "typed-arrays" option of every input codec use it,
+     so an array of numbers becomes the same typed array however it's read.
+     Each number is added as a double, a signed integer, or an unsigned integer.
+     The codecs add every non-negative integer as unsigned, even where they store it in a param_value as a signed integer (as JSON does),
+     so add() only gives the same result for param_values that hold non-negative integers as unsigned.
+
+     The element type is double if any number is a double, int64 if any is a signed integer, and uint64 otherwise.
+     There's no element type if there are no numbers, or if there are signed integers and unsigned integers too large for int64.
+    */
+    class SCARAB_API typed_array_classifier
+    {
+        public:
+            typed_array_classifier();
+
+            void add_double();
+            void add_int();
+            void add_uint( std::uint64_t a_value );
+            /// Adds a_value and returns true if it's a number; returns false otherwise (bools aren't numbers)
+            bool add( const param_value& a_value );
+
+            /// Returns true and sets an_element_type if the numbers that were added can share a typed array
+            bool classify( param_typed_array_base::element_type& an_element_type ) const;
+
+        private:
+            bool f_empty;
+            bool f_has_double;
+            bool f_has_int;
+            bool f_has_large_uint;
+    };
+
+    /// If every item in an_array is a number (bools don't count), returns a typed array with the same numbers; otherwise returns nullptr.
+    /// The element type is chosen by typed_array_classifier; if there's none (e.g. an_array is empty), returns nullptr.
+    SCARAB_API param_ptr_t to_typed_array( const param_array& an_array );
+    /// Returns a typed array with the numbers in an_array, converted to an_element_type; every item in an_array must be a number
+    SCARAB_API param_ptr_t to_typed_array( const param_array& an_array, param_typed_array_base::element_type an_element_type );
+
+    SCARAB_API std::ostream& operator<<(std::ostream& out, const param_typed_array_base& a_value);
+
+
+    //***************************************
+    //*********** IMPLEMENTATION ************
+    //***************************************
+
+    inline bool param_typed_array_base::empty() const
+    {
+        return size() == 0;
+    }
+
+    inline typed_array_classifier::typed_array_classifier() :
+            f_empty( true ),
+            f_has_double( false ),
+            f_has_int( false ),
+            f_has_large_uint( false )
+    {}
+
+    inline void typed_array_classifier::add_double()
+    {
+        f_empty = false;
+        f_has_double = true;
+        return;
+    }
+
+    inline void typed_array_classifier::add_int()
+    {
+        f_empty = false;
+        f_has_int = true;
+        return;
+    }
+
+    inline void typed_array_classifier::add_uint( std::uint64_t a_value )
+    {
+        f_empty = false;
+        f_has_large_uint = f_has_large_uint || a_value > std::uint64_t( std::numeric_limits< std::int64_t >::max() );
+        return;
+    }
+
+    inline bool typed_array_classifier::add( const param_value& a_value )
+    {
+        if( a_value.is_double() ) add_double();
+        else if( a_value.is_int() ) add_int();
+        else if( a_value.is_uint() ) add_uint( a_value.as_uint() );
+        else return false;
+        return true;
+    }
+
+    inline bool typed_array_classifier::classify( param_typed_array_base::element_type& an_element_type ) const
+    {
+        if( f_empty ) return false;
+        if( f_has_double ) an_element_type = param_typed_array_base::k_double;
+        else if( ! f_has_int ) an_element_type = param_typed_array_base::k_uint64;
+        else if( f_has_large_uint ) return false;
+        else an_element_type = param_typed_array_base::k_int64;
+        return true;
+    }
+
+    template< typename XElement >
+    inline bool param_typed_array_base::holds() const
+    {
+        return get_element_type() == typed_array_element< XElement >::s_type;
+    }
+
+    template< typename XElement >
+    const param_typed_array< XElement >& param_typed_array_base::as() const
+    {
+        if( holds< XElement >() ) return *static_cast< const param_typed_array< XElement >* >( this );
+        throw error() << "Typed array holds " << element_type_name() << " elements, not the requested type";
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >& param_typed_array_base::as()
+    {
+        if( holds< XElement >() ) return *static_cast< param_typed_array< XElement >* >( this );
+        throw error() << "Typed array holds " << element_type_name() << " elements, not the requested type";
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array() :
+            param_typed_array_base(),
+            f_contents()
+    {}
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array( unsigned a_size, XElement a_value ) :
+            param_typed_array_base(),
+            f_contents()
+    {
+        if( a_size != 0 ) f_contents.mutate().assign( a_size, a_value );
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array( std::initializer_list< XElement > a_values ) :
+            param_typed_array_base(),
+            f_contents()
+    {
+        if( a_values.size() != 0 ) f_contents.mutate().assign( a_values.begin(), a_values.end() );
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array( const XElement* a_values, unsigned a_size ) :
+            param_typed_array_base(),
+            f_contents()
+    {
+        assign( a_values, a_size );
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array( const param_typed_array& orig ) :
+            param_typed_array_base( orig ),
+            f_contents( orig.f_contents )
+    {}
+
+    template< typename XElement >
+    param_typed_array< XElement >::param_typed_array( param_typed_array&& orig ) :
+            param_typed_array_base( std::move(orig) ),
+            f_contents( std::move(orig.f_contents) )
+    {}
+
+    template< typename XElement >
+    param_typed_array< XElement >::~param_typed_array()
+    {}
+
+    template< typename XElement >
+    param_typed_array< XElement >& param_typed_array< XElement >::operator=( const param_typed_array& rhs )
+    {
+        f_contents = rhs.f_contents;
+        return *this;
+    }
+
+    template< typename XElement >
+    param_typed_array< XElement >& param_typed_array< XElement >::operator=( param_typed_array&& rhs )
+    {
+        f_contents = std::move(rhs.f_contents);
+        return *this;
+    }
+
+    template< typename XElement >
+    param_ptr_t param_typed_array< XElement >::clone() const
+    {
+        return param_ptr_t( new param_typed_array< XElement >( *this ) );
+    }
+
+    template< typename XElement >
+    param_ptr_t param_typed_array< XElement >::move_clone()
+    {
+        return param_ptr_t( new param_typed_array< XElement >( std::move(*this) ) );
+    }
+
+    template< typename XElement >
+    inline param_typed_array_base::element_type param_typed_array< XElement >::get_element_type() const
+    {
+        return typed_array_element< XElement >::s_type;
+    }
+
+    template< typename XElement >
+    inline unsigned param_typed_array< XElement >::size() const
+    {
+        return f_contents.get().size();
+    }
+
+    template< typename XElement >
+    inline bool param_typed_array< XElement >::is_shared() const
+    {
+        return f_contents.is_shared();
+    }
+
+    template< typename XElement >
+    inline bool param_typed_array< XElement >::shares_contents_with( const param_typed_array& a_other ) const
+    {
+        return f_contents.shares_with( a_other.f_contents );
+    }
+
+    template< typename XElement >
+    inline const XElement* param_typed_array< XElement >::data() const
+    {
+        return f_contents.get().data();
+    }
+
+    template< typename XElement >
+    inline XElement* param_typed_array< XElement >::data()
+    {
+        return f_contents.leak().data();
+    }
+
+    template< typename XElement >
+    inline XElement param_typed_array< XElement >::operator[]( unsigned a_index ) const
+    {
+        return f_contents.get()[ a_index ];
+    }
+
+    template< typename XElement >
+    inline XElement& param_typed_array< XElement >::operator[]( unsigned a_index )
+    {
+        return f_contents.leak()[ a_index ];
+    }
+
+    template< typename XElement >
+    XElement param_typed_array< XElement >::at( unsigned a_index ) const
+    {
+        if( a_index >= size() ) throw error() << "Index <" << a_index << "> is out of range for a typed array of size " << size();
+        return f_contents.get()[ a_index ];
+    }
+
+    template< typename XElement >
+    XElement& param_typed_array< XElement >::at( unsigned a_index )
+    {
+        if( a_index >= size() ) throw error() << "Index <" << a_index << "> is out of range for a typed array of size " << size();
+        return f_contents.leak()[ a_index ];
+    }
+
+    template< typename XElement >
+    param_value param_typed_array< XElement >::value_at( unsigned a_index ) const
+    {
+        return param_value( at( a_index ) );
+    }
+
+    template< typename XElement >
+    inline typename param_typed_array< XElement >::const_iterator param_typed_array< XElement >::begin() const
+    {
+        return data();
+    }
+
+    template< typename XElement >
+    inline typename param_typed_array< XElement >::const_iterator param_typed_array< XElement >::end() const
+    {
+        return data() + size();
+    }
+
+    template< typename XElement >
+    inline typename param_typed_array< XElement >::iterator param_typed_array< XElement >::begin()
+    {
+        return data();
+    }
+
+    template< typename XElement >
+    inline typename param_typed_array< XElement >::iterator param_typed_array< XElement >::end()
+    {
+        return data() + size();
+    }
+
+    template< typename XElement >
+    inline void param_typed_array< XElement >::push_back( XElement a_value )
+    {
+        f_contents.mutate().push_back( a_value );
+        return;
+    }
+
+    template< typename XElement >
+    void param_typed_array< XElement >::resize( unsigned a_size, XElement a_value )
+    {
+        if( a_size == size() ) return;
+        f_contents.mutate().resize( a_size, a_value );
+        return;
+    }
+
+    template< typename XElement >
+    void param_typed_array< XElement >::reserve( unsigned a_capacity )
+    {
+        f_contents.mutate().reserve( a_capacity );
+        return;
+    }
+
+    template< typename XElement >
+    void param_typed_array< XElement >::assign( const XElement* a_values, unsigned a_size )
+    {
+        if( a_size == 0 )
+        {
+            clear();
+            return;
+        }
+        f_contents.mutate().assign( a_values, a_values + a_size );
+        return;
+    }
+
+    template< typename XElement >
+    void param_typed_array< XElement >::clear()
+    {
+        f_contents.reset();
+        return;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_TYPED_ARRAY_HH_ */
@@ -7,7 +7,10 @@
 
 #define SCARAB_API_EXPORTS
 
+#include <algorithm>
+#include <cctype>
 #include <sstream>
+#include <stdexcept>
 using std::string;
 using std::stringstream;
 
@@ -109,33 +112,16 @@ namespace scarab
 
     param_value::param_value( const char* a_value ) :
             param(),
-            f_value( string() )
+            f_value( std::string( strip_quotes( a_value ) ) )
     {
         //LWARN( dlog, "param_value constructor: char* --> k_string" );
-        string t_value( a_value );
-        if( t_value.size() > 1 && t_value.front() == '\'' && t_value.back() == '\'' )
-        {
-            f_value = t_value.substr( 1, t_value.size() - 2 );
-        }
-        else
-        {
-            f_value = t_value;
-        }
     }
 
     param_value::param_value( const string& a_value ) :
             param(),
-            f_value( a_value )
+            f_value( std::string( strip_quotes( a_value ) ) )
     {
         //LWARN( dlog, "param_value constructor: string --> k_string" );
-        if( a_value.size() > 1 && a_value.front() == '\'' && a_value.back() == '\'' )
-        {
-            f_value = a_value.substr( 1, a_value.size() - 2 );
-        }
-        else
-        {
-            f_value = a_value;
-        }
     }
 
     param_value::param_value( const param_value& orig ) :
@@ -200,6 +186,50 @@ namespace scarab
         return true;
     }
 
+    std::string_view param_value::strip_quotes( std::string_view a_value )
+    {
+        if( a_value.size() > 1 && a_value.front() == '\'' && a_value.back() == '\'' )
+        {
+            return a_value.substr( 1, a_value.size() - 2 );
+        }
+        return a_value;
+    }
+
+    void param_value::check_parse_result( std::errc a_error, const std::string& a_string )
+    {
+        // use the same exceptions as std::stoull, std::stoll, and std::stod
+        if( a_error == std::errc::invalid_argument )
+        {
+            throw std::invalid_argument( "Unable to convert string to a number: <" + a_string + ">" );
+        }
+        if( a_error == std::errc::result_out_of_range )
+        {
+            throw std::out_of_range( "Number is out of range: <" + a_string + ">" );
+        }
+        return;
+    }
+
+    bool param_value::parse_bool( const std::string& a_value )
+    {
+        if( a_value.empty() ) return false;
+
+        // a string of digits is true if it's non-zero
+        if( std::all_of( a_value.begin(), a_value.end(), [](char a_char){ return ::isdigit( a_char ); } ) )
+        {
+            return a_value.find_first_not_of( '0' ) != std::string::npos;
+        }
+
+        // otherwise the string is true if it starts with "true" (case-insensitive, after any whitespace)
+        std::size_t t_start = a_value.find_first_not_of( " \t\n\v\f\r" );
+        if( t_start == std::string::npos || a_value.size() - t_start < 4 ) return false;
+        static const char s_true[] = "true";
+        for( unsigned i_char = 0; i_char < 4; ++i_char )
+        {
+            if( ::tolower( a_value[t_start + i_char] ) != s_true[i_char] ) return false;
+        }
+        return true;
+    }
+
     SCARAB_API std::ostream& operator<<(std::ostream& out, const param_value& a_value)
     {
         return out << a_value.as_string();
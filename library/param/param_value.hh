@@ -14,9 +14,16 @@
 #include "param_visitor.hh"
 #include "path.hh"
 
-#include <boost/variant.hpp>
+#include <boost/variant/static_visitor.hpp> // value visitors written for boost::variant can still derive from boost::static_visitor
 
+#include <charconv>
+#include <limits>
+#include <sstream>
 #include <stdint.h>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
 
 //#include "logger.hh"
 //LOGGER(pv_h, "param_value.hh")
@@ -30,6 +37,14 @@ namespace scarab
      @brief Param class holding values (i.e. bools, ints, floats, and strings)
 
      @details
+     The value is stored in a std::variant.  Strings use std::string, so short strings (up to 15 characters with libstdc++)
+     are stored inline without a heap allocation.
+
+     Conversions between numbers and strings use std::to_chars and std::from_chars.
+     Numbers are formatted the same way as std::to_string (e.g. doubles have 6 decimal places).
+     When converting from a string, leading whitespace and a leading '+' are skipped, and parsing stops at the first character
+     that isn't part of the number.  as_uint(), as_int(), and as_double() throw std::invalid_argument if the string does not
+     start with a number, and std::out_of_range if the number doesn't fit in the requested type.
     */
     class SCARAB_API param_value : public param
     {
@@ -102,208 +117,102 @@ namespace scarab
 
             void clear();
 
+            /// Applies a_visitor to the stored value with std::visit.
+            /// The visitor must be callable with bool&, uint64_t&, int64_t&, double&, and std::string&.
             template< typename XRetType, typename XVisitorType >
             XRetType accept_value_visitor( const XVisitorType& a_visitor );
+            /// Applies a_visitor to the stored value without modifying it;
+            /// the visitor must be callable with const bool&, const uint64_t&, const int64_t&, const double&, and const std::string&.
+            template< typename XRetType, typename XVisitorType >
+            XRetType accept_value_visitor( const XVisitorType& a_visitor ) const;
 
         private:
-            boost::variant< bool, uint64_t, int64_t, double, std::string > f_value;
+            std::variant< bool, uint64_t, int64_t, double, std::string > f_value;
+
+            /// Parses a number from the start of a_string; returns std::errc() on success
+            template< typename XNumType >
+            static std::errc parse_number( std::string_view a_string, XNumType& a_number );
+            /// Throws std::invalid_argument or std::out_of_range if parsing a number from a_string failed with a_error
+            static void check_parse_result( std::errc a_error, const std::string& a_string );
+            static bool parse_bool( const std::string& a_value );
+            /// Removes a single pair of single quotes that wraps a_value
+            static std::string_view strip_quotes( std::string_view a_value );
 
             //*********************
             // Visitor Classes
             //*********************
 
-            class are_strict_equals : public boost::static_visitor< bool >
+            /// Returns a view of the value in string form; numbers are formatted into the visitor's own buffer,
+            /// so the view is only valid as long as the visitor exists and isn't reused.
+            class string_view_visitor
             {
                 public:
-                    template < typename T, typename U >
-                    bool operator()( const T &, const U & ) const
+                    std::string_view operator()( bool a_value )
                     {
-                        return false; // cannot compare different types
+                        return a_value ? "true" : "false";
                     }
-
-                    template < typename T >
-                    bool operator()( const T & lhs, const T & rhs ) const
+                    std::string_view operator()( const std::string& a_value )
                     {
-                        return lhs == rhs;
+                        return a_value;
                     }
-            };
-
-            class are_loose_equals : public boost::static_visitor< bool >
-            {
-                public:
-                    template < typename T, typename U >
-                    bool operator()( const T & rhs, const U & lhs ) const
+                    std::string_view operator()( double a_value )
                     {
-                        as_string_visitor t_as_string;
-                        return t_as_string(lhs) == t_as_string(rhs); // cannot compare different types
+                        // matches std::to_string
+                        std::to_chars_result t_result = std::to_chars( f_buffer, f_buffer + s_buffer_size, a_value, std::chars_format::fixed, 6 );
+                        return std::string_view( f_buffer, t_result.ptr - f_buffer );
                     }
-
-                    template < typename T >
-                    bool operator()( const T & lhs, const T & rhs ) const
+                    template< typename T >
+                    std::string_view operator()( T a_value )
                     {
-                        return lhs == rhs;
+                        std::to_chars_result t_result = std::to_chars( f_buffer, f_buffer + s_buffer_size, a_value );
+                        return std::string_view( f_buffer, t_result.ptr - f_buffer );
                     }
-            };
-
 
-            class type_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef std::string result_type;
-                    std::string operator()( bool ) const
-                    {
-                        return "bool";
-                    }
-                    std::string operator()( uint64_t ) const
-                    {
-                        return "uint";
-                    }
-                    std::string operator()( int64_t ) const
-                    {
-                        return "int";
-                    }
-                    std::string operator()( double ) const
-                    {
-                        return "double";
-                    }
-                    std::string operator()( const std::string& ) const
-                    {
-                        return "string";
-                    }
+                private:
+                    // large enough for any double in fixed notation with 6 decimal places
+                    static constexpr std::size_t s_buffer_size = std::numeric_limits< double >::max_exponent10 + 16;
+                    char f_buffer[ s_buffer_size ];
             };
 
             template< typename XValType >
-            class get_visitor : public boost::static_visitor<>
+            class get_visitor
             {
                 public:
-                    typedef XValType result_type;
-                    XValType operator()( bool a_value ) const
-                    {
-                        return static_cast< XValType >( a_value );
-                    }
-                    XValType operator()( uint64_t a_value ) const
-                    {
-                        return static_cast< XValType >( a_value );
-                    }
-                    XValType operator()( int64_t a_value ) const
-                    {
-                        return static_cast< XValType >( a_value );
-                    }
-                    XValType operator()( double a_value ) const
-                    {
-                        return static_cast< XValType >( a_value );
-                    }
                     XValType operator()( const std::string& a_value ) const
                     {
-                        std::stringstream t_conv;
-                        t_conv << a_value;
-                        XValType t_return;
-                        t_conv >> t_return;
-                        return t_return;
-                    }
-            };
-
-            class is_bool_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef bool result_type;
-                    bool operator()( bool ) const
-                    {
-                        return true;
-                    }
-                    template< typename T >
-                    bool operator()( T ) const
-                    {
-                        return false;
-                    }
-            };
-
-            class is_int_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef bool result_type;
-                    bool operator()( int64_t ) const
-                    {
-                        return true;
-                    }
-                    template< typename T >
-                    bool operator()( T ) const
-                    {
-                        return false;
-                    }
-            };
-
-            class is_uint_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef bool result_type;
-                    bool operator()( uint64_t ) const
-                    {
-                        return true;
-                    }
-                    template< typename T >
-                    bool operator()( T ) const
-                    {
-                        return false;
-                    }
-            };
-
-            class is_double_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef bool result_type;
-                    bool operator()( double ) const
-                    {
-                        return true;
-                    }
-                    template< typename T >
-                    bool operator()( T ) const
-                    {
-                        return false;
-                    }
-            };
-
-            class is_string_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef bool result_type;
-                    bool operator()( const std::string& ) const
-                    {
-                        return true;
+                        // characters and non-arithmetic types keep the stream-based extraction
+                        if constexpr( std::is_arithmetic< XValType >::value && sizeof( XValType ) > 1 )
+                        {
+                            XValType t_return = XValType();
+                            param_value::parse_number( a_value, t_return );
+                            return t_return;
+                        }
+                        else
+                        {
+                            std::stringstream t_conv;
+                            t_conv << a_value;
+                            XValType t_return;
+                            t_conv >> t_return;
+                            return t_return;
+                        }
                     }
                     template< typename T >
-                    bool operator()( T ) const
+                    XValType operator()( T a_value ) const
                     {
-                        return false;
+                        return static_cast< XValType >( a_value );
                     }
             };
 
-            class as_bool_visitor : public boost::static_visitor<>
+            class as_bool_visitor
             {
                 public:
-                    typedef bool result_type;
                     bool operator()( bool a_value ) const
                     {
                         return a_value;
                     }
                     bool operator()( const std::string& a_value ) const
                     {
-                        if( a_value.empty() ) return false;
-
-                        std::string t_str_val;
-                        bool t_is_numeric = true;
-                        for( std::string::const_iterator t_val_it = a_value.begin(); t_val_it != a_value.end(); ++t_val_it )
-                        {
-                            t_is_numeric = t_is_numeric && ::isdigit( *t_val_it );
-                            t_str_val.push_back( ::tolower( *t_val_it ) );
-                        }
-
-                        if( t_is_numeric ) return std::stoi( t_str_val );
-
-                        std::istringstream t_iss_val( t_str_val );
-                        bool t_bool_val;
-                        t_iss_val >> std::boolalpha >> t_bool_val;
-                        return t_bool_val;
+                        return param_value::parse_bool( a_value );
                     }
                     template< typename T >
                     bool operator()( T a_value ) const
@@ -312,74 +221,26 @@ namespace scarab
                     }
             };
 
-            class as_uint_visitor : public boost::static_visitor<>
+            template< typename XNumType >
+            class as_number_visitor
             {
                 public:
-                    typedef uint64_t result_type;
-                    uint64_t operator()( const std::string& a_value ) const
+                    XNumType operator()( const std::string& a_value ) const
                     {
-                        return std::stoull( a_value );
-                    }
-                    template< typename T >
-                    uint64_t operator()( T a_value ) const
-                    {
-                        return (uint64_t)a_value;
-                    }
-            };
-
-            class as_int_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef int64_t result_type;
-                    int64_t operator()( const std::string& a_value ) const
-                    {
-                        return std::stoll( a_value );
-                    }
-                    template< typename T >
-                    int64_t operator()( T a_value ) const
-                    {
-                        return (int64_t)a_value;
-                    }
-            };
-
-            class as_double_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef double result_type;
-                    double operator()( const std::string& a_value ) const
-                    {
-                        return std::stod( a_value );
-                    }
-                    template< typename T >
-                    double operator()( T a_value ) const
-                    {
-                        return (double)a_value;
-                    }
-            };
-
-            class as_string_visitor : public boost::static_visitor<>
-            {
-                public:
-                    typedef std::string result_type;
-                    std::string operator()( bool a_value ) const
-                    {
-                        return a_value ? "true" : "false";
-                    }
-                    std::string operator()( const std::string& a_value ) const
-                    {
-                        return a_value;
+                        XNumType t_return = XNumType();
+                        param_value::check_parse_result( param_value::parse_number( a_value, t_return ), a_value );
+                        return t_return;
                     }
                     template< typename T >
-                    std::string operator()( T a_value ) const
+                    XNumType operator()( T a_value ) const
                     {
-                        return std::to_string( a_value );
+                        return (XNumType)a_value;
                     }
             };
 
-            class as_path_visitor : public boost::static_visitor<>
+            class as_path_visitor
             {
                 public:
-                    typedef scarab::path result_type;
                     scarab::path operator()( const std::string& a_value ) const
                     {
                         return scarab::path( a_value );
@@ -391,10 +252,9 @@ namespace scarab
                     }
             };
 
-            class clear_visitor : public boost::static_visitor<>
+            class clear_visitor
             {
                 public:
-                    typedef void result_type;
                     void operator()( bool& a_value ) const
                     {
                         a_value = false;
@@ -466,82 +326,113 @@ namespace scarab
     template< typename XValType >
     XValType param_value::as() const
     {
-        return boost::apply_visitor( get_visitor< XValType >(), f_value );
+        return std::visit( get_visitor< XValType >(), f_value );
+    }
+
+    template< typename XNumType >
+    std::errc param_value::parse_number( std::string_view a_string, XNumType& a_number )
+    {
+        // std::from_chars does not skip whitespace or accept a leading '+'
+        std::size_t t_start = a_string.find_first_not_of( " \t\n\v\f\r" );
+        if( t_start == std::string_view::npos ) return std::errc::invalid_argument;
+        a_string.remove_prefix( t_start );
+        if( a_string.front() == '+' ) a_string.remove_prefix( 1 );
+
+        if constexpr( std::is_unsigned< XNumType >::value )
+        {
+            // negative numbers wrap around, as with std::stoull
+            if( ! a_string.empty() && a_string.front() == '-' )
+            {
+                typename std::make_signed< XNumType >::type t_signed = 0;
+                std::errc t_error = parse_number( a_string, t_signed );
+                a_number = static_cast< XNumType >( t_signed );
+                return t_error;
+            }
+        }
+
+        std::from_chars_result t_result = std::from_chars( a_string.data(), a_string.data() + a_string.size(), a_number );
+        return t_result.ec;
     }
 
     inline bool param_value::operator==( const param_value& rhs ) const
     {
-        return boost::apply_visitor( are_strict_equals(), f_value, rhs.f_value );
+        return f_value == rhs.f_value;
     }
 
     inline bool param_value::strict_is_equal_to( const param_value& rhs ) const
     {
-        return boost::apply_visitor( are_strict_equals(), f_value, rhs.f_value );
+        return f_value == rhs.f_value;
     }
 
     inline bool param_value::loose_is_equal_to( const param_value& rhs ) const
     {
-        return boost::apply_visitor( are_loose_equals(), f_value, rhs.f_value );
+        if( f_value.index() == rhs.f_value.index() ) return f_value == rhs.f_value;
+        // different types are compared in string form
+        string_view_visitor t_lhs_visitor, t_rhs_visitor;
+        return std::visit( t_lhs_visitor, f_value ) == std::visit( t_rhs_visitor, rhs.f_value );
     }
 
     inline std::string param_value::type() const
     {
-        return boost::apply_visitor( type_visitor(), f_value );
+        static const char* s_type_names[] = { "bool", "uint", "int", "double", "string" };
+        return s_type_names[ f_value.index() ];
     }
 
     inline bool param_value::is_bool() const
     {
-        return boost::apply_visitor( is_bool_visitor(), f_value );
+        return std::holds_alternative< bool >( f_value );
     }
 
     inline bool param_value::is_uint() const
     {
-        return boost::apply_visitor( is_uint_visitor(), f_value );
+        return std::holds_alternative< uint64_t >( f_value );
     }
 
     inline bool param_value::is_int() const
     {
-        return boost::apply_visitor( is_int_visitor(), f_value );
+        return std::holds_alternative< int64_t >( f_value );
     }
 
     inline bool param_value::is_double() const
     {
-        return boost::apply_visitor( is_double_visitor(), f_value );
+        return std::holds_alternative< double >( f_value );
     }
 
     inline bool param_value::is_string() const
     {
-        return boost::apply_visitor( is_string_visitor(), f_value );
+        return std::holds_alternative< std::string >( f_value );
     }
 
     inline bool param_value::as_bool() const
     {
-        return boost::apply_visitor( as_bool_visitor(), f_value );
+        return std::visit( as_bool_visitor(), f_value );
     }
 
     inline uint64_t param_value::as_uint() const
     {
-        return boost::apply_visitor( as_uint_visitor(), f_value );
+        return std::visit( as_number_visitor< uint64_t >(), f_value );
     }
 
     inline int64_t param_value::as_int() const
     {
-        return boost::apply_visitor( as_int_visitor(), f_value );
+        return std::visit( as_number_visitor< int64_t >(), f_value );
     }
 
     inline double param_value::as_double() const
     {
-        return boost::apply_visitor( as_double_visitor(), f_value );
+        return std::visit( as_number_visitor< double >(), f_value );
     }
 
     inline std::string param_value::as_string() const
     {
-        return boost::apply_visitor( as_string_visitor(), f_value );
+        if( const std::string* t_string = std::get_if< std::string >( &f_value ) ) return *t_string;
+        string_view_visitor t_visitor;
+        return std::string( std::visit( t_visitor, f_value ) );
     }
 
     inline path param_value::as_path() const
     {
-        return boost::apply_visitor( as_path_visitor(), f_value );
+        return std::visit( as_path_visitor(), f_value );
     }
 
     template< typename XValType, typename std::enable_if< std::is_convertible< XValType, param_value >::value, XValType >::type* >
@@ -560,14 +451,20 @@ namespace scarab
 
     inline void param_value::clear()
     {
-        boost::apply_visitor( clear_visitor(), f_value );
+        std::visit( clear_visitor(), f_value );
         return;
     }
 
     template< typename XRetType, typename XVisitorType >
     XRetType param_value::accept_value_visitor( const XVisitorType& a_visitor )
     {
-        return boost::apply_visitor( a_visitor, f_value );
+        return std::visit( a_visitor, f_value );
+    }
+
+    template< typename XRetType, typename XVisitorType >
+    XRetType param_value::accept_value_visitor( const XVisitorType& a_visitor ) const
+    {
+        return std::visit( a_visitor, f_value );
     }
 
     //template< typename XRetType >
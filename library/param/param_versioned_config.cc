@@ -0,0 +1,114 @@
+/*
+ * param_versioned_config.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "param_versioned_config.hh"
+
+#include "logger.hh"
+
+#include <vector>
+
+LOGGER( vclog, "versioned_config" );
+
+namespace scarab
+{
+    versioned_config::reader::reader( const versioned_config& a_holder ) :
+            f_holder( &a_holder ),
+            f_version( a_holder.current() )
+    {}
+
+
+    versioned_config::versioned_config() :
+            versioned_config( param_node() )
+    {}
+
+    versioned_config::versioned_config( param_node a_config ) :
+            f_current( new config_version{ 0, std::move(a_config) } ),
+            f_version_number( 0 ),
+            f_publish_mutex(),
+            f_subscribers_mutex(),
+            f_subscribers(),
+            f_next_subscription_id( 0 )
+    {}
+
+    std::uint64_t versioned_config::publish( param_node a_config )
+    {
+        std::unique_lock< std::mutex > t_lock( f_publish_mutex );
+        return publish_locked( [&a_config]( param_node& a_current ){ a_current = std::move(a_config); } );
+    }
+
+    std::uint64_t versioned_config::update( const std::function< void ( param_node& ) >& a_modifier )
+    {
+        std::unique_lock< std::mutex > t_lock( f_publish_mutex );
+        return publish_locked( a_modifier );
+    }
+
+    std::uint64_t versioned_config::merge( const param_node& a_changes )
+    {
+        std::unique_lock< std::mutex > t_lock( f_publish_mutex );
+        return publish_locked( [&a_changes]( param_node& a_current ){ a_current.merge( a_changes ); } );
+    }
+
+    std::uint64_t versioned_config::merge( param_node&& a_changes )
+    {
+        std::unique_lock< std::mutex > t_lock( f_publish_mutex );
+        return publish_locked( [&a_changes]( param_node& a_current ){ a_current.merge( std::move(a_changes) ); } );
+    }
+
+    std::uint64_t versioned_config::publish_locked( const std::function< void ( param_node& ) >& a_modifier )
+    {
+        // only publishers change f_current, and they're serialized, so it can't change while we work on the copy
+        version_ptr_t t_previous = std::atomic_load( &f_current );
+
+        // the copy shares its contents with the previous version, so only what the modifier changes is copied
+        std::shared_ptr< config_version > t_next = std::make_shared< config_version >( config_version{ t_previous->f_number + 1, t_previous->f_config } );
+        a_modifier( t_next->f_config );
+
+        version_ptr_t t_published( std::move(t_next) );
+        std::atomic_store( &f_current, t_published );
+        // readers check the number, so it's stored after the pointer
+        f_version_number.store( t_published->f_number, std::memory_order_release );
+        LDEBUG( vclog, "Published configuration version " << t_published->f_number );
+
+        std::vector< subscriber_t > t_subscribers;
+        {
+            std::unique_lock< std::mutex > t_sub_lock( f_subscribers_mutex );
+            t_subscribers.reserve( f_subscribers.size() );
+            for( const auto& t_subscriber : f_subscribers ) t_subscribers.push_back( t_subscriber.second );
+        }
+        for( const subscriber_t& t_subscriber : t_subscribers )
+        {
+            try
+            {
+                t_subscriber( t_published, t_previous );
+            }
+            catch( const std::exception& e )
+            {
+                LERROR( vclog, "Exception thrown by a subscriber to configuration version " << t_published->f_number << ": " << e.what() );
+            }
+        }
+
+        return t_published->f_number;
+    }
+
+    versioned_config::subscription_id_t versioned_config::subscribe( subscriber_t a_subscriber )
+    {
+        std::unique_lock< std::mutex > t_lock( f_subscribers_mutex );
+        subscription_id_t t_id = f_next_subscription_id++;
+        f_subscribers.emplace( t_id, std::move(a_subscriber) );
+        return t_id;
+    }
+
+    void versioned_config::unsubscribe( subscription_id_t an_id )
+    {
+        std::unique_lock< std::mutex > t_lock( f_subscribers_mutex );
+        f_subscribers.erase( an_id );
+        return;
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,160 @@
+/*
+ * param_versioned_config.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_PARAM_VERSIONED_CONFIG_HH_
+#define SCARAB_PARAM_VERSIONED_CONFIG_HH_
+
+#include "param_node.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace scarab
+{
+    /*!
+     @class versioned_config
+     @author agent
+
+     @brief Holds the current version of a configuration that can be replaced while other threads are reading it
+
+     @details
+     Each version of the configuration is an immutable config_version, held by a shared pointer.
+     Publishing a new configuration swaps the pointer atomically (in the style of read-copy-update):
+     readers that already have the old version keep using it until they're done, and it's deleted when the last of them lets go.
+     Readers never see a configuration that's being modified.
+
+     For the data path, each reading thread should use its own versioned_config::reader.
+     Its get() is wait-free: it compares the published version number with the one it has,
+     and only if a new version was published does it fetch the new pointer.
+
+     Changes are made with publish(), update(), or merge(), which may be called from any thread; publishers are serialized.
+     Since copies of a param_node share their contents, update() and merge() only copy the parts of the configuration that change.
+
+     Subscribers are notified, in the order they subscribed, after each new version is published.
+     They're called on the publishing thread, and must not publish from within the notification.
+    */
+    class SCARAB_API versioned_config
+    {
+        public:
+            /// One published version of the configuration
+            struct config_version
+            {
+                std::uint64_t f_number;
+                param_node f_config;
+            };
+            typedef std::shared_ptr< const config_version > version_ptr_t;
+
+            /// Called with the new and the previous versions
+            typedef std::function< void ( const version_ptr_t&, const version_ptr_t& ) > subscriber_t;
+            typedef unsigned subscription_id_t;
+
+            /*!
+             @class reader
+             @author agent
+
+             @brief Cached, per-thread read access to a versioned_config
+
+             @details
+             A reader must only be used by one thread at a time, and must not outlive its versioned_config.
+             The reference returned by get() is valid until the next call to get() on the same reader.
+            */
+            class SCARAB_API reader
+            {
+                public:
+                    explicit reader( const versioned_config& a_holder );
+
+                    /// Returns the current configuration
+                    const param_node& get();
+                    /// Returns the current version
+                    const version_ptr_t& version();
+
+                    /// Returns true if no newer version has been published since the last call to get() or version()
+                    bool is_current() const;
+
+                private:
+                    const versioned_config* f_holder;
+                    version_ptr_t f_version;
+            };
+
+        public:
+            /// Starts at version 0 with an empty configuration
+            versioned_config();
+            /// Starts at version 0 with a_config
+            explicit versioned_config( param_node a_config );
+            versioned_config( const versioned_config& ) = delete;
+            versioned_config( versioned_config&& ) = delete;
+            virtual ~versioned_config() = default;
+
+            versioned_config& operator=( const versioned_config& ) = delete;
+            versioned_config& operator=( versioned_config&& ) = delete;
+
+            /// Returns the number of the most recently published version
+            std::uint64_t version_number() const;
+            /// Returns the current version; for repeated reads on one thread, a reader is faster
+            version_ptr_t current() const;
+
+            /// Replaces the configuration with a_config, and returns the new version number
+            std::uint64_t publish( param_node a_config );
+            /// Applies a_modifier to a copy of the current configuration and publishes the result; returns the new version number
+            std::uint64_t update( const std::function< void ( param_node& ) >& a_modifier );
+            /// Merges a_changes into a copy of the current configuration and publishes the result; returns the new version number
+            std::uint64_t merge( const param_node& a_changes );
+            std::uint64_t merge( param_node&& a_changes );
+
+            /// Adds a subscriber that is notified of each new version; returns an ID that can be used to unsubscribe
+            subscription_id_t subscribe( subscriber_t a_subscriber );
+            void unsubscribe( subscription_id_t an_id );
+
+        private:
+            /// Publishes the result of a_modifier applied to a copy of the current configuration; requires f_publish_mutex to be locked
+            std::uint64_t publish_locked( const std::function< void ( param_node& ) >& a_modifier );
+
+            // f_current is only accessed with the std::atomic_load/atomic_store functions for shared_ptr
+            version_ptr_t f_current;
+            std::atomic< std::uint64_t > f_version_number;
+
+            std::mutex f_publish_mutex;
+
+            mutable std::mutex f_subscribers_mutex;
+            std::map< subscription_id_t, subscriber_t > f_subscribers;
+            subscription_id_t f_next_subscription_id;
+    };
+
+    inline std::uint64_t versioned_config::version_number() const
+    {
+        return f_version_number.load( std::memory_order_acquire );
+    }
+
+    inline versioned_config::version_ptr_t versioned_config::current() const
+    {
+        return std::atomic_load( &f_current );
+    }
+
+    inline bool versioned_config::reader::is_current() const
+    {
+        return f_version->f_number == f_holder->version_number();
+    }
+
+    inline const versioned_config::version_ptr_t& versioned_config::reader::version()
+    {
+        // the version number is stored after the pointer, so once the new number is seen, the new pointer is available
+        if( ! is_current() ) f_version = f_holder->current();
+        return f_version;
+    }
+
+    inline const param_node& versioned_config::reader::get()
+    {
+        return version()->f_config;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_PARAM_VERSIONED_CONFIG_HH_ */
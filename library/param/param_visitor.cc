@@ -10,6 +10,7 @@
 #include "param_visitor.hh"
 
 #include "param.hh"
+#include "param_traversal.hh"
 
 #include "logger.hh"
 
@@ -30,19 +31,19 @@ namespace scarab
 
         void param_visitor::operator()( const param_array& an_array ) const
         {
-            for( const auto& it: an_array )
-            {
-                it.accept( *this );
-            }
+            // within a traversal, the traversal descends into the array; otherwise start one here
+            if( param_traversal::defer_descent( an_array ) ) return;
+            param_traversal().visit_elements( an_array, *this );
+            leave( an_array );
             return;
         }
 
         void param_visitor::operator()( const param_node& a_node ) const
         {
-            for( const auto& it: a_node )
-            {
-                it.accept( *this );
-            }
+            if( param_traversal::defer_descent( a_node ) ) return;
+            param_traversal().visit_elements( a_node, *this );
+            leave( a_node );
+            return;
         }
 
         void param_visitor::operator()( const param_value& ) const
@@ -50,6 +51,16 @@ namespace scarab
             return;
         }
 
+        void param_visitor::leave( const param_array& ) const
+        {
+            return;
+        }
+
+        void param_visitor::leave( const param_node& ) const
+        {
+            return;
+        }
+
 
         param_visitor_callback::param_visitor_callback() :
                 param_visitor(),
@@ -58,17 +69,11 @@ namespace scarab
                 }),
                 f_param_array_callback( [this](const param_array& an_array) {
                     LDEBUG( plog, "param_array callback: " << an_array );
-                    for( const auto& it: an_array )
-                    {
-                        it.accept( *this );
-                    }
+                    param_visitor::operator()( an_array );
                 }),
                 f_param_node_callback( [this](const param_node& a_node) {
                     LDEBUG( plog, "param_node callback: " << a_node );
-                    for( const auto& it: a_node )
-                    {
-                        it.accept( *this );
-                    }
+                    param_visitor::operator()( a_node );
                 }),
                 f_param_value_callback( [](const param_value& a_value) {
                     LDEBUG( plog, "param_value callback: " << a_value );
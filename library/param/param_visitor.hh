@@ -30,6 +30,17 @@ namespace scarab
      Visitor functions are marked as const --- the most intuitive behavior is that the visitor functions 
      don't modifiy the state of the visitor.  If such modification is required (e.g. an internal counter needs 
      to change at each visit), that should be marked as a mutable member of the visitor.
+
+     The default operator()s for arrays and nodes descend into their elements.  They do that iteratively,
+     with a param_traversal, so a visitor that relies on them can handle structures of any depth.
+     Use param_traversal directly to visit in parallel.
+
+     The default operator()s only ask for the elements to be visited: within a traversal (which includes every container below the one that accept() was called on), they return
+     before the elements have been reached, so code in a derived operator() that follows the call to the base-class operator()
+     runs before the elements, not after them.  Work that has to follow the elements (closing a bracket, decrementing a depth
+     counter, combining the results from the elements) belongs in leave(), which is called for each array and node
+     once all of its elements (and everything below them) have been visited.  leave() is only called for the containers whose
+     elements were visited through the base-class operator().
     */
     class SCARAB_API param_visitor
     {
@@ -41,6 +52,10 @@ namespace scarab
             virtual void operator()( const param_array& ) const;
             virtual void operator()( const param_node& ) const;
             virtual void operator()( const param_value& ) const;
+            /// Called after the elements of an array have been visited by the base-class operator(); does nothing by default
+            virtual void leave( const param_array& ) const;
+            /// Called after the elements of a node have been visited by the base-class operator(); does nothing by default
+            virtual void leave( const param_node& ) const;
     };
 
 
@@ -0,0 +1,149 @@
+/*
+ * mapped_file.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "mapped_file.hh"
+
+#include "error.hh"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace scarab
+{
+
+#ifdef _WIN32
+
+    mapped_file::mapped_file( const std::string& a_filename ) :
+            f_data( nullptr ),
+            f_size( 0 ),
+            f_mapped_size( 0 ),
+            f_buffer()
+    {
+        std::ifstream t_file( a_filename, std::ios::binary | std::ios::ate );
+        if( ! t_file )
+        {
+            throw error() << "Unable to open file <" << a_filename << ">";
+        }
+        f_size = t_file.tellg();
+        f_mapped_size = f_size + 1;
+        f_buffer.resize( f_mapped_size, '\0' );
+        t_file.seekg( 0 );
+        t_file.read( f_buffer.data(), f_size );
+        f_data = f_buffer.data();
+    }
+
+    void mapped_file::unmap()
+    {
+        f_buffer.clear();
+        f_data = nullptr;
+        f_size = 0;
+        f_mapped_size = 0;
+        return;
+    }
+
+#else
+
+    mapped_file::mapped_file( const std::string& a_filename ) :
+            f_data( nullptr ),
+            f_size( 0 ),
+            f_mapped_size( 0 )
+    {
+        int t_fd = ::open( a_filename.c_str(), O_RDONLY );
+        if( t_fd < 0 )
+        {
+            throw error() << "Unable to open file <" << a_filename << ">: " << std::strerror( errno );
+        }
+
+        struct stat t_stat;
+        if( ::fstat( t_fd, &t_stat ) != 0 )
+        {
+            int t_errno = errno;
+            ::close( t_fd );
+            throw error() << "Unable to get the size of file <" << a_filename << ">: " << std::strerror( t_errno );
+        }
+        f_size = t_stat.st_size;
+        f_mapped_size = f_size + 1;
+
+        // Reserve an anonymous (zeroed) region one byte longer than the file, and then map the file over the start of it.
+        // The byte after the file's contents is then zero, either because it's in the zero-filled remainder of the file's last page,
+        // or because it's in the anonymous region.
+        void* t_region = ::mmap( nullptr, f_mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if( t_region == MAP_FAILED )
+        {
+            int t_errno = errno;
+            ::close( t_fd );
+            throw error() << "Unable to reserve memory for file <" << a_filename << ">: " << std::strerror( t_errno );
+        }
+        if( f_size > 0 && ::mmap( t_region, f_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, t_fd, 0 ) == MAP_FAILED )
+        {
+            int t_errno = errno;
+            ::munmap( t_region, f_mapped_size );
+            ::close( t_fd );
+            throw error() << "Unable to map file <" << a_filename << ">: " << std::strerror( t_errno );
+        }
+        ::close( t_fd );
+
+        f_data = static_cast< char* >( t_region );
+    }
+
+    void mapped_file::unmap()
+    {
+        if( f_data != nullptr ) ::munmap( f_data, f_mapped_size );
+        f_data = nullptr;
+        f_size = 0;
+        f_mapped_size = 0;
+        return;
+    }
+
+#endif
+
+    mapped_file::mapped_file( mapped_file&& orig ) :
+            f_data( orig.f_data ),
+            f_size( orig.f_size ),
+            f_mapped_size( orig.f_mapped_size )
+#ifdef _WIN32
+            , f_buffer( std::move(orig.f_buffer) )
+#endif
+    {
+        orig.f_data = nullptr;
+        orig.f_size = 0;
+        orig.f_mapped_size = 0;
+    }
+
+    mapped_file::~mapped_file()
+    {
+        unmap();
+    }
+
+    mapped_file& mapped_file::operator=( mapped_file&& rhs )
+    {
+        if( this == &rhs ) return *this;
+        unmap();
+        f_data = rhs.f_data;
+        f_size = rhs.f_size;
+        f_mapped_size = rhs.f_mapped_size;
+#ifdef _WIN32
+        f_buffer = std::move(rhs.f_buffer);
+#endif
+        rhs.f_data = nullptr;
+        rhs.f_size = 0;
+        rhs.f_mapped_size = 0;
+        return *this;
+    }
+
+} /* namespace scarab */
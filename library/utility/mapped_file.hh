@@ -0,0 +1,80 @@
+/*
+ * mapped_file.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_MAPPED_FILE_HH_
+#define SCARAB_MAPPED_FILE_HH_
+
+#include "scarab_api.hh"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace scarab
+{
+
+    /*!
+     @class mapped_file
+     @author agent
+
+     @brief A private, writable memory mapping of a whole file, followed by a zero byte
+
+     @details
+     The file's contents can be read and modified in place through data(); modifications are never written back to the file
+     (the pages are copied when first written).  The byte at data()[size()] is always zero,
+     so the contents can be used as a null-terminated string, e.g. for in-situ parsing.
+
+     The mapping is released when the object is destroyed.  Throws a scarab::error if the file cannot be opened or mapped.
+
+     On platforms without mmap (i.e. Windows), the file is read into a buffer instead.
+    */
+    class SCARAB_API mapped_file
+    {
+        public:
+            mapped_file( const std::string& a_filename );
+            mapped_file( const mapped_file& ) = delete;
+            mapped_file( mapped_file&& orig );
+            ~mapped_file();
+
+            mapped_file& operator=( const mapped_file& ) = delete;
+            mapped_file& operator=( mapped_file&& rhs );
+
+            char* data();
+            const char* data() const;
+            /// Size of the file, not including the terminating zero byte
+            std::size_t size() const;
+
+        private:
+            void unmap();
+
+            char* f_data;
+            std::size_t f_size;
+            // size of the whole mapping, including the terminating zero byte
+            std::size_t f_mapped_size;
+#ifdef _WIN32
+            std::vector< char > f_buffer;
+#endif
+    };
+
+    inline char* mapped_file::data()
+    {
+        return f_data;
+    }
+
+    inline const char* mapped_file::data() const
+    {
+        return f_data;
+    }
+
+    inline std::size_t mapped_file::size() const
+    {
+        return f_size;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_MAPPED_FILE_HH_ */
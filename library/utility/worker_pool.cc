@@ -0,0 +1,130 @@
+/*
+ * worker_pool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#define SCARAB_API_EXPORTS
+
+#include "worker_pool.hh"
+
+#include <algorithm>
+
+namespace scarab
+{
+    worker_pool::worker_pool( unsigned a_n_threads ) :
+            f_n_threads( a_n_threads == 0 ? std::max( 1U, std::thread::hardware_concurrency() ) : a_n_threads ),
+            f_workers(),
+            f_mutex(),
+            f_start_condition(),
+            f_done_condition(),
+            f_generation( 0 ),
+            f_stopping( false ),
+            f_n_busy( 0 ),
+            f_task( nullptr ),
+            f_n_tasks( 0 ),
+            f_next( 0 ),
+            f_failed( false ),
+            f_error()
+    {}
+
+    worker_pool::~worker_pool()
+    {
+        {
+            std::unique_lock< std::mutex > t_lock( f_mutex );
+            f_stopping = true;
+        }
+        f_start_condition.notify_all();
+        for( std::thread& t_worker : f_workers )
+        {
+            t_worker.join();
+        }
+    }
+
+    void worker_pool::run( std::size_t a_n_tasks, const task& a_task )
+    {
+        if( f_n_threads == 1 || a_n_tasks <= 1 )
+        {
+            for( std::size_t i_task = 0; i_task < a_n_tasks; ++i_task )
+            {
+                a_task( i_task, 0 );
+            }
+            return;
+        }
+
+        if( f_workers.empty() ) start_workers();
+
+        {
+            std::unique_lock< std::mutex > t_lock( f_mutex );
+            f_task = &a_task;
+            f_n_tasks = a_n_tasks;
+            f_next.store( 0 );
+            f_failed.store( false );
+            f_error = nullptr;
+            f_n_busy = f_workers.size();
+            ++f_generation;
+        }
+        f_start_condition.notify_all();
+
+        do_tasks( 0 );
+
+        std::exception_ptr t_error;
+        {
+            std::unique_lock< std::mutex > t_lock( f_mutex );
+            f_done_condition.wait( t_lock, [this](){ return f_n_busy == 0; } );
+            f_task = nullptr;
+            std::swap( t_error, f_error );
+        }
+        if( t_error ) std::rethrow_exception( t_error );
+        return;
+    }
+
+    void worker_pool::start_workers()
+    {
+        f_workers.reserve( f_n_threads - 1 );
+        for( unsigned i_thread = 1; i_thread < f_n_threads; ++i_thread )
+        {
+            f_workers.emplace_back( &worker_pool::work, this, i_thread );
+        }
+        return;
+    }
+
+    void worker_pool::work( unsigned a_thread )
+    {
+        unsigned long t_generation = 0;
+        std::unique_lock< std::mutex > t_lock( f_mutex );
+        while( true )
+        {
+            f_start_condition.wait( t_lock, [this, t_generation](){ return f_stopping || f_generation != t_generation; } );
+            if( f_stopping ) return;
+            t_generation = f_generation;
+
+            t_lock.unlock();
+            do_tasks( a_thread );
+            t_lock.lock();
+
+            if( --f_n_busy == 0 ) f_done_condition.notify_all();
+        }
+    }
+
+    void worker_pool::do_tasks( unsigned a_thread )
+    {
+        std::size_t t_index = 0;
+        while( ! f_failed.load( std::memory_order_relaxed ) && (t_index = f_next.fetch_add( 1, std::memory_order_relaxed )) < f_n_tasks )
+        {
+            try
+            {
+                (*f_task)( t_index, a_thread );
+            }
+            catch( ... )
+            {
+                std::unique_lock< std::mutex > t_lock( f_mutex );
+                if( ! f_error ) f_error = std::current_exception();
+                f_failed.store( true );
+            }
+        }
+        return;
+    }
+
+} /* namespace scarab */
@@ -0,0 +1,92 @@
+/*
+ * worker_pool.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_WORKER_POOL_HH_
+#define SCARAB_WORKER_POOL_HH_
+
+#include "scarab_api.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scarab
+{
+    /*!
+     @class worker_pool
+     @author agent
+
+     @brief Runs a set of indexed tasks on a fixed set of threads
+
+     @details
+     run() calls a task for each index from 0 to the number of tasks, spread over n_threads threads:
+     the calling thread and up to n_threads - 1 worker threads.  Each thread takes the next unclaimed index until none are left.
+     The worker threads are started by the first run() that has more than one task, and are reused by later calls,
+     so a pool can be kept for a sequence of parallel jobs without paying for thread creation each time.
+
+     The task is also given the number of the thread it's running on (0 for the calling thread, up to n_threads - 1),
+     so that per-thread state can be kept in a vector of n_threads entries.
+
+     If a task throws, no further indices are handed out, and the first exception is rethrown from run()
+     once the tasks that were already running have finished.
+
+     run() must not be called from one of the pool's own tasks, nor from more than one thread at a time.
+    */
+    class SCARAB_API worker_pool
+    {
+        public:
+            /// Calls a task with the task index and the thread number
+            typedef std::function< void( std::size_t, unsigned ) > task;
+
+            /// Pool of a_n_threads threads, including the calling thread (0 uses the hardware concurrency)
+            worker_pool( unsigned a_n_threads = 0 );
+            worker_pool( const worker_pool& ) = delete;
+            virtual ~worker_pool();
+
+            worker_pool& operator=( const worker_pool& ) = delete;
+
+            unsigned get_n_threads() const;
+
+            /// Calls a_task for each index in [0, a_n_tasks); returns when all have been done
+            void run( std::size_t a_n_tasks, const task& a_task );
+
+        private:
+            void start_workers();
+            void work( unsigned a_thread );
+            void do_tasks( unsigned a_thread );
+
+            unsigned f_n_threads;
+            std::vector< std::thread > f_workers;
+
+            std::mutex f_mutex;
+            std::condition_variable f_start_condition;
+            std::condition_variable f_done_condition;
+            unsigned long f_generation;
+            bool f_stopping;
+            unsigned f_n_busy;
+
+            // the current job
+            const task* f_task;
+            std::size_t f_n_tasks;
+            std::atomic< std::size_t > f_next;
+            std::atomic< bool > f_failed;
+            std::exception_ptr f_error;
+    };
+
+    inline unsigned worker_pool::get_n_threads() const
+    {
+        return f_n_threads;
+    }
+
+} /* namespace scarab */
+
+#endif /* SCARAB_WORKER_POOL_HH_ */
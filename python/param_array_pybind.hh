@@ -86,7 +86,7 @@ namespace scarab_pybind
                     pybind11::arg( "array" ),
                     "adds all elements of a param_array to the end of this" )
             .def( "merge",
-                    &scarab::param_array::merge,
+                    (void (scarab::param_array::*)(const scarab::param_array&)) &scarab::param_array::merge,
                     pybind11::arg( "array" ),
                     "merges provided param_array, effectively replacing the current array")
             .def( "erase",
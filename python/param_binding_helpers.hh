@@ -103,6 +103,16 @@ namespace scarab_pybind
             }
             return std::move(to_return);
         }
+        else if (a_param.is_typed_array())
+        {
+            const scarab::param_typed_array_base& this_array = a_param.as_typed_array();
+            pybind11::list to_return;
+            for (unsigned an_index = 0; an_index < this_array.size(); ++an_index)
+            {
+                to_return.append( to_python( this_array.value_at( an_index ) ) );
+            }
+            return std::move(to_return);
+        }
         else if (a_param.is_node())
         {
             const scarab::param_node& this_node = a_param.as_node();
@@ -24,7 +24,7 @@ namespace scarab_pybind
 
             .def( "__str__", &scarab::param_node::to_string )
             .def( "__len__", &scarab::param_node::size )
-            .def( "__getitem__", (scarab::param& (scarab::param_node::*)(const std::string&)) &scarab::param_node::operator[],
+            .def( "__getitem__", (scarab::param& (scarab::param_node::*)(std::string_view)) &scarab::param_node::operator[],
                     pybind11::return_value_policy::reference_internal)
             .def( "__setitem__", [](scarab::param_node& an_obj, std::string& a_name, scarab::param& a_value){ an_obj.replace( a_name, a_value ); } )
             .def( "__contains__", &scarab::param_node::has )
@@ -53,32 +53,32 @@ namespace scarab_pybind
 
             // Get value of the parameter, bringing along the default value
             .def( "get_value",
-                    (bool (scarab::param_node::*)(const std::string&, bool) const) &scarab::param_node::get_value<bool>,
+                    (bool (scarab::param_node::*)(std::string_view, bool) const) &scarab::param_node::get_value<bool>,
                     pybind11::arg( "key" ),
                     pybind11::arg( "default" ),
                     "Get parameter node value at [key] or return [default] (as a bool)" )
             .def( "get_value",
-                    (unsigned (scarab::param_node::*)(const std::string&, unsigned) const) &scarab::param_node::get_value<uint>,
+                    (unsigned (scarab::param_node::*)(std::string_view, unsigned) const) &scarab::param_node::get_value<uint>,
                     pybind11::arg( "key" ),
                     pybind11::arg( "default" ),
                     "Get parameter node value at [key] or return [default] (as an unsigned integer)" )
             .def( "get_value",
-                    (int (scarab::param_node::*)(const std::string&, int) const) &scarab::param_node::get_value<int>,
+                    (int (scarab::param_node::*)(std::string_view, int) const) &scarab::param_node::get_value<int>,
                     pybind11::arg( "key" ),
                     pybind11::arg( "default" ),
                     "Get parameter node value at [key] or return [default] (as a signed integer)" )
             .def( "get_value",
-                    (double (scarab::param_node::*)(const std::string&, double) const) &scarab::param_node::get_value<double>,
+                    (double (scarab::param_node::*)(std::string_view, double) const) &scarab::param_node::get_value<double>,
                     pybind11::arg( "key" ),
                     pybind11::arg( "default" ),
                     "Get parameter node value at [key] or return [default] (as a float)" )
             .def( "get_value",
-                    (std::string (scarab::param_node::*)(const std::string&, const std::string& ) const) &scarab::param_node::get_value,
+                    (std::string (scarab::param_node::*)(std::string_view, const std::string& ) const) &scarab::param_node::get_value,
                     pybind11::arg( "key" ),
                     pybind11::arg( "default" ),
                     "Get parameter node value at [key] or return [default] (as a string)" )
 
-            .def( "merge", &scarab::param_node::merge,
+            .def( "merge", (void (scarab::param_node::*)(const scarab::param_node&)) &scarab::param_node::merge,
                     pybind11::arg( "object" ),
                     "Merge the contents of object into this node" )
 
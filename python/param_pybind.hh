@@ -50,6 +50,7 @@ namespace scarab_pybind
             .def( "is_node", &scarab::param::is_node, "return whether the param object is a ParamNode" )
             .def( "is_array", &scarab::param::is_array, "return whether the param object is a ParamArray" )
             .def( "is_value", &scarab::param::is_value, "return whether the param object is a ParamValue" )
+            .def( "is_typed_array", &scarab::param::is_typed_array, "return whether the param object is a ParamTypedArray" )
 
             .def( "as_array",
                     (scarab::param_array& (scarab::param::*)()) &scarab::param::as_array,
@@ -63,6 +64,10 @@ namespace scarab_pybind
                     (scarab::param_value& (scarab::param::*)()) &scarab::param::as_value,
                     pybind11::return_value_policy::reference_internal,
                     "returns Param object as ParamValue" )
+            .def( "as_typed_array",
+                    (scarab::param_typed_array_base& (scarab::param::*)()) &scarab::param::as_typed_array,
+                    pybind11::return_value_policy::reference_internal,
+                    "returns Param object as ParamTypedArray" )
 
             .def( "to_python",
                     &to_python,
@@ -0,0 +1,102 @@
+/*
+ * param_typed_array_pybind.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef PARAM_TYPED_ARRAY_PYBIND_HH_
+#define PARAM_TYPED_ARRAY_PYBIND_HH_
+
+#include "param.hh"
+
+#include "pybind11/pybind11.h"
+
+namespace scarab_pybind
+{
+
+    template< typename XElement >
+    void export_param_typed_array_type( pybind11::module& mod, const char* a_name, const char* a_doc )
+    {
+        typedef scarab::param_typed_array< XElement > typed_array_t;
+
+        // the buffer protocol lets numpy (and memoryview) use the array's contents without copying, e.g. numpy.asarray( an_array )
+        pybind11::class_< typed_array_t, scarab::param_typed_array_base >( mod, a_name, a_doc, pybind11::buffer_protocol() )
+            .def( pybind11::init< >() )
+            .def( pybind11::init( [](pybind11::buffer a_buffer){
+                        pybind11::buffer_info t_info = a_buffer.request();
+                        if( t_info.format != pybind11::format_descriptor< XElement >::format() || t_info.ndim != 1 )
+                        {
+                            throw scarab::error() << "Buffer must be one-dimensional, with elements of type " << pybind11::format_descriptor< XElement >::format();
+                        }
+                        typed_array_t t_array( t_info.shape[0] );
+                        XElement* t_data = t_array.data();
+                        const char* t_source = static_cast< const char* >( t_info.ptr );
+                        for( pybind11::ssize_t i_element = 0; i_element < t_info.shape[0]; ++i_element )
+                        {
+                            t_data[i_element] = *reinterpret_cast< const XElement* >( t_source + i_element * t_info.strides[0] );
+                        }
+                        return t_array;
+                    } ),
+                    pybind11::arg( "buffer" ),
+                    "Copies a one-dimensional buffer (e.g. a numpy array) of the matching element type" )
+            .def( pybind11::init( [](const pybind11::list& a_list){
+                        typed_array_t t_array;
+                        t_array.reserve( a_list.size() );
+                        for( const pybind11::handle& t_item : a_list ) t_array.push_back( t_item.cast< XElement >() );
+                        return t_array;
+                    } ),
+                    pybind11::arg( "values" ),
+                    "Creates the array from a list of numbers" )
+            .def_buffer( [](typed_array_t& an_array) -> pybind11::buffer_info {
+                        return pybind11::buffer_info(
+                                an_array.data(),
+                                sizeof( XElement ),
+                                pybind11::format_descriptor< XElement >::format(),
+                                1,
+                                { (pybind11::ssize_t)an_array.size() },
+                                { (pybind11::ssize_t)sizeof( XElement ) } );
+                    } )
+
+            .def( "__str__", &typed_array_t::to_string )
+            .def( "__len__", &typed_array_t::size, "Returns the size of the array" )
+            .def( "__getitem__", (XElement (typed_array_t::*)(unsigned) const) &typed_array_t::at )
+            .def( "__setitem__", [](typed_array_t& an_array, unsigned an_index, XElement a_value){ an_array.at( an_index ) = a_value; } )
+            .def( "__iter__", [](const typed_array_t& an_array){ return pybind11::make_iterator( an_array.begin(), an_array.end() ); },
+                    pybind11::keep_alive<0, 1>() /* keep object alive while the iterator exists */)
+
+            .def( "push_back", &typed_array_t::push_back, pybind11::arg( "value" ), "Adds a value to the end of the array" )
+            .def( "resize", &typed_array_t::resize, pybind11::arg( "size" ), pybind11::arg( "value" ) = XElement(),
+                    "Sets the size of the array; new elements are set to [value]" )
+            .def( "clear", &typed_array_t::clear, "Erases all contents and resizes to 0" )
+            ;
+        return;
+    }
+
+    std::list< std::string > export_param_typed_array( pybind11::module& mod )
+    {
+        std::list< std::string > all_members;
+
+        all_members.push_back( "ParamTypedArray" );
+        pybind11::class_< scarab::param_typed_array_base, scarab::param >( mod, "ParamTypedArray", "param data structure base class for contiguous arrays of numbers" )
+            .def( "__str__", &scarab::param_typed_array_base::to_string )
+            .def( "__len__", &scarab::param_typed_array_base::size, "Returns the size of the array" )
+            .def( "empty", &scarab::param_typed_array_base::empty, "True if the length is zero" )
+            .def( "element_type", &scarab::param_typed_array_base::element_type_name, "Returns the element type: double, int64, or uint64" )
+            .def( "to_param_array", &scarab::param_typed_array_base::to_param_array, "Returns a ParamArray of ParamValues with the same numbers" )
+            ;
+
+        all_members.push_back( "ParamDoubleArray" );
+        export_param_typed_array_type< double >( mod, "ParamDoubleArray", "param data structure object for holding a contiguous array of floats" );
+
+        all_members.push_back( "ParamInt64Array" );
+        export_param_typed_array_type< std::int64_t >( mod, "ParamInt64Array", "param data structure object for holding a contiguous array of signed integers" );
+
+        all_members.push_back( "ParamUint64Array" );
+        export_param_typed_array_type< std::uint64_t >( mod, "ParamUint64Array", "param data structure object for holding a contiguous array of unsigned integers" );
+
+        return all_members;
+    }
+
+} /* namespace scarab_pybind */
+#endif /* PARAM_TYPED_ARRAY_PYBIND_HH_ */
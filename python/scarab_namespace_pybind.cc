@@ -21,6 +21,7 @@
 #include "param_value_pybind.hh"
 #include "param_array_pybind.hh"
 #include "param_node_pybind.hh"
+#include "param_typed_array_pybind.hh"
 #endif
 
 #ifdef BUILD_AUTH_PYBINDING
@@ -52,6 +53,7 @@ PYBIND11_MODULE( scarab, scarab_mod )
     all_members.splice( all_members.end(), scarab_pybind::export_param_value( scarab_mod ) );
     all_members.splice( all_members.end(), scarab_pybind::export_param_array( scarab_mod ) );
     all_members.splice( all_members.end(), scarab_pybind::export_param_node( scarab_mod ) );
+    all_members.splice( all_members.end(), scarab_pybind::export_param_typed_array( scarab_mod ) );
 #endif
 #ifdef BUILD_AUTH_PYBINDING
     // authentication
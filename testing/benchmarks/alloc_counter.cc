@@ -0,0 +1,47 @@
+/*
+ * alloc_counter.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "alloc_counter.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic< std::size_t > s_n_allocations( 0 );
+}
+
+namespace scarab_testing
+{
+    std::size_t n_global_allocations()
+    {
+        return s_n_allocations.load( std::memory_order_relaxed );
+    }
+}
+
+// Replacements for the global allocation functions that count every allocation.
+// The array and nothrow forms forward to these by default.
+
+void* operator new( std::size_t a_size )
+{
+    s_n_allocations.fetch_add( 1, std::memory_order_relaxed );
+    if( a_size == 0 ) a_size = 1;
+    void* t_ptr = std::malloc( a_size );
+    if( t_ptr == nullptr ) throw std::bad_alloc();
+    return t_ptr;
+}
+
+void operator delete( void* a_ptr ) noexcept
+{
+    std::free( a_ptr );
+}
+
+void operator delete( void* a_ptr, std::size_t ) noexcept
+{
+    std::free( a_ptr );
+}
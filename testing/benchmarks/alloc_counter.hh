@@ -0,0 +1,36 @@
+/*
+ * alloc_counter.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SCARAB_TESTING_ALLOC_COUNTER_HH_
+#define SCARAB_TESTING_ALLOC_COUNTER_HH_
+
+#include <cstddef>
+
+namespace scarab_testing
+{
+    /// Number of calls to the global operator new since the program started
+    std::size_t n_global_allocations();
+
+    /*!
+     @class alloc_count
+     @author agent
+
+     @brief Counts the global heap allocations made between construction and a call to count()
+    */
+    class alloc_count
+    {
+        public:
+            alloc_count() : f_start( n_global_allocations() ) {}
+
+            std::size_t count() const { return n_global_allocations() - f_start; }
+
+        private:
+            std::size_t f_start;
+    };
+}
+
+#endif /* SCARAB_TESTING_ALLOC_COUNTER_HH_ */
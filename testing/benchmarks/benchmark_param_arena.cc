@@ -0,0 +1,152 @@
+/*
+ * benchmark_param_arena.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares building, parsing, and destroying large param trees with heap allocation and with a param_arena.
+ */
+
+#include "alloc_counter.hh"
+
+#include "param.hh"
+#include "param_codec.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <sstream>
+
+using scarab::param_arena;
+using scarab::param_arena_scope;
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::param_translator;
+using scarab_testing::alloc_count;
+
+namespace
+{
+    // Builds a tree with a_n_nodes nodes, each with 5 entries (~6*a_n_nodes params in total)
+    param_ptr_t make_tree( unsigned a_n_nodes )
+    {
+        param_ptr_t t_root( new param_node() );
+        for( unsigned i_node = 0; i_node < a_n_nodes; ++i_node )
+        {
+            param_node t_node;
+            t_node.add( "int", int(i_node) );
+            t_node.add( "double", 0.5 * i_node );
+            t_node.add( "string", "value " + std::to_string(i_node) );
+            t_node.add( "bool", i_node % 2 == 0 );
+            param_array t_array;
+            t_array.push_back( i_node );
+            t_node.add( "array", std::move(t_array) );
+            t_root->as_node().add( "node" + std::to_string(i_node), std::move(t_node) );
+        }
+        return t_root;
+    }
+
+#ifdef USE_CODEC_YAML
+    // Same structure as make_tree(), as a YAML document
+    std::string make_yaml( unsigned a_n_nodes )
+    {
+        std::stringstream t_yaml;
+        for( unsigned i_node = 0; i_node < a_n_nodes; ++i_node )
+        {
+            t_yaml << "node" << i_node << ":\n"
+                   << "  int: " << i_node << "\n"
+                   << "  double: " << 0.5 * i_node << "\n"
+                   << "  string: value " << i_node << "\n"
+                   << "  bool: " << (i_node % 2 == 0 ? "true" : "false") << "\n"
+                   << "  array: [" << i_node << "]\n";
+        }
+        return t_yaml.str();
+    }
+#endif
+}
+
+TEST_CASE( "param_arena allocations", "[param][param_arena][benchmark]" )
+{
+    const unsigned t_n_nodes = 10000; // ~50k params
+
+    std::size_t t_heap_allocs = 0;
+    {
+        alloc_count t_count;
+        param_ptr_t t_tree = make_tree( t_n_nodes );
+        t_heap_allocs = t_count.count();
+    }
+
+    std::size_t t_arena_allocs = 0;
+    {
+        param_arena t_arena;
+        alloc_count t_count;
+        param_ptr_t t_tree;
+        {
+            param_arena_scope t_scope( t_arena );
+            t_tree = make_tree( t_n_nodes );
+        }
+        t_arena_allocs = t_count.count();
+        REQUIRE( t_arena.n_allocations() > 5 * t_n_nodes );
+        std::cout << "Allocated " << t_arena.n_allocations() << " params in the arena\n";
+    }
+
+    std::cout << "Global allocations for building the tree -- heap: " << t_heap_allocs << "; arena: " << t_arena_allocs << std::endl;
+    REQUIRE( t_arena_allocs < t_heap_allocs );
+}
+
+TEST_CASE( "param_arena build and destroy", "[param][param_arena][benchmark]" )
+{
+    const unsigned t_n_nodes = 10000;
+
+    BENCHMARK( "heap" )
+    {
+        param_ptr_t t_tree = make_tree( t_n_nodes );
+        return t_tree->as_node().size();
+    };
+
+    BENCHMARK( "arena" )
+    {
+        param_arena t_arena;
+        param_arena_scope t_scope( t_arena );
+        param_ptr_t t_tree = make_tree( t_n_nodes );
+        return t_tree->as_node().size();
+    };
+
+    // a copy into an arena is a deep copy, since contents are not shared across arenas
+    param_ptr_t t_tree = make_tree( t_n_nodes );
+
+    BENCHMARK( "clone into arena" )
+    {
+        param_arena t_arena;
+        param_ptr_t t_clone = t_tree->clone_into( t_arena );
+        return t_clone->as_node().size();
+    };
+}
+
+#ifdef USE_CODEC_YAML
+TEST_CASE( "param_arena parse and destroy", "[param][param_arena][benchmark]" )
+{
+    const unsigned t_n_nodes = 10000;
+
+    std::string t_yaml = make_yaml( t_n_nodes );
+    param_translator t_translator;
+
+    BENCHMARK( "heap" )
+    {
+        param_ptr_t t_config = t_translator.read_string( t_yaml, "yaml" );
+        return t_config->as_node().size();
+    };
+
+    BENCHMARK( "arena" )
+    {
+        param_arena t_arena;
+        param_ptr_t t_config;
+        {
+            param_arena_scope t_scope( t_arena );
+            t_config = t_translator.read_string( t_yaml, "yaml" );
+        }
+        return t_config->as_node().size();
+    };
+}
+#endif
@@ -0,0 +1,81 @@
+/*
+ * benchmark_param_diff.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares making a patch for a one-value change to a large config: when the new config is a modified copy of the old one
+ *  (so everything else is shared, and skipped), and when the two were built separately (so everything is compared).
+ *  Serializing the whole config and the patch (with MessagePack) are included for comparison.
+ */
+
+#include "param.hh"
+#include "param_codec.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <string>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::operator""_a;
+
+namespace
+{
+    param_node make_config( unsigned a_n_channels )
+    {
+        param_array t_channels;
+        for( unsigned i_channel = 0; i_channel < a_n_channels; ++i_channel )
+        {
+            t_channels.push_back( param_node( "id"_a=i_channel, "gain"_a=1.0 + 0.001 * i_channel, "label"_a="channel-" + std::to_string( i_channel ),
+                                              "thresholds"_a=param_node( "low"_a=-1.0, "high"_a=1.0 ) ) );
+        }
+        return param_node( "run"_a=param_node( "name"_a="benchmark", "duration"_a=60 ), "channels"_a=t_channels );
+    }
+}
+
+TEST_CASE( "param_diff", "[param][param_diff][benchmark]" )
+{
+    const unsigned t_n_channels = 100000;
+    const param_node t_old = make_config( t_n_channels );
+
+    param_node t_copy( t_old );
+    t_copy["channels"][t_n_channels / 2]["thresholds"]["high"]() = 2.0;
+
+    param_node t_rebuilt = make_config( t_n_channels );
+    t_rebuilt["channels"][t_n_channels / 2]["thresholds"]["high"]() = 2.0;
+
+    REQUIRE( scarab::param_diff( t_old, t_copy ).size() == 1 );
+    REQUIRE( scarab::param_diff( t_old, t_rebuilt ).size() == 1 );
+    std::cout << "Patch for one changed value:\n" << scarab::param_diff( t_old, t_copy ) << std::endl;
+
+    BENCHMARK( "param_diff, modified copy" )
+    {
+        return scarab::param_diff( t_old, t_copy ).size();
+    };
+
+    BENCHMARK( "param_diff, separately built" )
+    {
+        return scarab::param_diff( t_old, t_rebuilt ).size();
+    };
+
+#ifdef USE_CODEC_MSGPACK
+    scarab::param_translator t_translator;
+    const param_array t_patch = scarab::param_diff( t_old, t_copy );
+    std::string t_written;
+
+    BENCHMARK( "write_string, whole config" )
+    {
+        t_translator.write_string( t_copy, t_written, "msgpack" );
+        return t_written.size();
+    };
+
+    BENCHMARK( "write_string, patch" )
+    {
+        t_translator.write_string( t_patch, t_written, "msgpack" );
+        return t_written.size();
+    };
+#endif
+}
@@ -0,0 +1,312 @@
+/*
+ * benchmark_param_json.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares reading a large JSON file by streaming the parser's events into a param structure, by doing so in situ from a memory-mapped file,
+ *  and by building a rapidjson::Document first.
+ *
+ *  The file size defaults to 64 MB; set SCARAB_BENCHMARK_JSON_MB to change it (e.g. to several hundred).
+ *  Peak memory is measured in a forked child process for each method (Linux only), as the increase in the high-water resident set size.
+ *
+ *  Also compares reading a JSON-lines record stream one record at a time with param_jsonl_reader, whose memory use doesn't depend on
+ *  the number of records, with reading every record into a param_array, and times writing records with param_jsonl_writer.
+ *
+ *  For a large shared configuration of which a service reads 1% of the keys, compares reading it in full with reading it lazily.
+ *
+ *  Compares the SIMD parser (when it's available on this CPU) with the scalar parser, on the shared configuration and on a
+ *  memory-mapped metadata file.
+ */
+
+#include "param.hh"
+#include "param_json.hh"
+#include "param_jsonl.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using scarab::param;
+using scarab::param_input_json;
+using scarab::param_jsonl_reader;
+using scarab::param_jsonl_writer;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::operator""_a;
+
+namespace
+{
+    // writes records until the file reaches a_megabytes
+    void write_metadata_file( const std::string& a_filename, unsigned a_megabytes )
+    {
+        std::ofstream t_file( a_filename );
+        t_file << "{\"run\": {\"name\": \"benchmark\", \"records\": [";
+        const std::size_t t_target = std::size_t( a_megabytes ) << 20;
+        for( unsigned i_record = 0; std::size_t( t_file.tellp() ) < t_target; ++i_record )
+        {
+            if( i_record != 0 ) t_file << ',';
+            t_file << "\n{\"id\": " << i_record << ", \"channel\": " << i_record % 16 << ", \"gain\": " << 1.0 + 0.001 * ( i_record % 1000 )
+                   << ", \"label\": \"record-" << i_record << "\", \"valid\": " << ( i_record % 7 != 0 ? "true" : "false" )
+                   << ", \"samples\": [" << i_record << ", " << i_record + 1 << ", " << i_record + 2 << ", " << i_record + 3 << "]}";
+        }
+        t_file << "\n]}}\n";
+        return;
+    }
+
+#ifdef __linux__
+    // reads a field such as VmRSS or VmHWM from /proc/self/status, in kB
+    long proc_status_kb( const std::string& a_field )
+    {
+        std::ifstream t_status( "/proc/self/status" );
+        std::string t_line;
+        while( std::getline( t_status, t_line ) )
+        {
+            if( t_line.compare( 0, a_field.size() + 1, a_field + ":" ) == 0 ) return std::atol( t_line.c_str() + a_field.size() + 1 );
+        }
+        return -1;
+    }
+
+    // calls a_read (which returns true on success) in a child process; returns the growth of the peak resident set size in kB, or -1 on failure
+    template< class XRead >
+    long peak_rss_growth_kb( XRead a_read )
+    {
+        int t_pipe[2];
+        if( pipe( t_pipe ) != 0 ) return -1;
+        pid_t t_pid = fork();
+        if( t_pid == 0 )
+        {
+            close( t_pipe[0] );
+            long t_before = proc_status_kb( "VmRSS" );
+            long t_growth = a_read() ? proc_status_kb( "VmHWM" ) - t_before : -1;
+            ssize_t t_written = write( t_pipe[1], &t_growth, sizeof( t_growth ) );
+            _exit( t_written == sizeof( t_growth ) ? 0 : 1 );
+        }
+        close( t_pipe[1] );
+        long t_growth = -1;
+        if( t_pid < 0 || read( t_pipe[0], &t_growth, sizeof( t_growth ) ) != sizeof( t_growth ) ) t_growth = -1;
+        close( t_pipe[0] );
+        if( t_pid > 0 ) waitpid( t_pid, nullptr, 0 );
+        return t_growth;
+    }
+
+    // reads the JSON file in a child process
+    long peak_rss_growth_kb( const std::string& a_filename, const param_node& a_options )
+    {
+        return peak_rss_growth_kb( [&](){ return bool( param_input_json().read_file( a_filename, a_options ) ); } );
+    }
+#endif
+
+    // writes a_n_records records, one per line
+    void write_records_file( const std::string& a_filename, unsigned a_n_records )
+    {
+        param_jsonl_writer t_writer( a_filename );
+        for( unsigned i_record = 0; i_record < a_n_records; ++i_record )
+        {
+            t_writer.write( param_node( "id"_a=i_record, "channel"_a=i_record % 16, "gain"_a=1.0 + 0.001 * ( i_record % 1000 ),
+                                        "label"_a="record-" + std::to_string( i_record ), "valid"_a=( i_record % 7 != 0 ) ) );
+        }
+        return;
+    }
+
+    // a shared configuration with a section for each of a_n_services services
+    std::string make_shared_config_json( unsigned a_n_services )
+    {
+        std::stringstream t_json;
+        t_json << "{\"services\": {";
+        for( unsigned i_service = 0; i_service < a_n_services; ++i_service )
+        {
+            if( i_service != 0 ) t_json << ",";
+            t_json << "\n\"service-" << i_service << "\": {\"host\": \"host-" << i_service % 64 << ".example.org\", \"port\": " << 8000 + i_service
+                   << ", \"timeout\": " << 0.5 + 0.01 * ( i_service % 100 ) << ", \"retries\": [1, 2, 4, 8], "
+                   << "\"limits\": {\"connections\": 100, \"requests\": 1000}}";
+        }
+        t_json << "\n}}\n";
+        return t_json.str();
+    }
+
+    // reads the port of every hundredth service
+    unsigned read_one_percent( const param_node& a_config, unsigned a_n_services )
+    {
+        unsigned t_sum = 0;
+        for( unsigned i_service = 0; i_service < a_n_services; i_service += 100 )
+        {
+            t_sum += a_config["services"]["service-" + std::to_string( i_service )]["port"]().as_uint();
+        }
+        return t_sum;
+    }
+
+    // reads every record one at a time, keeping only a sum
+    bool sum_records( const std::string& a_filename, double& a_sum )
+    {
+        param_jsonl_reader t_reader( a_filename );
+        a_sum = 0.;
+        for( param& t_record : t_reader ) a_sum += t_record["gain"]().as_double();
+        return ! t_reader.error().occurred();
+    }
+}
+
+TEST_CASE( "param_json read_file", "[param][param_json][benchmark]" )
+{
+    unsigned t_megabytes = 64;
+    if( const char* t_env = std::getenv( "SCARAB_BENCHMARK_JSON_MB" ) ) t_megabytes = std::atoi( t_env );
+
+    const std::string t_filename( "benchmark_param_json.json" );
+    write_metadata_file( t_filename, t_megabytes );
+
+    param_input_json t_reader;
+    const param_node t_dom_options( "dom"_a=true );
+    const param_node t_mmap_options( "mmap"_a=true );
+
+#ifdef __linux__
+    long t_streaming_kb = peak_rss_growth_kb( t_filename, param_node() );
+    long t_mmap_kb = peak_rss_growth_kb( t_filename, t_mmap_options );
+    long t_dom_kb = peak_rss_growth_kb( t_filename, t_dom_options );
+    std::cout << "Peak memory growth while reading a " << t_megabytes << " MB JSON file:\n";
+    std::cout << "\tstreaming: " << t_streaming_kb / 1024 << " MB\n";
+    std::cout << "\tstreaming, memory-mapped (includes the mapped file): " << t_mmap_kb / 1024 << " MB\n";
+    std::cout << "\tDOM: " << t_dom_kb / 1024 << " MB" << std::endl;
+    REQUIRE( t_streaming_kb > 0 );
+    REQUIRE( t_mmap_kb > 0 );
+    REQUIRE( t_dom_kb > t_streaming_kb );
+#endif
+
+    BENCHMARK( "read_file, streaming" )
+    {
+        return t_reader.read_file( t_filename )->as_node().size();
+    };
+
+    BENCHMARK( "read_file, streaming, memory-mapped" )
+    {
+        return t_reader.read_file( t_filename, t_mmap_options )->as_node().size();
+    };
+
+    BENCHMARK( "read_file, DOM" )
+    {
+        return t_reader.read_file( t_filename, t_dom_options )->as_node().size();
+    };
+
+    std::remove( t_filename.c_str() );
+}
+
+TEST_CASE( "param_jsonl records", "[param][param_json][benchmark]" )
+{
+    const std::string t_small_filename( "benchmark_param_jsonl_small.jsonl" );
+    const std::string t_large_filename( "benchmark_param_jsonl_large.jsonl" );
+    write_records_file( t_small_filename, 10000 );
+    write_records_file( t_large_filename, 200000 );
+
+#ifdef __linux__
+    double t_sum = 0.;
+    long t_small_stream_kb = peak_rss_growth_kb( [&](){ return sum_records( t_small_filename, t_sum ); } );
+    long t_large_stream_kb = peak_rss_growth_kb( [&](){ return sum_records( t_large_filename, t_sum ); } );
+    long t_large_all_kb = peak_rss_growth_kb( [&](){ return bool( scarab::param_input_jsonl().read_file( t_large_filename ) ); } );
+    std::cout << "Peak memory growth while reading JSON-lines records:\n";
+    std::cout << "\tone at a time, 10k records: " << t_small_stream_kb << " kB\n";
+    std::cout << "\tone at a time, 200k records: " << t_large_stream_kb << " kB\n";
+    std::cout << "\tall records at once, 200k records: " << t_large_all_kb / 1024 << " MB" << std::endl;
+    REQUIRE( t_large_stream_kb >= 0 );
+    REQUIRE( t_large_all_kb > t_large_stream_kb );
+#endif
+
+    BENCHMARK( "param_jsonl_reader, one record at a time, 200k records" )
+    {
+        double t_sum = 0.;
+        sum_records( t_large_filename, t_sum );
+        return t_sum;
+    };
+
+    BENCHMARK( "param_input_jsonl read_file, 200k records" )
+    {
+        return scarab::param_input_jsonl().read_file( t_large_filename )->as_array().size();
+    };
+
+    BENCHMARK( "param_jsonl_writer, 10k records" )
+    {
+        write_records_file( t_small_filename, 10000 );
+    };
+
+    std::remove( t_small_filename.c_str() );
+    std::remove( t_large_filename.c_str() );
+}
+
+TEST_CASE( "param_json lazy reading", "[param][param_json][benchmark]" )
+{
+    const unsigned t_n_services = 100000;
+    const std::string t_json = make_shared_config_json( t_n_services );
+    std::cout << "JSON size: " << t_json.size() << " bytes" << std::endl;
+
+    param_input_json t_reader;
+    const param_node t_dom_options( "dom"_a=true );
+    const param_node t_lazy_options( "lazy"_a=true );
+
+    const unsigned t_expected = read_one_percent( t_reader.read_string( t_json )->as_node(), t_n_services );
+    REQUIRE( read_one_percent( t_reader.read_string( t_json, t_lazy_options )->as_node(), t_n_services ) == t_expected );
+
+    BENCHMARK( "read_string and read 1% of the keys, streaming" )
+    {
+        return read_one_percent( t_reader.read_string( t_json )->as_node(), t_n_services );
+    };
+
+    BENCHMARK( "read_string and read 1% of the keys, DOM" )
+    {
+        return read_one_percent( t_reader.read_string( t_json, t_dom_options )->as_node(), t_n_services );
+    };
+
+    BENCHMARK( "read_string and read 1% of the keys, lazy" )
+    {
+        return read_one_percent( t_reader.read_string( t_json, t_lazy_options )->as_node(), t_n_services );
+    };
+}
+
+TEST_CASE( "param_json simd", "[param][param_json][benchmark]" )
+{
+    std::cout << "SIMD parser: " << ( scarab::json_simd::available() ? scarab::json_simd::instruction_set() : "not available" ) << std::endl;
+
+    const unsigned t_n_services = 100000;
+    const std::string t_json = make_shared_config_json( t_n_services );
+
+    const std::string t_filename( "benchmark_param_json_simd.json" );
+    write_metadata_file( t_filename, 64 );
+
+    param_input_json t_reader;
+    const param_node t_scalar_options( "simd"_a=false );
+    const param_node t_mmap_options( "mmap"_a=true );
+    const param_node t_mmap_scalar_options( "mmap"_a=true, "simd"_a=false );
+
+    REQUIRE( t_reader.read_string( t_json )->to_string() == t_reader.read_string( t_json, t_scalar_options )->to_string() );
+
+    BENCHMARK( "read_string, configuration, SIMD" )
+    {
+        return t_reader.read_string( t_json )->as_node().size();
+    };
+
+    BENCHMARK( "read_string, configuration, scalar" )
+    {
+        return t_reader.read_string( t_json, t_scalar_options )->as_node().size();
+    };
+
+    BENCHMARK( "read_file, 64 MB of metadata, memory-mapped, SIMD" )
+    {
+        return t_reader.read_file( t_filename, t_mmap_options )->as_node().size();
+    };
+
+    BENCHMARK( "read_file, 64 MB of metadata, memory-mapped, scalar" )
+    {
+        return t_reader.read_file( t_filename, t_mmap_scalar_options )->as_node().size();
+    };
+
+    std::remove( t_filename.c_str() );
+}
@@ -0,0 +1,104 @@
+/*
+ * benchmark_param_merge.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares merging a deep, wide config into another by copying and by moving, as done when building the primary config in main_app.
+ */
+
+#include "alloc_counter.hh"
+
+#include "param.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab_testing::alloc_count;
+
+namespace
+{
+    // Builds a node with a_width values, an array of a_width values, and (above the bottom level) a_width subnodes
+    // Values are offset by a_offset; if a_extra is true, each node gets an extra value that the other configs don't have
+    param_node make_config( unsigned a_depth, unsigned a_width, int a_offset, bool a_extra )
+    {
+        param_node t_node;
+        param_array t_array;
+        for( unsigned i_item = 0; i_item < a_width; ++i_item )
+        {
+            t_node.add( "value-" + std::to_string(i_item), a_offset + int(i_item) );
+            t_array.push_back( "string " + std::to_string(a_offset + int(i_item)) );
+        }
+        t_node.add( "array", std::move(t_array) );
+        if( a_extra ) t_node.add( "extra", a_offset );
+        if( a_depth == 0 ) return t_node;
+        for( unsigned i_sub = 0; i_sub < a_width; ++i_sub )
+        {
+            t_node.add( "node-" + std::to_string(i_sub), make_config( a_depth - 1, a_width, a_offset, a_extra ) );
+        }
+        return t_node;
+    }
+
+    const unsigned s_depth = 3;
+    const unsigned s_width = 8;
+}
+
+TEST_CASE( "param_node merge allocations", "[param][param_merge][benchmark]" )
+{
+    param_node t_copy_target = make_config( s_depth, s_width, 0, false );
+    param_node t_move_target( make_config( s_depth, s_width, 0, false ) );
+    param_node t_copy_source = make_config( s_depth, s_width, 1000, true );
+    param_node t_move_source = make_config( s_depth, s_width, 1000, true );
+
+    std::size_t t_n_copy = 0;
+    {
+        alloc_count t_count;
+        t_copy_target.merge( t_copy_source );
+        t_n_copy = t_count.count();
+    }
+
+    std::size_t t_n_move = 0;
+    {
+        alloc_count t_count;
+        t_move_target.merge( std::move(t_move_source) );
+        t_n_move = t_count.count();
+    }
+
+    std::cout << "Allocations merging a config with depth " << s_depth << " and width " << s_width << ":\n";
+    std::cout << "\tcopy: " << t_n_copy << '\n';
+    std::cout << "\tmove: " << t_n_move << std::endl;
+
+    REQUIRE( t_n_move < t_n_copy );
+    REQUIRE( t_move_source.empty() );
+    REQUIRE( t_copy_target.has_subset( t_move_target ) );
+    REQUIRE( t_move_target.has_subset( t_copy_target ) );
+}
+
+TEST_CASE( "param_node merge", "[param][param_merge][benchmark]" )
+{
+    const param_node t_base = make_config( s_depth, s_width, 0, false );
+
+    // the sources are built outside of the measurement; each run needs its own, since merging by move consumes it
+
+    BENCHMARK_ADVANCED( "merge copy" )( Catch::Benchmark::Chronometer meter )
+    {
+        std::vector< param_node > t_targets( meter.runs(), t_base );
+        std::vector< param_node > t_sources;
+        for( int i_run = 0; i_run < meter.runs(); ++i_run ) t_sources.push_back( make_config( s_depth, s_width, 1000, true ) );
+        meter.measure( [&t_targets, &t_sources]( int i_run ){ t_targets[i_run].merge( t_sources[i_run] ); return t_targets[i_run].size(); } );
+    };
+
+    BENCHMARK_ADVANCED( "merge move" )( Catch::Benchmark::Chronometer meter )
+    {
+        std::vector< param_node > t_targets( meter.runs(), t_base );
+        std::vector< param_node > t_sources;
+        for( int i_run = 0; i_run < meter.runs(); ++i_run ) t_sources.push_back( make_config( s_depth, s_width, 1000, true ) );
+        meter.measure( [&t_targets, &t_sources]( int i_run ){ t_targets[i_run].merge( std::move(t_sources[i_run]) ); return t_targets[i_run].size(); } );
+    };
+}
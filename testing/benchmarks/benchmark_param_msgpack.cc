@@ -0,0 +1,110 @@
+/*
+ * benchmark_param_msgpack.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares writing and reading a param structure with the MessagePack codec and with the text codecs.
+ */
+
+#include "param.hh"
+#include "param_msgpack.hh"
+
+#ifdef USE_CODEC_JSON
+#include "param_json.hh"
+#endif
+#ifdef USE_CODEC_YAML
+#include "param_yaml.hh"
+#endif
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <string>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::operator""_a;
+
+namespace
+{
+    // records of the sort found in run metadata
+    param_node make_metadata( unsigned a_n_records )
+    {
+        param_array t_records;
+        for( unsigned i_record = 0; i_record < a_n_records; ++i_record )
+        {
+            param_array t_samples;
+            t_samples.push_back( i_record, -int( i_record ), 0.5 * i_record );
+            t_records.push_back( param_node( "id"_a=i_record, "channel"_a=i_record % 16, "gain"_a=1.0 + 0.001 * i_record,
+                                             "label"_a="record-" + std::to_string( i_record ), "valid"_a=( i_record % 7 != 0 ),
+                                             "samples"_a=t_samples ) );
+        }
+        return param_node( "name"_a="benchmark", "records"_a=t_records );
+    }
+}
+
+TEST_CASE( "param_msgpack", "[param][param_msgpack][benchmark]" )
+{
+    const param_node t_metadata = make_metadata( 10000 );
+
+    scarab::param_output_msgpack t_msgpack_writer;
+    scarab::param_input_msgpack t_msgpack_reader;
+    std::string t_msgpack;
+    REQUIRE( t_msgpack_writer.write_string( t_metadata, t_msgpack ) );
+    std::cout << "Encoded sizes:\n\tMessagePack: " << t_msgpack.size() << " bytes\n";
+
+    BENCHMARK( "msgpack write" )
+    {
+        std::string t_written;
+        t_msgpack_writer.write_string( t_metadata, t_written );
+        return t_written.size();
+    };
+
+    BENCHMARK( "msgpack read" )
+    {
+        return t_msgpack_reader.read_string( t_msgpack )->as_node().size();
+    };
+
+#ifdef USE_CODEC_JSON
+    scarab::param_output_json t_json_writer;
+    scarab::param_input_json t_json_reader;
+    std::string t_json;
+    REQUIRE( t_json_writer.write_string( t_metadata, t_json ) );
+    std::cout << "\tJSON: " << t_json.size() << " bytes\n";
+
+    BENCHMARK( "json write" )
+    {
+        std::string t_written;
+        t_json_writer.write_string( t_metadata, t_written );
+        return t_written.size();
+    };
+
+    BENCHMARK( "json read" )
+    {
+        return t_json_reader.read_string( t_json )->as_node().size();
+    };
+#endif
+
+#ifdef USE_CODEC_YAML
+    scarab::param_output_yaml t_yaml_writer;
+    scarab::param_input_yaml t_yaml_reader;
+    std::string t_yaml;
+    REQUIRE( t_yaml_writer.write_string( t_metadata, t_yaml ) );
+    std::cout << "\tYAML: " << t_yaml.size() << " bytes\n";
+
+    BENCHMARK( "yaml write" )
+    {
+        std::string t_written;
+        t_yaml_writer.write_string( t_metadata, t_written );
+        return t_written.size();
+    };
+
+    BENCHMARK( "yaml read" )
+    {
+        return t_yaml_reader.read_string( t_yaml )->as_node().size();
+    };
+#endif
+    std::cout << std::flush;
+}
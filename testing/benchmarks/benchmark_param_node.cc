@@ -0,0 +1,83 @@
+/*
+ * benchmark_param_node.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Lookups in a param_node, as done when reading configuration values in a tight loop.
+ */
+
+#include "param.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+
+using scarab::param_node;
+using scarab::operator""_a;
+
+TEST_CASE( "param_node lookup", "[param][param_node][benchmark]" )
+{
+    param_node t_node;
+    for( unsigned i_item = 0; i_item < 100; ++i_item )
+    {
+        t_node.add( "item-" + std::to_string(i_item), i_item );
+    }
+    t_node.add( "threshold", 5.5 );
+
+    BENCHMARK( "has" )
+    {
+        return t_node.has( "threshold" );
+    };
+
+    BENCHMARK( "operator[]" )
+    {
+        return t_node["threshold"]().as_double();
+    };
+
+    BENCHMARK( "get_value (present)" )
+    {
+        return t_node.get_value( "threshold", 1.0 );
+    };
+
+    BENCHMARK( "get_value (absent)" )
+    {
+        return t_node.get_value( "not-there", 1.0 );
+    };
+}
+
+TEST_CASE( "param_node copy", "[param][param_node][benchmark]" )
+{
+    // 1000 subnodes with 50 values each
+    param_node t_tree;
+    for( unsigned i_node = 0; i_node < 1000; ++i_node )
+    {
+        param_node t_sub;
+        for( unsigned i_item = 0; i_item < 50; ++i_item )
+        {
+            t_sub.add( "item-" + std::to_string(i_item), i_item );
+        }
+        t_tree.add( "node-" + std::to_string(i_node), std::move(t_sub) );
+    }
+
+    BENCHMARK( "copy" )
+    {
+        param_node t_copy( t_tree );
+        return t_copy.size();
+    };
+
+    BENCHMARK( "copy and modify one value" )
+    {
+        param_node t_copy( t_tree );
+        t_copy["node-500"].as_node().replace( "item-25", 1000 );
+        return t_copy.size();
+    };
+
+    BENCHMARK( "copy and merge" )
+    {
+        param_node t_copy( t_tree );
+        t_copy.merge( param_node( "node-500"_a=param_node( "item-25"_a=1000 ) ) );
+        return t_copy.size();
+    };
+}
@@ -0,0 +1,65 @@
+/*
+ * benchmark_param_path.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares ways of reading a value deep in a config, as done when reading configuration values for every event.
+ */
+
+#include "param.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_path;
+using scarab::param_path_handle;
+
+TEST_CASE( "param_path lookup", "[param][param_path][benchmark]" )
+{
+    // detector.channels.[0-15].calibration.gain, with 50 other items at each node level
+    param_array t_channels;
+    for( unsigned i_channel = 0; i_channel < 16; ++i_channel )
+    {
+        param_node t_calibration;
+        for( unsigned i_item = 0; i_item < 50; ++i_item ) t_calibration.add( "item-" + std::to_string(i_item), i_item );
+        t_calibration.add( "gain", 1.0 + 0.1 * i_channel );
+        param_node t_channel;
+        t_channel.add( "calibration", std::move(t_calibration) );
+        t_channels.push_back( std::move(t_channel) );
+    }
+    param_node t_detector;
+    for( unsigned i_item = 0; i_item < 50; ++i_item ) t_detector.add( "item-" + std::to_string(i_item), i_item );
+    t_detector.add( "channels", std::move(t_channels) );
+    param_node t_config_tree;
+    for( unsigned i_item = 0; i_item < 50; ++i_item ) t_config_tree.add( "item-" + std::to_string(i_item), i_item );
+    t_config_tree.add( "detector", std::move(t_detector) );
+    const param_node& t_config = t_config_tree;
+
+    const param_path t_path( "detector.channels.3.calibration.gain" );
+    param_path_handle t_handle = t_path.bind( t_config );
+
+    BENCHMARK( "chained operator[]" )
+    {
+        return t_config["detector"]["channels"][3]["calibration"]["gain"]().as_double();
+    };
+
+    BENCHMARK( "param_path compiled each time" )
+    {
+        return param_path( "detector.channels.3.calibration.gain" ).resolve( t_config )().as_double();
+    };
+
+    BENCHMARK( "precompiled param_path" )
+    {
+        return t_path.resolve( t_config )().as_double();
+    };
+
+    BENCHMARK( "param_path_handle" )
+    {
+        return t_handle->as_value().as_double();
+    };
+}
@@ -0,0 +1,81 @@
+/*
+ * benchmark_param_snapshot.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares lookups in a param_node and in a frozen param_snapshot of it.
+ */
+
+#include "param.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_snapshot;
+
+TEST_CASE( "param_snapshot lookup", "[param][param_snapshot][benchmark]" )
+{
+    // 1000 items, plus detector.channels.[0-15].gain
+    param_node t_config_tree;
+    for( unsigned i_item = 0; i_item < 1000; ++i_item )
+    {
+        t_config_tree.add( "item-" + std::to_string(i_item), i_item );
+    }
+    param_array t_channels;
+    for( unsigned i_channel = 0; i_channel < 16; ++i_channel )
+    {
+        param_node t_channel;
+        t_channel.add( "gain", 1.0 + 0.1 * i_channel );
+        t_channels.push_back( std::move(t_channel) );
+    }
+    param_node t_detector;
+    t_detector.add( "channels", std::move(t_channels) );
+    t_config_tree.add( "detector", std::move(t_detector) );
+    const param_node& t_config = t_config_tree;
+
+    param_snapshot t_frozen = t_config.freeze();
+
+    BENCHMARK( "freeze" )
+    {
+        return t_config.freeze().n_params();
+    };
+
+    BENCHMARK( "param_node get_value" )
+    {
+        return t_config.get_value( "item-500", 0u );
+    };
+
+    BENCHMARK( "param_snapshot get_value" )
+    {
+        return t_frozen.get_value( "item-500", 0u );
+    };
+
+    BENCHMARK( "param_node nested operator[]" )
+    {
+        return t_config["detector"]["channels"][3]["gain"]().as_double();
+    };
+
+    BENCHMARK( "param_snapshot nested operator[]" )
+    {
+        return t_frozen["detector"]["channels"][3]["gain"]().as_double();
+    };
+
+    BENCHMARK( "param_node iteration" )
+    {
+        unsigned t_sum = 0;
+        for( const scarab::param& t_item : t_config ) t_sum += t_item.is_value() ? 1 : 0;
+        return t_sum;
+    };
+
+    BENCHMARK( "param_snapshot iteration" )
+    {
+        unsigned t_sum = 0;
+        for( scarab::frozen_param t_item : t_frozen ) t_sum += t_item.is_value() ? 1 : 0;
+        return t_sum;
+    };
+}
@@ -0,0 +1,92 @@
+/*
+ * benchmark_param_spb.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares the time for a process to open a configuration file and look up one value:
+ *  by mapping an spb snapshot file, by reading it through the codec (which thaws it), and by reading MessagePack (if available).
+ *  Mapping is done for two file sizes, to show that its time doesn't depend on the size of the file.
+ */
+
+#include "param.hh"
+#include "param_spb.hh"
+
+#ifdef USE_CODEC_MSGPACK
+#include "param_msgpack.hh"
+#endif
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_snapshot;
+using scarab::operator""_a;
+
+namespace
+{
+    // calibration records, plus a small settings node
+    param_node make_calibration( unsigned a_n_records )
+    {
+        param_array t_records;
+        for( unsigned i_record = 0; i_record < a_n_records; ++i_record )
+        {
+            t_records.push_back( param_node( "channel"_a=i_record, "gain"_a=1.0 + 0.001 * i_record, "offset"_a=-0.5 * i_record,
+                                             "label"_a="channel-" + std::to_string( i_record ) ) );
+        }
+        return param_node( "settings"_a=param_node( "threshold"_a=2.5, "mode"_a="calibrated" ), "records"_a=t_records );
+    }
+}
+
+TEST_CASE( "param_spb", "[param][param_spb][benchmark]" )
+{
+    const std::string t_small_filename( "benchmark_param_spb_small.spb" );
+    const std::string t_large_filename( "benchmark_param_spb_large.spb" );
+    const param_node t_small = make_calibration( 1000 );
+    const param_node t_large = make_calibration( 100000 );
+
+    scarab::param_output_spb t_spb_writer;
+    scarab::param_input_spb t_spb_reader;
+    REQUIRE( t_spb_writer.write_file( t_small, t_small_filename ) );
+    REQUIRE( t_spb_writer.write_file( t_large, t_large_filename ) );
+    std::cout << "File sizes:\n\tspb, small: " << param_snapshot::map_file( t_small_filename ).image().size() << " bytes\n";
+    std::cout << "\tspb, large: " << param_snapshot::map_file( t_large_filename ).image().size() << " bytes\n";
+
+    BENCHMARK( "spb map_file and lookup, small" )
+    {
+        return param_snapshot::map_file( t_small_filename )["records"][500]["gain"]().as_double();
+    };
+
+    BENCHMARK( "spb map_file and lookup, large" )
+    {
+        return param_snapshot::map_file( t_large_filename )["records"][500]["gain"]().as_double();
+    };
+
+    BENCHMARK( "spb read_file (thawed) and lookup, large" )
+    {
+        return t_spb_reader.read_file( t_large_filename )->as_node()["records"][500]["gain"]().as_double();
+    };
+
+#ifdef USE_CODEC_MSGPACK
+    const std::string t_msgpack_filename( "benchmark_param_spb_large.msgpack" );
+    scarab::param_output_msgpack t_msgpack_writer;
+    scarab::param_input_msgpack t_msgpack_reader;
+    REQUIRE( t_msgpack_writer.write_file( t_large, t_msgpack_filename ) );
+
+    BENCHMARK( "msgpack read_file and lookup, large" )
+    {
+        return t_msgpack_reader.read_file( t_msgpack_filename )->as_node()["records"][500]["gain"]().as_double();
+    };
+
+    std::remove( t_msgpack_filename.c_str() );
+#endif
+
+    std::remove( t_small_filename.c_str() );
+    std::remove( t_large_filename.c_str() );
+    std::cout << std::flush;
+}
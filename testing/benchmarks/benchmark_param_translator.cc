@@ -0,0 +1,109 @@
+/*
+ * benchmark_param_translator.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares serializing a small message through param_translator, which reuses the calling thread's codec,
+ *  with creating a codec from the factory for each message (as param_translator used to, though it never deleted them),
+ *  and with calling the codec directly.
+ *  Also compares reading and merging a set of config fragments with param_translator::read_files() on one thread and on several.
+ */
+
+#include "alloc_counter.hh"
+
+#include "param.hh"
+#include "param_codec.hh"
+#include "param_msgpack.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_output_codec;
+using scarab::param_translator;
+using scarab_testing::alloc_count;
+using scarab::operator""_a;
+
+TEST_CASE( "param_translator per-message overhead", "[param][param_translator][benchmark]" )
+{
+    const param_node t_message( "id"_a=42, "channel"_a=3, "gain"_a=1.25, "status"_a="ok" );
+    const std::string t_encoding( "msgpack" );
+
+    param_translator t_translator;
+    scarab::param_output_msgpack t_codec;
+    std::string t_written;
+
+    REQUIRE( t_translator.write_string( t_message, t_written, t_encoding ) );
+    std::size_t t_n_translator = 0;
+    {
+        alloc_count t_count;
+        t_translator.write_string( t_message, t_written, t_encoding );
+        t_n_translator = t_count.count();
+    }
+    std::size_t t_n_factory = 0;
+    {
+        alloc_count t_count;
+        std::unique_ptr< param_output_codec > t_new_codec( scarab::factory< param_output_codec >::get_instance()->create( t_encoding ) );
+        t_new_codec->write_string( t_message, t_written );
+        t_n_factory = t_count.count();
+    }
+    std::cout << "Allocations per message:\n\tparam_translator: " << t_n_translator << "\n\tcodec from the factory: " << t_n_factory << std::endl;
+    REQUIRE( t_n_translator < t_n_factory );
+
+    BENCHMARK( "param_translator::write_string" )
+    {
+        t_translator.write_string( t_message, t_written, t_encoding );
+        return t_written.size();
+    };
+
+    BENCHMARK( "codec from the factory, write_string" )
+    {
+        std::unique_ptr< param_output_codec > t_new_codec( scarab::factory< param_output_codec >::get_instance()->create( t_encoding ) );
+        t_new_codec->write_string( t_message, t_written );
+        return t_written.size();
+    };
+
+    BENCHMARK( "codec, write_string" )
+    {
+        t_codec.write_string( t_message, t_written );
+        return t_written.size();
+    };
+}
+
+TEST_CASE( "param_translator read_files", "[param][param_translator][benchmark]" )
+{
+    // per-channel fragments, each with its own node, plus some shared settings that later files override
+    const unsigned t_n_files = 32;
+    std::vector< std::string > t_filenames;
+    for( unsigned i_file = 0; i_file < t_n_files; ++i_file )
+    {
+        param_array t_samples;
+        for( unsigned i_sample = 0; i_sample < 20000; ++i_sample ) t_samples.push_back( param_node( "index"_a=i_sample, "weight"_a=0.5 * i_sample ) );
+        param_node t_fragment( "settings"_a=param_node( "source"_a=i_file ) );
+        t_fragment.add( "channel-" + std::to_string( i_file ), param_node( "samples"_a=t_samples ) );
+        t_filenames.push_back( "benchmark_param_translator_" + std::to_string( i_file ) + ".msgpack" );
+        REQUIRE( param_translator::output_codec( "msgpack" )->write_file( t_fragment, t_filenames.back() ) );
+    }
+
+    param_translator t_translator;
+
+    BENCHMARK( "read_files, 1 thread" )
+    {
+        return t_translator.read_files( t_filenames, param_node(), 1 )->as_node().size();
+    };
+
+    BENCHMARK( "read_files, hardware concurrency" )
+    {
+        return t_translator.read_files( t_filenames )->as_node().size();
+    };
+
+    for( const std::string& t_filename : t_filenames ) std::remove( t_filename.c_str() );
+}
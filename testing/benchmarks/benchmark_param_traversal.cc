@@ -0,0 +1,164 @@
+/*
+ * benchmark_param_traversal.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares recursive traversal with the serial and parallel param_traversal, on wide and on deep configs.
+ */
+
+#include "param.hh"
+#include "param_env_modifier.hh"
+#include "param_traversal.hh"
+#include "param_visitor.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <string>
+
+using scarab::param;
+using scarab::param_array;
+using scarab::param_env_modifier;
+using scarab::param_node;
+using scarab::param_traversal;
+using scarab::param_value;
+using scarab::param_visitor;
+
+namespace
+{
+    // Sums the lengths of the string values; thread-safe
+    class length_visitor : public param_visitor
+    {
+        public:
+            using param_visitor::operator();
+            virtual void operator()( const param_value& a_value ) const override
+            {
+                if( a_value.is_string() ) f_length.fetch_add( a_value.as_string().size(), std::memory_order_relaxed );
+                return;
+            }
+            mutable std::atomic< std::size_t > f_length{ 0 };
+    };
+
+    // The same, but descends with recursive calls to accept(), as visitors did before param_traversal
+    class recursive_length_visitor : public length_visitor
+    {
+        public:
+            using length_visitor::operator();
+            virtual void operator()( const param_array& an_array ) const override
+            {
+                for( const param& t_item : an_array ) t_item.accept( *this );
+                return;
+            }
+            virtual void operator()( const param_node& a_node ) const override
+            {
+                for( const param& t_item : a_node ) t_item.accept( *this );
+                return;
+            }
+    };
+
+    // An array of a_n_nodes nodes, each with a_n_values string values
+    param_node make_wide( unsigned a_n_nodes, unsigned a_n_values )
+    {
+        param_array t_array;
+        for( unsigned i_node = 0; i_node < a_n_nodes; ++i_node )
+        {
+            param_node t_node;
+            for( unsigned i_value = 0; i_value < a_n_values; ++i_value )
+            {
+                t_node.add( "value-" + std::to_string(i_value), "a string value, number " + std::to_string(i_value) );
+            }
+            t_array.push_back( std::move(t_node) );
+        }
+        param_node t_wide;
+        t_wide.add( "array", std::move(t_array) );
+        return t_wide;
+    }
+
+    // A chain of a_depth nested nodes, each with one value
+    param_node make_deep( unsigned a_depth )
+    {
+        param_node t_deep;
+        t_deep.add( "value", "a string value" );
+        for( unsigned i_level = 1; i_level < a_depth; ++i_level )
+        {
+            param_node t_parent;
+            t_parent.add( "value", "a string value" );
+            t_parent.add( "child", std::move(t_deep) );
+            t_deep = std::move(t_parent);
+        }
+        return t_deep;
+    }
+}
+
+TEST_CASE( "param_traversal scaling", "[param][param_traversal][benchmark]" )
+{
+    const param_node t_wide = make_wide( 256, 256 );
+
+    BENCHMARK( "wide visit: recursive" )
+    {
+        recursive_length_visitor t_visitor;
+        t_wide.accept( t_visitor );
+        return t_visitor.f_length.load();
+    };
+
+    BENCHMARK( "wide visit: serial traversal" )
+    {
+        length_visitor t_visitor;
+        param_traversal().visit( t_wide, t_visitor );
+        return t_visitor.f_length.load();
+    };
+
+    BENCHMARK( "wide visit: 2 threads" )
+    {
+        length_visitor t_visitor;
+        param_traversal( 2, 64 ).visit( t_wide, t_visitor );
+        return t_visitor.f_length.load();
+    };
+
+    BENCHMARK( "wide visit: 4 threads" )
+    {
+        length_visitor t_visitor;
+        param_traversal( 4, 64 ).visit( t_wide, t_visitor );
+        return t_visitor.f_length.load();
+    };
+
+    // environment-variable substitution runs a regex search on every string, so there's real work per value
+    param_node t_config = make_wide( 64, 64 );
+    param_env_modifier t_env_modifier;
+
+    BENCHMARK( "env modifier: serial" )
+    {
+        t_env_modifier( t_config );
+        return t_config.size();
+    };
+
+    BENCHMARK( "env modifier: 2 threads" )
+    {
+        param_traversal( 2, 16 ).modify( t_config, t_env_modifier );
+        return t_config.size();
+    };
+
+    BENCHMARK( "env modifier: 4 threads" )
+    {
+        param_traversal( 4, 16 ).modify( t_config, t_env_modifier );
+        return t_config.size();
+    };
+
+    const param_node t_deep = make_deep( 2000 );
+
+    BENCHMARK( "deep visit: recursive" )
+    {
+        recursive_length_visitor t_visitor;
+        t_deep.accept( t_visitor );
+        return t_visitor.f_length.load();
+    };
+
+    BENCHMARK( "deep visit: serial traversal" )
+    {
+        length_visitor t_visitor;
+        param_traversal().visit( t_deep, t_visitor );
+        return t_visitor.f_length.load();
+    };
+}
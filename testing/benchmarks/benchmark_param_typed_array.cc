@@ -0,0 +1,95 @@
+/*
+ * benchmark_param_typed_array.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Compares a long list of numbers held in a param_array and in a param_typed_array.
+ */
+
+#include "alloc_counter.hh"
+
+#include "param.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <vector>
+
+using scarab::param;
+using scarab::param_array;
+using scarab::param_double_array;
+using scarab_testing::alloc_count;
+
+namespace
+{
+    const unsigned s_size = 1000000;
+}
+
+TEST_CASE( "param_typed_array allocations", "[param][param_typed_array][benchmark]" )
+{
+    std::size_t t_n_boxed = 0;
+    param_array t_boxed;
+    {
+        alloc_count t_count;
+        for( unsigned i_element = 0; i_element < s_size; ++i_element ) t_boxed.push_back( 0.5 * i_element );
+        t_n_boxed = t_count.count();
+    }
+
+    std::size_t t_n_typed = 0;
+    param_double_array t_typed;
+    {
+        alloc_count t_count;
+        t_typed.resize( s_size );
+        double* t_data = t_typed.data();
+        for( unsigned i_element = 0; i_element < s_size; ++i_element ) t_data[i_element] = 0.5 * i_element;
+        t_n_typed = t_count.count();
+    }
+
+    std::cout << "Allocations for " << s_size << " doubles:\n";
+    std::cout << "\tparam_array: " << t_n_boxed << " (at least " << sizeof( scarab::param_value ) + sizeof( scarab::param_ptr_t ) << " bytes per element)\n";
+    std::cout << "\tparam_typed_array: " << t_n_typed << " (" << sizeof( double ) << " bytes per element)" << std::endl;
+
+    REQUIRE( t_n_typed < 5 );
+    REQUIRE( t_n_boxed >= s_size );
+}
+
+TEST_CASE( "param_typed_array access", "[param][param_typed_array][benchmark]" )
+{
+    // filled without the non-const accessors, so that copies share the contents
+    param_array t_boxed;
+    std::vector< double > t_values( s_size );
+    for( unsigned i_element = 0; i_element < s_size; ++i_element )
+    {
+        t_boxed.push_back( 0.5 * i_element );
+        t_values[i_element] = 0.5 * i_element;
+    }
+    param_double_array t_typed( t_values.data(), s_size );
+    const param_array& t_const_boxed = t_boxed;
+    const param_double_array& t_const_typed = t_typed;
+
+    BENCHMARK( "param_array sum" )
+    {
+        double t_sum = 0.;
+        for( const param& t_element : t_const_boxed ) t_sum += t_element().as_double();
+        return t_sum;
+    };
+
+    BENCHMARK( "param_typed_array sum" )
+    {
+        double t_sum = 0.;
+        for( double t_element : t_const_typed ) t_sum += t_element;
+        return t_sum;
+    };
+
+    BENCHMARK( "param_array copy" )
+    {
+        return param_array( t_const_boxed ).size();
+    };
+
+    BENCHMARK( "param_typed_array copy" )
+    {
+        return param_double_array( t_const_typed ).size();
+    };
+}
@@ -0,0 +1,88 @@
+/*
+ * benchmark_param_value.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Micro-benchmarks of param_value access, conversion, and comparison.
+ */
+
+#include "param_value.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+using scarab::param_value;
+
+TEST_CASE( "param_value access", "[param][param_value][benchmark]" )
+{
+    param_value t_int( 12345 );
+    param_value t_double( 3.14159 );
+    param_value t_string( "42" );
+    param_value t_double_string( "2.718281828" );
+
+    BENCHMARK( "as<int64_t>() from int" )
+    {
+        return t_int.as< int64_t >();
+    };
+
+    BENCHMARK( "as<int>() from double" )
+    {
+        return t_double.as< int >();
+    };
+
+    BENCHMARK( "as<int>() from string" )
+    {
+        return t_string.as< int >();
+    };
+
+    BENCHMARK( "as<double>() from string" )
+    {
+        return t_double_string.as< double >();
+    };
+
+    BENCHMARK( "as_string() from int" )
+    {
+        return t_int.as_string();
+    };
+
+    BENCHMARK( "as_string() from double" )
+    {
+        return t_double.as_string();
+    };
+
+    BENCHMARK( "as_string() from string" )
+    {
+        return t_string.as_string();
+    };
+}
+
+TEST_CASE( "param_value comparison", "[param][param_value][benchmark]" )
+{
+    param_value t_int( 42 );
+    param_value t_int_2( 42 );
+    param_value t_uint( 42U );
+    param_value t_string( "42" );
+    param_value t_string_2( "a string that is too long to be stored inline" );
+    param_value t_string_3( "a string that is too long to be stored inline" );
+
+    BENCHMARK( "strict, same type" )
+    {
+        return t_int.strict_is_equal_to( t_int_2 );
+    };
+
+    BENCHMARK( "strict, long strings" )
+    {
+        return t_string_2.strict_is_equal_to( t_string_3 );
+    };
+
+    BENCHMARK( "loose, int and uint" )
+    {
+        return t_int.loose_is_equal_to( t_uint );
+    };
+
+    BENCHMARK( "loose, int and string" )
+    {
+        return t_int.loose_is_equal_to( t_string );
+    };
+}
@@ -0,0 +1,120 @@
+/*
+ * benchmark_param_yaml.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Reads a string-heavy YAML file by streaming the parser's events and by converting a YAML::Node,
+ *  and compares typing its scalars with param_input_yaml::scalar_value()
+ *  and by trying YAML::Node::as<>() for each type in turn, catching the exceptions (as param_input_yaml used to).
+ *  Also compares writing it back out directly through a YAML::Emitter and by building a YAML::Node first.
+ */
+
+#include "param.hh"
+#include "param_yaml.hh"
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using scarab::param_input_yaml;
+using scarab::param_output_yaml;
+using scarab::param_value;
+using scarab::operator""_a;
+
+namespace
+{
+    // mostly string settings, with some numbers and flags
+    std::string make_string_heavy_yaml( unsigned a_n_channels )
+    {
+        std::stringstream t_yaml;
+        t_yaml << "channels:\n";
+        for( unsigned i_channel = 0; i_channel < a_n_channels; ++i_channel )
+        {
+            t_yaml << "  - name: channel-" << i_channel << "\n"
+                   << "    description: readout channel " << i_channel << " of the detector\n"
+                   << "    device: /dev/digitizer" << i_channel % 4 << "\n"
+                   << "    mode: triggered\n"
+                   << "    units: volts\n"
+                   << "    gain: " << 1.0 + 0.001 * i_channel << "\n"
+                   << "    enabled: true\n";
+        }
+        return t_yaml.str();
+    }
+
+    param_value scalar_value_by_exceptions( const YAML::Node& a_node )
+    {
+        try { return param_value( a_node.as< unsigned >() ); }
+        catch( const YAML::TypedBadConversion< unsigned >& ) {}
+        try { return param_value( a_node.as< int >() ); }
+        catch( const YAML::TypedBadConversion< int >& ) {}
+        try { return param_value( a_node.as< double >() ); }
+        catch( const YAML::TypedBadConversion< double >& ) {}
+        try { return param_value( a_node.as< bool >() ); }
+        catch( const YAML::TypedBadConversion< bool >& ) {}
+        return param_value( a_node.as< std::string >() );
+    }
+}
+
+TEST_CASE( "param_yaml scalars", "[param][param_yaml][benchmark]" )
+{
+    const std::string t_yaml = make_string_heavy_yaml( 2000 );
+    std::cout << "YAML size: " << t_yaml.size() << " bytes" << std::endl;
+
+    // the scalars in the file
+    std::vector< YAML::Node > t_scalars;
+    YAML::Node t_root = YAML::Load( t_yaml );
+    for( const YAML::Node& t_channel : t_root["channels"] )
+    {
+        for( YAML::const_iterator t_it = t_channel.begin(); t_it != t_channel.end(); ++t_it ) t_scalars.push_back( t_it->second );
+    }
+
+    param_input_yaml t_reader;
+
+    const scarab::param_node t_node_options( scarab::param_node( "node"_a=true ) );
+
+    BENCHMARK( "read_string, streaming" )
+    {
+        return t_reader.read_string( t_yaml )->as_node()["channels"].as_array().size();
+    };
+
+    BENCHMARK( "read_string, YAML::Node" )
+    {
+        return t_reader.read_string( t_yaml, t_node_options )->as_node()["channels"].as_array().size();
+    };
+
+    BENCHMARK( "type scalars with scalar_value" )
+    {
+        unsigned t_n_strings = 0;
+        for( const YAML::Node& t_scalar : t_scalars ) t_n_strings += param_input_yaml::scalar_value( t_scalar.Scalar() ).is_string();
+        return t_n_strings;
+    };
+
+    BENCHMARK( "type scalars with exceptions" )
+    {
+        unsigned t_n_strings = 0;
+        for( const YAML::Node& t_scalar : t_scalars ) t_n_strings += scalar_value_by_exceptions( t_scalar ).is_string();
+        return t_n_strings;
+    };
+
+    scarab::param_ptr_t t_param = t_reader.read_string( t_yaml );
+    param_output_yaml t_writer;
+
+    BENCHMARK( "write_string, emitter" )
+    {
+        std::string t_written;
+        t_writer.write_string( *t_param, t_written );
+        return t_written.size();
+    };
+
+    BENCHMARK( "write_string, YAML::Node" )
+    {
+        std::stringstream t_written;
+        t_written << t_writer.check_param_type( *t_param );
+        return t_written.str().size();
+    };
+}
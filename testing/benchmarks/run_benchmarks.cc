@@ -0,0 +1,16 @@
+/*
+ * run_benchmarks.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+
+#include "catch2/catch_session.hpp"
+
+int main( int argc, char* argv[] ) {
+
+  int result = Catch::Session().run( argc, argv );
+
+  return result;
+}
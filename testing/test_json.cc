@@ -11,7 +11,15 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <limits>
+#include <string>
+#include <vector>
 
 
 using scarab::param_node;
@@ -20,6 +28,7 @@ using scarab::param_array;
 using scarab::param_ptr_t;
 using scarab::param_output_json;
 using scarab::param_input_json;
+using scarab::operator""_a;
 
 TEST_CASE( "json", "[param][param_codec]" )
 {
@@ -72,3 +81,393 @@ TEST_CASE( "json", "[param][param_codec]" )
     REQUIRE( t_output_node["node"]["second"].is_value() );
     REQUIRE( t_output_node["node"]["second"]().as_string() == "hijklmnop" );
 }
+
+TEST_CASE( "json typed arrays", "[param][param_codec]" )
+{
+    param_node t_input;
+    t_input.add( "gains", scarab::param_double_array{ 1.5, 2.5, 3.5 } );
+    t_input.add( "offsets", scarab::param_int64_array{ -1, 0, 1 } );
+    t_input.add( "big", scarab::param_uint64_array{ 1, 18000000000000000000ULL } );
+
+    param_output_json t_writer;
+    std::string t_written;
+    REQUIRE( t_writer.write_string( t_input, t_written ) );
+
+    param_input_json t_reader;
+
+    // by default, arrays of numbers are read as param_arrays
+    param_ptr_t t_boxed( t_reader.read_string( t_written ) );
+    REQUIRE( t_boxed->as_node()["gains"].is_array() );
+    REQUIRE( t_boxed->as_node()["gains"][1]().as_double() == 2.5 );
+
+    const std::string t_filename( "test_json_typed_arrays.json" );
+    REQUIRE( t_writer.write_file( t_input, t_filename ) );
+
+    // every reading path gives back the same element types and values
+    std::vector< param_ptr_t > t_outputs;
+    t_outputs.push_back( t_reader.read_string( t_written, param_node( "typed-arrays"_a=true ) ) );
+    t_outputs.push_back( t_reader.read_string( t_written, param_node( "typed-arrays"_a=true, "dom"_a=true ) ) );
+    t_outputs.push_back( t_reader.read_file( t_filename, param_node( "typed-arrays"_a=true ) ) );
+    t_outputs.push_back( t_reader.read_file( t_filename, param_node( "typed-arrays"_a=true, "mmap"_a=true ) ) );
+    t_outputs.push_back( t_reader.read_file( t_filename, param_node( "typed-arrays"_a=true, "mmap"_a=true, "dom"_a=true ) ) );
+    std::remove( t_filename.c_str() );
+
+    for( const param_ptr_t& t_output : t_outputs )
+    {
+        REQUIRE( t_output );
+        const param_node& t_output_node = t_output->as_node();
+        REQUIRE( t_output_node["gains"].as_typed_array().get_element_type() == scarab::param_typed_array_base::k_double );
+        REQUIRE( t_output_node["offsets"].as_typed_array().get_element_type() == scarab::param_typed_array_base::k_int64 );
+        REQUIRE( t_output_node["big"].as_typed_array().get_element_type() == scarab::param_typed_array_base::k_uint64 );
+        for( const char* t_name : { "gains", "offsets", "big" } )
+        {
+            REQUIRE( t_output_node[t_name].as_typed_array().size() == t_input[t_name].as_typed_array().size() );
+        }
+        const scarab::param_double_array& t_gains = t_output_node["gains"].as_typed_array().as< double >();
+        const scarab::param_int64_array& t_offsets = t_output_node["offsets"].as_typed_array().as< std::int64_t >();
+        const scarab::param_uint64_array& t_big = t_output_node["big"].as_typed_array().as< std::uint64_t >();
+        REQUIRE( std::equal( t_gains.data(), t_gains.data() + t_gains.size(), t_input["gains"].as_typed_array().as< double >().data() ) );
+        REQUIRE( std::equal( t_offsets.data(), t_offsets.data() + t_offsets.size(), t_input["offsets"].as_typed_array().as< std::int64_t >().data() ) );
+        REQUIRE( std::equal( t_big.data(), t_big.data() + t_big.size(), t_input["big"].as_typed_array().as< std::uint64_t >().data() ) );
+    }
+
+    // non-negative integers are unsigned, whichever parser reads them
+    for( bool t_dom : { false, true } )
+    {
+        param_ptr_t t_small( t_reader.read_string( "[1, 2, 3]", param_node( "typed-arrays"_a=true, "dom"_a=t_dom ) ) );
+        REQUIRE( t_small->as_typed_array().get_element_type() == scarab::param_typed_array_base::k_uint64 );
+        param_ptr_t t_signed( t_reader.read_string( "[1, -2, 3]", param_node( "typed-arrays"_a=true, "dom"_a=t_dom ) ) );
+        REQUIRE( t_signed->as_typed_array().get_element_type() == scarab::param_typed_array_base::k_int64 );
+    }
+
+    param_ptr_t t_mixed( t_reader.read_string( "[1, \"two\", 3]", param_node( "typed-arrays"_a=true ) ) );
+    REQUIRE( t_mixed->is_array() );
+}
+
+TEST_CASE( "json streaming and dom parsing", "[param][param_codec]" )
+{
+    std::string t_json( "{\"name\": \"run\", \"count\": 3, \"big\": 5000000000, \"huge\": 18000000000000000000, \"neg\": -4, \"ratio\": 0.5, "
+                        "\"flag\": true, \"nothing\": null, \"list\": [1, \"two\", [3.5], {\"four\": 4}], \"nested\": {\"a\": {\"b\": []}}, "
+                        "\"name\": \"repeated\"}" );
+
+    param_input_json t_reader;
+    param_ptr_t t_streamed( t_reader.read_string( t_json ) );
+    param_ptr_t t_dom( t_reader.read_string( t_json, param_node( "dom"_a=true ) ) );
+    REQUIRE( t_streamed );
+    REQUIRE( t_dom );
+
+    // both paths give the same structure and the same value types
+    REQUIRE( t_streamed->to_string() == t_dom->to_string() );
+    REQUIRE( t_streamed->has_subset( *t_dom ) );
+    REQUIRE( t_dom->has_subset( *t_streamed ) );
+
+    const param_node& t_node = t_streamed->as_node();
+    REQUIRE( t_node.size() == 10 );
+    REQUIRE( t_node["name"]().as_string() == "repeated" );
+    REQUIRE( t_node["count"]().is_int() == t_dom->as_node()["count"]().is_int() );
+    REQUIRE( t_node["big"]().as_int() == 5000000000 );
+    REQUIRE( t_node["huge"]().as_uint() == 18000000000000000000ULL );
+    REQUIRE( t_node["neg"]().as_int() == -4 );
+    REQUIRE( t_node["ratio"]().as_double() == 0.5 );
+    REQUIRE( t_node["flag"]().as_bool() );
+    REQUIRE( t_node["nothing"].is_null() );
+    REQUIRE( t_node["list"].as_array().size() == 4 );
+    REQUIRE( t_node["list"][2][0]().as_double() == 3.5 );
+    REQUIRE( t_node["list"][3]["four"]().as_int() == 4 );
+    REQUIRE( t_node["nested"]["a"]["b"].as_array().empty() );
+
+    // a document may be a single value
+    param_ptr_t t_scalar( t_reader.read_string( "\"just a string\"" ) );
+    REQUIRE( t_scalar->is_value() );
+    REQUIRE( (*t_scalar)().as_string() == "just a string" );
+
+    REQUIRE_FALSE( t_reader.read_string( "{\"unterminated\": [1, 2" ) );
+    REQUIRE_FALSE( t_reader.read_string( "{\"unterminated\": [1, 2", param_node( "dom"_a=true ) ) );
+}
+
+TEST_CASE( "json memory-mapped files", "[param][param_codec]" )
+{
+    const std::string t_filename( "test_json_mmap.json" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << "{\n  \"name\": \"esc\\\"aped\\n\",\n  \"values\": [1, 2.5, -3],\n  \"nested\": {\"flag\": false}\n}\n";
+    }
+
+    param_input_json t_reader;
+    param_ptr_t t_streamed( t_reader.read_file( t_filename ) );
+    param_ptr_t t_mapped( t_reader.read_file( t_filename, param_node( "mmap"_a=true ) ) );
+    param_ptr_t t_mapped_dom( t_reader.read_file( t_filename, param_node( "mmap"_a=true, "dom"_a=true ) ) );
+    REQUIRE( t_streamed );
+    REQUIRE( t_mapped );
+    REQUIRE( t_mapped_dom );
+
+    REQUIRE( t_mapped->as_node()["name"]().as_string() == "esc\"aped\n" );
+    REQUIRE( t_mapped->as_node()["values"][1]().as_double() == 2.5 );
+    REQUIRE_FALSE( t_mapped->as_node()["nested"]["flag"]().as_bool() );
+    REQUIRE( t_mapped->to_string() == t_streamed->to_string() );
+    REQUIRE( t_mapped_dom->to_string() == t_streamed->to_string() );
+
+    // the file itself is not modified by in-situ parsing
+    REQUIRE( t_reader.read_file( t_filename, param_node( "mmap"_a=true ) )->to_string() == t_streamed->to_string() );
+
+    std::remove( t_filename.c_str() );
+    REQUIRE_FALSE( t_reader.read_file( t_filename, param_node( "mmap"_a=true ) ) );
+}
+
+TEST_CASE( "json memory-mapped file lifetime", "[param][param_codec]" )
+{
+    // strings and keys parsed in situ point into the mapping; the param structure has to have its own copies.
+    // They're longer than any small-string buffer, and some have escapes, which in-situ parsing rewrites in the mapping.
+    const std::string t_long( 200, 'x' );
+    const std::string t_filename( "test_json_mmap_lifetime.json" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << "{\"" << t_long << "-key\": \"" << t_long << "\", \"escaped\": \"tab\\there " << t_long << "\", "
+               << "\"list\": [\"" << t_long << "\", {\"inner\": \"" << t_long << "\\n\"}], \"number\": 42}";
+    }
+
+    param_input_json t_reader;
+    param_ptr_t t_streamed( t_reader.read_file( t_filename ) );
+    param_ptr_t t_mapped( t_reader.read_file( t_filename, param_node( "mmap"_a=true ) ) );
+    param_ptr_t t_mapped_dom( t_reader.read_file( t_filename, param_node( "mmap"_a=true, "dom"_a=true ) ) );
+    param_ptr_t t_mapped_lazy( t_reader.read_file( t_filename, param_node( "mmap"_a=true, "lazy"_a=true ) ) );
+    param_ptr_t t_untouched_lazy( t_reader.read_file( t_filename, param_node( "mmap"_a=true, "lazy"_a=true ) ) );
+    REQUIRE( t_streamed );
+    REQUIRE( t_mapped );
+    REQUIRE( t_mapped_dom );
+    REQUIRE( t_mapped_lazy );
+
+    // the file is gone, and the mappings have been released, except the one kept by the lazy structure
+    std::remove( t_filename.c_str() );
+    {
+        // reusing the freed memory shouldn't change anything
+        std::vector< std::string > t_filler( 100, std::string( t_long.size(), '?' ) );
+    }
+
+    for( const param_ptr_t* t_param : { &t_mapped, &t_mapped_dom, &t_mapped_lazy } )
+    {
+        const param_node& t_node = (*t_param)->as_node();
+        REQUIRE( t_node.has( t_long + "-key" ) );
+        REQUIRE( t_node[t_long + "-key"]().as_string() == t_long );
+        REQUIRE( t_node["escaped"]().as_string() == "tab\there " + t_long );
+        REQUIRE( t_node["list"][0]().as_string() == t_long );
+        REQUIRE( t_node["list"][1]["inner"]().as_string() == t_long + "\n" );
+        REQUIRE( t_node["number"]().as_int() == 42 );
+        REQUIRE( (*t_param)->to_string() == t_streamed->to_string() );
+    }
+
+    // a copy of a lazy structure that hasn't been made yet outlives the original, which keeps the mapping
+    param_ptr_t t_lazy_copy( t_untouched_lazy->clone() );
+    t_untouched_lazy.reset();
+    REQUIRE( t_lazy_copy->to_string() == t_streamed->to_string() );
+}
+
+TEST_CASE( "json lazy reading", "[param][param_codec]" )
+{
+    std::string t_json( "{\"name\": \"run\", \"count\": 3, \"list\": [1, \"two\", [3.5], {\"four\": 4}], \"gains\": [0.5, 1.5], "
+                        "\"nested\": {\"a\": {\"b\": []}, \"c\": {\"d\": true}}, \"name\": \"repeated\"}" );
+
+    param_input_json t_reader;
+    param_ptr_t t_streamed( t_reader.read_string( t_json ) );
+    for( bool t_typed_arrays : { false, true } )
+    {
+        param_ptr_t t_lazy( t_reader.read_string( t_json, param_node( "lazy"_a=true, "typed-arrays"_a=t_typed_arrays ) ) );
+        REQUIRE( t_lazy );
+        REQUIRE( t_lazy->as_node().is_deferred() );
+        REQUIRE( t_lazy->to_string() == t_reader.read_string( t_json, param_node( "typed-arrays"_a=t_typed_arrays ) )->to_string() );
+    }
+
+    // only the nodes and arrays that are reached are made
+    param_ptr_t t_lazy( t_reader.read_string( t_json, param_node( "lazy"_a=true ) ) );
+    const param_node& t_node = t_lazy->as_node();
+    REQUIRE( t_node["nested"]["c"]["d"]().as_bool() );
+    REQUIRE( t_node.size() == 5 );
+    REQUIRE( t_node["name"]().as_string() == "repeated" );
+    REQUIRE( t_node["list"].as_array().is_deferred() );
+    REQUIRE( t_node["nested"]["a"].as_node().is_deferred() );
+    REQUIRE( t_node.has_subset( t_streamed->as_node() ) );
+
+    // copies of a lazily-read structure don't need the original
+    param_node t_copy( t_lazy->as_node() );
+    t_lazy.reset();
+    REQUIRE( t_copy["list"][3]["four"]().as_int() == 4 );
+    t_copy["list"].as_array().push_back( 5 );
+    REQUIRE( t_copy["list"].as_array().size() == 5 );
+
+    // files, including memory-mapped files, whose mapping is kept until the structure has been made
+    const std::string t_filename( "test_json_lazy.json" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << t_json;
+    }
+    param_ptr_t t_from_file( t_reader.read_file( t_filename, param_node( "lazy"_a=true ) ) );
+    param_ptr_t t_from_mapping( t_reader.read_file( t_filename, param_node( "lazy"_a=true, "mmap"_a=true ) ) );
+    std::remove( t_filename.c_str() );
+    REQUIRE( t_from_file->to_string() == t_streamed->to_string() );
+    REQUIRE( t_from_mapping->to_string() == t_streamed->to_string() );
+
+    REQUIRE_FALSE( t_reader.read_string( "{\"unterminated\": [1, 2", param_node( "lazy"_a=true ) ) );
+}
+
+TEST_CASE( "json parse errors", "[param][param_codec]" )
+{
+    const std::string t_bad_json( "{\n  \"first\": 1,\n  \"second\": [1, 2,, 3]\n}\n" );
+    const std::size_t t_bad_offset = t_bad_json.find( ",," ) + 1;
+
+    param_input_json t_reader;
+    scarab::json_parse_error t_error;
+
+    REQUIRE( t_reader.read_string( "{\"fine\": true}", param_node(), t_error ) );
+    REQUIRE_FALSE( t_error.occurred() );
+
+    REQUIRE_FALSE( t_reader.read_string( t_bad_json, param_node(), t_error ) );
+    REQUIRE( t_error.occurred() );
+    REQUIRE( t_error.f_offset == t_bad_offset );
+    REQUIRE( t_error.f_line == 3 );
+    REQUIRE( t_error.f_column == t_bad_offset - t_bad_json.rfind( '\n', t_bad_offset ) );
+    REQUIRE( t_error.to_string().find( "line 3" ) != std::string::npos );
+
+    scarab::json_parse_error t_dom_error;
+    REQUIRE_FALSE( t_reader.read_string( t_bad_json, param_node( "dom"_a=true ), t_dom_error ) );
+    REQUIRE( t_dom_error.f_line == t_error.f_line );
+    REQUIRE( t_dom_error.f_column == t_error.f_column );
+
+    const std::string t_filename( "test_json_errors.json" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << t_bad_json;
+    }
+
+    // the location is the same whether it's counted while reading the file or found in memory
+    for( const param_node& t_options : { param_node(), param_node( "dom"_a=true ), param_node( "mmap"_a=true ), param_node( "mmap"_a=true, "dom"_a=true ) } )
+    {
+        scarab::json_parse_error t_file_error;
+        REQUIRE_FALSE( t_reader.read_file( t_filename, t_options, t_file_error ) );
+        REQUIRE( t_file_error.f_offset == t_error.f_offset );
+        REQUIRE( t_file_error.f_line == t_error.f_line );
+        REQUIRE( t_file_error.f_column == t_error.f_column );
+    }
+
+    std::remove( t_filename.c_str() );
+    REQUIRE_FALSE( t_reader.read_file( t_filename, param_node(), t_error ) );
+    REQUIRE( t_error.occurred() );
+    REQUIRE( t_error.f_line == 0 );
+}
+
+TEST_CASE( "json simd parsing", "[param][param_codec]" )
+{
+    // long runs of whitespace and long strings, which the SIMD parser scans 16 bytes at a time
+    std::string t_json( "{\n" );
+    for( unsigned i_item = 0; i_item < 100; ++i_item )
+    {
+        t_json += "                                  \"item-" + std::to_string( i_item ) + "\" :\t\t\t\t\t\t\t\t{ \"text\": \""
+                  + std::string( i_item, 'x' ) + "\\\"quoted\\\"\\u00e9\", \"values\": [ " + std::to_string( i_item ) + ",   -1.5e3 ,\r\n 0.25 ] },\n";
+    }
+    t_json += "\"last\": null}";
+
+    param_input_json t_reader;
+    const param_node t_scalar_options( "simd"_a=false );
+    param_ptr_t t_scalar( t_reader.read_string( t_json, t_scalar_options ) );
+    param_ptr_t t_simd( t_reader.read_string( t_json ) );
+    REQUIRE( t_scalar );
+    REQUIRE( t_simd );
+    REQUIRE( t_simd->to_string() == t_scalar->to_string() );
+    REQUIRE( t_simd->as_node()["item-99"]["text"]().as_string() == std::string( 99, 'x' ) + "\"quoted\"\u00e9" );
+
+    const std::string t_filename( "test_json_simd.json" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << t_json;
+    }
+    REQUIRE( t_reader.read_file( t_filename, param_node( "mmap"_a=true ) )->to_string() == t_scalar->to_string() );
+    REQUIRE( t_reader.read_file( t_filename, param_node( "mmap"_a=true, "simd"_a=false ) )->to_string() == t_scalar->to_string() );
+    std::remove( t_filename.c_str() );
+
+    // errors are found at the same place
+    const std::string t_bad_json( t_json.substr( 0, t_json.rfind( "\"last\"" ) ) + "                        ]" );
+    scarab::json_parse_error t_scalar_error, t_simd_error;
+    REQUIRE_FALSE( t_reader.read_string( t_bad_json, t_scalar_options, t_scalar_error ) );
+    REQUIRE_FALSE( t_reader.read_string( t_bad_json, param_node(), t_simd_error ) );
+    REQUIRE( t_simd_error.f_offset == t_scalar_error.f_offset );
+    REQUIRE( t_simd_error.f_line == t_scalar_error.f_line );
+
+    if( scarab::json_simd::available() ) REQUIRE( std::string( scarab::json_simd::instruction_set() ).size() > 0 );
+    else REQUIRE( std::string( scarab::json_simd::instruction_set() ).empty() );
+}
+
+TEST_CASE( "json number and string writing", "[param][param_codec]" )
+{
+    param_node t_node( "whole"_a=100.0, "negative-zero"_a=-0.0, "small"_a=1e-300, "large"_a=1e300, "tenth"_a=0.1,
+                       "int"_a=-5, "uint"_a=std::numeric_limits< std::uint64_t >::max(), "text"_a=std::string( "with\0null", 9 ) );
+    t_node.add( "doubles", scarab::param_double_array{ 3.0, 2.5, 1e22 } );
+
+    param_output_json t_writer;
+    std::string t_json;
+    REQUIRE( t_writer.write_string( t_node, t_json ) );
+    REQUIRE( t_json.find( "\"whole\":100.0" ) != std::string::npos );
+    REQUIRE( t_json.find( "\"tenth\":0.1," ) != std::string::npos );
+    REQUIRE( t_json.find( "\\u0000" ) != std::string::npos );
+
+    // doubles are read back as doubles, with the same values
+    param_input_json t_reader;
+    param_ptr_t t_read( t_reader.read_string( t_json, param_node( "typed-arrays"_a=true ) ) );
+    REQUIRE( t_read );
+    const param_node& t_read_node = t_read->as_node();
+    for( const char* t_name : { "whole", "negative-zero", "small", "large", "tenth" } )
+    {
+        REQUIRE( t_read_node[t_name]().is_double() );
+        REQUIRE( t_read_node[t_name]().as_double() == t_node[t_name]().as_double() );
+    }
+    REQUIRE( t_read_node["int"]().as_int() == -5 );
+    REQUIRE( t_read_node["uint"]().as_uint() == std::numeric_limits< std::uint64_t >::max() );
+    REQUIRE( t_read_node["text"]().as_string() == std::string( "with\0null", 9 ) );
+    REQUIRE( t_read_node["doubles"].as_typed_array().get_element_type() == scarab::param_typed_array_base::k_double );
+    REQUIRE( t_read_node["doubles"].to_string() == t_node["doubles"].to_string() );
+
+    // pretty printing places the numbers in the same way
+    std::string t_pretty;
+    REQUIRE( t_writer.write_string( t_node, t_pretty, param_node( "style"_a="pretty" ) ) );
+    REQUIRE( t_reader.read_string( t_pretty )->to_string() == t_reader.read_string( t_json )->to_string() );
+
+    // and so does writing a file, which is complete once write_file() returns
+    const std::string t_filename( "test_json_writing.json" );
+    REQUIRE( t_writer.write_file( t_node, t_filename ) );
+    param_ptr_t t_from_file( t_reader.read_file( t_filename ) );
+    std::remove( t_filename.c_str() );
+    REQUIRE( t_from_file );
+    REQUIRE( t_from_file->to_string() == t_reader.read_string( t_json )->to_string() );
+}
+
+TEST_CASE( "json streams", "[param][param_codec]" )
+{
+    param_node t_node( "name"_a="stream", "values"_a=param_array( scarab::args( 1, 2.5, "three" ) ), "nested"_a=param_node( "flag"_a=true ) );
+
+    param_output_json t_writer;
+    param_input_json t_reader;
+    for( const std::string& t_style : { std::string( "compact" ), std::string( "pretty" ) } )
+    {
+        std::stringstream t_stream;
+        REQUIRE( t_writer.write_stream( t_node, t_stream, param_node( "style"_a=t_style ) ) );
+        std::string t_string;
+        REQUIRE( t_writer.write_string( t_node, t_string, param_node( "style"_a=t_style ) ) );
+        REQUIRE( t_stream.str() == t_string );
+
+        for( const param_node& t_options : { param_node(), param_node( "dom"_a=true ), param_node( "lazy"_a=true ) } )
+        {
+            std::istringstream t_input( t_string );
+            param_ptr_t t_read = t_reader.read_stream( t_input, t_options );
+            REQUIRE( t_read );
+            REQUIRE( t_read->to_string() == t_node.to_string() );
+        }
+    }
+
+    // errors are located as they are in strings
+    const std::string t_bad_json( "{\n  \"first\": 1,\n  \"second\": [1, 2,, 3]\n}\n" );
+    scarab::json_parse_error t_string_error, t_stream_error;
+    std::istringstream t_bad_input( t_bad_json );
+    REQUIRE_FALSE( t_reader.read_string( t_bad_json, param_node(), t_string_error ) );
+    REQUIRE_FALSE( t_reader.read_stream( t_bad_input, param_node(), t_stream_error ) );
+    REQUIRE( t_stream_error.f_offset == t_string_error.f_offset );
+    REQUIRE( t_stream_error.f_line == t_string_error.f_line );
+    REQUIRE( t_stream_error.f_column == t_string_error.f_column );
+}
@@ -0,0 +1,145 @@
+/*
+ * test_jsonl.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+#include "param_jsonl.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using scarab::param;
+using scarab::param_array;
+using scarab::param_jsonl_reader;
+using scarab::param_jsonl_writer;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::operator""_a;
+
+TEST_CASE( "jsonl", "[param][param_codec]" )
+{
+    SECTION( "Writer and reader" )
+    {
+        std::stringstream t_stream;
+        param_jsonl_writer t_writer( t_stream, 2 );
+        REQUIRE( t_writer.write( param_node( "id"_a=0, "text"_a="first\nline" ) ) );
+        // nothing reaches the stream until a batch is complete
+        REQUIRE( t_stream.str().empty() );
+        REQUIRE( t_writer.write( param_array( scarab::args( 1, 2.5, true ) ) ) );
+        const std::string t_first_batch = t_stream.str();
+        REQUIRE( std::count( t_first_batch.begin(), t_first_batch.end(), '\n' ) == 2 );
+        REQUIRE( t_writer.write( scarab::param_value( "three" ) ) );
+        REQUIRE( t_writer.write( param() ) );
+        REQUIRE( t_writer.write( scarab::param_double_array{ 0.5 } ) );
+        REQUIRE( t_writer.flush() );
+        REQUIRE( t_writer.n_records() == 5 );
+
+        // blank lines are skipped
+        t_stream << "\n   \n{\"id\": 5}\r\n";
+
+        param_jsonl_reader t_reader( t_stream );
+        param_ptr_t t_record = t_reader.next();
+        REQUIRE( t_record );
+        REQUIRE( t_record->as_node()["text"]().as_string() == "first\nline" );
+
+        // iteration continues from the current position
+        std::vector< std::string > t_records;
+        for( param& t_each : t_reader ) t_records.push_back( t_each.to_string() );
+        REQUIRE( t_records.size() == 5 );
+        REQUIRE( t_records[0] == param_array( scarab::args( 1, 2.5, true ) ).to_string() );
+        REQUIRE( t_records[1] == scarab::param_value( "three" ).to_string() );
+        REQUIRE( t_records[4] == param_node( "id"_a=5 ).to_string() );
+        REQUIRE( t_reader.n_records() == 6 );
+        REQUIRE_FALSE( t_reader.error().occurred() );
+        REQUIRE( t_reader.begin() == t_reader.end() );
+    }
+
+    SECTION( "Parse errors stop the reader" )
+    {
+        std::istringstream t_stream( "{\"ok\": 1}\n\n[1, 2,, 3]\n{\"ok\": 2}\n" );
+        param_jsonl_reader t_reader( t_stream );
+        REQUIRE( t_reader.next() );
+        REQUIRE_FALSE( t_reader.next() );
+        REQUIRE( t_reader.error().occurred() );
+        REQUIRE( t_reader.error().f_line == 3 );
+        REQUIRE( t_reader.error().f_column == 7 );
+        REQUIRE( t_reader.error().f_offset == 17 );
+        REQUIRE_FALSE( t_reader.next() );
+
+        scarab::param_input_jsonl t_codec;
+        REQUIRE_FALSE( t_codec.read_string( t_stream.str() ) );
+    }
+
+    SECTION( "Files through the codec" )
+    {
+        const std::string t_filename( "test_jsonl.jsonl" );
+        param_array t_records;
+        for( unsigned i_record = 0; i_record < 300; ++i_record )
+        {
+            t_records.push_back( param_node( "id"_a=i_record, "values"_a=param_array( scarab::args( 1, 2, 3 ) ) ) );
+        }
+
+        scarab::param_translator t_translator;
+        REQUIRE( t_translator.write_file( t_records, t_filename ) );
+        REQUIRE( t_translator.write_file( param_node( "id"_a=300 ), t_filename, param_node( "append"_a=true ) ) );
+
+        param_ptr_t t_read = t_translator.read_file( t_filename, param_node( "typed-arrays"_a=true ) );
+        REQUIRE( t_read );
+        REQUIRE( t_read->as_array().size() == 301 );
+        REQUIRE( t_read->as_array()[299]["id"]().as_uint() == 299 );
+        REQUIRE( t_read->as_array()[299]["values"].is_typed_array() );
+        REQUIRE( t_read->as_array()[300]["id"]().as_uint() == 300 );
+
+        {
+            param_jsonl_writer t_writer( t_filename, true );
+            REQUIRE( t_writer.write( param_node( "id"_a=301 ) ) );
+            // flushed when the writer is destroyed
+        }
+        unsigned t_count = 0;
+        param_jsonl_reader t_reader( t_filename );
+        for( param_jsonl_reader::iterator t_it = t_reader.begin(); t_it != t_reader.end(); ++t_it )
+        {
+            REQUIRE( (*t_it)["id"]().as_uint() == t_count++ );
+        }
+        REQUIRE( t_count == 302 );
+
+        // the iterators are copyable, so they work with the standard algorithms
+        param_jsonl_reader t_counting_reader( t_filename );
+        REQUIRE( std::count_if( t_counting_reader.begin(), t_counting_reader.end(),
+                                []( const param& a_record ){ return a_record["id"]().as_uint() % 2 == 0; } ) == 151 );
+        param_jsonl_reader t_copying_reader( t_filename );
+        param_jsonl_reader::iterator t_it = t_copying_reader.begin();
+        param_jsonl_reader::iterator t_copy( t_it );
+        REQUIRE( (*t_copy)["id"]().as_uint() == 0 );
+        REQUIRE( (*t_it++)["id"]().as_uint() == 0 );
+        REQUIRE( (*t_it)["id"]().as_uint() == 1 );
+
+        std::string t_written;
+        REQUIRE( t_translator.write_string( t_records, t_written, "jsonl" ) );
+        REQUIRE( std::count( t_written.begin(), t_written.end(), '\n' ) == 300 );
+
+#ifdef USE_COMPRESSED_IO
+        // records are compressed and decompressed as they're written and read
+        const std::string t_compressed_filename( "test_jsonl.jsonl.zst" );
+        REQUIRE( t_translator.write_file( t_records, t_compressed_filename ) );
+        param_ptr_t t_decompressed = t_translator.read_file( t_compressed_filename );
+        REQUIRE( t_decompressed );
+        REQUIRE( t_decompressed->as_array().size() == 300 );
+        REQUIRE( t_decompressed->as_array()[299]["id"]().as_uint() == 299 );
+        std::remove( t_compressed_filename.c_str() );
+#endif
+
+        std::remove( t_filename.c_str() );
+        REQUIRE_THROWS_AS( param_jsonl_reader( t_filename ), scarab::error );
+        REQUIRE_FALSE( t_translator.read_file( t_filename ) );
+    }
+}
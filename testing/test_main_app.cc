@@ -18,6 +18,8 @@
 
 #include <cstdio>
 #include <stdlib.h>
+#include <string>
+#include <vector>
 
 using_param_args_and_kwargs; // bring _a into namespace
 
@@ -89,6 +91,8 @@ TEST_CASE( "configuration", "[main_app]" )
 
     REQUIRE( t_app.default_config().empty() );
     REQUIRE( t_app.primary_config().empty() );
+    REQUIRE( t_app.live_config().version_number() == 0 );
+    REQUIRE( t_app.live_config().current()->f_config.empty() );
 
     t_app.default_config().add( "value", 5 );
 
@@ -184,6 +188,75 @@ TEST_CASE( "configuration", "[main_app]" )
 
 }
 
+#ifdef USE_CODEC_YAML
+TEST_CASE( "several config files", "[main_app]" )
+{
+    // the files are merged in the order given on the command line
+    std::vector< std::string > t_filenames{ "test_main_app_site.yaml", "test_main_app_detector.yaml", "test_main_app_channel.yaml" };
+    std::vector< scarab::param_node > t_configs{
+        scarab::param_node( "site"_a="lab", "value"_a=1, "detector"_a=scarab::param_node( "gain"_a=1.0 ) ),
+        scarab::param_node( "value"_a=2, "detector"_a=scarab::param_node( "gain"_a=2.0, "channels"_a=4 ) ),
+        scarab::param_node( "value"_a=3 )
+    };
+    scarab::param_translator t_translator;
+    for( unsigned i_file = 0; i_file < t_filenames.size(); ++i_file )
+    {
+        REQUIRE( t_translator.write_file( t_configs[i_file], t_filenames[i_file] ) );
+    }
+
+    // a default config file, which -c replaces
+    const std::string t_default_filename( "test_main_app_default.yaml" );
+    REQUIRE( t_translator.write_file( scarab::param_node( "default-file"_a=true ), t_default_filename ) );
+
+    scarab::main_app t_app;
+    t_app.default_config().add( "value", 0 );
+    t_app.default_config().add( "default-only", true );
+    t_app.config_filename() = t_default_filename;
+
+    // equivalent of -c test_main_app_site.yaml -c test_main_app_detector.yaml -c test_main_app_channel.yaml
+    CLI::Option* t_opt = t_app.get_option( "--config" );
+    for( const std::string& t_filename : t_filenames ) t_opt->add_result( t_filename );
+    t_opt->run_callback();
+    REQUIRE( t_app.config_filenames() == t_filenames );
+    REQUIRE( t_app.config_filename() == t_filenames.front() );
+
+    t_app.do_config_stage_1();
+    t_app.do_config_stage_2();
+    REQUIRE( t_app.primary_config()["value"]().as_int() == 3 );
+    REQUIRE( t_app.primary_config()["site"]().as_string() == "lab" );
+    REQUIRE( t_app.primary_config()["detector"]["gain"]().as_double() == 2.0 );
+    REQUIRE( t_app.primary_config()["detector"]["channels"]().as_int() == 4 );
+    REQUIRE( t_app.primary_config()["default-only"]().as_bool() );
+    REQUIRE_FALSE( t_app.primary_config().has( "default-file" ) );
+
+    // without -c, the default config file is read
+    scarab::main_app t_default_app;
+    t_default_app.config_filename() = t_default_filename;
+    t_default_app.do_config_stage_2();
+    REQUIRE( t_default_app.primary_config()["default-file"]().as_bool() );
+
+    // a file that can't be read
+    scarab::main_app t_bad_app;
+    t_bad_app.config_filenames() = t_filenames;
+    t_bad_app.config_filenames().push_back( "test_main_app_nonexistent.yaml" );
+    REQUIRE_THROWS_WITH( t_bad_app.do_config_stage_2(), "[application] error parsing config file" );
+
+    // a file that doesn't contain a node
+    const std::string t_array_filename( "test_main_app_array.yaml" );
+    scarab::param_array t_array;
+    t_array.push_back( 1 );
+    REQUIRE( t_translator.write_file( t_array, t_array_filename ) );
+    scarab::main_app t_array_app;
+    t_array_app.config_filenames() = t_filenames;
+    t_array_app.config_filenames().push_back( t_array_filename );
+    REQUIRE_THROWS_WITH( t_array_app.do_config_stage_2(), "[application] configuration file must consist of an object/node" );
+
+    for( const std::string& t_filename : t_filenames ) std::remove( t_filename.c_str() );
+    std::remove( t_default_filename.c_str() );
+    std::remove( t_array_filename.c_str() );
+}
+#endif
+
 TEST_CASE( "options", "[main_app]" )
 {
     scarab::main_app t_app;
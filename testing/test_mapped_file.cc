@@ -0,0 +1,72 @@
+/*
+ * test_mapped_file.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "error.hh"
+#include "mapped_file.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+using scarab::mapped_file;
+
+TEST_CASE( "mapped_file", "[utility]" )
+{
+    const std::string t_filename( "test_mapped_file.txt" );
+    const std::string t_contents( "line one\nline two\n" );
+    {
+        std::ofstream t_file( t_filename );
+        t_file << t_contents;
+    }
+
+    {
+        mapped_file t_mapped( t_filename );
+        REQUIRE( t_mapped.size() == t_contents.size() );
+        REQUIRE( std::string( t_mapped.data(), t_mapped.size() ) == t_contents );
+        REQUIRE( t_mapped.data()[ t_mapped.size() ] == '\0' );
+
+        // modifications are private to the mapping
+        t_mapped.data()[0] = 'L';
+        REQUIRE( t_mapped.data()[0] == 'L' );
+
+        mapped_file t_moved( std::move(t_mapped) );
+        REQUIRE( t_mapped.data() == nullptr );
+        REQUIRE( t_moved.size() == t_contents.size() );
+    }
+
+    std::ifstream t_reread( t_filename );
+    std::string t_first_line;
+    std::getline( t_reread, t_first_line );
+    REQUIRE( t_first_line == "line one" );
+
+    // a file that fills whole pages still ends in a zero byte
+    {
+        std::ofstream t_file( t_filename );
+        t_file << std::string( 8192, 'x' );
+    }
+    {
+        mapped_file t_mapped( t_filename );
+        REQUIRE( t_mapped.size() == 8192 );
+        REQUIRE( t_mapped.data()[8192] == '\0' );
+    }
+
+    {
+        std::ofstream t_file( t_filename, std::ios::trunc );
+    }
+    {
+        mapped_file t_mapped( t_filename );
+        REQUIRE( t_mapped.size() == 0 );
+        REQUIRE( t_mapped.data()[0] == '\0' );
+    }
+
+    std::remove( t_filename.c_str() );
+
+    REQUIRE_THROWS_AS( mapped_file( "no_such_file_for_test_mapped_file.txt" ), scarab::error );
+}
@@ -0,0 +1,176 @@
+/*
+ * test_msgpack.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+#include "param_msgpack.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using scarab::param_array;
+using scarab::param_input_msgpack;
+using scarab::param_node;
+using scarab::param_output_msgpack;
+using scarab::param_ptr_t;
+using scarab::param_value;
+using scarab::operator""_a;
+
+TEST_CASE( "msgpack", "[param][param_codec]" )
+{
+    param_node t_input;
+    t_input.add( "string", "hello, world" );
+    t_input.add( "long-string", std::string( 300, 's' ) );
+    t_input.add( "empty-string", "" );
+    t_input.add( "true", true );
+    t_input.add( "false", false );
+    t_input.add( "small-uint", 5u );
+    t_input.add( "uint8", std::uint64_t( 200 ) );
+    t_input.add( "uint64", std::numeric_limits< std::uint64_t >::max() );
+    t_input.add( "small-int", std::int64_t( 5 ) );
+    t_input.add( "negative-int", -5 );
+    t_input.add( "int16", std::int64_t( -1000 ) );
+    t_input.add( "int64", std::numeric_limits< std::int64_t >::min() );
+    t_input.add( "double", 0.1 );
+    t_input.add( "null", scarab::param() );
+    t_input.add( "gains", scarab::param_double_array{ 1.5, -2.5 } );
+    t_input.add( "offsets", scarab::param_int64_array{ -1, std::numeric_limits< std::int64_t >::max() } );
+    t_input.add( "counts", scarab::param_uint64_array() );
+
+    param_array t_array;
+    for( unsigned i_element = 0; i_element < 20; ++i_element ) t_array.push_back( i_element );
+    t_array.push_back( param_node( "nested"_a=param_array() ) );
+    t_input.add( "array", t_array );
+
+    param_output_msgpack t_writer;
+    param_input_msgpack t_reader;
+
+    SECTION( "Round trip through a string" )
+    {
+        std::string t_written;
+        REQUIRE( t_writer.write_string( t_input, t_written ) );
+
+        param_ptr_t t_output = t_reader.read_string( t_written );
+        REQUIRE( t_output );
+        const param_node& t_node = t_output->as_node();
+        REQUIRE( t_node.size() == t_input.size() );
+
+        // every value keeps its type, including the uint/int distinction
+        const param_node& t_const_input = t_input;
+        for( param_node::const_iterator t_it = t_const_input.begin(); t_it != t_const_input.end(); ++t_it )
+        {
+            if( ! t_it->is_value() ) continue;
+            INFO( t_it.name() );
+            REQUIRE( t_node[t_it.name()]().type() == t_it->as_value().type() );
+            REQUIRE( t_node[t_it.name()]() == t_it->as_value() );
+        }
+        REQUIRE( t_node["small-uint"]().is_uint() );
+        REQUIRE( t_node["small-int"]().is_int() );
+        REQUIRE( t_node["uint64"]().as_uint() == std::numeric_limits< std::uint64_t >::max() );
+        REQUIRE( t_node["int64"]().as_int() == std::numeric_limits< std::int64_t >::min() );
+        REQUIRE( t_node["double"]().as_double() == 0.1 );
+        REQUIRE( t_node["long-string"]().as_string().size() == 300 );
+        REQUIRE( t_node["null"].is_null() );
+
+        REQUIRE( t_node["gains"].as_typed_array().as< double >()[1] == -2.5 );
+        REQUIRE( t_node["offsets"].as_typed_array().as< std::int64_t >()[1] == std::numeric_limits< std::int64_t >::max() );
+        REQUIRE( t_node["counts"].as_typed_array().holds< std::uint64_t >() );
+        REQUIRE( t_node["counts"].as_typed_array().empty() );
+
+        REQUIRE( t_node["array"].as_array().size() == 21 );
+        REQUIRE( t_node["array"][19]().as_uint() == 19 );
+        REQUIRE( t_node["array"][20]["nested"].is_array() );
+
+        // truncated data
+        REQUIRE_FALSE( t_reader.read_string( t_written.substr( 0, t_written.size() - 1 ) ) );
+    }
+
+    SECTION( "Standard encodings" )
+    {
+        std::string t_written;
+        REQUIRE( t_writer.write_string( param_value( 1u ), t_written ) );
+        REQUIRE( t_written == std::string( "\x01", 1 ) );
+        REQUIRE( t_writer.write_string( param_value( -1 ), t_written ) );
+        REQUIRE( t_written == "\xff" );
+        REQUIRE( t_writer.write_string( param_value( 1 ), t_written ) );
+        REQUIRE( t_written == std::string( "\xd0\x01", 2 ) );
+        REQUIRE( t_writer.write_string( param_value( "abc" ), t_written ) );
+        REQUIRE( t_written == "\xa3" "abc" );
+
+        // float 32 and bin, which this codec doesn't write
+        param_ptr_t t_float = t_reader.read_string( std::string( "\xca\x3f\xc0\x00\x00", 5 ) );
+        REQUIRE( (*t_float)().as_double() == 1.5 );
+        param_ptr_t t_bin = t_reader.read_string( std::string( "\xc4\x02hi", 4 ) );
+        REQUIRE( (*t_bin)().as_string() == "hi" );
+        REQUIRE_FALSE( t_reader.read_string( "\xc1" ) );
+    }
+
+    SECTION( "Corrupt and hostile data" )
+    {
+        // deep nesting is rejected rather than exhausting the stack
+        std::string t_deep( 100000, '\x91' );
+        t_deep += '\x01';
+        REQUIRE_FALSE( t_reader.read_string( t_deep ) );
+        std::istringstream t_deep_stream( t_deep );
+        REQUIRE_FALSE( t_reader.read_stream( t_deep_stream ) );
+        REQUIRE_FALSE( t_deep_stream.good() );
+
+        std::string t_allowed( scarab::param_msgpack_format::s_max_depth, '\x91' );
+        t_allowed += '\x01';
+        REQUIRE( t_reader.read_string( t_allowed ) );
+
+        // sizes of up to 4 GiB that the data don't back up fail without allocating them
+        const std::string t_huge_string( "\xdb\xff\xff\xff\xf0" "abc", 8 );
+        const std::string t_huge_bin( "\xc6\xff\xff\xff\xf0" "abc", 8 );
+        const std::string t_huge_ext( "\xc9\xff\xff\xff\xf8\x01" "abcdefgh", 14 );
+        const std::string t_huge_map( "\x81\xdb\xff\xff\xff\xf0" "k", 7 );
+        for( const std::string& t_data : { t_huge_string, t_huge_bin, t_huge_ext, t_huge_map } )
+        {
+            REQUIRE_FALSE( t_reader.read_string( t_data ) );
+            std::istringstream t_stream( t_data );
+            REQUIRE_FALSE( t_reader.read_stream( t_stream ) );
+        }
+
+        // a typed array that's read from a stream in several chunks
+        scarab::param_double_array t_long( 20000, 0.5 );
+        t_long[19999] = 2.5;
+        std::stringstream t_stream;
+        REQUIRE( t_writer.write_stream( t_long, t_stream ) );
+        param_ptr_t t_read = t_reader.read_stream( t_stream );
+        REQUIRE( t_read );
+        REQUIRE( t_read->as_typed_array().size() == 20000 );
+        REQUIRE( t_read->as_typed_array().as< double >()[19999] == 2.5 );
+    }
+
+    SECTION( "Streams and files" )
+    {
+        // several objects can be written to, and read from, one stream
+        std::stringstream t_stream;
+        REQUIRE( t_writer.write_stream( t_input, t_stream ) );
+        REQUIRE( t_writer.write_stream( param_value( "second" ), t_stream ) );
+
+        param_ptr_t t_first = t_reader.read_stream( t_stream );
+        REQUIRE( t_first );
+        REQUIRE( t_first->as_node()["string"]().as_string() == "hello, world" );
+        param_ptr_t t_second = t_reader.read_stream( t_stream );
+        REQUIRE( (*t_second)().as_string() == "second" );
+        REQUIRE_FALSE( t_reader.read_stream( t_stream ) );
+
+        const std::string t_filename( "test_msgpack.msgpack" );
+        scarab::param_translator t_translator;
+        REQUIRE( t_translator.write_file( t_input, t_filename ) );
+        param_ptr_t t_from_file = t_translator.read_file( t_filename );
+        REQUIRE( t_from_file );
+        REQUIRE( t_from_file->as_node()["array"].as_array().size() == 21 );
+        REQUIRE( t_from_file->as_node()["int64"]().as_int() == std::numeric_limits< std::int64_t >::min() );
+        std::remove( t_filename.c_str() );
+    }
+}
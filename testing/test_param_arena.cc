@@ -0,0 +1,91 @@
+/*
+ * test_param_arena.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+using scarab::param_arena;
+using scarab::param_arena_scope;
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::param_value;
+using scarab::operator""_a;
+
+TEST_CASE( "param_arena", "[param]" )
+{
+    param_arena t_arena( 1024 );
+    REQUIRE( param_arena::current() == nullptr );
+    REQUIRE( t_arena.n_allocations() == 0 );
+    REQUIRE( t_arena.n_blocks() == 0 );
+
+    SECTION( "Heap allocation without a scope" )
+    {
+        param_ptr_t t_node( new param_node() );
+        t_node->as_node().add( "value", 5 );
+        REQUIRE( t_arena.n_allocations() == 0 );
+    }
+
+    SECTION( "Allocation inside a scope" )
+    {
+        param_ptr_t t_node;
+        {
+            param_arena_scope t_scope( t_arena );
+            REQUIRE( param_arena::current() == &t_arena );
+
+            t_node.reset( new param_node() );
+            param_array t_array;
+            for( unsigned i = 0; i < 100; ++i ) t_array.push_back( i );
+            t_node->as_node().add( "array", std::move(t_array) );
+            t_node->as_node().add( "string", "hello" );
+        }
+        REQUIRE( param_arena::current() == nullptr );
+
+        // 1 node, 1 array (the moved-into clone), 100 values, 1 string value
+        REQUIRE( t_arena.n_live() == 103 );
+        REQUIRE( t_arena.n_blocks() > 1 );
+        REQUIRE( t_node->as_node()["array"][99]().as_uint() == 99 );
+        REQUIRE( t_node->as_node()["string"]().as_string() == "hello" );
+
+        // heap-allocated params can be mixed into an arena tree
+        t_node->as_node().add( "heap", 10 );
+        REQUIRE( t_arena.n_live() == 103 );
+
+        t_node.reset();
+        REQUIRE( t_arena.n_live() == 0 );
+    }
+
+    SECTION( "Nested scopes" )
+    {
+        param_arena t_inner( 1024 );
+        {
+            param_arena_scope t_scope( t_arena );
+            {
+                param_arena_scope t_inner_scope( t_inner );
+                REQUIRE( param_arena::current() == &t_inner );
+                param_value t_value( 5 );
+                param_ptr_t t_clone = t_value.clone();
+                REQUIRE( t_inner.n_live() == 1 );
+            }
+            REQUIRE( param_arena::current() == &t_arena );
+        }
+        REQUIRE( param_arena::current() == nullptr );
+        REQUIRE( t_inner.n_live() == 0 );
+    }
+
+    SECTION( "Clone into an arena" )
+    {
+        param_node t_node( "one"_a=1, "two"_a="two" );
+        param_ptr_t t_clone = t_node.clone_into( t_arena );
+        REQUIRE( param_arena::current() == nullptr );
+        REQUIRE( t_arena.n_live() == 3 );
+        REQUIRE( t_clone->as_node()["one"]().as_int() == 1 );
+        REQUIRE( t_clone->as_node()["two"]().as_string() == "two" );
+        REQUIRE( t_node.has_subset( *t_clone ) );
+    }
+}
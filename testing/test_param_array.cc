@@ -119,6 +119,14 @@ TEST_CASE( "param_array", "[param]" )
     REQUIRE( array.size() == 4 );
     REQUIRE( array[0]().as_int() == -2 );
 
+    param_array merged_by_move( args(1, 2) );
+    param_array to_move( args(-3, -4, -5) );
+    merged_by_move.merge( std::move(to_move) );
+    REQUIRE( to_move.empty() );
+    REQUIRE( merged_by_move.size() == 3 );
+    REQUIRE( merged_by_move[0]().as_int() == -3 );
+    REQUIRE( merged_by_move[2]().as_int() == -5 );
+
     // iterator, begin, and end
     param_array::iterator it = array.begin();
     unsigned count = 0;
@@ -165,6 +173,16 @@ TEST_CASE( "param_array", "[param]" )
     REQUIRE( array_2.size() == 0 );
     REQUIRE( array[0]().is_int() );
     REQUIRE( array[0]().as_int() == 100 );
-}
-
 
+    // insert and remove_element move the later elements
+    array.insert( 1, scarab::param_ptr_t( new scarab::param_value( "inserted" ) ) );
+    array.insert( 6, scarab::param_ptr_t( new scarab::param_value( "appended" ) ) );
+    REQUIRE( array.size() == 7 );
+    REQUIRE( array[1]().as_string() == "inserted" );
+    REQUIRE( array[6]().as_string() == "appended" );
+    REQUIRE_THROWS_AS( array.insert( 8, scarab::param_ptr_t( new scarab::param() ) ), scarab::error );
+    array.remove_element( 0 );
+    REQUIRE( array.size() == 6 );
+    REQUIRE( array[0]().as_string() == "inserted" );
+    REQUIRE_THROWS_AS( array.remove_element( 6 ), scarab::error );
+}
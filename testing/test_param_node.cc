@@ -10,6 +10,9 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <string_view>
+#include <utility>
+
 using scarab::param_array;
 using scarab::param_node;
 using scarab::param_value;
@@ -85,6 +88,21 @@ TEST_CASE( "param_node", "[param]" )
     for( ; it != node.end(); ++it, ++count );
     REQUIRE( count == node.size() );
 
+    // iteration is in name order, regardless of insertion order
+    std::string previous_name;
+    for( param_node::const_iterator c_it = const_node.begin(); c_it != const_node.end(); ++c_it )
+    {
+        REQUIRE( previous_name < c_it.name() );
+        previous_name = c_it.name();
+    }
+    REQUIRE( const_node.begin().name() == "five" );
+
+    // lookup with a string_view, including one that isn't null-terminated
+    std::string_view five_view( "fiveteen", 4 );
+    REQUIRE( node.has( five_view ) );
+    REQUIRE( node[five_view]().as_int() == 5 );
+    REQUIRE( node.get_value( std::string_view("fiv"), 99999 ) == 99999 );
+
     // remove, erase, and clear
     param_ptr_t removed = node.remove( "ten" );
     REQUIRE( removed->is_value() );
@@ -96,5 +114,22 @@ TEST_CASE( "param_node", "[param]" )
     node.clear();
     REQUIRE( node.size() == 0 );
 
+    SECTION( "Merge by moving" )
+    {
+        param_node target( "five"_a=5, "subnode"_a=param_node( "value"_a=0 ) );
+        param_node to_move( "minus-three"_a=-3, "subnode"_a=param_node( "value"_a=1 ) );
+        param_node subnode_moved( "value"_a=2, "other"_a=3 );
+        const scarab::param* other_ptr = &std::as_const(subnode_moved).at( "other" );
+        to_move.replace( "subnode", std::move(subnode_moved) );
+
+        target.merge( std::move(to_move) );
+        REQUIRE( to_move.empty() );
+        REQUIRE( target.size() == 3 );
+        REQUIRE( target["five"]().as_int() == 5 );
+        REQUIRE( target["minus-three"]().as_int() == -3 );
+        REQUIRE( target["subnode"]["value"]().as_int() == 2 );
+        // the moved items are not copied
+        REQUIRE( &std::as_const(target)["subnode"].as_node().at( "other" ) == other_ptr );
+    }
 }
 
@@ -0,0 +1,108 @@
+/*
+ * test_param_path.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <utility>
+
+using scarab::param;
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_path;
+using scarab::param_path_handle;
+using scarab::operator""_a;
+
+TEST_CASE( "param_path", "[param]" )
+{
+    auto t_make_array = [](){ param_array t_array; t_array.push_back( 0, param_node( "c"_a=5 ) ); return t_array; };
+    param_node t_root( "a"_a=param_node( "b"_a=t_make_array(), "3"_a="three" ), "value"_a=1.5 );
+
+    SECTION( "Compiling addresses" )
+    {
+        param_path t_path( "a.b.1.c" );
+        REQUIRE( t_path.address() == "a.b.1.c" );
+        REQUIRE( t_path.size() == 4 );
+        REQUIRE( param_path( "value" ).size() == 1 );
+
+        REQUIRE_THROWS_AS( param_path( "" ), scarab::error );
+        REQUIRE_THROWS_AS( param_path( "a..b" ), scarab::error );
+        REQUIRE_THROWS_AS( param_path( "a.b." ), scarab::error );
+        // an index that doesn't fit in an unsigned is an error rather than wrapping around
+        REQUIRE_THROWS_AS( param_path( "a.4294967296" ), scarab::error );
+        REQUIRE_THROWS_AS( param_path( "a.99999999999999999999" ), scarab::error );
+        REQUIRE( param_path( "a.4294967295" ).size() == 2 );
+    }
+
+    SECTION( "Finding and resolving" )
+    {
+        const param_node& t_const_root = t_root;
+        REQUIRE( param_path( "a.b.1.c" ).resolve( t_const_root )().as_int() == 5 );
+        REQUIRE( param_path( "value" ).resolve( t_const_root )().as_double() == 1.5 );
+        REQUIRE( param_path( "a.b" ).resolve( t_const_root ).is_array() );
+        // an index at a node is used as a name
+        REQUIRE( param_path( "a.3" ).resolve( t_const_root )().as_string() == "three" );
+
+        REQUIRE( param_path( "a.b.2.c" ).find( t_const_root ) == nullptr );
+        REQUIRE( param_path( "a.b.c" ).find( t_const_root ) == nullptr );
+        REQUIRE( param_path( "value.x" ).find( t_const_root ) == nullptr );
+        REQUIRE( param_path( "missing" ).find( t_const_root ) == nullptr );
+        REQUIRE_THROWS_AS( param_path( "a.b.2.c" ).resolve( t_const_root ), scarab::error );
+
+        param_path( "a.b.1.c" ).resolve( t_root )().set( 6 );
+        REQUIRE( t_root["a"]["b"][1]["c"]().as_int() == 6 );
+    }
+
+    SECTION( "Non-const lookups detach shared trees" )
+    {
+        param_node t_copy( t_root );
+        param_path( "a.b.1.c" ).resolve( t_copy )().set( 6 );
+        REQUIRE( t_copy["a"]["b"][1]["c"]().as_int() == 6 );
+        REQUIRE( t_root["a"]["b"][1]["c"]().as_int() == 5 );
+    }
+
+    SECTION( "Cached handles" )
+    {
+        param_path t_path( "a.b.1.c" );
+        param_path_handle t_handle = t_path.bind( t_root );
+        REQUIRE( t_handle.is_current() );
+        REQUIRE( (*t_handle)().as_int() == 5 );
+        const param* t_cached = t_handle.get();
+
+        // modifying a value in place doesn't invalidate the handle
+        t_root["a"]["b"][1]["c"]().set( 7 );
+        REQUIRE( t_handle.is_current() );
+        REQUIRE( t_handle.get() == t_cached );
+        REQUIRE( t_handle->as_value().as_int() == 7 );
+
+        // adding an item does, and the handle is revalidated
+        t_root["a"]["b"][1].as_node().add( "d", 10 );
+        REQUIRE_FALSE( t_handle.is_current() );
+        REQUIRE( (*t_handle)().as_int() == 7 );
+        REQUIRE( t_handle.is_current() );
+
+        // replacing a branch higher up
+        t_root["a"].as_node().replace( "b", param_array() );
+        REQUIRE_FALSE( t_handle.is_current() );
+        REQUIRE( t_handle.get() == nullptr );
+        REQUIRE_THROWS_AS( *t_handle, scarab::error );
+        REQUIRE( t_handle.is_current() );
+
+        // and the item coming back
+        t_root.merge( param_node( "a"_a=param_node( "b"_a=t_make_array() ) ) );
+        REQUIRE( (*t_handle)().as_int() == 5 );
+
+        // copying the tree doesn't invalidate the handle, but modifying the original after a copy does
+        param_node t_copy( t_root );
+        REQUIRE( t_handle.is_current() );
+        t_root.add( "new", 1 );
+        REQUIRE_FALSE( t_handle.is_current() );
+        REQUIRE( (*t_handle)().as_int() == 5 );
+        REQUIRE( &t_handle.root() == &t_root );
+    }
+}
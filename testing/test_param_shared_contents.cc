@@ -0,0 +1,195 @@
+/*
+ * test_param_shared_contents.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using scarab::param_arena;
+using scarab::param_arena_scope;
+using scarab::param;
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::param_value;
+using scarab::operator""_a;
+
+TEST_CASE( "param_shared_contents", "[param]" )
+{
+    param_array t_array;
+    t_array.push_back( 1, 2, 3 );
+    param_node t_sub( "x"_a=10, "y"_a=20 );
+    const param_node t_orig( "sub"_a=t_sub, "array"_a=t_array, "value"_a="hello" );
+    REQUIRE_FALSE( t_orig.is_shared() );
+
+    SECTION( "Copies share contents" )
+    {
+        const param_node t_copy( t_orig );
+        REQUIRE( t_orig.is_shared() );
+        REQUIRE( t_copy.is_shared() );
+        REQUIRE( &t_copy.at("sub") == &t_orig.at("sub") );
+        REQUIRE( t_copy.has_subset( t_orig ) );
+        REQUIRE( t_orig.has_subset( t_copy ) );
+
+        param_ptr_t t_clone = t_orig.clone();
+        const param_node& t_clone_node = t_clone->as_node();
+        REQUIRE( &t_clone_node.at("array") == &t_orig.at("array") );
+    }
+
+    SECTION( "Modifying a copy does not modify the original" )
+    {
+        param_node t_copy( t_orig );
+        t_copy["sub"].as_node().replace( "x", 11 );
+        t_copy["array"].as_array().push_back( 4 );
+        t_copy.add( "new", true );
+
+        REQUIRE_FALSE( t_orig.is_shared() );
+        REQUIRE( t_orig["sub"]["x"]().as_int() == 10 );
+        REQUIRE( t_orig["array"].as_array().size() == 3 );
+        REQUIRE_FALSE( t_orig.has( "new" ) );
+
+        REQUIRE( t_copy["sub"]["x"]().as_int() == 11 );
+        REQUIRE( t_copy["array"].as_array().size() == 4 );
+        REQUIRE( t_copy["new"]().as_bool() );
+    }
+
+    SECTION( "Merging only copies what changes" )
+    {
+        param_node t_copy( t_orig );
+        param_node t_update( "sub"_a=param_node( "y"_a=21 ) );
+        t_copy.merge( t_update );
+
+        REQUIRE( t_orig["sub"]["y"]().as_int() == 20 );
+        REQUIRE( t_copy["sub"]["y"]().as_int() == 21 );
+        // the array wasn't touched, so its contents are still shared
+        REQUIRE( std::as_const(t_copy).at("array").as_array().is_shared() );
+    }
+
+    SECTION( "Previously-obtained references are not shared" )
+    {
+        param_node t_node( t_orig );
+        param_node t_other( t_orig );
+        param& t_x = t_node["sub"]["x"];
+        param_node t_copy( t_node );
+        t_x.as_value() = 100;
+        REQUIRE( t_node["sub"]["x"]().as_int() == 100 );
+        REQUIRE( t_copy["sub"]["x"]().as_int() == 10 );
+        REQUIRE( t_orig["sub"]["x"]().as_int() == 10 );
+
+        param_node::iterator t_it = t_node.begin();
+        REQUIRE( t_it.name() == "array" );
+        param_node t_copy_2( t_node );
+        t_it->as_array().push_back( 4 );
+        REQUIRE( t_node["array"].as_array().size() == 4 );
+        REQUIRE( t_copy_2["array"].as_array().size() == 3 );
+    }
+
+    SECTION( "Moves and clearing" )
+    {
+        param_node t_copy( t_orig );
+        param_node t_moved( std::move(t_copy) );
+        REQUIRE( t_copy.empty() );
+        REQUIRE( t_moved.size() == 3 );
+        REQUIRE( t_moved.is_shared() );
+
+        t_moved.clear();
+        REQUIRE( t_moved.empty() );
+        REQUIRE_FALSE( t_orig.is_shared() );
+        REQUIRE( t_orig.size() == 3 );
+    }
+
+    SECTION( "Contents are not shared across arenas" )
+    {
+        param_arena t_arena;
+        param_ptr_t t_clone = t_orig.clone_into( t_arena );
+        REQUIRE_FALSE( t_orig.is_shared() );
+        REQUIRE( &std::as_const(*t_clone).as_node().at("sub") != &t_orig.at("sub") );
+
+        param_ptr_t t_heap_clone = t_clone->clone();
+        REQUIRE_FALSE( t_clone->as_node().is_shared() );
+        REQUIRE( t_heap_clone->as_node().has_subset( t_orig ) );
+    }
+
+    SECTION( "Copies can be modified on other threads" )
+    {
+        std::vector< param_node > t_copies( 4, t_orig );
+        std::vector< std::thread > t_threads;
+        for( unsigned i_thread = 0; i_thread < t_copies.size(); ++i_thread )
+        {
+            t_threads.emplace_back( [&t_copies, i_thread](){
+                for( unsigned i_mod = 0; i_mod < 100; ++i_mod )
+                {
+                    param_node t_local( t_copies[i_thread] );
+                    t_local["sub"].as_node().replace( "x", i_mod );
+                    t_copies[i_thread] = t_local;
+                }
+            } );
+        }
+        for( std::thread& t_thread : t_threads ) t_thread.join();
+
+        REQUIRE( t_orig["sub"]["x"]().as_int() == 10 );
+        for( const param_node& t_copy : t_copies )
+        {
+            REQUIRE( t_copy["sub"]["x"]().as_int() == 99 );
+        }
+    }
+
+    SECTION( "Deferred contents are built once, on first access" )
+    {
+        std::atomic< unsigned > t_n_builds( 0 );
+        param_node t_deferred = param_node::deferred( [&t_n_builds, &t_orig]()
+        {
+            ++t_n_builds;
+            param_node::contents t_contents;
+            t_contents["sub"] = t_orig.at( "sub" ).clone();
+            t_contents["value"] = param_ptr_t( new param_value( 5 ) );
+            return t_contents;
+        } );
+        REQUIRE( t_deferred.is_deferred() );
+
+        // copies share the deferred contents without building them
+        param_node t_copy( t_deferred );
+        const param_node t_const_copy( t_deferred );
+        REQUIRE( t_copy.shares_contents_with( t_deferred ) );
+        REQUIRE( t_deferred.is_shared() );
+        REQUIRE( t_n_builds == 0 );
+
+        // const access from several threads builds the contents once
+        std::vector< std::thread > t_threads;
+        std::atomic< unsigned > t_n_found( 0 );
+        for( unsigned i_thread = 0; i_thread < 4; ++i_thread )
+        {
+            t_threads.emplace_back( [&t_const_copy, &t_n_found](){ if( t_const_copy["value"]().as_int() == 5 ) ++t_n_found; } );
+        }
+        for( std::thread& t_thread : t_threads ) t_thread.join();
+        REQUIRE( t_n_found == 4 );
+        REQUIRE( t_n_builds == 1 );
+        REQUIRE_FALSE( t_deferred.is_deferred() );
+        REQUIRE( &std::as_const(t_deferred).at( "sub" ) == &t_const_copy.at( "sub" ) );
+
+        // modifying a copy leaves the others with the built contents
+        t_copy.replace( "value", 6 );
+        REQUIRE( t_copy["value"]().as_int() == 6 );
+        REQUIRE( t_deferred["value"]().as_int() == 5 );
+        REQUIRE( t_n_builds == 1 );
+
+        // deferred contents are built on the heap, even if an arena is active when they're accessed
+        param_array t_deferred_array = param_array::deferred( [](){ param_array::contents t_contents; t_contents.emplace_back( new param_value( 1 ) ); return t_contents; } );
+        {
+            param_arena t_arena;
+            param_arena_scope t_scope( t_arena );
+            REQUIRE( std::as_const(t_deferred_array)[0]().as_int() == 1 );
+            REQUIRE( t_arena.n_allocations() == 0 );
+        }
+        REQUIRE( t_deferred_array[0]().as_int() == 1 );
+    }
+}
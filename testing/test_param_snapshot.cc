@@ -0,0 +1,133 @@
+/*
+ * test_param_snapshot.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using scarab::frozen_param;
+using scarab::param_array;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::param_snapshot;
+using scarab::operator""_a;
+
+TEST_CASE( "param_snapshot", "[param]" )
+{
+    param_array t_array;
+    t_array.push_back( 1, "two", param_node( "three"_a=3.0 ) );
+    param_node t_node( "int"_a=5, "string"_a="hello", "array"_a=t_array, "sub"_a=param_node( "flag"_a=true ), "empty"_a=param_node() );
+    t_node.add( "null", scarab::param() );
+
+    param_snapshot t_frozen = t_node.freeze();
+
+    SECTION( "Read access" )
+    {
+        REQUIRE( t_frozen.is_node() );
+        REQUIRE( t_frozen.size() == 6 );
+        REQUIRE( t_frozen.n_params() == 12 );
+
+        REQUIRE( t_frozen["int"]().as_int() == 5 );
+        REQUIRE( t_frozen["string"]().as_string() == "hello" );
+        REQUIRE( t_frozen["sub"]["flag"]().as_bool() );
+        REQUIRE( t_frozen["array"].is_array() );
+        REQUIRE( t_frozen["array"].size() == 3 );
+        REQUIRE( t_frozen["array"][1]().as_string() == "two" );
+        REQUIRE( t_frozen["array"][2]["three"]().as_double() == 3.0 );
+        REQUIRE( t_frozen["empty"].is_node() );
+        REQUIRE( t_frozen["empty"].empty() );
+        REQUIRE( t_frozen["null"].is_null() );
+        REQUIRE( t_frozen["sub"].name() == "sub" );
+
+        REQUIRE( t_frozen.has( "int" ) );
+        REQUIRE_FALSE( t_frozen.has( "missing" ) );
+        REQUIRE_FALSE( t_frozen["empty"].has( "missing" ) );
+        REQUIRE_THROWS_AS( t_frozen["missing"], scarab::error );
+        REQUIRE_THROWS_AS( t_frozen["array"][3], scarab::error );
+        REQUIRE_THROWS_AS( t_frozen["int"]["x"], scarab::error );
+        REQUIRE_THROWS_AS( t_frozen["sub"](), scarab::error );
+
+        REQUIRE( t_frozen.get_value( "int", 0 ) == 5 );
+        REQUIRE( t_frozen.get_value( "missing", 10 ) == 10 );
+        REQUIRE( t_frozen.get_value( "string", "default" ) == "hello" );
+        REQUIRE( t_frozen.get_value( "sub", "default" ) == "default" );
+        REQUIRE( t_frozen["array"].get_value( 0u, 0 ) == 1 );
+    }
+
+    SECTION( "Iteration is in name order" )
+    {
+        std::vector< std::string > t_names;
+        for( frozen_param::const_iterator t_it = t_frozen.begin(); t_it != t_frozen.end(); ++t_it )
+        {
+            t_names.push_back( std::string( t_it.name() ) );
+        }
+        REQUIRE( t_names == std::vector< std::string >{ "array", "empty", "int", "null", "string", "sub" } );
+
+        unsigned t_count = 0;
+        for( frozen_param t_item : t_frozen["array"] )
+        {
+            REQUIRE( t_item.name().empty() );
+            ++t_count;
+        }
+        REQUIRE( t_count == 3 );
+        REQUIRE( t_frozen["array"].end() - t_frozen["array"].begin() == 3 );
+    }
+
+    SECTION( "Large nodes" )
+    {
+        param_node t_large;
+        for( unsigned i_item = 0; i_item < 5000; ++i_item )
+        {
+            t_large.add( "item-" + std::to_string(i_item), i_item );
+        }
+        param_snapshot t_large_frozen = t_large.freeze();
+        for( unsigned i_item = 0; i_item < 5000; ++i_item )
+        {
+            REQUIRE( t_large_frozen["item-" + std::to_string(i_item)]().as_uint() == i_item );
+        }
+        REQUIRE_FALSE( t_large_frozen.has( "item-5000" ) );
+        REQUIRE_FALSE( t_large_frozen.has( "" ) );
+    }
+
+    SECTION( "The snapshot is independent of the original" )
+    {
+        t_node.replace( "int", 6 );
+        t_node.erase( "sub" );
+        REQUIRE( t_frozen["int"]().as_int() == 5 );
+        REQUIRE( t_frozen.has( "sub" ) );
+    }
+
+    SECTION( "Copying, thawing, and sharing" )
+    {
+        param_snapshot t_copy( t_frozen );
+        REQUIRE( t_copy["int"]().as_int() == 5 );
+
+        param_snapshot t_moved( std::move(t_copy) );
+        REQUIRE( t_copy.is_null() );
+        REQUIRE( t_moved["int"]().as_int() == 5 );
+
+        param_ptr_t t_thawed = t_frozen.thaw();
+        REQUIRE( t_thawed->as_node().has_subset( t_node ) );
+        REQUIRE( t_node.has_subset( *t_thawed ) );
+
+        std::vector< std::thread > t_threads;
+        std::vector< int > t_results( 4, 0 );
+        for( unsigned i_thread = 0; i_thread < t_results.size(); ++i_thread )
+        {
+            t_threads.emplace_back( [t_frozen, &t_results, i_thread](){ t_results[i_thread] = t_frozen["int"]().as_int(); } );
+        }
+        for( std::thread& t_thread : t_threads ) t_thread.join();
+        REQUIRE( t_results == std::vector< int >( 4, 5 ) );
+
+        REQUIRE( param_snapshot().is_null() );
+        REQUIRE( param_snapshot().n_params() == 0 );
+    }
+}
@@ -12,6 +12,14 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 LOGGER( testlog, "test_param_translator" );
 
 using namespace scarab;
@@ -88,5 +96,267 @@ TEST_CASE( "param_translator", "[param]" )
 
 }
 
+TEST_CASE( "param_translator read_files", "[param]" )
+{
+#ifdef USE_CODEC_YAML
+    // fragments that override each other's values, read on more threads than there are files and on one thread
+    std::vector< std::string > t_filenames;
+    for( unsigned i_file = 0; i_file < 12; ++i_file )
+    {
+        t_filenames.push_back( "test_param_translator_" + std::to_string( i_file ) + ".yaml" );
+        param_node t_fragment;
+        t_fragment.add( "last", i_file );
+        t_fragment.add( "file-" + std::to_string( i_file ), i_file );
+        t_fragment.add( "nested", param_node() );
+        t_fragment["nested"].as_node().add( "last", i_file );
+        t_fragment["nested"].as_node().add( "file-" + std::to_string( i_file ), i_file );
+        param_output_codec* t_writer = param_translator::output_codec( "yaml" );
+        REQUIRE( t_writer->write_file( t_fragment, t_filenames.back() ) );
+    }
+
+    param_translator t_translator;
+    for( unsigned t_n_threads : { 1U, 4U, 32U } )
+    {
+        param_ptr_t t_merged = t_translator.read_files( t_filenames, param_node(), t_n_threads );
+        REQUIRE( t_merged );
+        const param_node& t_node = t_merged->as_node();
+        REQUIRE( t_node["last"]().as_uint() == 11 );
+        REQUIRE( t_node["nested"]["last"]().as_uint() == 11 );
+        for( unsigned i_file = 0; i_file < t_filenames.size(); ++i_file )
+        {
+            REQUIRE( t_node["file-" + std::to_string( i_file )]().as_uint() == i_file );
+            REQUIRE( t_node["nested"]["file-" + std::to_string( i_file )]().as_uint() == i_file );
+        }
+    }
+
+    // no files gives an empty node
+    param_ptr_t t_empty = t_translator.read_files( std::vector< std::string >() );
+    REQUIRE( t_empty );
+    REQUIRE( t_empty->as_node().empty() );
+
+    // a missing file, and a file that isn't a node
+    REQUIRE_FALSE( t_translator.read_files( { t_filenames[0], "test_param_translator_nonexistent.yaml" } ) );
+    REQUIRE( param_translator::output_codec( "yaml" )->write_file( param_value( 5 ), "test_param_translator_value.yaml" ) );
+    REQUIRE_FALSE( t_translator.read_files( { t_filenames[0], "test_param_translator_value.yaml" } ) );
+
+    std::remove( "test_param_translator_value.yaml" );
+    for( const std::string& t_filename : t_filenames ) std::remove( t_filename.c_str() );
+#endif
+}
+
+TEST_CASE( "param_translator codecs", "[param]" )
+{
+    // no such encoding
+    REQUIRE_FALSE( param_translator::input_codec( "no-such-encoding" ) );
+    REQUIRE_FALSE( param_translator::output_codec( "no-such-encoding" ) );
+
+#ifdef USE_CODEC_YAML
+    // a thread reuses its codec for an encoding, and each thread has its own
+    param_input_codec* t_input = param_translator::input_codec( "yaml" );
+    param_output_codec* t_output = param_translator::output_codec( "yaml" );
+    REQUIRE( t_input );
+    REQUIRE( t_output );
+    REQUIRE( param_translator::input_codec( "yaml" ) == t_input );
+    REQUIRE( param_translator::output_codec( "yaml" ) == t_output );
 
+    param_input_codec* t_other_thread_input = nullptr;
+    std::thread t_thread( [&t_other_thread_input](){ t_other_thread_input = param_translator::input_codec( "yaml" ); } );
+    t_thread.join();
+    REQUIRE( t_other_thread_input );
+    REQUIRE( t_other_thread_input != t_input );
+
+    param_translator t_translator;
+    param_ptr_t t_read = t_translator.read_string( "value: 5", "yaml" );
+    REQUIRE( t_read );
+    REQUIRE( (*t_read)["value"]().as_uint() == 5 );
+#endif
+}
+
+TEST_CASE( "param_translator compressed files", "[param]" )
+{
+    param_node t_config;
+    t_config.add( "name", "run 42" );
+    t_config.add( "values", param_array( args( 1, 2.5, "three" ) ) );
+    t_config.add( "nested", param_node( "flag"_a=true, "count"_a=12 ) );
+
+    std::vector< std::string > t_encodings;
+#ifdef USE_CODEC_YAML
+    t_encodings.push_back( "yaml" );
+#endif
+#ifdef USE_CODEC_JSON
+    t_encodings.push_back( "json" );
+#endif
+#ifdef USE_CODEC_MSGPACK
+    t_encodings.push_back( "msgpack" );
+#endif
+#ifdef USE_CODEC_SPB
+    // read and written through a string rather than incrementally
+    t_encodings.push_back( "spb" );
+#endif
+
+    // reads the first bytes of a file
+    auto t_magic = []( const std::string& a_filename )
+    {
+        std::ifstream t_file( a_filename, std::ios::binary );
+        std::string t_bytes( 4, '\0' );
+        t_file.read( &t_bytes[0], 4 );
+        return t_bytes;
+    };
+
+    param_translator t_translator;
+    for( const std::string& t_encoding : t_encodings )
+    {
+        for( const std::string& t_compression : { std::string( "gz" ), std::string( "zst" ) } )
+        {
+            const std::string t_filename( "test_param_translator." + t_encoding + "." + t_compression );
+#ifdef USE_COMPRESSED_IO
+            INFO( t_filename );
+            REQUIRE( t_translator.write_file( t_config, t_filename ) );
+            if( t_compression == "gz" ) REQUIRE( t_magic( t_filename ).substr( 0, 2 ) == "\x1f\x8b" );
+            else REQUIRE( t_magic( t_filename ) == "\x28\xb5\x2f\xfd" );
 
+            param_ptr_t t_read = t_translator.read_file( t_filename );
+            REQUIRE( t_read );
+            REQUIRE( t_read->to_string() == t_config.to_string() );
+#else
+            REQUIRE_FALSE( t_translator.write_file( t_config, t_filename ) );
+            REQUIRE_FALSE( t_translator.read_file( t_filename ) );
+#endif
+            std::remove( t_filename.c_str() );
+        }
+    }
+
+#if defined( USE_COMPRESSED_IO ) && defined( USE_CODEC_YAML )
+    // the options override the extensions
+    const std::string t_filename( "test_param_translator_compressed.cfg" );
+    const param_node t_options( "encoding"_a="yaml", "compression"_a="gzip" );
+    REQUIRE( t_translator.write_file( t_config, t_filename, t_options ) );
+    REQUIRE( t_magic( t_filename ).substr( 0, 2 ) == "\x1f\x8b" );
+    REQUIRE( t_translator.read_file( t_filename, t_options )->to_string() == t_config.to_string() );
+    REQUIRE( t_translator.read_files( { t_filename }, t_options )->to_string() == t_config.to_string() );
+
+    // data that aren't compressed, or that are cut short, can't be read
+    REQUIRE_FALSE( t_translator.read_file( t_filename, param_node( "encoding"_a="yaml", "compression"_a="zstd" ) ) );
+    std::string t_compressed;
+    {
+        std::ifstream t_file( t_filename, std::ios::binary );
+        t_compressed.assign( std::istreambuf_iterator< char >( t_file ), std::istreambuf_iterator< char >() );
+    }
+    {
+        std::ofstream t_file( t_filename, std::ios::binary | std::ios::trunc );
+        t_file.write( t_compressed.data(), t_compressed.size() / 2 );
+    }
+    REQUIRE_FALSE( t_translator.read_file( t_filename, t_options ) );
+    std::remove( t_filename.c_str() );
+
+    REQUIRE_FALSE( t_translator.read_file( "test_param_translator_nonexistent.yaml.gz" ) );
+#endif
+
+#if defined( USE_COMPRESSED_IO ) && defined( USE_CODEC_JSON )
+    // JSON is parsed from the decompressing stream as it's read, so a stream that's cut short is a parse error
+    for( const std::string& t_compression : { std::string( "gz" ), std::string( "zst" ) } )
+    {
+        const std::string t_json_filename( "test_param_translator_truncated.json." + t_compression );
+        INFO( t_json_filename );
+        REQUIRE( t_translator.write_file( t_config, t_json_filename ) );
+        std::string t_json_compressed;
+        {
+            std::ifstream t_file( t_json_filename, std::ios::binary );
+            t_json_compressed.assign( std::istreambuf_iterator< char >( t_file ), std::istreambuf_iterator< char >() );
+        }
+        {
+            std::ofstream t_file( t_json_filename, std::ios::binary | std::ios::trunc );
+            t_file.write( t_json_compressed.data(), t_json_compressed.size() / 2 );
+        }
+        REQUIRE_FALSE( t_translator.read_file( t_json_filename ) );
+        std::remove( t_json_filename.c_str() );
+    }
+#endif
+
+#ifdef USE_CODEC_YAML
+    // with no compression, a compression extension still isn't taken as the encoding
+    const std::string t_plain_filename( "test_param_translator_plain.yaml.gz" );
+    const param_node t_no_compression( "compression"_a="none" );
+    REQUIRE( t_translator.write_file( t_config, t_plain_filename, t_no_compression ) );
+    REQUIRE( t_magic( t_plain_filename ).substr( 0, 2 ) != "\x1f\x8b" );
+    param_ptr_t t_plain = t_translator.read_file( t_plain_filename, t_no_compression );
+    REQUIRE( t_plain );
+    REQUIRE( t_plain->to_string() == t_config.to_string() );
+    REQUIRE_FALSE( t_translator.read_file( t_plain_filename ) );
+
+    // unknown compressions are errors, rather than being treated as uncompressed
+    REQUIRE_FALSE( t_translator.read_file( t_plain_filename, param_node( "compression"_a="bz2" ) ) );
+    REQUIRE_FALSE( t_translator.write_file( t_config, t_plain_filename, param_node( "compression"_a="gzipp" ) ) );
+    std::remove( t_plain_filename.c_str() );
+#endif
+}
+
+TEST_CASE( "param_translator typed arrays", "[param]" )
+{
+    // each codec, and each way of reading, chooses the same element type (see typed_array_classifier)
+    std::vector< std::pair< std::string, param_node > > t_readers;
+#ifdef USE_CODEC_JSON
+    t_readers.emplace_back( "json", param_node() );
+    t_readers.emplace_back( "json", param_node( "dom"_a=true ) );
+    t_readers.emplace_back( "json", param_node( "lazy"_a=true ) );
+#endif
+#ifdef USE_CODEC_YAML
+    t_readers.emplace_back( "yaml", param_node() );
+    t_readers.emplace_back( "yaml", param_node( "node"_a=true ) );
+#endif
+
+    // the arrays, and the element types they should have from JSON and from YAML; "array" if they can't be typed arrays.
+    // They only differ where the numbers themselves are read differently: YAML reads integers beyond 32 bits as doubles.
+    struct typed_array_case
+    {
+        std::string f_text;
+        std::string f_json;
+        std::string f_yaml;
+    };
+    const std::vector< typed_array_case > t_arrays{
+        { "[1, 2, 3]", "uint64", "uint64" },
+        { "[-1, 2, 3]", "int64", "int64" },
+        { "[1, 2.5]", "double", "double" },
+        { "[-1, 2.5]", "double", "double" },
+        { "[-1, 4294967295]", "int64", "int64" },
+        { "[1, 18446744073709551615]", "uint64", "double" },
+        { "[-1, 9223372036854775807]", "int64", "double" },
+        { "[-1, 9223372036854775808]", "array", "double" },
+        { "[1, \"two\"]", "array", "array" },
+        { "[]", "array", "array" }
+    };
+
+    param_translator t_translator;
+    for( const auto& t_reader : t_readers )
+    {
+        param_node t_options( t_reader.second );
+        t_options.add( "typed-arrays", true );
+        for( const typed_array_case& t_array : t_arrays )
+        {
+            INFO( t_reader.first << " " << t_reader.second << " " << t_array.f_text );
+            const std::string t_text( "{\"values\": " + t_array.f_text + "}" );
+            const std::string& t_expected = t_reader.first == "json" ? t_array.f_json : t_array.f_yaml;
+            param_ptr_t t_typed = t_translator.read_string( t_text, t_reader.first, t_options );
+            REQUIRE( t_typed );
+            const param& t_values = t_typed->as_node()["values"];
+            if( t_expected == "array" )
+            {
+                REQUIRE( t_values.is_array() );
+            }
+            else
+            {
+                REQUIRE( t_values.is_typed_array() );
+                REQUIRE( t_values.as_typed_array().element_type_name() == t_expected );
+            }
+
+            // the same numbers as converting the param_array that's read without the option.
+            // JSON stores non-negative integers that fit in an int64 as signed values, so to_typed_array() can't always tell
+            // that they're unsigned, and only YAML is sure to give a typed array in the same cases.
+            param_ptr_t t_boxed = t_translator.read_string( t_text, t_reader.first, t_reader.second );
+            REQUIRE( t_boxed );
+            param_ptr_t t_converted = to_typed_array( t_boxed->as_node()["values"].as_array() );
+            if( t_reader.first == "yaml" ) REQUIRE( bool( t_converted ) == t_values.is_typed_array() );
+            if( t_converted ) REQUIRE( t_converted->to_string() == t_values.to_string() );
+        }
+    }
+}
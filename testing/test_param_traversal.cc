@@ -0,0 +1,326 @@
+/*
+ * test_param_traversal.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "test_param_modifiers_visitors.hh"
+
+#include "param_env_modifier.hh"
+#include "param_traversal.hh"
+
+#include "param.hh"
+#include "param_helpers_impl.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace scarab;
+using namespace scarab_testing;
+
+namespace
+{
+    // Records the values it sees, in order; relies on the default operator()s for containers
+    class recording_visitor : public param_visitor
+    {
+        public:
+            using param_visitor::operator();
+            virtual void operator()( const param_value& a_value ) const override
+            {
+                f_values.push_back( a_value.as_int() );
+                return;
+            }
+            mutable std::vector< int > f_values;
+    };
+
+    // Thread-safe counts of containers and values
+    class counting_visitor : public param_visitor
+    {
+        public:
+            virtual void operator()( const param_array& an_array ) const override
+            {
+                ++f_containers;
+                param_visitor::operator()( an_array );
+                return;
+            }
+            virtual void operator()( const param_node& a_node ) const override
+            {
+                ++f_containers;
+                param_visitor::operator()( a_node );
+                return;
+            }
+            virtual void operator()( const param_value& ) const override
+            {
+                ++f_values;
+                return;
+            }
+            mutable std::atomic< unsigned > f_containers{ 0 };
+            mutable std::atomic< unsigned > f_values{ 0 };
+    };
+
+    // Doesn't descend into nodes that have a "skip" item
+    class skipping_visitor : public counting_visitor
+    {
+        public:
+            using counting_visitor::operator();
+            virtual void operator()( const param_node& a_node ) const override
+            {
+                if( a_node.has( "skip" ) ) return;
+                counting_visitor::operator()( a_node );
+                return;
+            }
+    };
+
+    // Writes the structure with brackets, and tracks the depth, using leave() to close each container
+    class bracketing_visitor : public param_visitor
+    {
+        public:
+            virtual void operator()( const param_array& an_array ) const override
+            {
+                open( "[" );
+                param_visitor::operator()( an_array );
+                return;
+            }
+            virtual void operator()( const param_node& a_node ) const override
+            {
+                open( "{" );
+                param_visitor::operator()( a_node );
+                return;
+            }
+            virtual void operator()( const param_value& a_value ) const override
+            {
+                f_text += std::to_string( a_value.as_int() );
+                return;
+            }
+            virtual void leave( const param_array& ) const override
+            {
+                close( "]" );
+                return;
+            }
+            virtual void leave( const param_node& ) const override
+            {
+                close( "}" );
+                return;
+            }
+            mutable std::string f_text;
+            mutable int f_depth = 0;
+            mutable int f_max_depth = 0;
+
+        private:
+            void open( const char* a_bracket ) const
+            {
+                f_text += a_bracket;
+                f_max_depth = std::max( f_max_depth, ++f_depth );
+                return;
+            }
+            void close( const char* a_bracket ) const
+            {
+                f_text += a_bracket;
+                --f_depth;
+                return;
+            }
+    };
+
+    // Checks that each node is left after all of its values were counted
+    class leave_counting_visitor : public counting_visitor
+    {
+        public:
+            using counting_visitor::leave;
+            virtual void leave( const param_node& a_node ) const override
+            {
+                if( a_node.has( "array" ) ) f_values_at_root = f_values.load();
+                ++f_n_left;
+                return;
+            }
+            mutable std::atomic< unsigned > f_n_left{ 0 };
+            mutable unsigned f_values_at_root = 0;
+    };
+
+    // Replaces each array's elements with their sum, once they've been modified; an array element counts as its first element
+    class summing_modifier : public param_modifier
+    {
+        public:
+            using param_modifier::operator();
+            virtual void leave( param_array& an_array ) const override
+            {
+                int t_sum = 0;
+                for( const param& t_element : an_array ) t_sum += t_element.is_value() ? t_element().as_int() : ( t_element.is_array() ? t_element[0]().as_int() : 0 );
+                an_array.clear();
+                an_array.push_back( t_sum );
+                return;
+            }
+    };
+
+    class doubling_modifier : public param_modifier
+    {
+        public:
+            using param_modifier::operator();
+            virtual void operator()( param_value& a_value ) const override
+            {
+                if( a_value.as_int() < 0 ) throw error() << "negative value";
+                a_value.set( 2 * a_value.as_int() );
+                return;
+            }
+    };
+
+    param_node make_wide( unsigned a_n_nodes, unsigned a_n_values )
+    {
+        param_array t_array;
+        for( unsigned i_node = 0; i_node < a_n_nodes; ++i_node )
+        {
+            param_node t_node;
+            for( unsigned i_value = 0; i_value < a_n_values; ++i_value )
+            {
+                t_node.add( "value-" + std::to_string(i_value), (int)i_value );
+            }
+            t_array.push_back( std::move(t_node) );
+        }
+        param_node t_wide;
+        t_wide.add( "array", std::move(t_array) );
+        return t_wide;
+    }
+}
+
+TEST_CASE( "param_traversal", "[param]" )
+{
+    param_node test_nested(
+        "null"_a=param(),
+        "one"_a=1,
+        "array"_a=param_array( args(
+            2,
+            3,
+            param_array( args(4) ),
+            param_node( "five"_a=5, "six"_a=6 )
+        )),
+        "node"_a=param_node(
+            "seven"_a=7
+        )
+    );
+
+    SECTION( "Same order as recursion" )
+    {
+        recording_visitor t_visitor;
+        param_traversal().visit( test_nested, t_visitor );
+        // nodes are visited in name order
+        REQUIRE( t_visitor.f_values == std::vector< int >{ 2, 3, 4, 5, 6, 7, 1 } );
+
+        recording_visitor t_default;
+        test_nested.accept( t_default );
+        REQUIRE( t_default.f_values == t_visitor.f_values );
+    }
+
+    SECTION( "Post-order with leave()" )
+    {
+        param_array t_array( args(
+            1,
+            param_array( args( 2, param_array( args( 3 ) ) ) ),
+            param_node( "four"_a=4 )
+        ));
+
+        bracketing_visitor t_visitor;
+        param_traversal().visit( t_array, t_visitor );
+        REQUIRE( t_visitor.f_text == "[1[2[3]]{4}]" );
+        REQUIRE( t_visitor.f_depth == 0 );
+        REQUIRE( t_visitor.f_max_depth == 3 );
+
+        // the same from accept(), where the outermost array's base-class operator() starts the traversal
+        bracketing_visitor t_default;
+        t_array.accept( t_default );
+        REQUIRE( t_default.f_text == t_visitor.f_text );
+        REQUIRE( t_default.f_depth == 0 );
+
+        // the inner arrays are summed before the outer ones
+        t_array.accept( summing_modifier() );
+        REQUIRE( t_array.size() == 1 );
+        REQUIRE( t_array[0]().as_int() == 6 );
+
+        // a container is left after all of its distributed sub-trees are done
+        param_node t_wide = make_wide( 64, 10 );
+        leave_counting_visitor t_parallel;
+        param_traversal( 4, 16 ).visit( t_wide, t_parallel );
+        REQUIRE( t_parallel.f_n_left.load() == 65 );
+        REQUIRE( t_parallel.f_values_at_root == 640 );
+    }
+
+    SECTION( "Visitors that descend themselves" )
+    {
+        param_visitor_callback_tester t_visitor;
+        param_traversal().visit( test_nested, t_visitor );
+        REQUIRE( t_visitor.get_param_count() == 1 );
+        REQUIRE( t_visitor.get_param_array_count() == 2 );
+        REQUIRE( t_visitor.get_param_node_count() == 3 );
+        REQUIRE( t_visitor.get_param_value_count() == 7 );
+
+        skipping_visitor t_skipping;
+        test_nested.add( "skipped", param_node( "skip"_a=true, "more"_a=1 ) );
+        param_traversal().visit( test_nested, t_skipping );
+        REQUIRE( t_skipping.f_containers.load() == 5 );
+        REQUIRE( t_skipping.f_values.load() == 7 );
+    }
+
+    SECTION( "Deep structures" )
+    {
+        const unsigned t_depth = 10000;
+        param_node t_deep( "value"_a=1 );
+        for( unsigned i_level = 1; i_level < t_depth; ++i_level )
+        {
+            param_node t_parent( "value"_a=1 );
+            t_parent.add( "child", std::move(t_deep) );
+            t_deep = std::move(t_parent);
+        }
+
+        counting_visitor t_visitor;
+        t_deep.accept( t_visitor );
+        REQUIRE( t_visitor.f_containers.load() == t_depth );
+        REQUIRE( t_visitor.f_values.load() == t_depth );
+
+        t_deep.accept( doubling_modifier() );
+        REQUIRE( t_deep["child"]["child"]["value"]().as_int() == 2 );
+    }
+
+    SECTION( "Parallel" )
+    {
+        param_node t_wide = make_wide( 64, 100 );
+        param_traversal t_parallel( 4, 16 );
+        REQUIRE( t_parallel.get_n_threads() == 4 );
+
+        counting_visitor t_visitor;
+        t_parallel.visit( t_wide, t_visitor );
+        REQUIRE( t_visitor.f_containers.load() == 66 );
+        REQUIRE( t_visitor.f_values.load() == 6400 );
+
+        t_parallel.modify( t_wide, doubling_modifier() );
+        for( unsigned i_node = 0; i_node < 64; ++i_node )
+        {
+            REQUIRE( t_wide["array"][i_node]["value-99"]().as_int() == 198 );
+        }
+
+        t_wide["array"][40].as_node().replace( "value-3", -1 );
+        REQUIRE_THROWS_AS( t_parallel.modify( t_wide, doubling_modifier() ), scarab::error );
+
+        REQUIRE( param_traversal( 0 ).get_n_threads() >= 1 );
+    }
+
+    SECTION( "Environment variables" )
+    {
+        setenv( "SCARAB_TRAVERSAL_VAR", "substituted", true );
+        param_node t_config = make_wide( 32, 10 );
+        for( unsigned i_node = 0; i_node < 32; ++i_node )
+        {
+            t_config["array"][i_node].as_node().add( "env", "ENV{SCARAB_TRAVERSAL_VAR}" );
+        }
+
+        param_traversal( 4, 8 ).modify( t_config, param_env_modifier() );
+        for( unsigned i_node = 0; i_node < 32; ++i_node )
+        {
+            REQUIRE( t_config["array"][i_node]["env"]().as_string() == "substituted" );
+        }
+        unsetenv( "SCARAB_TRAVERSAL_VAR" );
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * test_param_typed_array.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using scarab::param_array;
+using scarab::param_double_array;
+using scarab::param_int64_array;
+using scarab::param_node;
+using scarab::param_ptr_t;
+using scarab::param_typed_array_base;
+using scarab::param_uint64_array;
+using scarab::operator""_a;
+
+TEST_CASE( "param_typed_array", "[param]" )
+{
+    param_double_array t_gains{ 1.0, 1.5, 2.0 };
+
+    SECTION( "Element access" )
+    {
+        REQUIRE( t_gains.is_typed_array() );
+        REQUIRE_FALSE( t_gains.is_array() );
+        REQUIRE_FALSE( t_gains.is_null() );
+        REQUIRE( t_gains.type() == "typed_array" );
+        REQUIRE( t_gains.get_element_type() == param_typed_array_base::k_double );
+        REQUIRE( t_gains.element_type_name() == "double" );
+        REQUIRE( t_gains.holds< double >() );
+        REQUIRE_FALSE( t_gains.holds< std::int64_t >() );
+
+        REQUIRE( t_gains.size() == 3 );
+        REQUIRE( t_gains[1] == 1.5 );
+        REQUIRE( t_gains.at(2) == 2.0 );
+        REQUIRE_THROWS_AS( t_gains.at(3), scarab::error );
+        REQUIRE( t_gains.value_at(0).is_double() );
+        REQUIRE( std::vector< double >( t_gains.begin(), t_gains.end() ) == std::vector< double >{ 1.0, 1.5, 2.0 } );
+
+        double* t_data = t_gains.data();
+        t_data[0] = 0.5;
+        REQUIRE( t_gains[0] == 0.5 );
+
+        t_gains.push_back( 2.5 );
+        t_gains.resize( 6, 3.0 );
+        REQUIRE( t_gains.size() == 6 );
+        REQUIRE( t_gains[5] == 3.0 );
+        t_gains.clear();
+        REQUIRE( t_gains.empty() );
+
+        param_uint64_array t_zeros( 1000 );
+        REQUIRE( t_zeros.size() == 1000 );
+        REQUIRE( t_zeros[999] == 0 );
+
+        std::int64_t t_values[] = { -1, 2, -3 };
+        param_int64_array t_from_buffer( t_values, 3 );
+        REQUIRE( t_from_buffer[2] == -3 );
+    }
+
+    SECTION( "Copies share the buffer" )
+    {
+        const param_double_array& t_const_gains = t_gains;
+        param_double_array t_copy( t_const_gains );
+        REQUIRE( t_copy.is_shared() );
+        REQUIRE( std::as_const( t_copy ).data() == t_const_gains.data() );
+
+        t_copy.push_back( 10.0 );
+        REQUIRE_FALSE( t_copy.is_shared() );
+        REQUIRE( t_gains.size() == 3 );
+        REQUIRE( t_copy.size() == 4 );
+
+        param_ptr_t t_clone = t_gains.clone();
+        REQUIRE( t_clone->is_typed_array() );
+        REQUIRE( t_clone->as_typed_array().as< double >()[2] == 2.0 );
+        REQUIRE_THROWS_AS( t_clone->as_typed_array().as< std::uint64_t >(), scarab::error );
+        REQUIRE_THROWS_AS( t_clone->as_array(), scarab::error );
+    }
+
+    SECTION( "In a param structure" )
+    {
+        param_node t_config( "name"_a="detector" );
+        t_config.add( "gains", t_gains );
+        REQUIRE( t_config["gains"].is_typed_array() );
+        REQUIRE( t_config["gains"].as_typed_array().size() == 3 );
+
+        // merging replaces a typed array, as with a value
+        param_node t_update;
+        t_update.add( "gains", param_double_array{ 4.0 } );
+        t_config.merge( t_update );
+        REQUIRE( t_config["gains"].as_typed_array().as< double >()[0] == 4.0 );
+        REQUIRE( t_config["gains"].as_typed_array().size() == 1 );
+
+        scarab::param& t_gains_param = t_config["gains"];
+        t_gains_param.merge( param_double_array{ 5.0, 6.0 } );
+        REQUIRE( t_config["gains"].as_typed_array().size() == 2 );
+        REQUIRE_THROWS_AS( t_gains_param.merge( param_int64_array{ 1 } ), scarab::error );
+
+        REQUIRE( t_config.has_subset( param_node( "gains"_a=param_double_array{ 1.0 } ) ) );
+
+        scarab::param_snapshot t_frozen = t_config.freeze();
+        REQUIRE( t_frozen["gains"].is_array() );
+        REQUIRE( t_frozen["gains"][1]().as_double() == 6.0 );
+        REQUIRE( t_frozen["name"]().as_string() == "detector" );
+    }
+
+    SECTION( "Conversion to and from param_array" )
+    {
+        param_array t_array = t_gains.to_param_array();
+        REQUIRE( t_array.size() == 3 );
+        REQUIRE( t_array[1]().as_double() == 1.5 );
+
+        param_ptr_t t_typed = scarab::to_typed_array( t_array );
+        REQUIRE( t_typed );
+        REQUIRE( t_typed->as_typed_array().holds< double >() );
+
+        param_array t_uints;
+        t_uints.push_back( 1u, 2u, 3u );
+        REQUIRE( scarab::to_typed_array( t_uints )->as_typed_array().holds< std::uint64_t >() );
+
+        param_array t_ints;
+        t_ints.push_back( 1u, -2, 3u );
+        t_typed = scarab::to_typed_array( t_ints );
+        REQUIRE( t_typed->as_typed_array().holds< std::int64_t >() );
+        REQUIRE( t_typed->as_typed_array().as< std::int64_t >()[1] == -2 );
+
+        param_array t_mixed;
+        t_mixed.push_back( 1, 2.5 );
+        REQUIRE( scarab::to_typed_array( t_mixed )->as_typed_array().holds< double >() );
+
+        // signed integers with an unsigned integer too large for int64 can't share a typed array
+        param_array t_too_large;
+        t_too_large.push_back( -1, std::uint64_t( 1 ) << 63 );
+        REQUIRE_FALSE( scarab::to_typed_array( t_too_large ) );
+
+        scarab::typed_array_classifier t_classifier;
+        param_typed_array_base::element_type t_type;
+        REQUIRE_FALSE( t_classifier.classify( t_type ) );
+        REQUIRE_FALSE( t_classifier.add( scarab::param_value( true ) ) );
+        t_classifier.add_uint( std::uint64_t( 1 ) << 63 );
+        REQUIRE( t_classifier.classify( t_type ) );
+        REQUIRE( t_type == param_typed_array_base::k_uint64 );
+        t_classifier.add_int();
+        REQUIRE_FALSE( t_classifier.classify( t_type ) );
+        t_classifier.add_double();
+        REQUIRE( t_classifier.classify( t_type ) );
+        REQUIRE( t_type == param_typed_array_base::k_double );
+
+        param_array t_not_numbers;
+        t_not_numbers.push_back( 1, "two" );
+        REQUIRE_FALSE( scarab::to_typed_array( t_not_numbers ) );
+        REQUIRE_FALSE( scarab::to_typed_array( param_array() ) );
+    }
+}
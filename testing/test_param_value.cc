@@ -11,6 +11,9 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
+#include <limits>
+#include <stdexcept>
+
 using scarab::param_value;
 
 class modify_value : public boost::static_visitor< void >
@@ -138,6 +141,49 @@ TEST_CASE( "param_value", "[param]" )
         REQUIRE( quote_opts_val.is_string() );
     }
 
+    SECTION( "conversions" )
+    {
+        param_value double_val( 2.5 );
+        REQUIRE( double_val.as_string() == std::to_string( 2.5 ) );
+        REQUIRE( double_val.as_int() == 2 );
+
+        param_value big_val( 1.e300 );
+        REQUIRE( big_val.as_string() == std::to_string( 1.e300 ) );
+
+        param_value neg_val( -12345 );
+        REQUIRE( neg_val.as_string() == "-12345" );
+
+        param_value string_val( " +42 is the answer" );
+        REQUIRE( string_val.as_int() == 42 );
+        REQUIRE( string_val.as_uint() == 42 );
+        REQUIRE( string_val.as< int >() == 42 );
+        REQUIRE_THAT( string_val.as_double(), WithinULP( 42., 10 ) );
+
+        string_val = "-1";
+        REQUIRE( string_val.as_uint() == std::numeric_limits< uint64_t >::max() );
+
+        string_val = "2.5e3";
+        REQUIRE_THAT( string_val.as_double(), WithinULP( 2500., 10 ) );
+        REQUIRE_THAT( string_val.as< float >(), WithinULP( 2500.f, 10 ) );
+
+        string_val = "not a number";
+        REQUIRE_THROWS_AS( string_val.as_int(), std::invalid_argument );
+        REQUIRE_THROWS_AS( string_val.as_double(), std::invalid_argument );
+        REQUIRE( string_val.as< int >() == 0 );
+
+        string_val = "123456789012345678901234567890";
+        REQUIRE_THROWS_AS( string_val.as_int(), std::out_of_range );
+
+        string_val = "TRUE";
+        REQUIRE( string_val.as_bool() );
+        string_val = "0";
+        REQUIRE_FALSE( string_val.as_bool() );
+        string_val = "10";
+        REQUIRE( string_val.as_bool() );
+        string_val = "yes";
+        REQUIRE_FALSE( string_val.as_bool() );
+    }
+
     SECTION( "strict_equality" )
     {
         param_value bool_val( true );
@@ -0,0 +1,107 @@
+/*
+ * test_param_versioned_config.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+#include "param_versioned_config.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using scarab::param_node;
+using scarab::versioned_config;
+using scarab::operator""_a;
+
+TEST_CASE( "versioned_config", "[param]" )
+{
+    versioned_config t_holder( param_node( "rate"_a=10, "sub"_a=param_node( "name"_a="detector" ) ) );
+    REQUIRE( t_holder.version_number() == 0 );
+    REQUIRE( t_holder.current()->f_config["rate"]().as_int() == 10 );
+
+    SECTION( "Publishing and reading" )
+    {
+        versioned_config::reader t_reader( t_holder );
+        REQUIRE( t_reader.is_current() );
+        const param_node& t_first = t_reader.get();
+        REQUIRE( t_first["rate"]().as_int() == 10 );
+
+        versioned_config::version_ptr_t t_held = t_holder.current();
+
+        REQUIRE( t_holder.merge( param_node( "rate"_a=20 ) ) == 1 );
+        REQUIRE_FALSE( t_reader.is_current() );
+        REQUIRE( t_reader.get()["rate"]().as_int() == 20 );
+        REQUIRE( t_reader.get()["sub"]["name"]().as_string() == "detector" );
+        REQUIRE( t_reader.version()->f_number == 1 );
+        REQUIRE( t_reader.is_current() );
+
+        // a version that's still held isn't changed
+        REQUIRE( t_held->f_config["rate"]().as_int() == 10 );
+        // and the parts that weren't changed are shared
+        REQUIRE( &t_held->f_config.at("sub") != &t_reader.get().at("sub") );
+        REQUIRE( t_reader.get().at("sub").as_node().is_shared() );
+
+        REQUIRE( t_holder.update( []( param_node& a_config ){ a_config.erase( "sub" ); } ) == 2 );
+        REQUIRE_FALSE( t_reader.get().has( "sub" ) );
+
+        REQUIRE( t_holder.publish( param_node( "other"_a=1 ) ) == 3 );
+        REQUIRE( t_reader.get().size() == 1 );
+        REQUIRE( t_holder.version_number() == 3 );
+    }
+
+    SECTION( "Subscribers" )
+    {
+        std::vector< std::uint64_t > t_notified;
+        int t_last_rate = 0;
+        versioned_config::subscription_id_t t_id = t_holder.subscribe(
+                [&]( const versioned_config::version_ptr_t& a_new, const versioned_config::version_ptr_t& a_old )
+                {
+                    t_notified.push_back( a_new->f_number );
+                    REQUIRE( a_old->f_number + 1 == a_new->f_number );
+                    t_last_rate = a_new->f_config["rate"]().as_int();
+                } );
+        t_holder.subscribe( []( const versioned_config::version_ptr_t&, const versioned_config::version_ptr_t& ){ throw scarab::error() << "subscriber error"; } );
+
+        t_holder.merge( param_node( "rate"_a=20 ) );
+        t_holder.merge( param_node( "rate"_a=30 ) );
+        REQUIRE( t_notified == std::vector< std::uint64_t >{ 1, 2 } );
+        REQUIRE( t_last_rate == 30 );
+
+        t_holder.unsubscribe( t_id );
+        t_holder.merge( param_node( "rate"_a=40 ) );
+        REQUIRE( t_notified.size() == 2 );
+    }
+
+    SECTION( "Reading while publishing" )
+    {
+        std::atomic< bool > t_done( false );
+        std::atomic< bool > t_consistent( true );
+        std::vector< std::thread > t_readers;
+        for( unsigned i_thread = 0; i_thread < 4; ++i_thread )
+        {
+            t_readers.emplace_back( [&t_holder, &t_done, &t_consistent](){
+                versioned_config::reader t_reader( t_holder );
+                while( ! t_done.load() )
+                {
+                    // each version has rate == 10 * (version + 1), and the reader must never see a mix
+                    const versioned_config::version_ptr_t& t_version = t_reader.version();
+                    if( t_version->f_config["rate"]().as_uint() != 10 * (t_version->f_number + 1) ) t_consistent = false;
+                }
+            } );
+        }
+        for( unsigned i_version = 1; i_version <= 200; ++i_version )
+        {
+            t_holder.update( [i_version]( param_node& a_config ){ a_config.replace( "rate", 10 * (i_version + 1) ); } );
+        }
+        t_done = true;
+        for( std::thread& t_reader : t_readers ) t_reader.join();
+
+        REQUIRE( t_consistent.load() );
+        REQUIRE( t_holder.version_number() == 200 );
+    }
+}
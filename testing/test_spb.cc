@@ -0,0 +1,169 @@
+/*
+ * test_spb.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "param.hh"
+#include "param_snapshot.hh"
+#include "param_spb.hh"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+
+using scarab::param_array;
+using scarab::param_input_spb;
+using scarab::param_node;
+using scarab::param_output_spb;
+using scarab::param_ptr_t;
+using scarab::param_snapshot;
+using scarab::param_snapshot_data;
+using scarab::operator""_a;
+
+TEST_CASE( "spb", "[param][param_codec]" )
+{
+    param_node t_input;
+    t_input.add( "string", "hello, world" );
+    t_input.add( "quoted", "''quoted''" );
+    t_input.add( "empty-string", "" );
+    t_input.add( "true", true );
+    t_input.add( "uint64", std::numeric_limits< std::uint64_t >::max() );
+    t_input.add( "int64", std::numeric_limits< std::int64_t >::min() );
+    t_input.add( "double", 0.1 );
+    t_input.add( "null", scarab::param() );
+    t_input.add( "gains", scarab::param_double_array{ 1.5, -2.5 } );
+
+    param_array t_array;
+    for( unsigned i_element = 0; i_element < 20; ++i_element ) t_array.push_back( i_element );
+    t_array.push_back( param_node( "nested"_a=param_array() ) );
+    t_input.add( "array", t_array );
+
+    param_output_spb t_writer;
+    param_input_spb t_reader;
+
+    SECTION( "Round trip through a string" )
+    {
+        std::string t_written;
+        REQUIRE( t_writer.write_string( t_input, t_written ) );
+        REQUIRE( t_written.size() % 8 == 0 );
+
+        param_ptr_t t_output = t_reader.read_string( t_written );
+        REQUIRE( t_output );
+        const param_node& t_node = t_output->as_node();
+        REQUIRE( t_node.size() == t_input.size() );
+
+        // every value keeps its type and value
+        const param_node& t_const_input = t_input;
+        for( param_node::const_iterator t_it = t_const_input.begin(); t_it != t_const_input.end(); ++t_it )
+        {
+            if( ! t_it->is_value() ) continue;
+            INFO( t_it.name() );
+            REQUIRE( t_node[t_it.name()]().type() == t_it->as_value().type() );
+            REQUIRE( t_node[t_it.name()]() == t_it->as_value() );
+        }
+        REQUIRE( t_node["quoted"]().as_string() == "'quoted'" );
+        REQUIRE( t_node["null"].is_null() );
+        // typed arrays are frozen as arrays of values
+        REQUIRE( t_node["gains"][1]().as_double() == -2.5 );
+        REQUIRE( t_node["array"].as_array().size() == 21 );
+        REQUIRE( t_node["array"][20]["nested"].is_array() );
+
+        // the same param structure always gives the same image
+        std::string t_rewritten;
+        REQUIRE( t_writer.write_string( t_input, t_rewritten ) );
+        REQUIRE( t_rewritten == t_written );
+
+        // invalid images
+        REQUIRE_FALSE( t_reader.read_string( t_written.substr( 0, t_written.size() - 8 ) ) );
+        REQUIRE_FALSE( t_reader.read_string( "not a snapshot image, but long enough to have a header" ) );
+        REQUIRE_FALSE( t_reader.read_string( "" ) );
+    }
+
+    SECTION( "Mapped files" )
+    {
+        const std::string t_filename( "test_spb.spb" );
+        scarab::param_translator t_translator;
+        REQUIRE( t_translator.write_file( t_input, t_filename ) );
+
+        param_ptr_t t_from_file = t_translator.read_file( t_filename );
+        REQUIRE( t_from_file );
+        REQUIRE( t_from_file->as_node()["int64"]().as_int() == std::numeric_limits< std::int64_t >::min() );
+
+        param_snapshot t_mapped = param_snapshot::map_file( t_filename );
+        REQUIRE( t_mapped.n_params() == t_input.freeze().n_params() );
+        REQUIRE( t_mapped["string"]().as_string() == "hello, world" );
+        REQUIRE( t_mapped.get_value( "string", "" ) == "hello, world" );
+        REQUIRE( t_mapped.get_value( "quoted", "" ) == "'quoted'" );
+        REQUIRE( t_mapped["array"][19]().as_uint() == 19 );
+        REQUIRE_FALSE( t_mapped.has( "missing" ) );
+
+        // rewriting the file replaces it, so the existing mapping still sees the previous contents
+        REQUIRE( t_translator.write_file( param_node( "string"_a="goodbye" ), t_filename ) );
+        REQUIRE( t_mapped["string"]().as_string() == "hello, world" );
+        REQUIRE( param_snapshot::map_file( t_filename )["string"]().as_string() == "goodbye" );
+
+        std::remove( t_filename.c_str() );
+        REQUIRE( t_mapped["array"].size() == 21 );
+        REQUIRE_THROWS_AS( param_snapshot::map_file( t_filename ), scarab::error );
+    }
+
+    SECTION( "Corrupt images" )
+    {
+        std::string t_written;
+        REQUIRE( t_writer.write_string( t_input, t_written ) );
+
+        param_snapshot_data::header t_header;
+        std::memcpy( &t_header, t_written.data(), sizeof( t_header ) );
+        const std::size_t t_entries = sizeof( param_snapshot_data::header );
+        const std::size_t t_values = ( t_entries + t_header.f_n_entries * sizeof( param_snapshot_data::entry ) + 7 ) & ~std::size_t( 7 );
+
+        // a copy of the image with a_field written at an_offset
+        auto t_corrupt = [&t_written]( std::size_t an_offset, auto a_field )
+        {
+            std::string t_image( t_written );
+            std::memcpy( &t_image[ an_offset ], &a_field, sizeof( a_field ) );
+            return t_image;
+        };
+        const std::size_t t_first = offsetof( param_snapshot_data::entry, f_first );
+        const std::size_t t_size = offsetof( param_snapshot_data::entry, f_size );
+
+        // the root node's children out of bounds
+        REQUIRE_FALSE( t_reader.read_string( t_corrupt( t_entries + t_first, std::uint32_t( 1000000 ) ) ) );
+        REQUIRE_FALSE( t_reader.read_string( t_corrupt( t_entries + t_size, std::uint32_t( 0xFFFFFFF0 ) ) ) );
+        // the first child ("array") with children that start at itself, which would be a cycle
+        std::string t_cycle = t_corrupt( t_entries + sizeof( param_snapshot_data::entry ) + t_first, std::uint32_t( 1 ) );
+        REQUIRE_FALSE( t_reader.read_string( t_cycle ) );
+        // the second child ("double") with a value past the value section, and the second value ("empty-string") with characters past the buffer
+        REQUIRE_FALSE( t_reader.read_string( t_corrupt( t_entries + 2 * sizeof( param_snapshot_data::entry ) + t_first, std::uint32_t( t_header.f_n_values ) ) ) );
+        REQUIRE_FALSE( t_reader.read_string( t_corrupt( t_values + sizeof( param_snapshot_data::value ) + offsetof( param_snapshot_data::value, f_size ), std::uint32_t( 0x7FFFFFFF ) ) ) );
+        REQUIRE_THROWS_AS( param_snapshot( t_cycle.data(), t_cycle.size() ), scarab::error );
+
+        // every single-byte corruption either fails to read or reads without touching memory outside of the image (as a sanitizer build checks)
+        for( std::size_t i_byte = 0; i_byte < t_written.size(); ++i_byte )
+        {
+            std::string t_image( t_written );
+            t_image[ i_byte ] = char( ~t_image[ i_byte ] );
+            param_ptr_t t_read = t_reader.read_string( t_image );
+            if( t_read ) t_read->to_string();
+        }
+
+        // a mapped file is only checked when it's validated, which the codec does
+        const std::string t_filename( "test_spb_corrupt.spb" );
+        {
+            std::ofstream t_file( t_filename, std::ios::binary );
+            t_file.write( t_cycle.data(), t_cycle.size() );
+        }
+        param_snapshot t_mapped = param_snapshot::map_file( t_filename );
+        REQUIRE_THROWS_AS( t_mapped.validate(), scarab::error );
+        REQUIRE_FALSE( t_reader.read_file( t_filename ) );
+        std::remove( t_filename.c_str() );
+    }
+}
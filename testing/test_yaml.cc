@@ -11,7 +11,14 @@
 
 #include "catch2/catch_test_macros.hpp"
 
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
 
 
 using scarab::param_node;
@@ -20,6 +27,7 @@ using scarab::param_array;
 using scarab::param_ptr_t;
 using scarab::param_output_yaml;
 using scarab::param_input_yaml;
+using scarab::operator""_a;
 
 TEST_CASE( "yaml", "[param][param_codec]" )
 {
@@ -72,3 +80,229 @@ TEST_CASE( "yaml", "[param][param_codec]" )
     REQUIRE( t_output_node["node"]["second"].is_value() );
     REQUIRE( t_output_node["node"]["second"]().as_string() == "hijklmnop" );
 }
+
+TEST_CASE( "yaml typed arrays", "[param][param_codec]" )
+{
+    param_node t_input;
+    t_input.add( "gains", scarab::param_double_array{ 1.5, 2.5, 3.5 } );
+    t_input.add( "offsets", scarab::param_int64_array{ -1, 0, 1 } );
+    t_input.add( "names", param_array() );
+    t_input["names"].as_array().push_back( "a", "b" );
+
+    param_output_yaml t_writer;
+    std::string t_written;
+    REQUIRE( t_writer.write_string( t_input, t_written ) );
+
+    param_input_yaml t_reader;
+
+    // by default, arrays of numbers are read as param_arrays
+    param_ptr_t t_boxed( t_reader.read_string( t_written ) );
+    REQUIRE( t_boxed->as_node()["gains"].is_array() );
+    REQUIRE( t_boxed->as_node()["gains"][1]().as_double() == 2.5 );
+
+    param_ptr_t t_output( t_reader.read_string( t_written, param_node( "typed-arrays"_a=true ) ) );
+    const param_node& t_output_node = t_output->as_node();
+    REQUIRE( t_output_node["gains"].is_typed_array() );
+    REQUIRE( t_output_node["gains"].as_typed_array().as< double >()[2] == 3.5 );
+    REQUIRE( t_output_node["offsets"].as_typed_array().as< std::int64_t >()[0] == -1 );
+    REQUIRE( t_output_node["names"].is_array() );
+}
+
+TEST_CASE( "yaml emitter", "[param][param_codec]" )
+{
+    param_node t_input;
+    t_input.add( "string", "hello, world" );
+    t_input.add( "numeric-string", "1.5" );
+    t_input.add( "multiline", "line 1\nline 2" );
+    t_input.add( "true", true );
+    t_input.add( "uint", std::numeric_limits< std::uint64_t >::max() );
+    t_input.add( "int", -42 );
+    t_input.add( "tenth", 0.1 );
+    t_input.add( "nan", std::nan( "" ) );
+    t_input.add( "-inf", -HUGE_VAL );
+    t_input.add( "null", scarab::param() );
+    t_input.add( "empty-node", param_node() );
+    t_input.add( "empty-array", param_array() );
+    t_input.add( "gains", scarab::param_double_array{ 1.5, 1.0 / 3.0 } );
+    t_input.add( "empty-gains", scarab::param_double_array() );
+    param_array t_nested;
+    t_nested.push_back( 3, 4 );
+    param_array t_array;
+    t_array.push_back( 1, "two", scarab::param(), param_array(), param_node( "nested"_a=t_nested ), scarab::param_uint64_array{ 5, 6 } );
+    t_input.add( "array", t_array );
+
+    param_output_yaml t_writer;
+
+    // emitting directly gives the same output as emitting the YAML::Node from check_param_type()
+    const scarab::param t_null;
+    const param_node t_empty;
+    const param_value t_value( 2.5 );
+    for( const scarab::param* t_param : std::vector< const scarab::param* >{ &t_input, &t_array, &t_null, &t_empty, &t_value } )
+    {
+        YAML::Emitter t_node_emitter;
+        t_node_emitter << t_writer.check_param_type( *t_param );
+
+        std::string t_written;
+        REQUIRE( t_writer.write_string( *t_param, t_written ) );
+        REQUIRE( t_written == t_node_emitter.c_str() );
+    }
+
+    // and it reads back
+    std::string t_written;
+    REQUIRE( t_writer.write_string( t_input, t_written ) );
+    param_input_yaml t_reader;
+    param_ptr_t t_output( t_reader.read_string( t_written ) );
+    const param_node& t_output_node = t_output->as_node();
+    REQUIRE( t_output_node["numeric-string"]().as_double() == 1.5 );
+    REQUIRE( t_output_node["multiline"]().as_string() == "line 1\nline 2" );
+    REQUIRE( t_output_node["tenth"]().as_double() == 0.1 );
+    REQUIRE( std::isnan( t_output_node["nan"]().as_double() ) );
+    REQUIRE( t_output_node["array"][4]["nested"][1]().as_uint() == 4 );
+    REQUIRE( t_output_node["gains"][1]().as_double() == 1.0 / 3.0 );
+}
+
+TEST_CASE( "yaml streaming and multiple documents", "[param][param_codec]" )
+{
+    const std::string t_yaml(
+        "defaults: &defaults\n"
+        "  rate: 100\n"
+        "  mode: triggered\n"
+        "  gains: &gains [1.5, 2.5]\n"
+        "channels:\n"
+        "  - *defaults\n"
+        "  - {rate: -5, mode: 'free', gains: *gains}\n"
+        "&name label: first\n"
+        "*name : second\n"
+        "empty:\n"
+        "~: null key\n"
+        "repeated: 1\n"
+        "repeated: 2\n"
+        "flags: [yes, Off, 0x10, .inf, \"quoted\"]\n" );
+
+    param_input_yaml t_reader;
+
+    SECTION( "Streaming gives the same result as converting a YAML::Node" )
+    {
+        for( bool t_typed_arrays : { false, true } )
+        {
+            param_ptr_t t_streamed = t_reader.read_string( t_yaml, param_node( "typed-arrays"_a=t_typed_arrays ) );
+            param_ptr_t t_from_node = t_reader.read_string( t_yaml, param_node( "typed-arrays"_a=t_typed_arrays, "node"_a=true ) );
+            REQUIRE( t_streamed );
+            REQUIRE( t_from_node );
+            REQUIRE( t_streamed->to_string() == t_from_node->to_string() );
+            REQUIRE( t_streamed->has_subset( *t_from_node ) );
+            REQUIRE( t_from_node->has_subset( *t_streamed ) );
+        }
+
+        param_ptr_t t_output = t_reader.read_string( t_yaml );
+        const param_node& t_node = t_output->as_node();
+        REQUIRE( t_node["channels"][0]["rate"]().as_uint() == 100 );
+        REQUIRE( t_node["channels"][1]["rate"]().as_int() == -5 );
+        REQUIRE( t_node["channels"][1]["gains"][1]().as_double() == 2.5 );
+        REQUIRE( t_node["label"]().as_string() == "second" );
+        REQUIRE( t_node["empty"].is_null() );
+        REQUIRE( t_node["null"]().as_string() == "null key" );
+        REQUIRE( t_node["repeated"]().as_uint() == 2 );
+        REQUIRE( t_node["flags"][0]().as_bool() );
+        REQUIRE( t_node["flags"][2]().as_uint() == 16 );
+
+        REQUIRE( t_reader.read_string( "" )->is_null() );
+        REQUIRE( (*t_reader.read_string( "5" ))().as_uint() == 5 );
+        REQUIRE_FALSE( t_reader.read_string( "a: [1, 2" ) );
+        REQUIRE_FALSE( t_reader.read_string( "? [1, 2]\n: value\n" ) );
+        REQUIRE_FALSE( t_reader.read_file( "nonexistent_file.yaml" ) );
+    }
+
+    SECTION( "Multiple documents" )
+    {
+        std::stringstream t_stream( "---\nindex: 0\n---\nindex: 1\n...\n---\n- 2\n---\n" );
+        std::vector< std::string > t_documents;
+        REQUIRE( t_reader.read_documents( t_stream, [&t_documents]( param_ptr_t a_document ){ t_documents.push_back( a_document->to_string() ); return true; } ) );
+        REQUIRE( t_documents.size() == 4 );
+        REQUIRE( t_documents[1] == param_node( "index"_a=1 ).to_string() );
+        REQUIRE( t_documents[3] == scarab::param().to_string() );
+
+        // the callback can stop the reading
+        std::stringstream t_second_stream( "a: 1\n---\nb: 2\n---\n[unterminated\n" );
+        unsigned t_count = 0;
+        REQUIRE( t_reader.read_documents( t_second_stream, [&t_count]( param_ptr_t ){ return ++t_count < 2; } ) );
+        REQUIRE( t_count == 2 );
+
+        // documents before an error are still passed on
+        std::stringstream t_third_stream( "a: 1\n---\nb: 2\n---\n[unterminated\n" );
+        t_count = 0;
+        REQUIRE_FALSE( t_reader.read_documents( t_third_stream, [&t_count]( param_ptr_t ){ ++t_count; return true; } ) );
+        REQUIRE( t_count == 2 );
+
+        // read_stream() reads the first document
+        std::stringstream t_fourth_stream( "a: 1\n---\nb: 2\n" );
+        REQUIRE( t_reader.read_stream( t_fourth_stream )->as_node().has( "a" ) );
+    }
+}
+
+namespace
+{
+    // the type a scalar gets from trying YAML::Node::as<>() in order, as param_input_yaml did before scalar_value()
+    param_value scalar_value_by_exceptions( const std::string& a_scalar )
+    {
+        YAML::Node t_node( a_scalar );
+        try { return param_value( t_node.as< unsigned >() ); }
+        catch( const YAML::TypedBadConversion< unsigned >& ) {}
+        try { return param_value( t_node.as< int >() ); }
+        catch( const YAML::TypedBadConversion< int >& ) {}
+        try { return param_value( t_node.as< double >() ); }
+        catch( const YAML::TypedBadConversion< double >& ) {}
+        try { return param_value( t_node.as< bool >() ); }
+        catch( const YAML::TypedBadConversion< bool >& ) {}
+        return param_value( t_node.as< std::string >() );
+    }
+
+    void check_scalar_value( const std::string& a_scalar )
+    {
+        INFO( "Scalar: <" << a_scalar << ">" );
+        param_value t_expected = scalar_value_by_exceptions( a_scalar );
+        param_value t_value = param_input_yaml::scalar_value( a_scalar );
+        REQUIRE( t_value.type() == t_expected.type() );
+        if( t_value.is_double() && std::isnan( t_expected.as_double() ) ) REQUIRE( std::isnan( t_value.as_double() ) );
+        else REQUIRE( t_value == t_expected );
+    }
+}
+
+TEST_CASE( "yaml scalar typing", "[param][param_codec]" )
+{
+    REQUIRE( param_input_yaml::scalar_value( "5" ).is_uint() );
+    REQUIRE( param_input_yaml::scalar_value( "-5" ).is_int() );
+    REQUIRE( param_input_yaml::scalar_value( "5.5" ).is_double() );
+    REQUIRE( param_input_yaml::scalar_value( "Yes" ).is_bool() );
+    REQUIRE( param_input_yaml::scalar_value( "hello" ).is_string() );
+
+    SECTION( "Edge cases" )
+    {
+        const std::vector< std::string > t_scalars{
+            "", " ", "0", "00", "07", "08", "010", "-010", "0x", "0x1F", "0X1f", "-0x10", "+0x10", "0x1G", "00x5",
+            "+5", "-0", "+-5", "5 ", " 5", "5\t\n", "5x", "1,000",
+            "4294967295", "4294967296", "-2147483648", "-2147483649", "2147483648", "99999999999999999999",
+            "1.5", "-1.5", "+1.5", ".5", "5.", ".", "-.", "1e5", "1E+5", "1e-5", "1.e5", "1e", "1e+", "e5", ".e5", "1e5.5", "1.5.2",
+            "1e400", "-1e400", "1e-400", "0.1e-320", "inf", "nan", "infinity", "0x1p3",
+            ".inf", ".Inf", ".INF", "+.inf", "-.inf", "-.INF", ".nan", ".NaN", ".NAN", ".iNF",
+            "y", "Y", "n", "yes", "Yes", "YES", "yEs", "YeS", "no", "NO", "true", "True", "TRUE", "tRUE", "false", "False",
+            "on", "On", "ON", "off", "Off", "OFF", "truex", "maybe",
+            "hello, world", "'quoted'", "42abc"
+        };
+        for( const std::string& t_scalar : t_scalars ) check_scalar_value( t_scalar );
+    }
+
+    SECTION( "Generated scalars" )
+    {
+        const std::string t_alphabet( "0123456789+-.eExXaFfnoOyYtT \t" );
+        std::mt19937 t_generator( 20261018 );
+        std::uniform_int_distribution< std::size_t > t_length( 1, 7 );
+        std::uniform_int_distribution< std::size_t > t_char( 0, t_alphabet.size() - 1 );
+        for( unsigned i_scalar = 0; i_scalar < 20000; ++i_scalar )
+        {
+            std::string t_scalar( t_length( t_generator ), ' ' );
+            for( char& t_c : t_scalar ) t_c = t_alphabet[ t_char( t_generator ) ];
+            check_scalar_value( t_scalar );
+        }
+    }
+}